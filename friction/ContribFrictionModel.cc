@@ -0,0 +1,1130 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+// See ContribFrictionModel.hh for a description of each C++ function
+// and its arguments.
+
+#include <portinfo> // machine specific info generated by configure
+
+#include "ContribFrictionModel.hh" // implementation of object methods
+
+#include "FrictionVertexFields.hh" // USES FrictionVertexFields
+
+#include "pylith/utils/constdefs.h" // USES PYLITH_MAXSCALAR
+
+#include "spatialdata/units/Nondimensional.hh" // USES Nondimensional
+
+#include <petscsys.h> // USES MPI_Comm_rank()
+
+#include <algorithm> // USES std::min(), std::max(), std::swap()
+#include <cassert> // USES assert()
+#include <cmath> // USES floor(), pow()
+#include <cstring> // USES memcpy()
+#include <sstream> // USES std::ostringstream
+#include <stdexcept> // USES std::runtime_error, std::logic_error
+
+#if defined(_OPENMP)
+#include <omp.h> // USES omp_get_max_threads()
+#endif
+
+// ----------------------------------------------------------------------
+namespace contrib {
+  namespace friction {
+    namespace _ContribFrictionModel {
+
+      // Minimum number of vertices per thread in the batch functions.
+      const int minVerticesPerThread = 1024;
+
+      /** Replace "%d" in the name of a file by the MPI rank.
+       *
+       * @param filename Name of file.
+       *
+       * @returns Name of file of this process.
+       */
+      std::string
+      rankFilename(const std::string& filename)
+      { // rankFilename
+	std::string rankName = filename;
+	const size_t pos = rankName.find("%d");
+	if (pos != std::string::npos) {
+	  int rank = 0;
+	  MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
+	  std::ostringstream rankString;
+	  rankString << rank;
+	  rankName.replace(pos, 2, rankString.str());
+	} // if
+	return rankName;
+      } // rankFilename
+
+      /** Get number of property values per vertex.
+       *
+       * @param metadata Metadata of the friction model.
+       * @returns Sum of the fiber dimensions of the properties.
+       */
+      int
+      propertiesFiberDim(const pylith::materials::Metadata& metadata)
+      { // propertiesFiberDim
+	const pylith::string_vector& names = metadata.properties();
+	int fiberDim = 0;
+	for (size_t i=0; i < names.size(); ++i)
+	  fiberDim += metadata.getProperty(names[i].c_str()).fiberDim;
+	return fiberDim;
+      } // propertiesFiberDim
+
+      /** Get number of state variable values per vertex.
+       *
+       * @param metadata Metadata of the friction model.
+       * @returns Sum of the fiber dimensions of the state variables.
+       */
+      int
+      stateVarsFiberDim(const pylith::materials::Metadata& metadata)
+      { // stateVarsFiberDim
+	const pylith::string_vector& names = metadata.stateVars();
+	int fiberDim = 0;
+	for (size_t i=0; i < names.size(); ++i)
+	  fiberDim += metadata.getStateVar(names[i].c_str()).fiberDim;
+	return fiberDim;
+      } // stateVarsFiberDim
+
+      // Number of vertices listed for each rule violated by the
+      // properties.
+      const int maxReportedVertices = 10;
+
+      // Number of vertices dimensionalized at a time when writing
+      // vertex fields.
+      const int fieldsBlockSize = 4096;
+
+      // Number of vertices in each block of the batch scaling
+      // functions. The scales are repeated over a block, so the
+      // values of a block are scaled in one contiguous loop.
+      const int scaleBlockSize = 256;
+
+      // Names of PETSc log events (after the prefix), in the order of
+      // EventEnum.
+      const char* eventNames[] = {
+	"friction",
+	"update",
+	"dbProps",
+      };
+
+      // Names of regimes in header of census file, in the order of
+      // RegimeEnum.
+      const char* regimeNames[] = {
+	"locked",
+	"weakening",
+	"weakening2",
+	"residual",
+	"tension",
+      };
+
+    } // _ContribFrictionModel
+  } // friction
+} // contrib
+
+// ----------------------------------------------------------------------
+// Default constructor.
+contrib::friction::ContribFrictionModel::ContribFrictionModel(const pylith::materials::Metadata& metadata) :
+  pylith::friction::FrictionModel(metadata),
+  _numStateVars(_ContribFrictionModel::stateVarsFiberDim(metadata)),
+  _numProperties(_ContribFrictionModel::propertiesFiberDim(metadata)),
+  _numThreads(0),
+  _logger(0),
+  _censusFilename(""),
+  _census(NUM_REGIMES)
+{ // constructor
+  _propertiesCheck.active = false;
+  _propertiesCheck.numInvalid = 0;
+  for (int i=0; i < NUM_EVENTS; ++i)
+    _events[i] = -1;
+} // constructor
+
+// ----------------------------------------------------------------------
+// Destructor.
+contrib::friction::ContribFrictionModel::~ContribFrictionModel(void)
+{ // destructor
+  delete _logger; _logger = 0;
+} // destructor
+
+// ----------------------------------------------------------------------
+// Set nondimensionalizer.
+void
+contrib::friction::ContribFrictionModel::normalizer(const spatialdata::units::Nondimensional& dim)
+{ // normalizer
+  pylith::friction::FrictionModel::normalizer(dim);
+  _updateScales();
+} // normalizer
+
+// ----------------------------------------------------------------------
+// Get number of state variables per vertex.
+int
+contrib::friction::ContribFrictionModel::numStateVars(void) const
+{ // numStateVars
+  return _numStateVars;
+} // numStateVars
+
+// ----------------------------------------------------------------------
+// Set number of threads used in the batch functions.
+void
+contrib::friction::ContribFrictionModel::numThreads(const int value)
+{ // numThreads
+  if (value < 0) {
+    std::ostringstream msg;
+    msg << "Number of threads for friction model '" << label()
+	<< "' must be nonnegative.\n"
+	<< "Number of threads: " << value << "\n";
+    throw std::runtime_error(msg.str());
+  } // if
+
+  _numThreads = value;
+} // numThreads
+
+// ----------------------------------------------------------------------
+// Get number of threads used in the batch functions.
+int
+contrib::friction::ContribFrictionModel::numThreads(void) const
+{ // numThreads
+  return _numThreads;
+} // numThreads
+
+// ----------------------------------------------------------------------
+// Set name of file for the number of vertices in each regime.
+void
+contrib::friction::ContribFrictionModel::censusFilename(const char* value)
+{ // censusFilename
+  assert(value);
+
+  _census.close();
+  _censusFilename = value;
+  if (_censusFilename.empty())
+    return;
+
+  // Each process writes its own file.
+  const std::string filename = _ContribFrictionModel::rankFilename(_censusFilename);
+  try {
+    _census.open(filename.c_str(), label(), _ContribFrictionModel::regimeNames);
+  } catch (...) {
+    _censusFilename = "";
+    throw;
+  } // try/catch
+} // censusFilename
+
+// ----------------------------------------------------------------------
+// Get name of file for the number of vertices in each regime.
+const char*
+contrib::friction::ContribFrictionModel::censusFilename(void) const
+{ // censusFilename
+  return _censusFilename.c_str();
+} // censusFilename
+
+// ----------------------------------------------------------------------
+// Get time of the last state update counted in the census.
+PylithScalar
+contrib::friction::ContribFrictionModel::censusTime(void) const
+{ // censusTime
+  return _census.time();
+} // censusTime
+
+// ----------------------------------------------------------------------
+// Get number of vertices in a regime at the last state update.
+int
+contrib::friction::ContribFrictionModel::regimeCount(const RegimeEnum regime) const
+{ // regimeCount
+  assert(regime >= 0 && regime < NUM_REGIMES);
+
+  return _census.count(regime);
+} // regimeCount
+
+// ----------------------------------------------------------------------
+// Get number of vertices whose derivative of friction with slip
+// changed at the last state update.
+int
+contrib::friction::ContribFrictionModel::tangentChangeCount(void) const
+{ // tangentChangeCount
+  return _census.tangentChanges();
+} // tangentChangeCount
+
+// ----------------------------------------------------------------------
+// Check whether the derivative of friction with slip may have changed
+// at the last state update.
+bool
+contrib::friction::ContribFrictionModel::tangentChanged(void) const
+{ // tangentChanged
+  return !_census.started() || _census.tangentChanges() > 0;
+} // tangentChanged
+
+// ----------------------------------------------------------------------
+// Register PETSc log events for the functions of the model.
+void
+contrib::friction::ContribFrictionModel::loggingPrefix(const char* value)
+{ // loggingPrefix
+  assert(value);
+
+  delete _logger; _logger = new pylith::utils::EventLogger;
+  _logger->className("FrictionModel");
+  _logger->initialize();
+  for (int i=0; i < NUM_EVENTS; ++i) {
+    const std::string name = std::string(value) + _ContribFrictionModel::eventNames[i];
+    _events[i] = _logger->registerEvent(name.c_str());
+  } // for
+} // loggingPrefix
+
+// ----------------------------------------------------------------------
+// Set name of file for recording the calls to the model.
+void
+contrib::friction::ContribFrictionModel::traceFilename(const char* value)
+{ // traceFilename
+  assert(value);
+
+  _traceRecorder.open(value);
+} // traceFilename
+
+// ----------------------------------------------------------------------
+// Get name of file for recording the calls to the model.
+const char*
+contrib::friction::ContribFrictionModel::traceFilename(void) const
+{ // traceFilename
+  return _traceRecorder.filename();
+} // traceFilename
+
+// ----------------------------------------------------------------------
+// Create the fields of physical properties and state variables and
+// fill them.
+void
+contrib::friction::ContribFrictionModel::initialize(const pylith::topology::Mesh& faultMesh,
+						    pylith::feassemble::Quadrature* quadrature)
+{ // initialize
+  _updateScales();
+
+  // Invalid properties are recorded by _dbToProperties() instead of
+  // stopping the queries at the first vertex. Swapping with an idle
+  // check ends the recording and keeps what was recorded.
+  PropertiesCheck check;
+  check.active = false;
+  check.numInvalid = 0;
+  _propertiesCheck = check;
+  _propertiesCheck.active = true;
+  try {
+    pylith::friction::FrictionModel::initialize(faultMesh, quadrature);
+  } catch (...) {
+    std::swap(_propertiesCheck, check);
+    throw;
+  } // try/catch
+  std::swap(_propertiesCheck, check);
+
+  const int numVertices = check.invalid.size();
+  std::ostringstream rulesReport;
+  const int numViolated =
+    _checkPropertyRules((numVertices > 0) ? &check.properties[0] : 0, _numProperties,
+			numVertices, (numVertices > 0) ? &check.invalid[0] : 0, &rulesReport);
+  if (check.numInvalid > 0 || numViolated > 0) {
+    std::ostringstream msg;
+    msg << "Could not initialize properties of friction model '" << label()
+	<< "' at " << numVertices << " vertices:";
+    if (check.numInvalid > 0)
+      msg << "\n  Invalid values of physical properties at "
+	  << check.numInvalid << ((1 == check.numInvalid) ? " vertex" : " vertices")
+	  << ", first:" << check.report;
+    if (numViolated > 0)
+      msg << "\n  Properties violate " << numViolated
+	  << ((1 == numViolated) ? " rule" : " rules")
+	  << " (number of vertices and first vertices violating each rule):"
+	  << rulesReport.str();
+    throw std::runtime_error(msg.str());
+  } // if
+} // initialize
+
+// ----------------------------------------------------------------------
+// Compute properties from values in spatial database.
+void
+contrib::friction::ContribFrictionModel::_dbToProperties(PylithScalar* const propValues,
+							 const pylith::scalar_array& dbValues) const
+{ // _dbToProperties
+  assert(propValues);
+
+  _eventBegin(DB_PROPERTIES_EVENT);
+  unsigned char invalid = 0;
+  try {
+    _dbValuesToProperties(propValues, dbValues);
+  } catch (const std::runtime_error& err) {
+    if (!_propertiesCheck.active) {
+      _eventEnd(DB_PROPERTIES_EVENT);
+      throw;
+    } // if
+    invalid = 1;
+    if (_propertiesCheck.numInvalid++ < _ContribFrictionModel::maxReportedVertices) {
+      std::ostringstream report;
+      report << "\n    vertex " << _propertiesCheck.invalid.size() << ": " << err.what();
+      _propertiesCheck.report += report.str();
+    } // if
+  } // try/catch
+  if (_propertiesCheck.active) {
+    _propertiesCheck.invalid.push_back(invalid);
+    _propertiesCheck.properties.insert(_propertiesCheck.properties.end(),
+				       propValues, propValues+_numProperties);
+  } // if
+  _eventEnd(DB_PROPERTIES_EVENT);
+} // _dbToProperties
+
+// ----------------------------------------------------------------------
+// Check the properties of a batch of fault vertices against the rules
+// of the model.
+void
+contrib::friction::ContribFrictionModel::validateProperties(const PylithScalar* properties,
+							    const int numProperties,
+							    const int numVertices) const
+{ // validateProperties
+  assert(properties || 0 == numVertices);
+  assert(numProperties > 0);
+  assert(numVertices >= 0);
+
+  std::ostringstream report;
+  const int numViolated = _checkPropertyRules(properties, numProperties, numVertices, 0, &report);
+  if (numViolated > 0) {
+    std::ostringstream msg;
+    msg << "Properties of friction model '" << label() << "' at " << numVertices
+	<< " vertices violate " << numViolated << ((1 == numViolated) ? " rule" : " rules")
+	<< " (number of vertices and first vertices violating each rule):"
+	<< report.str();
+    throw std::runtime_error(msg.str());
+  } // if
+} // validateProperties
+
+// ----------------------------------------------------------------------
+// Check the properties of a batch of fault vertices against the rules
+// of the model, skipping flagged vertices.
+int
+contrib::friction::ContribFrictionModel::_checkPropertyRules(const PylithScalar* properties,
+							     const int numProperties,
+							     const int numVertices,
+							     const unsigned char* skip,
+							     std::ostream* report) const
+{ // _checkPropertyRules
+  assert(properties || 0 == numVertices);
+  assert(numProperties > 0);
+  assert(numVertices >= 0);
+  assert(report);
+
+  std::vector<PropertyRule> rules;
+  _propertyRules(&rules);
+  const int numRules = rules.size();
+
+  // Flag the vertices violating each rule in a separate pass, so the
+  // loops over the vertices do not branch on the kind of rule.
+  const int numThreads = _batchThreads(numVertices);
+  std::vector<unsigned char> violated(numVertices);
+  int numViolated = 0;
+  for (int iRule=0; iRule < numRules; ++iRule) {
+    const PropertyRule& rule = rules[iRule];
+    assert(rule.property >= 0 && rule.property < numProperties);
+    assert(rule.other >= 0 && rule.other < numProperties);
+    const PylithScalar* values = &properties[rule.property];
+    const PylithScalar* others = &properties[rule.other];
+    const PylithScalar bound = rule.bound;
+    unsigned char* flags = (numVertices > 0) ? &violated[0] : 0;
+    switch (rule.kind) {
+    case POSITIVE_RULE :
+#if defined(_OPENMP)
+#pragma omp parallel for num_threads(numThreads) schedule(static)
+#endif
+      for (int i=0; i < numVertices; ++i)
+	flags[i] = !(values[i*numProperties] > 0.0);
+      break;
+    case NONNEGATIVE_RULE :
+#if defined(_OPENMP)
+#pragma omp parallel for num_threads(numThreads) schedule(static)
+#endif
+      for (int i=0; i < numVertices; ++i)
+	flags[i] = !(values[i*numProperties] >= 0.0);
+      break;
+    case GREATER_RULE :
+#if defined(_OPENMP)
+#pragma omp parallel for num_threads(numThreads) schedule(static)
+#endif
+      for (int i=0; i < numVertices; ++i)
+	flags[i] = !(values[i*numProperties] > others[i*numProperties]);
+      break;
+    case NOT_LESS_RULE :
+#if defined(_OPENMP)
+#pragma omp parallel for num_threads(numThreads) schedule(static)
+#endif
+      for (int i=0; i < numVertices; ++i)
+	flags[i] = !(values[i*numProperties] >= others[i*numProperties]);
+      break;
+    case INDEX_RULE :
+#if defined(_OPENMP)
+#pragma omp parallel for num_threads(numThreads) schedule(static)
+#endif
+      for (int i=0; i < numVertices; ++i) {
+	const PylithScalar value = values[i*numProperties];
+	flags[i] = !(value >= 0.0 && value < bound && value == floor(value));
+      } // for
+      break;
+    default :
+      assert(0);
+      throw std::logic_error("Unknown kind of rule for properties.");
+    } // switch
+
+    if (skip)
+      for (int i=0; i < numVertices; ++i)
+	flags[i] &= !skip[i];
+    int count = 0;
+    for (int i=0; i < numVertices; ++i)
+      count += flags[i];
+    if (0 == count)
+      continue;
+
+    ++numViolated;
+    *report << "\n  " << rule.description << ": " << count
+	   << ((1 == count) ? " vertex" : " vertices") << ", first";
+    for (int i=0, numReported=0; i < numVertices &&
+	   numReported < _ContribFrictionModel::maxReportedVertices; ++i)
+      if (flags[i]) {
+	*report << " " << i;
+	++numReported;
+      } // if
+  } // for
+
+  return numViolated;
+} // _checkPropertyRules
+
+// ----------------------------------------------------------------------
+// Write properties and state variables of a batch of fault vertices
+// to a vertex fields file.
+void
+contrib::friction::ContribFrictionModel::writeVertexFields(const char* filename,
+							   const PylithScalar* properties,
+							   const int numProperties,
+							   const PylithScalar* stateVars,
+							   const int numStateVars,
+							   const int numVertices) const
+{ // writeVertexFields
+  assert(filename);
+  assert(properties || 0 == numVertices);
+  assert(stateVars || 0 == numVertices*numStateVars);
+  assert(numProperties > 0);
+  assert(numStateVars >= 0);
+  assert(numVertices >= 0);
+
+  const std::string rankFilename = _ContribFrictionModel::rankFilename(filename);
+  FrictionVertexFields file;
+  file.openWrite(rankFilename.c_str(), label(), numProperties, numStateVars, numVertices);
+
+  // Dimensionalize copies of the values, a block of vertices at a time.
+  const int blockSize = _ContribFrictionModel::fieldsBlockSize;
+  pylith::scalar_array block(blockSize*std::max(numProperties, numStateVars));
+  for (int iField=0; iField < 2; ++iField) {
+    const PylithScalar* values = (0 == iField) ? properties : stateVars;
+    const int numValues = (0 == iField) ? numProperties : numStateVars;
+    for (int iBlock=0; numValues > 0 && iBlock < numVertices; iBlock += blockSize) {
+      const int numBlock = std::min(blockSize, numVertices-iBlock);
+      memcpy(&block[0], &values[iBlock*numValues], numBlock*numValues*sizeof(PylithScalar));
+      _scaleBatch(&block[0], numValues, numBlock, 1 == iField, false);
+      file.write(&block[0], numBlock*numValues);
+    } // for
+  } // for
+  file.close();
+} // writeVertexFields
+
+// ----------------------------------------------------------------------
+// Read properties and state variables of a batch of fault vertices
+// from a vertex fields file.
+void
+contrib::friction::ContribFrictionModel::readVertexFields(PylithScalar* const properties,
+							  const int numProperties,
+							  PylithScalar* const stateVars,
+							  const int numStateVars,
+							  const int numVertices,
+							  const char* filename)
+{ // readVertexFields
+  assert(properties || 0 == numVertices);
+  assert(stateVars || 0 == numVertices*numStateVars);
+  assert(numProperties > 0);
+  assert(numStateVars >= 0);
+  assert(numVertices >= 0);
+  assert(filename);
+
+  const std::string rankFilename = _ContribFrictionModel::rankFilename(filename);
+  FrictionVertexFields file;
+  file.openRead(rankFilename.c_str(), label(), numProperties, numStateVars, numVertices);
+
+  _eventBegin(DB_PROPERTIES_EVENT);
+
+  // Read straight into the fields, then nondimensionalize in place.
+  try {
+    file.read(properties, size_t(numVertices)*numProperties);
+    file.read(stateVars, size_t(numVertices)*numStateVars);
+  } catch (...) {
+    _eventEnd(DB_PROPERTIES_EVENT);
+    throw;
+  } // try/catch
+  file.close();
+  nondimPropertiesBatch(properties, numProperties, numVertices);
+  nondimStateVarsBatch(stateVars, numStateVars, numVertices);
+
+  _eventEnd(DB_PROPERTIES_EVENT);
+
+  validateProperties(properties, numProperties, numVertices);
+} // readVertexFields
+
+// ----------------------------------------------------------------------
+// Nondimensionalize properties of a batch of fault vertices.
+void
+contrib::friction::ContribFrictionModel::nondimPropertiesBatch(PylithScalar* const properties,
+							       const int numProperties,
+							       const int numVertices)
+{ // nondimPropertiesBatch
+  _scaleBatch(properties, numProperties, numVertices, false, true);
+  _fieldsRescaled();
+} // nondimPropertiesBatch
+
+// ----------------------------------------------------------------------
+// Dimensionalize properties of a batch of fault vertices.
+void
+contrib::friction::ContribFrictionModel::dimPropertiesBatch(PylithScalar* const properties,
+							    const int numProperties,
+							    const int numVertices)
+{ // dimPropertiesBatch
+  _scaleBatch(properties, numProperties, numVertices, false, false);
+  _fieldsRescaled();
+} // dimPropertiesBatch
+
+// ----------------------------------------------------------------------
+// Nondimensionalize state variables of a batch of fault vertices.
+void
+contrib::friction::ContribFrictionModel::nondimStateVarsBatch(PylithScalar* const stateVars,
+							      const int numStateVars,
+							      const int numVertices)
+{ // nondimStateVarsBatch
+  _scaleBatch(stateVars, numStateVars, numVertices, true, true);
+  _fieldsRescaled();
+} // nondimStateVarsBatch
+
+// ----------------------------------------------------------------------
+// Dimensionalize state variables of a batch of fault vertices.
+void
+contrib::friction::ContribFrictionModel::dimStateVarsBatch(PylithScalar* const stateVars,
+							   const int numStateVars,
+							   const int numVertices)
+{ // dimStateVarsBatch
+  _scaleBatch(stateVars, numStateVars, numVertices, true, false);
+  _fieldsRescaled();
+} // dimStateVarsBatch
+
+// ----------------------------------------------------------------------
+// Compute friction at a batch of fault vertices.
+void
+contrib::friction::ContribFrictionModel::calcFrictionBatch(PylithScalar* const friction,
+							   const PylithScalar t,
+							   const PylithScalar* slip,
+							   const PylithScalar* slipRate,
+							   const PylithScalar* normalTraction,
+							   const PylithScalar* properties,
+							   const int numProperties,
+							   const PylithScalar* stateVars,
+							   const int numStateVars,
+							   const int numVertices)
+{ // calcFrictionBatch
+  // Check consistency of arguments once for the whole batch, so the
+  // kernels do not need to.
+  assert(numVertices >= 0);
+  if (0 == numVertices)
+    return;
+  assert(friction);
+  assert(slip);
+  assert(slipRate);
+  assert(normalTraction);
+  assert(properties || 0 == numVertices);
+  assert(numProperties > 0);
+  assert(stateVars || 0 == numStateVars);
+
+  // Record the batch here, so the per-vertex functions the batch may
+  // call do not record it again.
+  const bool traceOn = _traceRecorder.recording();
+  if (traceOn) {
+    _traceRecorder.writeBatch(label(), FrictionTrace::FRICTION, false, _dt, t,
+			      slip, slipRate, normalTraction,
+			      properties, numProperties, stateVars, numStateVars, numVertices);
+    _traceRecorder.recording(false);
+  } // if
+
+  _eventBegin(FRICTION_EVENT);
+  _calcFrictionBatch(friction, t, slip, slipRate, normalTraction,
+		     properties, numProperties, stateVars, numStateVars,
+		     numVertices);
+  _eventEnd(FRICTION_EVENT);
+
+  _traceRecorder.recording(traceOn);
+} // calcFrictionBatch
+
+// ----------------------------------------------------------------------
+// Compute friction and its derivative at a batch of fault vertices.
+void
+contrib::friction::ContribFrictionModel::calcFrictionAndDerivBatch(PylithScalar* const friction,
+								   PylithScalar* const frictionDeriv,
+								   const PylithScalar t,
+								   const PylithScalar* slip,
+								   const PylithScalar* slipRate,
+								   const PylithScalar* normalTraction,
+								   const PylithScalar* properties,
+								   const int numProperties,
+								   const PylithScalar* stateVars,
+								   const int numStateVars,
+								   const int numVertices)
+{ // calcFrictionAndDerivBatch
+  // Check consistency of arguments.
+  assert(numVertices >= 0);
+  if (0 == numVertices)
+    return;
+  assert(friction);
+  assert(frictionDeriv);
+  assert(slip);
+  assert(slipRate);
+  assert(normalTraction);
+  assert(properties || 0 == numVertices);
+  assert(numProperties > 0);
+  assert(stateVars || 0 == numStateVars);
+
+  const bool traceOn = _traceRecorder.recording();
+  if (traceOn) {
+    _traceRecorder.writeBatch(label(), FrictionTrace::FRICTION, true, _dt, t,
+			      slip, slipRate, normalTraction,
+			      properties, numProperties, stateVars, numStateVars, numVertices);
+    _traceRecorder.recording(false);
+  } // if
+
+  _eventBegin(FRICTION_EVENT);
+  _calcFrictionAndDerivBatch(friction, frictionDeriv, t, slip, slipRate,
+			     normalTraction, properties, numProperties,
+			     stateVars, numStateVars, numVertices);
+  _eventEnd(FRICTION_EVENT);
+
+  _traceRecorder.recording(traceOn);
+} // calcFrictionAndDerivBatch
+
+// ----------------------------------------------------------------------
+// Compute friction and its tangent at a batch of fault vertices.
+void
+contrib::friction::ContribFrictionModel::calcFrictionTangentBatch(PylithScalar* const friction,
+								  PylithScalar* const tangent,
+								  const PylithScalar t,
+								  const PylithScalar* slip,
+								  const PylithScalar* slipRate,
+								  const PylithScalar* normalTraction,
+								  const PylithScalar* properties,
+								  const int numProperties,
+								  const PylithScalar* stateVars,
+								  const int numStateVars,
+								  const int numVertices)
+{ // calcFrictionTangentBatch
+  // Check consistency of arguments.
+  assert(numVertices >= 0);
+  if (0 == numVertices)
+    return;
+  assert(friction);
+  assert(tangent);
+  assert(slip);
+  assert(slipRate);
+  assert(normalTraction);
+  assert(properties || 0 == numVertices);
+  assert(numProperties > 0);
+  assert(stateVars || 0 == numStateVars);
+
+  const bool traceOn = _traceRecorder.recording();
+  if (traceOn) {
+    _traceRecorder.writeBatch(label(), FrictionTrace::FRICTION, true, _dt, t,
+			      slip, slipRate, normalTraction,
+			      properties, numProperties, stateVars, numStateVars, numVertices);
+    _traceRecorder.recording(false);
+  } // if
+
+  _eventBegin(FRICTION_EVENT);
+  _calcFrictionTangentBatch(friction, tangent, t, slip, slipRate,
+			    normalTraction, properties, numProperties,
+			    stateVars, numStateVars, numVertices);
+  _eventEnd(FRICTION_EVENT);
+
+  _traceRecorder.recording(traceOn);
+} // calcFrictionTangentBatch
+
+// ----------------------------------------------------------------------
+// Get distance to the next breakpoint at a batch of fault vertices.
+void
+contrib::friction::ContribFrictionModel::breakpointsBatch(BreakpointHint* const hint,
+							  PylithScalar* const slipToBreakpoint,
+							  PylithScalar* const weakeningRate,
+							  const PylithScalar* slip,
+							  const PylithScalar* slipRate,
+							  const PylithScalar* normalTraction,
+							  const PylithScalar* properties,
+							  const int numProperties,
+							  const PylithScalar* stateVars,
+							  const int numStateVars,
+							  const int numVertices)
+{ // breakpointsBatch
+  // Check consistency of arguments.
+  assert(hint);
+  assert(numVertices >= 0);
+
+  hint->slipToBreakpoint = PYLITH_MAXSCALAR;
+  hint->timeToBreakpoint = PYLITH_MAXSCALAR;
+  hint->weakeningRate = 0.0;
+  if (0 == numVertices)
+    return;
+  assert(slip);
+  assert(slipRate);
+  assert(normalTraction);
+  assert(properties || 0 == numVertices);
+  assert(numProperties > 0);
+  assert(stateVars || 0 == numStateVars);
+
+  _breakpointsBatch(hint, slipToBreakpoint, weakeningRate, slip, slipRate,
+		    normalTraction, properties, numProperties,
+		    stateVars, numStateVars, numVertices);
+} // breakpointsBatch
+
+// ----------------------------------------------------------------------
+// Update state variables at a batch of fault vertices.
+void
+contrib::friction::ContribFrictionModel::updateStateVarsBatch(const PylithScalar t,
+							      const PylithScalar* slip,
+							      const PylithScalar* slipRate,
+							      const PylithScalar* normalTraction,
+							      PylithScalar* const stateVars,
+							      const int numStateVars,
+							      const PylithScalar* properties,
+							      const int numProperties,
+							      const int numVertices)
+{ // updateStateVarsBatch
+  // Check consistency of arguments.
+  assert(numVertices >= 0);
+  if (0 == numVertices)
+    return;
+  assert(slip);
+  assert(slipRate);
+  assert(normalTraction);
+  assert(stateVars || 0 == numStateVars);
+  assert(properties || 0 == numVertices);
+  assert(numProperties > 0);
+
+  const bool traceOn = _traceRecorder.recording();
+  if (traceOn) {
+    _traceRecorder.writeBatch(label(), FrictionTrace::UPDATE_STATE_VARS, false, _dt, t,
+			      slip, slipRate, normalTraction,
+			      properties, numProperties, stateVars, numStateVars, numVertices);
+    _traceRecorder.recording(false);
+  } // if
+
+  _eventBegin(UPDATE_EVENT);
+  _updateStateVarsBatch(t, slip, slipRate, normalTraction,
+			stateVars, numStateVars, properties, numProperties,
+			numVertices);
+  _eventEnd(UPDATE_EVENT);
+
+  _traceRecorder.recording(traceOn);
+} // updateStateVarsBatch
+
+// ----------------------------------------------------------------------
+// Compute friction at a batch of fault vertices.
+void
+contrib::friction::ContribFrictionModel::_calcFrictionBatch(PylithScalar* const friction,
+							    const PylithScalar t,
+							    const PylithScalar* slip,
+							    const PylithScalar* slipRate,
+							    const PylithScalar* normalTraction,
+							    const PylithScalar* properties,
+							    const int numProperties,
+							    const PylithScalar* stateVars,
+							    const int numStateVars,
+							    const int numVertices)
+{ // _calcFrictionBatch
+  for (int i=0; i < numVertices; ++i) {
+    friction[i] = _calcFriction(t, slip[i], slipRate[i], normalTraction[i],
+				&properties[i*numProperties], numProperties,
+				&stateVars[i*numStateVars], numStateVars);
+  } // for
+} // _calcFrictionBatch
+
+// ----------------------------------------------------------------------
+// Compute friction and its derivative at a batch of fault vertices.
+void
+contrib::friction::ContribFrictionModel::_calcFrictionAndDerivBatch(PylithScalar* const friction,
+								    PylithScalar* const frictionDeriv,
+								    const PylithScalar t,
+								    const PylithScalar* slip,
+								    const PylithScalar* slipRate,
+								    const PylithScalar* normalTraction,
+								    const PylithScalar* properties,
+								    const int numProperties,
+								    const PylithScalar* stateVars,
+								    const int numStateVars,
+								    const int numVertices)
+{ // _calcFrictionAndDerivBatch
+  for (int i=0; i < numVertices; ++i) {
+    const PylithScalar* propertiesVertex = &properties[i*numProperties];
+    const PylithScalar* stateVarsVertex = &stateVars[i*numStateVars];
+    friction[i] = _calcFriction(t, slip[i], slipRate[i], normalTraction[i],
+				propertiesVertex, numProperties,
+				stateVarsVertex, numStateVars);
+    frictionDeriv[i] = _calcFrictionDeriv(t, slip[i], slipRate[i],
+					  normalTraction[i],
+					  propertiesVertex, numProperties,
+					  stateVarsVertex, numStateVars);
+  } // for
+} // _calcFrictionAndDerivBatch
+
+// ----------------------------------------------------------------------
+// Compute friction and its tangent at a batch of fault vertices.
+void
+contrib::friction::ContribFrictionModel::_calcFrictionTangentBatch(PylithScalar* const friction,
+								   PylithScalar* const tangent,
+								   const PylithScalar t,
+								   const PylithScalar* slip,
+								   const PylithScalar* slipRate,
+								   const PylithScalar* normalTraction,
+								   const PylithScalar* properties,
+								   const int numProperties,
+								   const PylithScalar* stateVars,
+								   const int numStateVars,
+								   const int numVertices)
+{ // _calcFrictionTangentBatch
+  for (int i=0; i < numVertices; ++i) {
+    friction[i] = _calcFrictionTangent(&tangent[i*NUM_TANGENTS], t, slip[i], slipRate[i],
+				       normalTraction[i],
+				       &properties[i*numProperties], numProperties,
+				       &stateVars[i*numStateVars], numStateVars);
+  } // for
+} // _calcFrictionTangentBatch
+
+// ----------------------------------------------------------------------
+// Get distance to the next breakpoint at a batch of fault vertices.
+void
+contrib::friction::ContribFrictionModel::_breakpointsBatch(BreakpointHint* const hint,
+							   PylithScalar* const slipToBreakpoint,
+							   PylithScalar* const weakeningRate,
+							   const PylithScalar* slip,
+							   const PylithScalar* slipRate,
+							   const PylithScalar* normalTraction,
+							   const PylithScalar* properties,
+							   const int numProperties,
+							   const PylithScalar* stateVars,
+							   const int numStateVars,
+							   const int numVertices)
+{ // _breakpointsBatch
+  // No breakpoints, so the hint keeps the values set by
+  // breakpointsBatch().
+  for (int i=0; i < numVertices; ++i) {
+    if (slipToBreakpoint)
+      slipToBreakpoint[i] = PYLITH_MAXSCALAR;
+    if (weakeningRate)
+      weakeningRate[i] = 0.0;
+  } // for
+} // _breakpointsBatch
+
+// ----------------------------------------------------------------------
+// Update state variables at a batch of fault vertices.
+void
+contrib::friction::ContribFrictionModel::_updateStateVarsBatch(const PylithScalar t,
+							       const PylithScalar* slip,
+							       const PylithScalar* slipRate,
+							       const PylithScalar* normalTraction,
+							       PylithScalar* const stateVars,
+							       const int numStateVars,
+							       const PylithScalar* properties,
+							       const int numProperties,
+							       const int numVertices)
+{ // _updateStateVarsBatch
+  for (int i=0; i < numVertices; ++i) {
+    _updateStateVars(t, slip[i], slipRate[i], normalTraction[i],
+		     &stateVars[i*numStateVars], numStateVars,
+		     &properties[i*numProperties], numProperties);
+  } // for
+} // _updateStateVarsBatch
+
+// ----------------------------------------------------------------------
+// Get number of threads to use for a batch.
+int
+contrib::friction::ContribFrictionModel::_batchThreads(const int numVertices) const
+{ // _batchThreads
+#if defined(_OPENMP)
+  const int maxThreads = (_numThreads > 0) ? _numThreads : omp_get_max_threads();
+  const int numThreads =
+    std::min(maxThreads, numVertices / _ContribFrictionModel::minVerticesPerThread);
+  return std::max(numThreads, 1);
+#else
+  return 1;
+#endif
+} // _batchThreads
+
+// ----------------------------------------------------------------------
+// Get rules for the properties at a vertex.
+void
+contrib::friction::ContribFrictionModel::_propertyRules(std::vector<PropertyRule>* rules) const
+{ // _propertyRules
+  assert(rules);
+} // _propertyRules
+
+// ----------------------------------------------------------------------
+// Get dimensions of the properties and state variables.
+void
+contrib::friction::ContribFrictionModel::_dimensions(std::vector<Dimension>* properties,
+						     std::vector<Dimension>* stateVars) const
+{ // _dimensions
+  assert(properties);
+  assert(stateVars);
+} // _dimensions
+
+// ----------------------------------------------------------------------
+// Compute the scales of the properties and state variables.
+void
+contrib::friction::ContribFrictionModel::_updateScales(void)
+{ // _updateScales
+  assert(_normalizer);
+
+  std::vector<Dimension> propertyDimensions;
+  std::vector<Dimension> stateVarDimensions;
+  _dimensions(&propertyDimensions, &stateVarDimensions);
+
+  const PylithScalar lengthScale = _normalizer->lengthScale();
+  const PylithScalar pressureScale = _normalizer->pressureScale();
+  const PylithScalar timeScale = _normalizer->timeScale();
+  for (int iField=0; iField < 2; ++iField) {
+    const std::vector<Dimension>& dimensions = (0 == iField) ? propertyDimensions : stateVarDimensions;
+    std::vector<PylithScalar>& scales = (0 == iField) ? _propertyScales : _stateVarScales;
+    const int numValues = dimensions.size();
+    scales.resize(2*numValues);
+    for (int iValue=0; iValue < numValues; ++iValue) {
+      const Dimension& dimension = dimensions[iValue];
+      const PylithScalar scale =
+	pow(lengthScale, PylithScalar(dimension.length)) *
+	pow(pressureScale, PylithScalar(dimension.pressure)) *
+	pow(timeScale, PylithScalar(dimension.time));
+      scales[iValue] = scale;
+      scales[numValues+iValue] = 1.0 / scale;
+    } // for
+  } // for
+
+  _census.timeScale(timeScale);
+
+  _scalesChanged();
+} // _updateScales
+
+// ----------------------------------------------------------------------
+// Update data that depend on the scales of the normalizer.
+void
+contrib::friction::ContribFrictionModel::_scalesChanged(void)
+{ // _scalesChanged
+} // _scalesChanged
+
+// ----------------------------------------------------------------------
+// Nondimensionalize or dimensionalize the properties or state
+// variables of a vertex.
+void
+contrib::friction::ContribFrictionModel::_scaleVertex(PylithScalar* const values,
+						      const int numValues,
+						      const bool stateVars,
+						      const bool nondim) const
+{ // _scaleVertex
+  assert(values);
+  const std::vector<PylithScalar>& valueScales = stateVars ? _stateVarScales : _propertyScales;
+  assert(int(valueScales.size()) == 2*numValues);
+
+  const PylithScalar* scales = &valueScales[nondim ? numValues : 0];
+  for (int i=0; i < numValues; ++i)
+    if (values[i] < PYLITH_MAXSCALAR)
+      values[i] *= scales[i];
+} // _scaleVertex
+
+// ----------------------------------------------------------------------
+// Invalidate values cached from the fields.
+void
+contrib::friction::ContribFrictionModel::_fieldsRescaled(void)
+{ // _fieldsRescaled
+} // _fieldsRescaled
+
+// ----------------------------------------------------------------------
+// Count batch of vertices in the census of the state update at time t.
+void
+contrib::friction::ContribFrictionModel::_censusBatch(const PylithScalar t,
+						      const int* counts,
+						      const int numTangentChanges)
+{ // _censusBatch
+  _census.countBatch(t, counts, numTangentChanges);
+} // _censusBatch
+
+// ----------------------------------------------------------------------
+// Nondimensionalize or dimensionalize the properties or state
+// variables of a batch of fault vertices.
+void
+contrib::friction::ContribFrictionModel::_scaleBatch(PylithScalar* const values,
+						     const int numValues,
+						     const int numVertices,
+						     const bool stateVars,
+						     const bool nondim) const
+{ // _scaleBatch
+  assert(values || 0 == numVertices*numValues);
+  assert(numValues >= 0);
+  assert(numVertices >= 0);
+
+  if (0 == numValues || 0 == numVertices)
+    return;
+
+  const std::vector<PylithScalar>& valueScales = stateVars ? _stateVarScales : _propertyScales;
+  if (valueScales.empty()) {
+    for (int iVertex=0; iVertex < numVertices; ++iVertex) {
+      PylithScalar* const valuesVertex = &values[iVertex*numValues];
+      if (stateVars && nondim)
+	_nondimStateVars(valuesVertex, numValues);
+      else if (stateVars)
+	_dimStateVars(valuesVertex, numValues);
+      else if (nondim)
+	_nondimProperties(valuesVertex, numValues);
+      else
+	_dimProperties(valuesVertex, numValues);
+    } // for
+    return;
+  } // if
+  assert(int(valueScales.size()) == 2*numValues);
+
+  // Repeat the scale of each component over a block of vertices.
+  const int blockSize = _ContribFrictionModel::scaleBlockSize;
+  std::vector<PylithScalar> scales(blockSize*numValues);
+  memcpy(&scales[0], &valueScales[nondim ? numValues : 0], numValues*sizeof(PylithScalar));
+  for (int iVertex=1; iVertex < blockSize; ++iVertex)
+    memcpy(&scales[iVertex*numValues], &scales[0], numValues*sizeof(PylithScalar));
+
+  // Values of PYLITH_MAXSCALAR (e.g., times not reached) are not
+  // scaled.
+  const PylithScalar* blockScales = &scales[0];
+  const int numBlocks = (numVertices + blockSize - 1) / blockSize;
+  const int numThreads = _batchThreads(numVertices);
+#if defined(_OPENMP)
+#pragma omp parallel for num_threads(numThreads) schedule(static)
+#endif
+  for (int iBlock=0; iBlock < numBlocks; ++iBlock) {
+    const int iStart = iBlock*blockSize;
+    const int numBlockValues = std::min(blockSize, numVertices-iStart)*numValues;
+    PylithScalar* const blockValues = &values[iStart*numValues];
+    for (int i=0; i < numBlockValues; ++i) {
+      const PylithScalar value = blockValues[i];
+      blockValues[i] = (value < PYLITH_MAXSCALAR) ? value*blockScales[i] : value;
+    } // for
+  } // for
+} // _scaleBatch
+
+
+// End of file
@@ -0,0 +1,936 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+/* @brief C++ abstract base class for the contrib fault constitutive
+ * models, adding batch (fault-wide) entry points and diagnostics to
+ * PyLith's per-vertex FrictionModel interface.
+ */
+
+#if !defined(pylith_friction_ContribFrictionModel_hh)
+#define pylith_friction_ContribFrictionModel_hh
+
+// Include directives ---------------------------------------------------
+#include "pylith/friction/FrictionModel.hh" // ISA FrictionModel
+
+#include "FrictionCensus.hh" // HASA FrictionCensus
+#include "FrictionTraceRecorder.hh" // HASA FrictionTraceRecorder
+
+#include "pylith/utils/array.hh" // HASA scalar_array
+#include "pylith/utils/EventLogger.hh" // HOLDSA EventLogger
+
+#include <iosfwd> // USES std::ostream
+#include <string> // HASA std::string
+#include <vector> // HASA std::vector
+
+// Forward declarations
+namespace contrib {
+  namespace friction {
+    class ContribFrictionModel;
+  } // friction
+} // pylith
+
+// ContribFrictionModel -------------------------------------------------
+class contrib::friction::ContribFrictionModel : public pylith::friction::FrictionModel
+{ // class ContribFrictionModel
+  friend class TestContribFrictionModel; // unit testing
+
+  // PUBLIC ENUMS ///////////////////////////////////////////////////////
+public :
+
+  /// Regimes of fault vertices at a state update.
+  enum RegimeEnum {
+    LOCKED_REGIME=0, ///< Did not slip during the time step.
+    WEAKENING_REGIME=1, ///< Weakening (first segment of a double slip-weakening law).
+    WEAKENING2_REGIME=2, ///< Second segment of a double slip-weakening law.
+    RESIDUAL_REGIME=3, ///< Fully weakened.
+    TENSION_REGIME=4, ///< Fault in tension.
+    NUM_REGIMES=5
+  }; // RegimeEnum
+
+  /** Derivatives of friction in the tangent of a vertex.
+   *
+   * Each entry is the true partial derivative of the friction
+   * returned by _calcFriction() with one argument, holding the others
+   * fixed. Unlike _calcFrictionDeriv(), which keeps the sign
+   * convention of each model and, for models that depend on slip
+   * rate, includes the change of slip rate with slip over the time
+   * step, TANGENT_SLIP is taken at fixed slip rate. An integrator that
+   * computes slip rate from the slip increment adds
+   * TANGENT_SLIP_RATE/dt to it.
+   */
+  enum TangentEnum {
+    TANGENT_SLIP=0, ///< Derivative with slip.
+    TANGENT_NORMAL_TRACTION=1, ///< Derivative with normal traction.
+    TANGENT_SLIP_RATE=2, ///< Derivative with slip rate.
+    NUM_TANGENTS=3
+  }; // TangentEnum
+
+  /// Kinds of rules for properties (see PropertyRule).
+  enum RuleEnum {
+    POSITIVE_RULE=0, ///< property > 0.
+    NONNEGATIVE_RULE=1, ///< property >= 0.
+    GREATER_RULE=2, ///< property > other property.
+    NOT_LESS_RULE=3, ///< property >= other property.
+    INDEX_RULE=4 ///< property is an integer in [0, bound).
+  }; // RuleEnum
+
+  // PUBLIC STRUCTS /////////////////////////////////////////////////////
+public :
+
+  /** Breakpoints of the friction law over a batch of fault vertices
+   * (see breakpointsBatch()). Values are nondimensional and are
+   * PYLITH_MAXSCALAR if no vertex approaches a breakpoint.
+   */
+  struct BreakpointHint {
+    PylithScalar slipToBreakpoint; ///< Minimum slip to the next breakpoint.
+    PylithScalar timeToBreakpoint; ///< Minimum time to the next breakpoint at the current slip rate.
+    PylithScalar weakeningRate; ///< Maximum magnitude of the derivative of friction with slip.
+  }; // BreakpointHint
+
+  /** Dimension of a property or state variable, as the powers of the
+   * length, pressure, and time scales of the normalizer (e.g., {1, 0,
+   * -1} for a slip rate). Dimensionless values have {0, 0, 0}.
+   */
+  struct Dimension {
+    int length; ///< Power of length scale.
+    int pressure; ///< Power of pressure scale.
+    int time; ///< Power of time scale.
+  }; // Dimension
+
+  /** Rule for the properties at a vertex (see validateProperties()).
+   * The rules compare properties with zero or with each other, so
+   * they hold for dimensional and nondimensional properties.
+   */
+  struct PropertyRule {
+    const char* description; ///< Description of rule (e.g., "cohesion >= 0").
+    RuleEnum kind; ///< Kind of rule.
+    int property; ///< Index of property.
+    int other; ///< Index of other property (GREATER_RULE, NOT_LESS_RULE).
+    int bound; ///< Upper bound of index (INDEX_RULE).
+  }; // PropertyRule
+
+  // PUBLIC METHODS /////////////////////////////////////////////////////
+public :
+
+  /** Default constructor.
+   *
+   * @param metadata Metadata for physical properties and state variables.
+   */
+  ContribFrictionModel(const pylith::materials::Metadata& metadata);
+
+  /// Destructor.
+  virtual ~ContribFrictionModel(void);
+
+  /** Set the nondimensionalizer and compute the scales of the
+   * properties and state variables from it. Hides
+   * FrictionModel::normalizer(), which is not virtual.
+   *
+   * @param dim Nondimensionalizer.
+   */
+  void normalizer(const spatialdata::units::Nondimensional& dim);
+
+  /** Get number of state variables per vertex.
+   *
+   * @returns Number of state variables, which may depend on the
+   *   options the model was constructed with.
+   */
+  int numStateVars(void) const;
+
+  /** Set number of threads used in the batch functions.
+   *
+   * @param value Number of threads (0 uses the OpenMP default, e.g.,
+   *   OMP_NUM_THREADS).
+   */
+  void numThreads(const int value);
+
+  /** Get number of threads used in the batch functions.
+   *
+   * @returns Number of threads (0 if the OpenMP default is used).
+   */
+  int numThreads(void) const;
+
+  /** Set name of file for the number of vertices in each regime at
+   * each state update.
+   *
+   * Each update appends a line with the time (in seconds) and the
+   * number of vertices in each regime in the order of RegimeEnum. A
+   * "%d" in the name is replaced by the MPI rank, so each process
+   * writes its own file.
+   *
+   * @param value Name of file (empty for no file).
+   */
+  void censusFilename(const char* value);
+
+  /** Get name of file for the number of vertices in each regime.
+   *
+   * @returns Name of file (empty if none).
+   */
+  const char* censusFilename(void) const;
+
+  /** Get time of the last state update counted in the census.
+   *
+   * @returns Time (nondimensional).
+   */
+  PylithScalar censusTime(void) const;
+
+  /** Get number of vertices in a regime at the last state update.
+   *
+   * @param regime Regime.
+   *
+   * @returns Number of vertices.
+   */
+  int regimeCount(const RegimeEnum regime) const;
+
+  /** Get number of vertices whose derivative of friction with slip
+   * changed at the last state update (e.g., a vertex entering the
+   * second weakening segment or leaving tension).
+   *
+   * @returns Number of vertices (0 if no update has been counted).
+   */
+  int tangentChangeCount(void) const;
+
+  /** Check whether the derivative of friction with slip may have
+   * changed at the last state update.
+   *
+   * Changes with normal traction are not included. Models that do
+   * not count the changes (no state update counted yet, or models
+   * without a census) always return true.
+   *
+   * @returns True if the fault Jacobian must be recomputed.
+   */
+  bool tangentChanged(void) const;
+
+  /** Register PETSc log events for the functions of the model.
+   *
+   * The events are named with the prefix followed by "friction",
+   * "update", and "dbProps". The batch functions log to the first
+   * two; the friction event includes the derivative in
+   * calcFrictionAndDerivBatch().
+   *
+   * @param value Prefix of names of events (e.g., "FrDSlWk ").
+   */
+  void loggingPrefix(const char* value);
+
+  /** Set name of file for recording the calls to the model.
+   *
+   * The calls to _calcFriction(), _calcFrictionDeriv() and
+   * _updateStateVars() (including those made by the batch functions)
+   * are written to the file with FrictionTrace. The file is created
+   * at the first call. A "%d" in the name is replaced by the MPI rank,
+   * so each process writes its own file.
+   *
+   * @param value Name of file (empty to stop recording).
+   */
+  void traceFilename(const char* value);
+
+  /** Get name of file for recording the calls to the model.
+   *
+   * @returns Name of file (empty if calls are not recorded).
+   */
+  const char* traceFilename(void) const;
+
+  /** Create the fields of physical properties and state variables and
+   * fill them from the spatial databases.
+   *
+   * Vertices with invalid values (see _dbToProperties()) do not stop
+   * FrictionModel::initialize(), the converted properties are then
+   * checked against the rules of the model (see
+   * validateProperties()), and a single error reports all of them.
+   *
+   * @param faultMesh Finite-element mesh of subdomain.
+   * @param quadrature Quadrature for finite-element integration.
+   */
+  void initialize(const pylith::topology::Mesh& faultMesh,
+		  pylith::feassemble::Quadrature* quadrature);
+
+  /** Check the properties of a batch of fault vertices against all
+   * of the rules of the model, including the relations between
+   * properties that the laws rely on (e.g., final_slip_distance >
+   * transition_slip_distance).
+   *
+   * All vertices are checked before reporting, so a single error
+   * lists, for each violated rule, the number of vertices that
+   * violate it and the first of them.
+   *
+   * @param properties Array of properties [numVertices*numProperties].
+   * @param numProperties Number of properties per vertex.
+   * @param numVertices Number of vertices in batch.
+   */
+  void validateProperties(const PylithScalar* properties,
+			  const int numProperties,
+			  const int numVertices) const;
+
+  /** Write properties and state variables of a batch of fault
+   * vertices to a vertex fields file, in SI units and in the order of
+   * the vertices. A "%d" in the name is replaced by the MPI rank,
+   * since each process writes the vertices of its fault partition
+   * (see FrictionVertexFields for the file layout).
+   *
+   * @param filename Name of file.
+   * @param properties Array of properties [numVertices*numProperties].
+   * @param numProperties Number of properties per vertex.
+   * @param stateVars Array of state variables [numVertices*numStateVars].
+   * @param numStateVars Number of state variables per vertex.
+   * @param numVertices Number of vertices in batch.
+   */
+  void writeVertexFields(const char* filename,
+			 const PylithScalar* properties,
+			 const int numProperties,
+			 const PylithScalar* stateVars,
+			 const int numStateVars,
+			 const int numVertices) const;
+
+  /** Read properties and state variables of a batch of fault vertices
+   * from a vertex fields file (see writeVertexFields()) and
+   * nondimensionalize them. This replaces the query of the spatial
+   * databases and _dbToProperties() and _dbToStateVars() when the
+   * file holds the vertices of the fault partition in the same order.
+   * The properties are checked with validateProperties().
+   *
+   * @param properties Array of properties [numVertices*numProperties] (output).
+   * @param numProperties Number of properties per vertex.
+   * @param stateVars Array of state variables [numVertices*numStateVars] (output).
+   * @param numStateVars Number of state variables per vertex.
+   * @param numVertices Number of vertices in batch.
+   * @param filename Name of file.
+   */
+  void readVertexFields(PylithScalar* const properties,
+			const int numProperties,
+			PylithScalar* const stateVars,
+			const int numStateVars,
+			const int numVertices,
+			const char* filename);
+
+  /** Nondimensionalize properties of a batch of fault vertices (in
+   * place).
+   *
+   * Values cached from the fields are invalidated (see
+   * _fieldsRescaled()).
+   *
+   * @param properties Array of properties [numVertices*numProperties].
+   * @param numProperties Number of properties per vertex.
+   * @param numVertices Number of vertices in batch.
+   */
+  void nondimPropertiesBatch(PylithScalar* const properties,
+			     const int numProperties,
+			     const int numVertices);
+
+  /** Dimensionalize properties of a batch of fault vertices (in
+   * place).
+   *
+   * Values cached from the fields are invalidated (see
+   * _fieldsRescaled()).
+   *
+   * @param properties Array of properties [numVertices*numProperties].
+   * @param numProperties Number of properties per vertex.
+   * @param numVertices Number of vertices in batch.
+   */
+  void dimPropertiesBatch(PylithScalar* const properties,
+			  const int numProperties,
+			  const int numVertices);
+
+  /** Nondimensionalize state variables of a batch of fault vertices
+   * (in place). Values of PYLITH_MAXSCALAR (e.g., times not reached)
+   * are not scaled. Values cached from the fields are invalidated
+   * (see _fieldsRescaled()).
+   *
+   * @param stateVars Array of state variables [numVertices*numStateVars].
+   * @param numStateVars Number of state variables per vertex.
+   * @param numVertices Number of vertices in batch.
+   */
+  void nondimStateVarsBatch(PylithScalar* const stateVars,
+			    const int numStateVars,
+			    const int numVertices);
+
+  /** Dimensionalize state variables of a batch of fault vertices (in
+   * place). Values of PYLITH_MAXSCALAR (e.g., times not reached) are
+   * not scaled. Values cached from the fields are invalidated (see
+   * _fieldsRescaled()).
+   *
+   * @param stateVars Array of state variables [numVertices*numStateVars].
+   * @param numStateVars Number of state variables per vertex.
+   * @param numVertices Number of vertices in batch.
+   */
+  void dimStateVarsBatch(PylithScalar* const stateVars,
+			 const int numStateVars,
+			 const int numVertices);
+
+  /** Compute friction at a batch of fault vertices.
+   *
+   * @param friction Array of friction values [numVertices] (output).
+   * @param t Time in simulation.
+   * @param slip Array of slip [numVertices].
+   * @param slipRate Array of slip rate [numVertices].
+   * @param normalTraction Array of normal traction [numVertices].
+   * @param properties Array of properties [numVertices*numProperties].
+   * @param numProperties Number of properties per vertex.
+   * @param stateVars Array of state variables [numVertices*numStateVars].
+   * @param numStateVars Number of state variables per vertex.
+   * @param numVertices Number of vertices in batch.
+   */
+  void calcFrictionBatch(PylithScalar* const friction,
+			 const PylithScalar t,
+			 const PylithScalar* slip,
+			 const PylithScalar* slipRate,
+			 const PylithScalar* normalTraction,
+			 const PylithScalar* properties,
+			 const int numProperties,
+			 const PylithScalar* stateVars,
+			 const int numStateVars,
+			 const int numVertices);
+
+  /** Compute friction and its derivative with slip at a batch of
+   * fault vertices.
+   *
+   * @param friction Array of friction values [numVertices] (output).
+   * @param frictionDeriv Array of derivatives of friction with slip [numVertices] (output).
+   * @param t Time in simulation.
+   * @param slip Array of slip [numVertices].
+   * @param slipRate Array of slip rate [numVertices].
+   * @param normalTraction Array of normal traction [numVertices].
+   * @param properties Array of properties [numVertices*numProperties].
+   * @param numProperties Number of properties per vertex.
+   * @param stateVars Array of state variables [numVertices*numStateVars].
+   * @param numStateVars Number of state variables per vertex.
+   * @param numVertices Number of vertices in batch.
+   */
+  void calcFrictionAndDerivBatch(PylithScalar* const friction,
+				 PylithScalar* const frictionDeriv,
+				 const PylithScalar t,
+				 const PylithScalar* slip,
+				 const PylithScalar* slipRate,
+				 const PylithScalar* normalTraction,
+				 const PylithScalar* properties,
+				 const int numProperties,
+				 const PylithScalar* stateVars,
+				 const int numStateVars,
+				 const int numVertices);
+
+  /** Compute friction and its tangent at a batch of fault vertices.
+   *
+   * Calls are recorded in the trace file as _calcFriction() followed
+   * by _calcFrictionDeriv() at each vertex, and logged in the friction
+   * event.
+   *
+   * @param friction Array of friction values [numVertices] (output).
+   * @param tangent Array of derivatives of friction [numVertices*NUM_TANGENTS] (output).
+   * @param t Time in simulation.
+   * @param slip Array of slip [numVertices].
+   * @param slipRate Array of slip rate [numVertices].
+   * @param normalTraction Array of normal traction [numVertices].
+   * @param properties Array of properties [numVertices*numProperties].
+   * @param numProperties Number of properties per vertex.
+   * @param stateVars Array of state variables [numVertices*numStateVars].
+   * @param numStateVars Number of state variables per vertex.
+   * @param numVertices Number of vertices in batch.
+   */
+  void calcFrictionTangentBatch(PylithScalar* const friction,
+				PylithScalar* const tangent,
+				const PylithScalar t,
+				const PylithScalar* slip,
+				const PylithScalar* slipRate,
+				const PylithScalar* normalTraction,
+				const PylithScalar* properties,
+				const int numProperties,
+				const PylithScalar* stateVars,
+				const int numStateVars,
+				const int numVertices);
+
+  /** Get distance to the next breakpoint (kink) of the friction law
+   * at a batch of fault vertices.
+   *
+   * Vertices in tension and vertices past the last breakpoint have
+   * slip to breakpoint PYLITH_MAXSCALAR. The time to the breakpoint
+   * is the slip to the breakpoint divided by the slip rate of
+   * vertices with positive slip rate. The hint is reduced over the
+   * batch only; reduce it over processes to get a global time step.
+   *
+   * @param hint Minimum slip and time to the next breakpoint and
+   *   maximum weakening rate over batch (output).
+   * @param slipToBreakpoint Array of slip to next breakpoint
+   *   [numVertices] (output, may be NULL).
+   * @param weakeningRate Array of magnitude of derivative of friction
+   *   with slip [numVertices] (output, may be NULL).
+   * @param slip Array of slip [numVertices].
+   * @param slipRate Array of slip rate [numVertices].
+   * @param normalTraction Array of normal traction [numVertices].
+   * @param properties Array of properties [numVertices*numProperties].
+   * @param numProperties Number of properties per vertex.
+   * @param stateVars Array of state variables [numVertices*numStateVars].
+   * @param numStateVars Number of state variables per vertex.
+   * @param numVertices Number of vertices in batch.
+   */
+  void breakpointsBatch(BreakpointHint* const hint,
+			PylithScalar* const slipToBreakpoint,
+			PylithScalar* const weakeningRate,
+			const PylithScalar* slip,
+			const PylithScalar* slipRate,
+			const PylithScalar* normalTraction,
+			const PylithScalar* properties,
+			const int numProperties,
+			const PylithScalar* stateVars,
+			const int numStateVars,
+			const int numVertices);
+
+  /** Update state variables (for next time step) at a batch of fault
+   * vertices.
+   *
+   * @param t Time in simulation.
+   * @param slip Array of slip [numVertices].
+   * @param slipRate Array of slip rate [numVertices].
+   * @param normalTraction Array of normal traction [numVertices].
+   * @param stateVars Array of state variables [numVertices*numStateVars].
+   * @param numStateVars Number of state variables per vertex.
+   * @param properties Array of properties [numVertices*numProperties].
+   * @param numProperties Number of properties per vertex.
+   * @param numVertices Number of vertices in batch.
+   */
+  void updateStateVarsBatch(const PylithScalar t,
+			    const PylithScalar* slip,
+			    const PylithScalar* slipRate,
+			    const PylithScalar* normalTraction,
+			    PylithScalar* const stateVars,
+			    const int numStateVars,
+			    const PylithScalar* properties,
+			    const int numProperties,
+			    const int numVertices);
+
+  // PROTECTED ENUMS ////////////////////////////////////////////////////
+protected :
+
+  /// Functions with PETSc log events.
+  enum EventEnum {
+    FRICTION_EVENT=0, ///< Friction (and derivative) of batch.
+    UPDATE_EVENT=1, ///< Update of state variables of batch.
+    DB_PROPERTIES_EVENT=2, ///< Properties from values in spatial database.
+    NUM_EVENTS=3
+  }; // EventEnum
+
+  // PROTECTED METHODS //////////////////////////////////////////////////
+protected :
+
+  /** Compute friction at a batch of fault vertices.
+   *
+   * Default implementation calls _calcFriction() at each vertex.
+   *
+   * @param friction Array of friction values [numVertices] (output).
+   * @param t Time in simulation.
+   * @param slip Array of slip [numVertices].
+   * @param slipRate Array of slip rate [numVertices].
+   * @param normalTraction Array of normal traction [numVertices].
+   * @param properties Array of properties [numVertices*numProperties].
+   * @param numProperties Number of properties per vertex.
+   * @param stateVars Array of state variables [numVertices*numStateVars].
+   * @param numStateVars Number of state variables per vertex.
+   * @param numVertices Number of vertices in batch.
+   */
+  virtual
+  void _calcFrictionBatch(PylithScalar* const friction,
+			  const PylithScalar t,
+			  const PylithScalar* slip,
+			  const PylithScalar* slipRate,
+			  const PylithScalar* normalTraction,
+			  const PylithScalar* properties,
+			  const int numProperties,
+			  const PylithScalar* stateVars,
+			  const int numStateVars,
+			  const int numVertices);
+
+  /** Compute friction and its derivative with slip at a batch of
+   * fault vertices.
+   *
+   * Default implementation calls _calcFriction() and
+   * _calcFrictionDeriv() at each vertex.
+   *
+   * @param friction Array of friction values [numVertices] (output).
+   * @param frictionDeriv Array of derivatives of friction with slip [numVertices] (output).
+   * @param t Time in simulation.
+   * @param slip Array of slip [numVertices].
+   * @param slipRate Array of slip rate [numVertices].
+   * @param normalTraction Array of normal traction [numVertices].
+   * @param properties Array of properties [numVertices*numProperties].
+   * @param numProperties Number of properties per vertex.
+   * @param stateVars Array of state variables [numVertices*numStateVars].
+   * @param numStateVars Number of state variables per vertex.
+   * @param numVertices Number of vertices in batch.
+   */
+  virtual
+  void _calcFrictionAndDerivBatch(PylithScalar* const friction,
+				  PylithScalar* const frictionDeriv,
+				  const PylithScalar t,
+				  const PylithScalar* slip,
+				  const PylithScalar* slipRate,
+				  const PylithScalar* normalTraction,
+				  const PylithScalar* properties,
+				  const int numProperties,
+				  const PylithScalar* stateVars,
+				  const int numStateVars,
+				  const int numVertices);
+
+  /** Compute friction and its tangent at a location.
+   *
+   * @param tangent Derivatives of friction [NUM_TANGENTS] (output).
+   * @param t Time in simulation.
+   * @param slip Current slip at location.
+   * @param slipRate Current slip rate at location.
+   * @param normalTraction Normal traction at location.
+   * @param properties Properties at location.
+   * @param numProperties Number of properties.
+   * @param stateVars State variables at location.
+   * @param numStateVars Number of state variables.
+   *
+   * @returns Friction (magnitude of shear traction) at location.
+   */
+  virtual
+  PylithScalar _calcFrictionTangent(PylithScalar* const tangent,
+				    const PylithScalar t,
+				    const PylithScalar slip,
+				    const PylithScalar slipRate,
+				    const PylithScalar normalTraction,
+				    const PylithScalar* properties,
+				    const int numProperties,
+				    const PylithScalar* stateVars,
+				    const int numStateVars) = 0;
+
+  /** Compute friction and its tangent at a batch of fault vertices.
+   *
+   * Default implementation calls _calcFrictionTangent() at each vertex.
+   *
+   * @param friction Array of friction values [numVertices] (output).
+   * @param tangent Array of derivatives of friction [numVertices*NUM_TANGENTS] (output).
+   * @param t Time in simulation.
+   * @param slip Array of slip [numVertices].
+   * @param slipRate Array of slip rate [numVertices].
+   * @param normalTraction Array of normal traction [numVertices].
+   * @param properties Array of properties [numVertices*numProperties].
+   * @param numProperties Number of properties per vertex.
+   * @param stateVars Array of state variables [numVertices*numStateVars].
+   * @param numStateVars Number of state variables per vertex.
+   * @param numVertices Number of vertices in batch.
+   */
+  virtual
+  void _calcFrictionTangentBatch(PylithScalar* const friction,
+				 PylithScalar* const tangent,
+				 const PylithScalar t,
+				 const PylithScalar* slip,
+				 const PylithScalar* slipRate,
+				 const PylithScalar* normalTraction,
+				 const PylithScalar* properties,
+				 const int numProperties,
+				 const PylithScalar* stateVars,
+				 const int numStateVars,
+				 const int numVertices);
+
+  /** Get distance to the next breakpoint of the friction law at a
+   * batch of fault vertices.
+   *
+   * Default implementation is for laws without breakpoints.
+   *
+   * @param hint Minimum slip and time to the next breakpoint and
+   *   maximum weakening rate over batch (output).
+   * @param slipToBreakpoint Array of slip to next breakpoint
+   *   [numVertices] (output, may be NULL).
+   * @param weakeningRate Array of magnitude of derivative of friction
+   *   with slip [numVertices] (output, may be NULL).
+   * @param slip Array of slip [numVertices].
+   * @param slipRate Array of slip rate [numVertices].
+   * @param normalTraction Array of normal traction [numVertices].
+   * @param properties Array of properties [numVertices*numProperties].
+   * @param numProperties Number of properties per vertex.
+   * @param stateVars Array of state variables [numVertices*numStateVars].
+   * @param numStateVars Number of state variables per vertex.
+   * @param numVertices Number of vertices in batch.
+   */
+  virtual
+  void _breakpointsBatch(BreakpointHint* const hint,
+			 PylithScalar* const slipToBreakpoint,
+			 PylithScalar* const weakeningRate,
+			 const PylithScalar* slip,
+			 const PylithScalar* slipRate,
+			 const PylithScalar* normalTraction,
+			 const PylithScalar* properties,
+			 const int numProperties,
+			 const PylithScalar* stateVars,
+			 const int numStateVars,
+			 const int numVertices);
+
+  /** Update state variables (for next time step) at a batch of fault
+   * vertices.
+   *
+   * Default implementation calls _updateStateVars() at each vertex.
+   *
+   * @param t Time in simulation.
+   * @param slip Array of slip [numVertices].
+   * @param slipRate Array of slip rate [numVertices].
+   * @param normalTraction Array of normal traction [numVertices].
+   * @param stateVars Array of state variables [numVertices*numStateVars].
+   * @param numStateVars Number of state variables per vertex.
+   * @param properties Array of properties [numVertices*numProperties].
+   * @param numProperties Number of properties per vertex.
+   * @param numVertices Number of vertices in batch.
+   */
+  virtual
+  void _updateStateVarsBatch(const PylithScalar t,
+			     const PylithScalar* slip,
+			     const PylithScalar* slipRate,
+			     const PylithScalar* normalTraction,
+			     PylithScalar* const stateVars,
+			     const int numStateVars,
+			     const PylithScalar* properties,
+			     const int numProperties,
+			     const int numVertices);
+
+  /** Get number of threads to use for a batch.
+   *
+   * Small batches use fewer threads, so that each thread has enough
+   * vertices to amortize the cost of starting it.
+   *
+   * @param numVertices Number of vertices in batch.
+   *
+   * @returns Number of threads (1 if OpenMP is not enabled).
+   */
+  int _batchThreads(const int numVertices) const;
+
+  /** Compute properties from values in spatial database with
+   * _dbValuesToProperties().
+   *
+   * During initialize(), invalid values are recorded instead of
+   * thrown, and the properties are kept for checking the rules.
+   *
+   * @param propValues Array of property values.
+   * @param dbValues Array of database values.
+   */
+  void _dbToProperties(PylithScalar* const propValues,
+		       const pylith::scalar_array& dbValues) const;
+
+  /** Compute properties from values in spatial database, throwing
+   * std::runtime_error for invalid values.
+   *
+   * @param propValues Array of property values.
+   * @param dbValues Array of database values.
+   */
+  virtual
+  void _dbValuesToProperties(PylithScalar* const propValues,
+			     const pylith::scalar_array& dbValues) const = 0;
+
+  /** Get rules for the properties at a vertex (see
+   * validateProperties()). The default has no rules.
+   *
+   * @param rules Array of rules (rules of the model are appended).
+   */
+  virtual
+  void _propertyRules(std::vector<PropertyRule>* rules) const;
+
+  /** Check the properties of a batch of fault vertices against the
+   * rules of the model (see validateProperties()).
+   *
+   * @param properties Array of properties [numVertices*numProperties].
+   * @param numProperties Number of properties per vertex.
+   * @param numVertices Number of vertices in batch.
+   * @param skip Flags of vertices to skip [numVertices] (NULL for none).
+   * @param report Stream for the number of vertices and the first
+   *   vertices violating each rule.
+   *
+   * @returns Number of violated rules.
+   */
+  int _checkPropertyRules(const PylithScalar* properties,
+			  const int numProperties,
+			  const int numVertices,
+			  const unsigned char* skip,
+			  std::ostream* report) const;
+
+  /** Get dimensions of the properties and state variables, including
+   * derived properties, for scaling batches of vertices. The default
+   * has none, so the batch scaling functions call _nondimProperties()
+   * and the other per-vertex functions at each vertex.
+   *
+   * @param properties Dimensions of properties [numProperties] (output).
+   * @param stateVars Dimensions of state variables [numStateVars] (output).
+   */
+  virtual
+  void _dimensions(std::vector<Dimension>* properties,
+		   std::vector<Dimension>* stateVars) const;
+
+  /** Compute the scales of the properties and state variables from
+   * their dimensions (see _dimensions()) and the normalizer, then
+   * call _scalesChanged(). Called by normalizer() and initialize();
+   * models call it at the end of their constructors for the default
+   * normalizer.
+   */
+  void _updateScales(void);
+
+  /** Update data of the model that depend on the scales of the
+   * normalizer (called by _updateScales()). The default has none.
+   */
+  virtual
+  void _scalesChanged(void);
+
+  /** Nondimensionalize or dimensionalize the properties or state
+   * variables of a vertex (in place) with the scales computed by
+   * _updateScales(). Values of PYLITH_MAXSCALAR (e.g., times not
+   * reached) are not scaled.
+   *
+   * @param values Array of values [numValues].
+   * @param numValues Number of values.
+   * @param stateVars True for state variables, false for properties.
+   * @param nondim True to nondimensionalize, false to dimensionalize.
+   */
+  void _scaleVertex(PylithScalar* const values,
+		    const int numValues,
+		    const bool stateVars,
+		    const bool nondim) const;
+
+  /** Invalidate values the model caches from the properties or state
+   * variables, after a batch of them was rescaled in place. The
+   * default caches nothing.
+   */
+  virtual
+  void _fieldsRescaled(void);
+
+
+  /** Record call in the trace file if recording is on.
+   *
+   * @param operation Traced function.
+   * @param t Time in simulation.
+   * @param slip Current slip at location.
+   * @param slipRate Current slip rate at location.
+   * @param normalTraction Normal traction at location.
+   * @param properties Properties at location.
+   * @param numProperties Number of properties.
+   * @param stateVars State variables at location (before update).
+   * @param numStateVars Number of state variables.
+   */
+  void _traceCall(const FrictionTrace::OperationEnum operation,
+		  const PylithScalar t,
+		  const PylithScalar slip,
+		  const PylithScalar slipRate,
+		  const PylithScalar normalTraction,
+		  const PylithScalar* properties,
+		  const int numProperties,
+		  const PylithScalar* stateVars,
+		  const int numStateVars);
+
+  /** Count vertex in the census of the state update at time t.
+   *
+   * @param t Time of state update.
+   * @param regime Regime of vertex.
+   * @param tangentChanged True if the derivative of friction with
+   *   slip at the vertex changed in the update.
+   */
+  void _censusVertex(const PylithScalar t,
+		     const RegimeEnum regime,
+		     const bool tangentChanged);
+
+  /** Count batch of vertices in the census of the state update at
+   * time t.
+   *
+   * @param t Time of state update.
+   * @param counts Number of vertices in each regime [NUM_REGIMES].
+   * @param numTangentChanges Number of vertices whose derivative of
+   *   friction with slip changed in the update.
+   */
+  void _censusBatch(const PylithScalar t,
+		    const int* counts,
+		    const int numTangentChanges);
+
+  /** Check whether any vertex was in tension at the state update
+   * before the one at time t, for models that do not store the
+   * regime of each vertex.
+   *
+   * @param t Time of state update.
+   *
+   * @returns True if the census counted a vertex in tension.
+   */
+  bool _censusTensionBefore(const PylithScalar t) const;
+
+  /** Begin PETSc log event of function (if events are registered).
+   *
+   * @param event Function.
+   */
+  void _eventBegin(const EventEnum event) const;
+
+  /** End PETSc log event of function (if events are registered).
+   *
+   * @param event Function.
+   */
+  void _eventEnd(const EventEnum event) const;
+
+  // PRIVATE METHODS ////////////////////////////////////////////////////
+private :
+
+  /** Nondimensionalize or dimensionalize the properties or state
+   * variables of a batch of fault vertices (in place), multiplying
+   * each component by its scale.
+   *
+   * @param values Array of values [numVertices*numValues].
+   * @param numValues Number of values per vertex.
+   * @param numVertices Number of vertices in batch.
+   * @param stateVars True for state variables, false for properties.
+   * @param nondim True to nondimensionalize, false to dimensionalize.
+   */
+  void _scaleBatch(PylithScalar* const values,
+		   const int numValues,
+		   const int numVertices,
+		   const bool stateVars,
+		   const bool nondim) const;
+
+  // PROTECTED MEMBERS //////////////////////////////////////////////////
+protected :
+
+  /// Number of state variable values per vertex, from the metadata
+  /// (the fiber dimension of FrictionModel is private).
+  const int _numStateVars;
+
+  // PRIVATE MEMBERS ////////////////////////////////////////////////////
+private :
+
+  /// Properties converted by initialize(), checked once the fields
+  /// are filled.
+  struct PropertiesCheck {
+    bool active; ///< True while initialize() converts properties.
+    std::vector<PylithScalar> properties; ///< Properties in the order of conversion [numVertices*numProperties].
+    std::vector<unsigned char> invalid; ///< Flags of vertices with invalid values [numVertices].
+    int numInvalid; ///< Number of vertices with invalid values.
+    std::string report; ///< Errors of the first vertices with invalid values.
+  }; // PropertiesCheck
+
+  const int _numProperties; ///< Number of property values per vertex.
+  mutable PropertiesCheck _propertiesCheck; ///< Properties converted by initialize().
+  int _numThreads; ///< Number of threads in batch functions (0 for OpenMP default).
+  FrictionTraceRecorder _traceRecorder; ///< Recorder of calls to the model.
+  pylith::utils::EventLogger* _logger; ///< Logger of PETSc events (0 if not registered).
+  int _events[NUM_EVENTS]; ///< Identifiers of PETSc log events.
+  std::string _censusFilename; ///< Name of census file (empty for none).
+  FrictionCensus _census; ///< Number of vertices in each regime at the state updates.
+  std::vector<PylithScalar> _propertyScales; ///< Scales of properties, then their inverses [2*numProperties] (empty without dimensions).
+  std::vector<PylithScalar> _stateVarScales; ///< Scales of state variables, then their inverses [2*numStateVars] (empty without dimensions).
+
+  // NOT IMPLEMENTED ////////////////////////////////////////////////////
+private :
+
+  ContribFrictionModel(const ContribFrictionModel&); ///< Not implemented.
+  const ContribFrictionModel& operator=(const ContribFrictionModel&); ///< Not implemented
+
+}; // class ContribFrictionModel
+
+#include "ContribFrictionModel.icc" // inline methods
+
+#endif // pylith_friction_ContribFrictionModel_hh
+
+
+// End of file
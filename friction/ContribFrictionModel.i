@@ -0,0 +1,121 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+// SWIG interface to C++ ContribFrictionModel object.
+
+/* This is nearly identical to the C++ ContribFrictionModel header
+ * file. There are a few important differences required by SWIG:
+ *
+ * (1) Instead of forward declaring the ContribFrictionModel class, we
+ * embed the class definition within the namespace declarations.
+ *
+ * (2) We only include public members and methods, because this is an
+ * interface file. The batch methods operate on raw arrays, so they
+ * are only available from C++.
+ */
+
+namespace contrib {
+  namespace friction {
+
+    class ContribFrictionModel : public pylith::friction::FrictionModel
+    { // class ContribFrictionModel
+
+      // PUBLIC METHODS /////////////////////////////////////////////////
+    public :
+
+      /** Default constructor.
+       *
+       * @param metadata Metadata for physical properties and state variables.
+       */
+      ContribFrictionModel(const pylith::materials::Metadata& metadata);
+
+      /// Destructor.
+      virtual ~ContribFrictionModel(void);
+
+      /** Set the nondimensionalizer and compute the scales of the
+       * properties and state variables from it. Hides
+       * FrictionModel::normalizer(), which is not virtual.
+       *
+       * @param dim Nondimensionalizer.
+       */
+      void normalizer(const spatialdata::units::Nondimensional& dim);
+
+      /** Get number of state variables per vertex.
+       *
+       * @returns Number of state variables, which may depend on the
+       *   options the model was constructed with.
+       */
+      int numStateVars(void) const;
+
+      /** Set number of threads used in the batch functions.
+       *
+       * @param value Number of threads (0 uses the OpenMP default, e.g.,
+       *   OMP_NUM_THREADS).
+       */
+      void numThreads(const int value);
+
+      /** Get number of threads used in the batch functions.
+       *
+       * @returns Number of threads (0 if the OpenMP default is used).
+       */
+      int numThreads(void) const;
+
+      /** Set name of file for the number of vertices in each regime
+       * at each state update.
+       *
+       * A "%d" in the name is replaced by the MPI rank, so each
+       * process writes its own file.
+       *
+       * @param value Name of file (empty for no file).
+       */
+      void censusFilename(const char* value);
+
+      /** Get name of file for the number of vertices in each regime.
+       *
+       * @returns Name of file (empty if none).
+       */
+      const char* censusFilename(void) const;
+
+      /** Register PETSc log events for the functions of the model.
+       *
+       * @param value Prefix of names of events (e.g., "FrDSlWk ").
+       */
+      void loggingPrefix(const char* value);
+
+      /** Set name of file for recording the calls to the model.
+       *
+       * A "%d" in the name is replaced by the MPI rank, so each
+       * process writes its own file.
+       *
+       * @param value Name of file (empty to stop recording).
+       */
+      void traceFilename(const char* value);
+
+      /** Get name of file for recording the calls to the model.
+       *
+       * @returns Name of file (empty if calls are not recorded).
+       */
+      const char* traceFilename(void) const;
+
+    }; // class ContribFrictionModel
+
+  } // friction
+} // pylith
+
+
+// End of file 
@@ -24,142 +24,77 @@
 
 #include "DoubleSlipWeakeningFrictionNoHeal.hh" // implementation of object methods
 
-#include "pylith/materials/Metadata.hh" // USES Metadata
+#include "SlipWeakeningLaw.icc" // implementation of template methods
 
-#include "pylith/utils/array.hh" // USES scaary_array
+#include "pylith/utils/array.hh" // USES scalar_array
 #include "pylith/utils/constdefs.h" // USES PYLITH_MAXSCALAR
 
-#include "spatialdata/units/Nondimensional.hh" // USES Nondimensional
-
 #include <cassert> // USES assert()
 #include <sstream> // USES std::ostringstream
 #include <stdexcept> // USES std::runtime_error
 
 // ----------------------------------------------------------------------
-// Create a local namespace to use for local constants and other
-// information. This insulates all other classes from this information
-// while preventing clashes with other local constants and data (as
-// long as no other object use the same _DoubleSlipWeakeningFrictionNoHeal namespace in
-// the  namespace.
-namespace contrib {
-  namespace friction {
-    namespace _DoubleSlipWeakeningFrictionNoHeal {
-
-      // These are the fault constitutive parameters stored during the
-      // simulation and need not coincide with the physical properties
-      // provided by the user.
-
-      // Number of physical properties.
-      const int numProperties = 6;
-
-      // Friction model parameters.
-      const pylith::materials::Metadata::ParamDescription properties[numProperties] = {
-	{ "static_coefficient", 1, pylith::topology::FieldBase::SCALAR },
-	{ "transition_coefficient", 1, pylith::topology::FieldBase::SCALAR },
-	{ "dynamic_coefficient", 1, pylith::topology::FieldBase::SCALAR },
-	{ "transition_slip_distance", 1, pylith::topology::FieldBase::SCALAR },
-	{ "final_slip_distance", 1, pylith::topology::FieldBase::SCALAR },
-	{ "cohesion", 1, pylith::topology::FieldBase::SCALAR },
-      };
-
-      // Number of state variables.
-      const int numStateVars = 2;
-
-      // State Variables.
-      const pylith::materials::Metadata::ParamDescription stateVars[] = {
-	{ "cumulative_slip", 1, pylith::topology::FieldBase::SCALAR },
-	{ "previous_slip", 1, pylith::topology::FieldBase::SCALAR },
-      };
-
-      // Values expected in spatial database
-      const int numDBProperties = 6;
-      const char* dbProperties[numDBProperties] = { 
-	"static_coefficient",
-	"transition_coefficient",
-	"dynamic_coefficient",
-	"transition_slip_distance",
-	"final_slip_distance",
-	"cohesion",
-      };
-
-      // These are the state variables stored during the simulation. 
-
-      const int numDBStateVars = 2;
-      const char* dbStateVars[numDBStateVars] = { "cumulative_slip",
-	"previous_slip",
-      };      
-      
-    } // _DoubleSlipWeakeningFrictionNoHeal
-  } // friction
-} // contrib
-
-// Indices of fault constitutive parameters.
-const int contrib::friction::DoubleSlipWeakeningFrictionNoHeal::p_coefS = 0;
-const int contrib::friction::DoubleSlipWeakeningFrictionNoHeal::p_coefT = 
-  contrib::friction::DoubleSlipWeakeningFrictionNoHeal::p_coefS + 1;
-const int contrib::friction::DoubleSlipWeakeningFrictionNoHeal::p_coefD = 
-  contrib::friction::DoubleSlipWeakeningFrictionNoHeal::p_coefT + 1;
-const int contrib::friction::DoubleSlipWeakeningFrictionNoHeal::p_distT = 
-  contrib::friction::DoubleSlipWeakeningFrictionNoHeal::p_coefD + 1;
-const int contrib::friction::DoubleSlipWeakeningFrictionNoHeal::p_distF = 
-  contrib::friction::DoubleSlipWeakeningFrictionNoHeal::p_distT + 1;
-const int contrib::friction::DoubleSlipWeakeningFrictionNoHeal::p_cohesion =
-  contrib::friction::DoubleSlipWeakeningFrictionNoHeal::p_distF + 1;
-
-// Indices of database values (order must match dbProperties)
-const int contrib::friction::DoubleSlipWeakeningFrictionNoHeal::db_coefS = 0;
-const int contrib::friction::DoubleSlipWeakeningFrictionNoHeal::db_coefT =
-  contrib::friction::DoubleSlipWeakeningFrictionNoHeal::db_coefS + 1;
-const int contrib::friction::DoubleSlipWeakeningFrictionNoHeal::db_coefD =
-  contrib::friction::DoubleSlipWeakeningFrictionNoHeal::db_coefT + 1;
-const int contrib::friction::DoubleSlipWeakeningFrictionNoHeal::db_distT =
-  contrib::friction::DoubleSlipWeakeningFrictionNoHeal::db_coefD + 1;
-const int contrib::friction::DoubleSlipWeakeningFrictionNoHeal::db_distF =
-  contrib::friction::DoubleSlipWeakeningFrictionNoHeal::db_distT + 1;
-const int contrib::friction::DoubleSlipWeakeningFrictionNoHeal::db_cohesion =
-  contrib::friction::DoubleSlipWeakeningFrictionNoHeal::db_distF + 1;
-
-// Indices of state variables.
-const int contrib::friction::DoubleSlipWeakeningFrictionNoHeal::s_slipCum = 0;
-const int contrib::friction::DoubleSlipWeakeningFrictionNoHeal::s_slipPrev = 
-  contrib::friction::DoubleSlipWeakeningFrictionNoHeal::s_slipCum + 1;
-
-// Indices of database values (order must match dbProperties)
-const int contrib::friction::DoubleSlipWeakeningFrictionNoHeal::db_slipCum = 0;
-const int contrib::friction::DoubleSlipWeakeningFrictionNoHeal::db_slipPrev = 
-  contrib::friction::DoubleSlipWeakeningFrictionNoHeal::db_slipCum + 1;
-
-// ----------------------------------------------------------------------
-// Default constructor.
-contrib::friction::DoubleSlipWeakeningFrictionNoHeal::DoubleSlipWeakeningFrictionNoHeal(void) :
-  pylith::friction::FrictionModel(pylith::materials::Metadata(_DoubleSlipWeakeningFrictionNoHeal::properties,
-				    _DoubleSlipWeakeningFrictionNoHeal::numProperties,
-				    _DoubleSlipWeakeningFrictionNoHeal::dbProperties,
-				    _DoubleSlipWeakeningFrictionNoHeal::numDBProperties,
-				    _DoubleSlipWeakeningFrictionNoHeal::stateVars,
-				    _DoubleSlipWeakeningFrictionNoHeal::numStateVars,
-				    _DoubleSlipWeakeningFrictionNoHeal::dbStateVars,
-				    _DoubleSlipWeakeningFrictionNoHeal::numDBStateVars))
-                    
-{ // constructor
-} // constructor
-
-// ----------------------------------------------------------------------
-// Destructor.
-contrib::friction::DoubleSlipWeakeningFrictionNoHeal::~DoubleSlipWeakeningFrictionNoHeal(void)
-{ // destructor
-} // destructor
+// Physical properties.
+const pylith::materials::Metadata::ParamDescription
+contrib::friction::DoubleSlipWeakeningCurve::properties[numProperties] = {
+  { "static_coefficient", 1, pylith::topology::FieldBase::SCALAR },
+  { "transition_coefficient", 1, pylith::topology::FieldBase::SCALAR },
+  { "dynamic_coefficient", 1, pylith::topology::FieldBase::SCALAR },
+  { "transition_slip_distance", 1, pylith::topology::FieldBase::SCALAR },
+  { "final_slip_distance", 1, pylith::topology::FieldBase::SCALAR },
+  { "cohesion", 1, pylith::topology::FieldBase::SCALAR },
+  // Derived properties (not in spatial database).
+  { "transition_weakening_rate", 1, pylith::topology::FieldBase::SCALAR },
+  { "final_weakening_rate", 1, pylith::topology::FieldBase::SCALAR },
+};
+
+// Values expected in spatial database.
+const char*
+contrib::friction::DoubleSlipWeakeningCurve::dbProperties[numDBProperties] = {
+  "static_coefficient",
+  "transition_coefficient",
+  "dynamic_coefficient",
+  "transition_slip_distance",
+  "final_slip_distance",
+  "cohesion",
+};
+
+// Rules for properties.
+const contrib::friction::ContribFrictionModel::PropertyRule
+contrib::friction::DoubleSlipWeakeningCurve::propertyRules[numPropertyRules] = {
+  { "static_coefficient > 0", ContribFrictionModel::POSITIVE_RULE, p_coefS, p_coefS, 0 },
+  { "transition_coefficient > 0", ContribFrictionModel::POSITIVE_RULE, p_coefT, p_coefT, 0 },
+  { "dynamic_coefficient > 0", ContribFrictionModel::POSITIVE_RULE, p_coefD, p_coefD, 0 },
+  { "transition_slip_distance > 0", ContribFrictionModel::POSITIVE_RULE, p_distT, p_distT, 0 },
+  { "final_slip_distance > 0", ContribFrictionModel::POSITIVE_RULE, p_distF, p_distF, 0 },
+  { "cohesion >= 0", ContribFrictionModel::NONNEGATIVE_RULE, p_cohesion, p_cohesion, 0 },
+  { "final_slip_distance > transition_slip_distance", ContribFrictionModel::GREATER_RULE, p_distF, p_distT, 0 },
+  { "static_coefficient >= transition_coefficient", ContribFrictionModel::NOT_LESS_RULE, p_coefS, p_coefT, 0 },
+  { "transition_coefficient >= dynamic_coefficient", ContribFrictionModel::NOT_LESS_RULE, p_coefT, p_coefD, 0 },
+};
+
+// Dimensions of properties, including derived properties.
+const contrib::friction::ContribFrictionModel::Dimension
+contrib::friction::DoubleSlipWeakeningCurve::propertyDimensions[numProperties] = {
+  { 0, 0, 0 }, // static_coefficient
+  { 0, 0, 0 }, // transition_coefficient
+  { 0, 0, 0 }, // dynamic_coefficient
+  { 1, 0, 0 }, // transition_slip_distance
+  { 1, 0, 0 }, // final_slip_distance
+  { 0, 1, 0 }, // cohesion
+  { -1, 0, 0 }, // transition_weakening_rate
+  { -1, 0, 0 }, // final_weakening_rate
+};
 
 // ----------------------------------------------------------------------
 // Compute properties from values in spatial database.
 void
-contrib::friction::DoubleSlipWeakeningFrictionNoHeal::_dbToProperties(PylithScalar* const propValues,
-						    const pylith::scalar_array& dbValues) const
-{ // _dbToProperties
+contrib::friction::DoubleSlipWeakeningCurve::dbToProperties(PylithScalar* const propValues,
+							    const pylith::scalar_array& dbValues)
+{ // dbToProperties
   // Check consistency of arguments
   assert(propValues);
-  const int numDBValues = dbValues.size();
-  assert(_DoubleSlipWeakeningFrictionNoHeal::numDBProperties == numDBValues);
+  assert(numDBProperties == int(dbValues.size()));
 
   // Extract values from array using our defined indices.
   const PylithScalar coefS = dbValues[db_coefS];
@@ -225,246 +160,158 @@ contrib::friction::DoubleSlipWeakeningFrictionNoHeal::_dbToProperties(PylithScal
   propValues[p_distT] = distT;
   propValues[p_distF] = distF;
   propValues[p_cohesion] = cohesion;
+  _computeDerivedProperties(propValues);
 
-} // _dbToProperties
+} // dbToProperties
 
 // ----------------------------------------------------------------------
-// Nondimensionalize properties.
+// Compute derived properties.
 void
-contrib::friction::DoubleSlipWeakeningFrictionNoHeal::_nondimProperties(PylithScalar* const values,
-						      const int nvalues) const
-{ // _nondimProperties
-  // Check consistency of arguments.
-  assert(_normalizer);
+contrib::friction::DoubleSlipWeakeningCurve::_computeDerivedProperties(PylithScalar* const values)
+{ // _computeDerivedProperties
   assert(values);
-  assert(nvalues == _DoubleSlipWeakeningFrictionNoHeal::numProperties);
-
-  // Get scales needed to nondimensional parameters from the
-  // Nondimensional object.
-  const PylithScalar lengthScale = _normalizer->lengthScale();
-  const PylithScalar timeScale = _normalizer->timeScale();
-  const PylithScalar pressureScale = _normalizer->pressureScale();
-  const PylithScalar velocityScale = lengthScale / timeScale;
-
-  // Use the Nondimensional::nondimensionalize() function to
-  // nondimensionalize the quantities using the appropriate scale.
-  values[p_distT] = _normalizer->nondimensionalize(values[p_distT], lengthScale);
-  values[p_distF] = _normalizer->nondimensionalize(values[p_distF], lengthScale);
-  values[p_cohesion] = 
-    _normalizer->nondimensionalize(values[p_cohesion], pressureScale);
-} // _nondimProperties
 
-// ----------------------------------------------------------------------
-// Dimensionalize properties.
-void
-contrib::friction::DoubleSlipWeakeningFrictionNoHeal::_dimProperties(PylithScalar* const values,
-						   const int nvalues) const
-{ // _dimProperties
-  // Check consistency of arguments.
-  assert(_normalizer);
-  assert(values);
-  assert(nvalues == _DoubleSlipWeakeningFrictionNoHeal::numProperties);
-
-  // Get scales needed to dimensional parameters from the
-  // Nondimensional object.
-  const PylithScalar lengthScale = _normalizer->lengthScale();
-  const PylithScalar timeScale = _normalizer->timeScale();
-  const PylithScalar pressureScale = _normalizer->pressureScale();
-  const PylithScalar velocityScale = lengthScale / timeScale;
-
-  // Use the Nondimensional::dimensionalize() function to
-  // dimensionalize the quantities using the appropriate scale.
-  values[p_distT] = _normalizer->dimensionalize(values[p_distT], lengthScale);
-  values[p_distF] = _normalizer->dimensionalize(values[p_distF], lengthScale);
-  values[p_cohesion] = 
-    _normalizer->dimensionalize(values[p_cohesion], pressureScale);
-} // _dimProperties
+  // Slopes of the two linear segments. A degenerate second segment
+  // (final slip distance not beyond the transition slip distance) is
+  // never used, so store zero instead of dividing by zero.
+  values[p_rateT] = (values[p_coefS] - values[p_coefT]) / values[p_distT];
+  values[p_rateF] = (values[p_distF] > values[p_distT]) ?
+    (values[p_coefT] - values[p_coefD]) / (values[p_distF] - values[p_distT]) :
+    PylithScalar(0.0);
+} // _computeDerivedProperties
 
 // ----------------------------------------------------------------------
-// Compute state variables from values in spatial database.
-void
-contrib::friction::DoubleSlipWeakeningFrictionNoHeal::_dbToStateVars(PylithScalar* const stateValues,
-						   const pylith::scalar_array& dbValues) const
-{ // _dbToStateVars
-  // Check consistency of arguments.
-  assert(stateValues);
-  const int numDBValues = dbValues.size();
-  assert(_DoubleSlipWeakeningFrictionNoHeal::numDBStateVars == numDBValues);
-
-  // Compute friction parameters that we store from the user-supplied
-  // friction parameters.
-  const PylithScalar cumulativeSlip = dbValues[db_slipCum];
-  const PylithScalar previousSlip = dbValues[db_slipPrev];
- 
-  // Store computed friction parameters in the properties array.
-  stateValues[s_slipCum] = cumulativeSlip;
-  stateValues[s_slipPrev] = previousSlip;
-} // _dbToStateVars
+// Compute friction coefficient at a location.
+inline
+PylithScalar
+contrib::friction::DoubleSlipWeakeningCurve::coefficient(const PylithScalar slipCum,
+							 const PylithScalar* properties,
+							 PylithScalar* const derivCoef)
+{ // coefficient
+  // Rather than branching on the linear segment, both segments are
+  // evaluated and the active one is selected, so the same expressions
+  // apply at every vertex (see coefficientSIMD()). The slopes are
+  // precomputed, so there are no divisions.
+  const PylithScalar muT = properties[p_coefS] - properties[p_rateT] * slipCum;
+  const PylithScalar muF = properties[p_coefT] -
+    properties[p_rateF] * (slipCum - properties[p_distT]);
+
+  *derivCoef =
+    simd::selectLess(slipCum, properties[p_distT], properties[p_rateT],
+		     simd::selectLess(slipCum, properties[p_distF], properties[p_rateF], 0.0));
+  return simd::selectLess(slipCum, properties[p_distT], muT,
+			  simd::selectLess(slipCum, properties[p_distF], muF, properties[p_coefD]));
+} // coefficient
 
 // ----------------------------------------------------------------------
-// Nondimensionalize state variables.
-void
-contrib::friction::DoubleSlipWeakeningFrictionNoHeal::_nondimStateVars(PylithScalar* const values,
-						     const int nvalues) const
-{ // _nondimStateVars
-  // Check consistency of arguments.
-  assert(_normalizer);
-  assert(values);
-  assert(nvalues == _DoubleSlipWeakeningFrictionNoHeal::numStateVars);
-
-  // Get scales needed to nondimensional parameters from the
-  // Nondimensional object.
-  const PylithScalar lengthScale = _normalizer->lengthScale();
-  const PylithScalar timeScale = _normalizer->timeScale();
-  const PylithScalar velocityScale = lengthScale / timeScale;
-
-  // Use the Nondimensional::dimensionalize() function to
-  // dimensionalize the quantities using the appropriate scale.
-  values[s_slipCum] = _normalizer->nondimensionalize(values[s_slipCum], lengthScale);
-  values[s_slipPrev] = _normalizer->nondimensionalize(values[s_slipPrev], lengthScale);
-} // _nondimStateVars
+// Get index of weakening segment at a location.
+inline
+int
+contrib::friction::DoubleSlipWeakeningCurve::segment(const PylithScalar slipCum,
+						     const PylithScalar* properties)
+{ // segment
+  return (slipCum < properties[p_distT]) ? 0 : 1;
+} // segment
 
 // ----------------------------------------------------------------------
-// Dimensionalize state variables.
-void
-contrib::friction::DoubleSlipWeakeningFrictionNoHeal::_dimStateVars(PylithScalar* const values,
-						  const int nvalues) const
-{ // _dimStateVars
-  // Check consistency of arguments.
-  assert(_normalizer);
-  assert(values);
-  assert(nvalues == _DoubleSlipWeakeningFrictionNoHeal::numStateVars);
+// Check whether the friction coefficient no longer changes with slip.
+inline
+bool
+contrib::friction::DoubleSlipWeakeningCurve::fullyWeakened(const PylithScalar slipCum,
+							   const PylithScalar* properties)
+{ // fullyWeakened
+  return !(slipCum < properties[p_distT]) && !(slipCum < properties[p_distF]);
+} // fullyWeakened
 
-  // Get scales needed to dimensional parameters from the
-  // Nondimensional object.
-  const PylithScalar lengthScale = _normalizer->lengthScale();
-  const PylithScalar timeScale = _normalizer->timeScale();
-  const PylithScalar velocityScale = lengthScale / timeScale;
+// ----------------------------------------------------------------------
+// Check whether a location has reached the end of weakening.
+inline
+bool
+contrib::friction::DoubleSlipWeakeningCurve::weakeningEnded(const PylithScalar slipCum,
+							    const PylithScalar* properties,
+							    const PylithScalar fraction)
+{ // weakeningEnded
+  return fullyWeakened(slipCum, properties);
+} // weakeningEnded
 
-  // Use the Nondimensional::dimensionalize() function to
-  // dimensionalize the quantities using the appropriate scale.
-  values[s_slipCum] = _normalizer->dimensionalize(values[s_slipCum], lengthScale);
-  values[s_slipPrev] = _normalizer->dimensionalize(values[s_slipPrev], lengthScale);
-} // _dimStateVars
+// ----------------------------------------------------------------------
+// Get number of flops in coefficient() at a location.
+inline
+int
+contrib::friction::DoubleSlipWeakeningCurve::coefficientFlops(const PylithScalar slipCum,
+							      const PylithScalar* properties)
+{ // coefficientFlops
+  // Both segments are evaluated (see coefficient()).
+  return 5;
+} // coefficientFlops
 
 // ----------------------------------------------------------------------
-// Compute friction from properties and state variables.
+// Get slip from a location to the next breakpoint of the friction
+// coefficient.
+inline
 PylithScalar
-contrib::friction::DoubleSlipWeakeningFrictionNoHeal::_calcFriction(const PylithScalar t,
-						  const PylithScalar slip,
-						  const PylithScalar slipRate,
-						  const PylithScalar normalTraction,
-						  const PylithScalar* properties,
-						  const int numProperties,
-						  const PylithScalar* stateVars,
-						  const int numStateVars)
-{ // _calcFriction
-  // Check consistency of arguments.
-  assert(properties);
-  assert(_DoubleSlipWeakeningFrictionNoHeal::numProperties == numProperties);
-  assert(numStateVars);
-  assert(_DoubleSlipWeakeningFrictionNoHeal::numStateVars == numStateVars);
-
-  // Compute friction traction.
-  PylithScalar friction = 0.0;
-  PylithScalar mu_f = 0.0;
-  if (normalTraction <= 0.0) {
-    // if fault is in compression
-    const PylithScalar slipPrev = stateVars[s_slipPrev];
-    const PylithScalar slipCum = stateVars[s_slipCum] + fabs(slip - slipPrev);
-
-    if (slipCum < properties[p_distT]) {
-	// if/else 
-	mu_f = properties[p_coefS] -
-	  (properties[p_coefS] - properties[p_coefT]) * 
-	  slipCum / properties[p_distT];
-	  } else if (slipCum < properties[p_distF]) {
-	mu_f = properties[p_coefT] -
-	  (properties[p_coefT] - properties[p_coefD]) * 
-	  (slipCum - properties[p_distT]) / (properties[p_distF]-properties[p_distT]);
-      } else {
-	mu_f = properties[p_coefD];
-      } // if/else
-    friction = -mu_f * normalTraction + properties[p_cohesion];
-  } else { // else
-    friction = properties[p_cohesion];
-  } // if/else
-
-  PetscLogFlops(10);
-
-  return friction;
-} // _calcFriction
+contrib::friction::DoubleSlipWeakeningCurve::slipToBreakpoint(const PylithScalar slipCum,
+							      const PylithScalar* properties)
+{ // slipToBreakpoint
+  if (slipCum < properties[p_distT])
+    return properties[p_distT] - slipCum;
+  if (slipCum < properties[p_distF])
+    return properties[p_distF] - slipCum;
+  return PYLITH_MAXSCALAR;
+} // slipToBreakpoint
 
 // ----------------------------------------------------------------------
-// Compute derivative of friction with slip from properties and state variables.
+// Get friction coefficient at a location once fully weakened.
+inline
 PylithScalar
-contrib::friction::DoubleSlipWeakeningFrictionNoHeal::_calcFrictionDeriv(const PylithScalar t,
-						       const PylithScalar slip,
-						       const PylithScalar slipRate,
-						       const PylithScalar normalTraction,
-						       const PylithScalar* properties,
-						       const int numProperties,
-						       const PylithScalar* stateVars,
-						       const int numStateVars)
-{ // _calcFrictionDeriv
-  // Check consistency of arguments.
-  assert(properties);
-  assert(_DoubleSlipWeakeningFrictionNoHeal::numProperties == numProperties);
-  assert(numStateVars);
-  assert(_DoubleSlipWeakeningFrictionNoHeal::numStateVars == numStateVars);
-
-  // Compute friction traction.
-  PylithScalar frictionDeriv = 0.0;
-  if (normalTraction <= 0.0) {
-    // if fault is in compression
-	const PylithScalar slipPrev = stateVars[s_slipPrev];
-    const PylithScalar slipCum = stateVars[s_slipCum] + fabs(slip - slipPrev);
-
-    if (slipCum < properties[p_distT]) {
-      frictionDeriv = normalTraction * (properties[p_coefS] - properties[p_coefT]) / properties[p_distT];
-    } else if (slipCum < properties[p_distF]) {
-		frictionDeriv = normalTraction * (properties[p_coefT] - properties[p_coefD]) / (properties[p_distF]-properties[p_distT]);
-      } // if/else
-  } // if
+contrib::friction::DoubleSlipWeakeningCurve::residualCoefficient(const PylithScalar* properties)
+{ // residualCoefficient
+  return properties[p_coefD];
+} // residualCoefficient
 
-  return frictionDeriv;
-} // _calcFrictionDeriv
+// ----------------------------------------------------------------------
+// Compute friction coefficient at a vector of locations.
+inline
+contrib::friction::simd::VecD
+contrib::friction::DoubleSlipWeakeningCurve::coefficientSIMD(const simd::VecD slipCum,
+							     const double* properties,
+							     const int stride,
+							     simd::VecD* const derivCoef)
+{ // coefficientSIMD
+  const simd::VecD coefS = simd::loads(&properties[p_coefS], stride);
+  const simd::VecD coefT = simd::loads(&properties[p_coefT], stride);
+  const simd::VecD coefD = simd::loads(&properties[p_coefD], stride);
+  const simd::VecD distT = simd::loads(&properties[p_distT], stride);
+  const simd::VecD distF = simd::loads(&properties[p_distF], stride);
+  const simd::VecD rateT = simd::loads(&properties[p_rateT], stride);
+  const simd::VecD rateF = simd::loads(&properties[p_rateF], stride);
+
+  // Same expressions as coefficient(), evaluated for all lanes.
+  const simd::MaskD inTransition = simd::cmplt(slipCum, distT);
+  const simd::MaskD inFinal = simd::cmplt(slipCum, distF);
+  const simd::VecD muT = simd::sub(coefS, simd::mul(rateT, slipCum));
+  const simd::VecD muF = simd::sub(coefT, simd::mul(rateF, simd::sub(slipCum, distT)));
+
+  *derivCoef =
+    simd::select(inTransition, rateT, simd::select(inFinal, rateF, simd::set1(0.0)));
+  return simd::select(inTransition, muT, simd::select(inFinal, muF, coefD));
+} // coefficientSIMD
 
 // ----------------------------------------------------------------------
-// Update state variables (for next time step).
-void
-contrib::friction::DoubleSlipWeakeningFrictionNoHeal::_updateStateVars(const PylithScalar t,
-						     const PylithScalar slip,
-						     const PylithScalar slipRate,
-						     const PylithScalar normalTraction,
-						     PylithScalar* const stateVars,
-						     const int numStateVars,
-						     const PylithScalar* properties,
-						     const int numProperties)
-{ // _updateStateVars
-  // Check consistency of arguments.
-  assert(properties);
-  assert(_DoubleSlipWeakeningFrictionNoHeal::numProperties == numProperties);
-  assert(numStateVars);
-  assert(_DoubleSlipWeakeningFrictionNoHeal::numStateVars == numStateVars);
-  
-  const PylithScalar tolerance = 0;
-  if (slipRate >= tolerance) {
-    const PylithScalar slipPrev = stateVars[s_slipPrev];
-
-    stateVars[s_slipPrev] = slip;
-    stateVars[s_slipCum] += fabs(slip - slipPrev);
-  } else {
-    // Sliding has stopped, so reset state variables.
-    stateVars[s_slipPrev] = slip;
-    stateVars[s_slipCum] = 0.0;
-  } // else
-	  
-  //const PylithScalar slipPrev = stateVars[s_slipPrev];
-  //stateVars[s_slipPrev] = slip;
-  //stateVars[s_slipCum] += fabs(slip - slipPrev);
-  
-} // _updateStateVars
+// Constructor.
+contrib::friction::DoubleSlipWeakeningFrictionNoHeal::DoubleSlipWeakeningFrictionNoHeal(const bool diagnostics) :
+  SlipWeakeningLaw<DoubleSlipWeakeningCurve>(diagnostics)
+{ // constructor
+} // constructor
+
+// ----------------------------------------------------------------------
+// Destructor.
+contrib::friction::DoubleSlipWeakeningFrictionNoHeal::~DoubleSlipWeakeningFrictionNoHeal(void)
+{ // destructor
+} // destructor
+
+// Instantiate the slip-weakening law for this friction coefficient.
+template class contrib::friction::SlipWeakeningLaw<contrib::friction::DoubleSlipWeakeningCurve>;
 
 
 // End of file 
@@ -31,14 +31,17 @@
 namespace contrib {
   namespace friction {
 
-    class DoubleSlipWeakeningFrictionNoHeal : public pylith::friction::FrictionModel
+    class DoubleSlipWeakeningFrictionNoHeal : public contrib::friction::ContribFrictionModel
     { // class DoubleSlipWeakeningFrictionNoHeal
 
       // PUBLIC METHODS /////////////////////////////////////////////////
     public :
 
-      /// Default constructor.
-      DoubleSlipWeakeningFrictionNoHeal(void);
+      /** Constructor.
+       *
+       * @param diagnostics True to add the diagnostic state variables.
+       */
+      DoubleSlipWeakeningFrictionNoHeal(const bool diagnostics=false);
 
       /// Destructor.
       ~DoubleSlipWeakeningFrictionNoHeal(void);
@@ -51,8 +54,8 @@ namespace contrib {
        * @param propValues Array of property values.
        * @param dbValues Array of database values.
        */
-      void _dbToProperties(PylithScalar* const propValues,
-			   const scalar_array& dbValues) const;
+      void _dbValuesToProperties(PylithScalar* const propValues,
+				 const scalar_array& dbValues) const;
 
       /** Nondimensionalize properties.
        *
@@ -24,136 +24,71 @@
 
 #include "ExponentialCohesiveZoneNoHeal.hh" // implementation of object methods
 
-#include "pylith/materials/Metadata.hh" // USES Metadata
+#include "SlipWeakeningLaw.icc" // implementation of template methods
 
-#include "pylith/utils/array.hh" // USES scaary_array
+#include "pylith/utils/array.hh" // USES scalar_array
 #include "pylith/utils/constdefs.h" // USES PYLITH_MAXSCALAR
 
-#include "spatialdata/units/Nondimensional.hh" // USES Nondimensional
+#include <cmath> // USES exp()
 
 #include <cassert> // USES assert()
 #include <sstream> // USES std::ostringstream
 #include <stdexcept> // USES std::runtime_error
 
 // ----------------------------------------------------------------------
-// Create a local namespace to use for local constants and other
-// information. This insulates all other classes from this information
-// while preventing clashes with other local constants and data (as
-// long as no other object use the same _ExponentialCohesiveZoneNoHeal namespace in
-// the  namespace.
-namespace contrib {
-  namespace friction {
-    namespace _ExponentialCohesiveZoneNoHeal {
-
-      // These are the fault constitutive parameters stored during the
-      // simulation and need not coincide with the physical properties
-      // provided by the user.
-
-      // Number of physical properties.
-      const int numProperties = 5;
-
-      // Friction model parameters.
-      const pylith::materials::Metadata::ParamDescription properties[numProperties] = {
-	{ "static_coefficient", 1, pylith::topology::FieldBase::SCALAR },
-	{ "dynamic_coefficient", 1, pylith::topology::FieldBase::SCALAR },
-	{ "slip_shift", 1, pylith::topology::FieldBase::SCALAR },
-	{ "slip_stretch", 1, pylith::topology::FieldBase::SCALAR },
-	{ "cohesion", 1, pylith::topology::FieldBase::SCALAR },
-      };
-
-      // Number of state variables.
-      const int numStateVars = 2;
-
-      // State Variables.
-      const pylith::materials::Metadata::ParamDescription stateVars[] = {
-	{ "cumulative_slip", 1, pylith::topology::FieldBase::SCALAR },
-	{ "previous_slip", 1, pylith::topology::FieldBase::SCALAR },
-      };
-
-      // Values expected in spatial database
-      const int numDBProperties = 5;
-      const char* dbProperties[numDBProperties] = { 
-	"static_coefficient",
-	"dynamic_coefficient",
-	"slip_shift",
-	"slip_stretch",
-	"cohesion",
-      };
-
-      // These are the state variables stored during the simulation.
-
-      const int numDBStateVars = 2;
-      const char* dbStateVars[numDBStateVars] = { "cumulative_slip",
-	"previous_slip",
-      };      
-      
-    } // _ExponentialCohesiveZoneNoHeal
-  } // friction
-} // contrib
-
-// Indices of fault constitutive parameters.
-const int contrib::friction::ExponentialCohesiveZoneNoHeal::p_coefS = 0;
-const int contrib::friction::ExponentialCohesiveZoneNoHeal::p_coefD = 
-  contrib::friction::ExponentialCohesiveZoneNoHeal::p_coefS + 1;
-const int contrib::friction::ExponentialCohesiveZoneNoHeal::p_slShift = 
-  contrib::friction::ExponentialCohesiveZoneNoHeal::p_coefD + 1;
-const int contrib::friction::ExponentialCohesiveZoneNoHeal::p_slStretch = 
-  contrib::friction::ExponentialCohesiveZoneNoHeal::p_slShift + 1;
-const int contrib::friction::ExponentialCohesiveZoneNoHeal::p_cohesion =
-  contrib::friction::ExponentialCohesiveZoneNoHeal::p_slStretch + 1;
-
-// Indices of database values (order must match dbProperties)
-const int contrib::friction::ExponentialCohesiveZoneNoHeal::db_coefS = 0;
-const int contrib::friction::ExponentialCohesiveZoneNoHeal::db_coefD =
-  contrib::friction::ExponentialCohesiveZoneNoHeal::db_coefS + 1;
-const int contrib::friction::ExponentialCohesiveZoneNoHeal::db_slShift =
-  contrib::friction::ExponentialCohesiveZoneNoHeal::db_coefD + 1;
-const int contrib::friction::ExponentialCohesiveZoneNoHeal::db_slStretch =
-  contrib::friction::ExponentialCohesiveZoneNoHeal::db_slShift + 1;
-const int contrib::friction::ExponentialCohesiveZoneNoHeal::db_cohesion =
-  contrib::friction::ExponentialCohesiveZoneNoHeal::db_slStretch + 1;
-
-// Indices of state variables.
-const int contrib::friction::ExponentialCohesiveZoneNoHeal::s_slipCum = 0;
-const int contrib::friction::ExponentialCohesiveZoneNoHeal::s_slipPrev = 
-  contrib::friction::ExponentialCohesiveZoneNoHeal::s_slipCum + 1;
-
-// Indices of database values (order must match dbProperties)
-const int contrib::friction::ExponentialCohesiveZoneNoHeal::db_slipCum = 0;
-const int contrib::friction::ExponentialCohesiveZoneNoHeal::db_slipPrev = 
-  contrib::friction::ExponentialCohesiveZoneNoHeal::db_slipCum + 1;
-
-// ----------------------------------------------------------------------
-// Default constructor.
-contrib::friction::ExponentialCohesiveZoneNoHeal::ExponentialCohesiveZoneNoHeal(void) :
-  pylith::friction::FrictionModel(pylith::materials::Metadata(_ExponentialCohesiveZoneNoHeal::properties,
-				    _ExponentialCohesiveZoneNoHeal::numProperties,
-				    _ExponentialCohesiveZoneNoHeal::dbProperties,
-				    _ExponentialCohesiveZoneNoHeal::numDBProperties,
-				    _ExponentialCohesiveZoneNoHeal::stateVars,
-				    _ExponentialCohesiveZoneNoHeal::numStateVars,
-				    _ExponentialCohesiveZoneNoHeal::dbStateVars,
-				    _ExponentialCohesiveZoneNoHeal::numDBStateVars))
-                    
-{ // constructor
-} // constructor
-
-// ----------------------------------------------------------------------
-// Destructor.
-contrib::friction::ExponentialCohesiveZoneNoHeal::~ExponentialCohesiveZoneNoHeal(void)
-{ // destructor
-} // destructor
+// Physical properties.
+const pylith::materials::Metadata::ParamDescription
+contrib::friction::ExponentialCohesiveZoneCurve::properties[numProperties] = {
+  { "static_coefficient", 1, pylith::topology::FieldBase::SCALAR },
+  { "dynamic_coefficient", 1, pylith::topology::FieldBase::SCALAR },
+  { "slip_shift", 1, pylith::topology::FieldBase::SCALAR },
+  { "slip_stretch", 1, pylith::topology::FieldBase::SCALAR },
+  { "cohesion", 1, pylith::topology::FieldBase::SCALAR },
+  // Derived properties (not in spatial database).
+  { "inverse_slip_stretch", 1, pylith::topology::FieldBase::SCALAR },
+};
+
+// Values expected in spatial database.
+const char*
+contrib::friction::ExponentialCohesiveZoneCurve::dbProperties[numDBProperties] = {
+  "static_coefficient",
+  "dynamic_coefficient",
+  "slip_shift",
+  "slip_stretch",
+  "cohesion",
+};
+
+// Rules for properties.
+const contrib::friction::ContribFrictionModel::PropertyRule
+contrib::friction::ExponentialCohesiveZoneCurve::propertyRules[numPropertyRules] = {
+  { "static_coefficient > 0", ContribFrictionModel::POSITIVE_RULE, p_coefS, p_coefS, 0 },
+  { "dynamic_coefficient > 0", ContribFrictionModel::POSITIVE_RULE, p_coefD, p_coefD, 0 },
+  { "slip_shift > 0", ContribFrictionModel::POSITIVE_RULE, p_slShift, p_slShift, 0 },
+  { "slip_stretch > 0", ContribFrictionModel::POSITIVE_RULE, p_slStretch, p_slStretch, 0 },
+  { "cohesion >= 0", ContribFrictionModel::NONNEGATIVE_RULE, p_cohesion, p_cohesion, 0 },
+  { "static_coefficient >= dynamic_coefficient", ContribFrictionModel::NOT_LESS_RULE, p_coefS, p_coefD, 0 },
+};
+
+// Dimensions of properties, including derived properties.
+const contrib::friction::ContribFrictionModel::Dimension
+contrib::friction::ExponentialCohesiveZoneCurve::propertyDimensions[numProperties] = {
+  { 0, 0, 0 }, // static_coefficient
+  { 0, 0, 0 }, // dynamic_coefficient
+  { 1, 0, 0 }, // slip_shift
+  { 1, 0, 0 }, // slip_stretch
+  { 0, 1, 0 }, // cohesion
+  { -1, 0, 0 }, // inverse_slip_stretch
+};
 
 // ----------------------------------------------------------------------
 // Compute properties from values in spatial database.
 void
-contrib::friction::ExponentialCohesiveZoneNoHeal::_dbToProperties(PylithScalar* const propValues,
-						    const pylith::scalar_array& dbValues) const
-{ // _dbToProperties
+contrib::friction::ExponentialCohesiveZoneCurve::dbToProperties(PylithScalar* const propValues,
+								const pylith::scalar_array& dbValues)
+{ // dbToProperties
   // Check consistency of arguments
   assert(propValues);
-  const int numDBValues = dbValues.size();
-  assert(_ExponentialCohesiveZoneNoHeal::numDBProperties == numDBValues);
+  assert(numDBProperties == int(dbValues.size()));
 
   // Extract values from array using our defined indices.
   const PylithScalar coefS = dbValues[db_coefS];
@@ -209,235 +144,174 @@ contrib::friction::ExponentialCohesiveZoneNoHeal::_dbToProperties(PylithScalar*
   propValues[p_slShift] = slShift;
   propValues[p_slStretch] = slStretch;
   propValues[p_cohesion] = cohesion;
+  _computeDerivedProperties(propValues);
 
-} // _dbToProperties
+} // dbToProperties
 
 // ----------------------------------------------------------------------
-// Nondimensionalize properties.
+// Compute derived properties.
 void
-contrib::friction::ExponentialCohesiveZoneNoHeal::_nondimProperties(PylithScalar* const values,
-						      const int nvalues) const
-{ // _nondimProperties
-  // Check consistency of arguments.
-  assert(_normalizer);
+contrib::friction::ExponentialCohesiveZoneCurve::_computeDerivedProperties(PylithScalar* const values)
+{ // _computeDerivedProperties
   assert(values);
-  assert(nvalues == _ExponentialCohesiveZoneNoHeal::numProperties);
-
-  // Get scales needed to nondimensional parameters from the
-  // Nondimensional object.
-  const PylithScalar lengthScale = _normalizer->lengthScale();
-  const PylithScalar timeScale = _normalizer->timeScale();
-  const PylithScalar pressureScale = _normalizer->pressureScale();
-  const PylithScalar velocityScale = lengthScale / timeScale;
-
-  // Use the Nondimensional::nondimensionalize() function to
-  // nondimensionalize the quantities using the appropriate scale.
-  values[p_slShift] = _normalizer->nondimensionalize(values[p_slShift], lengthScale);
-  values[p_slStretch] = _normalizer->nondimensionalize(values[p_slStretch], lengthScale);
-  values[p_cohesion] = _normalizer->nondimensionalize(values[p_cohesion], pressureScale);
-} // _nondimProperties
+
+  values[p_invStretch] = 1.0 / values[p_slStretch];
+} // _computeDerivedProperties
 
 // ----------------------------------------------------------------------
-// Dimensionalize properties.
-void
-contrib::friction::ExponentialCohesiveZoneNoHeal::_dimProperties(PylithScalar* const values,
-						   const int nvalues) const
-{ // _dimProperties
-  // Check consistency of arguments.
-  assert(_normalizer);
-  assert(values);
-  assert(nvalues == _ExponentialCohesiveZoneNoHeal::numProperties);
-
-  // Get scales needed to dimensional parameters from the
-  // Nondimensional object.
-  const PylithScalar lengthScale = _normalizer->lengthScale();
-  const PylithScalar timeScale = _normalizer->timeScale();
-  const PylithScalar pressureScale = _normalizer->pressureScale();
-  const PylithScalar velocityScale = lengthScale / timeScale;
-
-  // Use the Nondimensional::dimensionalize() function to
-  // dimensionalize the quantities using the appropriate scale.
-  values[p_slShift] = _normalizer->dimensionalize(values[p_slShift], lengthScale);
-  values[p_slStretch] = _normalizer->dimensionalize(values[p_slStretch], lengthScale);
-  values[p_cohesion] = _normalizer->dimensionalize(values[p_cohesion], pressureScale);
-} // _dimProperties
+// Compute friction coefficient at a location.
+inline
+PylithScalar
+contrib::friction::ExponentialCohesiveZoneCurve::coefficient(const PylithScalar slipCum,
+							     const PylithScalar* properties,
+							     PylithScalar* const derivCoef)
+{ // coefficient
+  // The friction coefficient and its derivative depend on the same
+  // exponential, so we only evaluate it once. The reciprocal of the
+  // stretch slip distance is precomputed, so there are no divisions.
+  const PylithScalar slipScaled =
+    (slipCum + properties[p_slShift]) * properties[p_invStretch];
+  const PylithScalar expTerm = exp(1 - slipScaled);
+
+  *derivCoef = (properties[p_coefD] - properties[p_coefS]) *
+    expTerm * (slipScaled - 1) * properties[p_invStretch];
+  return (properties[p_coefS] - properties[p_coefD]) * slipScaled * expTerm +
+    properties[p_coefD];
+} // coefficient
 
 // ----------------------------------------------------------------------
-// Compute state variables from values in spatial database.
-void
-contrib::friction::ExponentialCohesiveZoneNoHeal::_dbToStateVars(PylithScalar* const stateValues,
-						   const pylith::scalar_array& dbValues) const
-{ // _dbToStateVars
-  // Check consistency of arguments.
-  assert(stateValues);
-  const int numDBValues = dbValues.size();
-  assert(_ExponentialCohesiveZoneNoHeal::numDBStateVars == numDBValues);
-
-  // Compute friction parameters that we store from the user-supplied
-  // friction parameters.
-  const PylithScalar cumulativeSlip = dbValues[db_slipCum];
-  const PylithScalar previousSlip = dbValues[db_slipPrev];
- 
-  // Store computed friction parameters in the properties array.
-  stateValues[s_slipCum] = cumulativeSlip;
-  stateValues[s_slipPrev] = previousSlip;
-} // _dbToStateVars
+// Get index of weakening segment at a location.
+inline
+int
+contrib::friction::ExponentialCohesiveZoneCurve::segment(const PylithScalar slipCum,
+							 const PylithScalar* properties)
+{ // segment
+  return 0;
+} // segment
 
 // ----------------------------------------------------------------------
-// Nondimensionalize state variables.
-void
-contrib::friction::ExponentialCohesiveZoneNoHeal::_nondimStateVars(PylithScalar* const values,
-						     const int nvalues) const
-{ // _nondimStateVars
-  // Check consistency of arguments.
-  assert(_normalizer);
-  assert(values);
-  assert(nvalues == _ExponentialCohesiveZoneNoHeal::numStateVars);
+// Check whether the friction coefficient no longer changes with slip.
+inline
+bool
+contrib::friction::ExponentialCohesiveZoneCurve::fullyWeakened(const PylithScalar slipCum,
+							       const PylithScalar* properties)
+{ // fullyWeakened
+  // The exponential decays but never reaches the dynamic value.
+  return false;
+} // fullyWeakened
 
-  // Get scales needed to nondimensional parameters from the
-  // Nondimensional object.
-  const PylithScalar lengthScale = _normalizer->lengthScale();
-  const PylithScalar timeScale = _normalizer->timeScale();
-  const PylithScalar velocityScale = lengthScale / timeScale;
+// ----------------------------------------------------------------------
+// Check whether a location has reached the end of weakening.
+inline
+bool
+contrib::friction::ExponentialCohesiveZoneCurve::weakeningEnded(const PylithScalar slipCum,
+							 const PylithScalar* properties,
+							 const PylithScalar fraction)
+{ // weakeningEnded
+  // (mu - mu_d) / (mu_s - mu_d) = x e^(1-x) peaks at x = 1 and decays
+  // toward zero, so the fraction is reached once past the peak.
+  const PylithScalar slipScaled =
+    (slipCum + properties[p_slShift]) * properties[p_invStretch];
+  return slipScaled >= 1.0 && slipScaled * exp(1 - slipScaled) <= 1.0 - fraction;
+} // weakeningEnded
 
-  // Use the Nondimensional::dimensionalize() function to
-  // dimensionalize the quantities using the appropriate scale.
-  values[s_slipCum] = _normalizer->nondimensionalize(values[s_slipCum], lengthScale);
-  values[s_slipPrev] = _normalizer->nondimensionalize(values[s_slipPrev], lengthScale);
-} // _nondimStateVars
+// ----------------------------------------------------------------------
+// Get number of flops in coefficient() at a location.
+inline
+int
+contrib::friction::ExponentialCohesiveZoneCurve::coefficientFlops(const PylithScalar slipCum,
+								  const PylithScalar* properties)
+{ // coefficientFlops
+  return 12 + simd::expFlops;
+} // coefficientFlops
 
 // ----------------------------------------------------------------------
-// Dimensionalize state variables.
-void
-contrib::friction::ExponentialCohesiveZoneNoHeal::_dimStateVars(PylithScalar* const values,
-						  const int nvalues) const
-{ // _dimStateVars
-  // Check consistency of arguments.
-  assert(_normalizer);
-  assert(values);
-  assert(nvalues == _ExponentialCohesiveZoneNoHeal::numStateVars);
+// Get slip from a location to the next breakpoint of the friction
+// coefficient.
+inline
+PylithScalar
+contrib::friction::ExponentialCohesiveZoneCurve::slipToBreakpoint(const PylithScalar slipCum,
+								  const PylithScalar* properties)
+{ // slipToBreakpoint
+  return PYLITH_MAXSCALAR;
+} // slipToBreakpoint
 
-  // Get scales needed to dimensional parameters from the
-  // Nondimensional object.
-  const PylithScalar lengthScale = _normalizer->lengthScale();
-  const PylithScalar timeScale = _normalizer->timeScale();
-  const PylithScalar velocityScale = lengthScale / timeScale;
+// ----------------------------------------------------------------------
+// Get friction coefficient at a location once fully weakened.
+inline
+PylithScalar
+contrib::friction::ExponentialCohesiveZoneCurve::residualCoefficient(const PylithScalar* properties)
+{ // residualCoefficient
+  return properties[p_coefD];
+} // residualCoefficient
 
-  // Use the Nondimensional::dimensionalize() function to
-  // dimensionalize the quantities using the appropriate scale.
-  values[s_slipCum] = _normalizer->dimensionalize(values[s_slipCum], lengthScale);
-  values[s_slipPrev] = _normalizer->dimensionalize(values[s_slipPrev], lengthScale);
-} // _dimStateVars
+// ----------------------------------------------------------------------
+// Compute friction coefficient at a vector of locations.
+inline
+contrib::friction::simd::VecD
+contrib::friction::ExponentialCohesiveZoneCurve::coefficientSIMD(const simd::VecD slipCum,
+								 const double* properties,
+								 const int stride,
+								 simd::VecD* const derivCoef)
+{ // coefficientSIMD
+  const simd::VecD coefS = simd::loads(&properties[p_coefS], stride);
+  const simd::VecD coefD = simd::loads(&properties[p_coefD], stride);
+  const simd::VecD slShift = simd::loads(&properties[p_slShift], stride);
+  const simd::VecD invStretch = simd::loads(&properties[p_invStretch], stride);
+  const simd::VecD one = simd::set1(1.0);
+
+  // Same expressions as coefficient(), evaluated for all lanes. The
+  // vectorized exponential agrees with exp() to about 1 ulp, so
+  // results can differ from coefficient() in the last bits.
+  const simd::VecD slipScaled = simd::mul(simd::add(slipCum, slShift), invStretch);
+  const simd::VecD expTerm = simd::exp(simd::sub(one, slipScaled));
+
+  *derivCoef = simd::mul(simd::mul(simd::mul(simd::sub(coefD, coefS), expTerm),
+				   simd::sub(slipScaled, one)), invStretch);
+  return simd::fmadd(simd::mul(simd::sub(coefS, coefD), slipScaled), expTerm, coefD);
+} // coefficientSIMD
 
 // ----------------------------------------------------------------------
-// Compute friction from properties and state variables.
-PylithScalar
-contrib::friction::ExponentialCohesiveZoneNoHeal::_calcFriction(const PylithScalar t,
-						  const PylithScalar slip,
-						  const PylithScalar slipRate,
-						  const PylithScalar normalTraction,
-						  const PylithScalar* properties,
-						  const int numProperties,
-						  const PylithScalar* stateVars,
-						  const int numStateVars)
-{ // _calcFriction
-  // Check consistency of arguments.
-  assert(properties);
-  assert(_ExponentialCohesiveZoneNoHeal::numProperties == numProperties);
-  assert(numStateVars);
-  assert(_ExponentialCohesiveZoneNoHeal::numStateVars == numStateVars);
-
-  // Compute friction traction.
-  PylithScalar friction = 0.0;
-  PylithScalar mu_f = 0.0;
-  if (normalTraction <= 0.0) {
-    // if fault is in compression
-    const PylithScalar slipPrev = stateVars[s_slipPrev];
-    const PylithScalar slipCum = stateVars[s_slipCum] + fabs(slip - slipPrev);
-    
-	mu_f = (properties[p_coefS] - properties[p_coefD]) * (slipCum + properties[p_slShift]) *
-	  exp(1 - (slipCum + properties[p_slShift]) / properties[p_slStretch]) / properties[p_slStretch] +
-	  properties[p_coefD];
-	   // if/else
-    friction = -mu_f * normalTraction + properties[p_cohesion];
-  } else { // else
-    friction = properties[p_cohesion];
-  } // if/else
-
-  PetscLogFlops(10);
-
-  return friction;
-} // _calcFriction
+// Constructor.
+contrib::friction::ExponentialCohesiveZoneNoHeal::ExponentialCohesiveZoneNoHeal(const bool diagnostics) :
+  SlipWeakeningLaw<ExponentialCohesiveZoneCurve>(diagnostics)
+{ // constructor
+  // The exponential never reaches the dynamic coefficient.
+  _weakeningEndFraction = 0.95;
+} // constructor
 
 // ----------------------------------------------------------------------
-// Compute derivative of friction with slip from properties and state variables.
-PylithScalar
-contrib::friction::ExponentialCohesiveZoneNoHeal::_calcFrictionDeriv(const PylithScalar t,
-						       const PylithScalar slip,
-						       const PylithScalar slipRate,
-						       const PylithScalar normalTraction,
-						       const PylithScalar* properties,
-						       const int numProperties,
-						       const PylithScalar* stateVars,
-						       const int numStateVars)
-{ // _calcFrictionDeriv
-  // Check consistency of arguments.
-  assert(properties);
-  assert(_ExponentialCohesiveZoneNoHeal::numProperties == numProperties);
-  assert(numStateVars);
-  assert(_ExponentialCohesiveZoneNoHeal::numStateVars == numStateVars);
-
-  // Compute friction traction.
-  PylithScalar frictionDeriv = 0.0;
-  if (normalTraction <= 0.0) {
-    // if fault is in compression
-	const PylithScalar slipPrev = stateVars[s_slipPrev];
-    const PylithScalar slipCum = stateVars[s_slipCum] + fabs(slip - slipPrev);
-
-    frictionDeriv = normalTraction * ((properties[p_coefD] - properties[p_coefS]) * 
-	  exp((properties[p_slStretch] - slipCum - properties[p_slShift]) / properties[p_slStretch]) *
-	  (-properties[p_slStretch] + slipCum + properties[p_slShift]) / properties[p_slStretch] / properties[p_slStretch]);
-    } // if/else
-   // if
-
-  return frictionDeriv;
-} // _calcFrictionDeriv
+// Destructor.
+contrib::friction::ExponentialCohesiveZoneNoHeal::~ExponentialCohesiveZoneNoHeal(void)
+{ // destructor
+} // destructor
 
 // ----------------------------------------------------------------------
-// Update state variables (for next time step).
+// Set fraction of the strength drop that ends weakening.
 void
-contrib::friction::ExponentialCohesiveZoneNoHeal::_updateStateVars(const PylithScalar t,
-						     const PylithScalar slip,
-						     const PylithScalar slipRate,
-						     const PylithScalar normalTraction,
-						     PylithScalar* const stateVars,
-						     const int numStateVars,
-						     const PylithScalar* properties,
-						     const int numProperties)
-{ // _updateStateVars
-  // Check consistency of arguments.
-  assert(properties);
-  assert(_ExponentialCohesiveZoneNoHeal::numProperties == numProperties);
-  assert(numStateVars);
-  assert(_ExponentialCohesiveZoneNoHeal::numStateVars == numStateVars);
-  
-  const PylithScalar tolerance = 0;
-  if (slipRate >= tolerance) {
-    const PylithScalar slipPrev = stateVars[s_slipPrev];
-
-    stateVars[s_slipPrev] = slip;
-    stateVars[s_slipCum] += fabs(slip - slipPrev);
-  } else {
-    // Sliding has stopped, so reset state variables.
-    stateVars[s_slipPrev] = slip;
-    stateVars[s_slipCum] = 0.0;
-  } // else
-	  
-  //const PylithScalar slipPrev = stateVars[s_slipPrev];
-  //stateVars[s_slipPrev] = slip;
-  //stateVars[s_slipCum] += fabs(slip - slipPrev);
-  
-} // _updateStateVars
+contrib::friction::ExponentialCohesiveZoneNoHeal::weakeningEndFraction(const PylithScalar value)
+{ // weakeningEndFraction
+  if (value <= 0.0 || value >= 1.0) {
+    std::ostringstream msg;
+    msg << "Fraction of strength drop that ends weakening must be "
+	<< "between 0 and 1 for friction model '" << label() << "'.\n"
+	<< "Fraction: " << value << "\n";
+    throw std::runtime_error(msg.str());
+  } // if
+
+  _weakeningEndFraction = value;
+} // weakeningEndFraction
+
+// ----------------------------------------------------------------------
+// Get fraction of the strength drop that ends weakening.
+PylithScalar
+contrib::friction::ExponentialCohesiveZoneNoHeal::weakeningEndFraction(void) const
+{ // weakeningEndFraction
+  return _weakeningEndFraction;
+} // weakeningEndFraction
+
+// Instantiate the slip-weakening law for this friction coefficient.
+template class contrib::friction::SlipWeakeningLaw<contrib::friction::ExponentialCohesiveZoneCurve>;
 
 
 // End of file 
@@ -32,187 +32,224 @@
 #define pylith_friction_ExponentialCohesiveZoneNoHeal_hh
 
 // Include directives ---------------------------------------------------
-#include "pylith/friction/FrictionModel.hh" // ISA FrictionModel
+#include "SlipWeakeningLaw.hh" // ISA SlipWeakeningLaw
+
+#include "pylith/materials/Metadata.hh" // HASA ParamDescription
+
+#include "SIMDMath.hh" // USES simd::VecD
 
 // Forward declarations
 namespace contrib {
   namespace friction {
+    class ExponentialCohesiveZoneCurve;
     class ExponentialCohesiveZoneNoHeal;
   } // friction
 } // pylith
 
-// ExponentialCohesiveZoneNoHeal -------------------------------------------------------
-class contrib::friction::ExponentialCohesiveZoneNoHeal : public pylith::friction::FrictionModel
-{ // class ExponentialCohesiveZoneNoHeal
-  friend class TestExponentialCohesiveZoneNoHeal; // unit testing
+// ExponentialCohesiveZoneCurve --------------------------------------
+/// Friction coefficient for ExponentialCohesiveZoneNoHeal (see SlipWeakeningLaw).
+class contrib::friction::ExponentialCohesiveZoneCurve
+{ // class ExponentialCohesiveZoneCurve
+
+  // PUBLIC MEMBERS /////////////////////////////////////////////////////
+public :
 
   // --------------------------------------------------------------------
-  // All of these functions are required to satisfy the PyLith
-  // interface for a fault constitutive model.
+  // We use these constants for consistent access into the arrays of
+  // physical properties.
   // --------------------------------------------------------------------
 
-  // PUBLIC METHODS /////////////////////////////////////////////////////
-public :
+  static const int p_coefS = 0;
+  static const int p_coefD = p_coefS + 1;
+  static const int p_slShift = p_coefD + 1;
+  static const int p_slStretch = p_slShift + 1;
+  static const int p_cohesion = p_slStretch + 1;
+  static const int p_invStretch = p_cohesion + 1;
+  static const int numProperties = p_invStretch + 1;
 
-  /// Default constructor.
-  ExponentialCohesiveZoneNoHeal(void);
+  /// Indices of values in spatial database (order must match dbProperties).
+  static const int db_coefS = 0;
+  static const int db_coefD = db_coefS + 1;
+  static const int db_slShift = db_coefD + 1;
+  static const int db_slStretch = db_slShift + 1;
+  static const int db_cohesion = db_slStretch + 1;
+  static const int numDBProperties = db_cohesion + 1;
 
-  /// Destructor.
-  ~ExponentialCohesiveZoneNoHeal(void);
+  static const bool vectorized = true;
+  static const int coefficientFlopsSIMD = 12 + simd::expFlops;
+  static const int residualCoefficientFlops = 0;
+
+  /// Sign of derivCoef from coefficient() relative to -d(mu)/d(slip).
+  static const int derivCoefSign = -1;
 
-  // PROTECTED METHODS //////////////////////////////////////////////////
-protected :
+  static const pylith::materials::Metadata::ParamDescription properties[numProperties];
+  static const char* dbProperties[numDBProperties];
 
-  /// These methods should be implemented by every constitutive model.
+  /// Rules for properties (see ContribFrictionModel::validateProperties()).
+  static const int numPropertyRules = 6;
+  static const ContribFrictionModel::PropertyRule propertyRules[numPropertyRules];
+
+  /// Dimensions of properties (see ContribFrictionModel::Dimension).
+  static const ContribFrictionModel::Dimension propertyDimensions[numProperties];
+
+  // PUBLIC METHODS /////////////////////////////////////////////////////
+public :
 
   /** Compute properties from values in spatial database.
    *
    * @param propValues Array of property values.
    * @param dbValues Array of database values.
    */
-  void _dbToProperties(PylithScalar* const propValues,
-		       const pylith::scalar_array& dbValues) const;
+  static
+  void dbToProperties(PylithScalar* const propValues,
+		      const pylith::scalar_array& dbValues);
 
-  /** Nondimensionalize properties.
+  /** Compute friction coefficient at a location.
    *
-   * @param values Array of property values.
-   * @param nvalues Number of values.
+   * @param slipCum Cumulative slip at location.
+   * @param properties Properties at location.
+   * @param derivCoef Derivative of friction coefficient with slip
+   *   (output).
+   *
+   * @returns Friction coefficient at location.
    */
-  void _nondimProperties(PylithScalar* const values,
-			 const int nvalues) const;
+  static
+  PylithScalar coefficient(const PylithScalar slipCum,
+			   const PylithScalar* properties,
+			   PylithScalar* const derivCoef);
 
-  /** Dimensionalize properties.
+  /** Get index of weakening segment at a location.
    *
-   * @param values Array of property values.
-   * @param nvalues Number of values.
+   * @param slipCum Cumulative slip at location.
+   * @param properties Properties at location.
+   *
+   * @returns 0 (one weakening segment).
    */
-  void _dimProperties(PylithScalar* const values,
-		      const int nvalues) const;
+  static
+  int segment(const PylithScalar slipCum,
+	      const PylithScalar* properties);
 
-  /** Compute friction from properties and state variables.
+  /** Check whether the friction coefficient no longer changes with
+   * slip at a location.
    *
-   * @param slip Current slip at location.
-   * @param slipRate Current slip rate at location.
-   * @param normalTraction Normal traction at location.
+   * @param slipCum Cumulative slip at location.
    * @param properties Properties at location.
-   * @param numProperties Number of properties.
-   * @param stateVars State variables at location.
-   * @param numStateVars Number of state variables.
+   *
+   * @returns True if the friction coefficient is constant for all
+   * cumulative slip greater than or equal to slipCum.
    */
-  void _dbToStateVars(PylithScalar* const stateValues,
-		      const pylith::scalar_array& dbValues) const;
+  static
+  bool fullyWeakened(const PylithScalar slipCum,
+		     const PylithScalar* properties);
 
-  /** Nondimensionalize state variables.
+  /** Check whether a location has reached the end of weakening.
    *
-   * @param values Array of initial state values.
-   * @param nvalues Number of values.
-   */
-  void _nondimStateVars(PylithScalar* const values,
-			const int nvalues) const;
-  
-  /** Dimensionalize state variables.
+   * @param slipCum Cumulative slip at location.
+   * @param properties Properties at location.
+   * @param fraction Fraction of the strength drop that ends weakening
+   *   (only used by curves without a finite end).
    *
-   * @param values Array of initial state values.
-   * @param nvalues Number of values.
+   * @returns True past the peak once the friction coefficient has
+   * dropped by fraction of (mu_s - mu_d).
    */
-  void _dimStateVars(PylithScalar* const values,
-		     const int nvalues) const;
+  static
+  bool weakeningEnded(const PylithScalar slipCum,
+		      const PylithScalar* properties,
+		      const PylithScalar fraction);
 
-  /** Compute friction from properties and state variables.
+  /** Get number of flops in coefficient() at a location.
    *
-   * @param t Time in simulation.
-   * @param slip Current slip at location.
-   * @param slipRate Current slip rate at location.
-   * @param normalTraction Normal traction at location.
+   * @param slipCum Cumulative slip at location.
    * @param properties Properties at location.
-   * @param numProperties Number of properties.
-   * @param stateVars State variables at location.
-   * @param numStateVars Number of state variables.
+   *
+   * @returns Number of flops for the branch taken at location.
    */
-  PylithScalar _calcFriction(const PylithScalar t,
-			     const PylithScalar slip,
-			     const PylithScalar slipRate,
-			     const PylithScalar normalTraction,
-			     const PylithScalar* properties,
-			     const int numProperties,
-			     const PylithScalar* stateVars,
-			     const int numStateVars);
-
-  /** Compute derivative friction with slip from properties and state
-   * variables.
-   *
-   * @param t Time in simulation.
-   * @param slip Current slip at location.
-   * @param slipRate Current slip rate at location.
-   * @param normalTraction Normal traction at location.
+  static
+  int coefficientFlops(const PylithScalar slipCum,
+		       const PylithScalar* properties);
+
+  /** Get slip from a location to the next breakpoint (kink) of the
+   * friction coefficient.
+   *
+   * @param slipCum Cumulative slip at location.
    * @param properties Properties at location.
-   * @param numProperties Number of properties.
-   * @param stateVars State variables at location.
-   * @param numStateVars Number of state variables.
    *
-   * @returns Derivative of friction (magnitude of shear traction) at vertex.
+   * @returns PYLITH_MAXSCALAR (the curve is smooth).
    */
-  PylithScalar _calcFrictionDeriv(const PylithScalar t,
-				  const PylithScalar slip,
-				  const PylithScalar slipRate,
-				  const PylithScalar normalTraction,
-				  const PylithScalar* properties,
-				  const int numProperties,
-				  const PylithScalar* stateVars,
-				  const int numStateVars);
-  
-  // --------------------------------------------------------------------
-  // Optional function in the PyLith interface for a fault
-  // constitutive model. Even though this function is optional, for it
-  // to be used it the interface must exactly matched the one
-  // specified in FrictionModel.
-  // --------------------------------------------------------------------
+  static
+  PylithScalar slipToBreakpoint(const PylithScalar slipCum,
+				const PylithScalar* properties);
 
-  /** Update state variables (for next time step).
+  /** Get friction coefficient at a location once fully weakened.
    *
-   * @param t Time in simulation.
-   * @param slip Current slip at location.
-   * @param slipRate Current slip rate at location.
-   * @param normalTraction Normal traction at location.
-   * @param stateVars State variables at location.
-   * @param numStateVars Number of state variables.
    * @param properties Properties at location.
-   * @param numProperties Number of properties.
+   *
+   * @returns Dynamic coefficient (approached as slip grows).
    */
-  void _updateStateVars(const PylithScalar t,
-			const PylithScalar slip,
-			const PylithScalar slipRate,
-			const PylithScalar normalTraction,
-			PylithScalar* const stateVars,
-			const int numStateVars,
-			const PylithScalar* properties,
-			const int numProperties);
-
-  // PRIVATE MEMBERS ////////////////////////////////////////////////////
+  static
+  PylithScalar residualCoefficient(const PylithScalar* properties);
+
+  /** Compute friction coefficient at a vector of locations.
+   *
+   * @param slipCum Cumulative slip at locations.
+   * @param properties Properties at first location.
+   * @param stride Stride between properties of consecutive locations.
+   * @param derivCoef Derivative of friction coefficient with slip
+   *   (output).
+   *
+   * @returns Friction coefficient at locations.
+   */
+  static
+  simd::VecD coefficientSIMD(const simd::VecD slipCum,
+			     const double* properties,
+			     const int stride,
+			     simd::VecD* const derivCoef);
+
+  // PRIVATE METHODS ////////////////////////////////////////////////////
 private :
 
-  // --------------------------------------------------------------------
-  // We use these constants for consistent access into the arrays of
-  // physical properties and state variables.
-  // --------------------------------------------------------------------
+  /** Compute derived properties from the user-supplied properties.
+   *
+   * The reciprocal of the stretch slip distance is stored so that the
+   * kernels only need multiplications.
+   *
+   * @param values Array of property values.
+   */
+  static
+  void _computeDerivedProperties(PylithScalar* const values);
+
+}; // class ExponentialCohesiveZoneCurve
+
+// ExponentialCohesiveZoneNoHeal -------------------------------------
+class contrib::friction::ExponentialCohesiveZoneNoHeal : public contrib::friction::SlipWeakeningLaw<contrib::friction::ExponentialCohesiveZoneCurve>
+{ // class ExponentialCohesiveZoneNoHeal
+  friend class TestExponentialCohesiveZoneNoHeal; // unit testing
+
+  // PUBLIC METHODS /////////////////////////////////////////////////////
+public :
 
-  static const int p_coefS;
-  static const int p_coefD;
-  static const int p_slShift;
-  static const int p_slStretch;
-  static const int p_cohesion;
-  static const int db_coefS;
-  static const int db_coefD;
-  static const int db_slShift;
-  static const int db_slStretch;
-  static const int db_cohesion;
-
-  /// Indices for state variables in section and spatial database.
-  static const int s_slipCum;
-  static const int s_slipPrev;
-
-  static const int db_slipCum;
-  static const int db_slipPrev;
+  /** Constructor.
+   *
+   * @param diagnostics True to add the diagnostic state variables
+   *   (see SlipWeakeningLaw).
+   */
+  ExponentialCohesiveZoneNoHeal(const bool diagnostics=false);
+
+  /// Destructor.
+  ~ExponentialCohesiveZoneNoHeal(void);
+
+  /** Set fraction of the strength drop, (mu_s - mu_d), that ends
+   * weakening for the weakening_end_time state variable.
+   *
+   * @param value Fraction (0 < value < 1).
+   */
+  void weakeningEndFraction(const PylithScalar value);
+
+  /** Get fraction of the strength drop that ends weakening.
+   *
+   * @returns Fraction.
+   */
+  PylithScalar weakeningEndFraction(void) const;
 
   // NOT IMPLEMENTED ////////////////////////////////////////////////////
 private :
@@ -31,18 +31,34 @@
 namespace contrib {
   namespace friction {
 
-    class ExponentialCohesiveZoneNoHeal : public pylith::friction::FrictionModel
+    class ExponentialCohesiveZoneNoHeal : public contrib::friction::ContribFrictionModel
     { // class ExponentialCohesiveZoneNoHeal
 
       // PUBLIC METHODS /////////////////////////////////////////////////
     public :
 
-      /// Default constructor.
-      ExponentialCohesiveZoneNoHeal(void);
+      /** Constructor.
+       *
+       * @param diagnostics True to add the diagnostic state variables.
+       */
+      ExponentialCohesiveZoneNoHeal(const bool diagnostics=false);
 
       /// Destructor.
       ~ExponentialCohesiveZoneNoHeal(void);
 
+      /** Set fraction of the strength drop, (mu_s - mu_d), that ends
+       * weakening for the weakening_end_time state variable.
+       *
+       * @param value Fraction (0 < value < 1).
+       */
+      void weakeningEndFraction(const PylithScalar value);
+
+      /** Get fraction of the strength drop that ends weakening.
+       *
+       * @returns Fraction.
+       */
+      PylithScalar weakeningEndFraction(void) const;
+
       // PROTECTED METHODS //////////////////////////////////////////////
     protected :
 
@@ -51,8 +67,8 @@ namespace contrib {
        * @param propValues Array of property values.
        * @param dbValues Array of database values.
        */
-      void _dbToProperties(PylithScalar* const propValues,
-			   const scalar_array& dbValues) const;
+      void _dbValuesToProperties(PylithScalar* const propValues,
+				 const scalar_array& dbValues) const;
 
       /** Nondimensionalize properties.
        *
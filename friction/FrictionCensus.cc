@@ -0,0 +1,152 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+#include <portinfo> // machine specific info generated by configure
+
+#include "FrictionCensus.hh" // implementation of object methods
+
+#include <cassert> // USES assert()
+#include <fstream> // USES std::ofstream
+#include <sstream> // USES std::ostringstream
+#include <stdexcept> // USES std::runtime_error
+
+// ----------------------------------------------------------------------
+// Constructor.
+contrib::friction::FrictionCensus::FrictionCensus(const int numRegimes) :
+  _counts(numRegimes, 0),
+  _countsBefore(numRegimes, 0),
+  _tangentChanges(0),
+  _time(0.0),
+  _timeScale(1.0),
+  _started(false),
+  _file(0)
+{ // constructor
+  assert(numRegimes > 0);
+} // constructor
+
+// ----------------------------------------------------------------------
+// Destructor.
+contrib::friction::FrictionCensus::~FrictionCensus(void)
+{ // destructor
+  close();
+} // destructor
+
+// ----------------------------------------------------------------------
+// Create census file and start a new census.
+void
+contrib::friction::FrictionCensus::open(const char* filename,
+					const char* label,
+					const char* const* regimeNames)
+{ // open
+  assert(filename);
+  assert(label);
+  assert(regimeNames);
+
+  close();
+
+  _file = new std::ofstream(filename);
+  if (!_file->is_open() || !_file->good()) {
+    delete _file; _file = 0;
+    std::ostringstream msg;
+    msg << "Could not create census file '" << filename
+	<< "' for friction model '" << label << "'.";
+    throw std::runtime_error(msg.str());
+  } // if
+  *_file << "# time";
+  for (size_t i=0; i < _counts.size(); ++i)
+    *_file << " " << regimeNames[i];
+  *_file << "\n";
+  _file->precision(16);
+} // open
+
+// ----------------------------------------------------------------------
+// Write the counts of the current state update and close the census
+// file.
+void
+contrib::friction::FrictionCensus::close(void)
+{ // close
+  if (_file) {
+    if (_started)
+      _write();
+    delete _file; _file = 0;
+  } // if
+  _started = false;
+} // close
+
+// ----------------------------------------------------------------------
+// Set scale of time.
+void
+contrib::friction::FrictionCensus::timeScale(const PylithScalar value)
+{ // timeScale
+  assert(value > 0.0);
+  _timeScale = value;
+} // timeScale
+
+// ----------------------------------------------------------------------
+// Count batch of vertices at the state update at time t.
+void
+contrib::friction::FrictionCensus::countBatch(const PylithScalar t,
+					      const int* counts,
+					      const int numTangentChanges)
+{ // countBatch
+  assert(counts);
+  assert(numTangentChanges >= 0);
+
+  if (!_started || t != _time)
+    _step(t);
+  const int numRegimes = _counts.size();
+  for (int i=0; i < numRegimes; ++i)
+    _counts[i] += counts[i];
+  _tangentChanges += numTangentChanges;
+} // countBatch
+
+// ----------------------------------------------------------------------
+// Start the state update at time t.
+void
+contrib::friction::FrictionCensus::_step(const PylithScalar t)
+{ // _step
+  if (_started && _file)
+    _write();
+
+  const int numRegimes = _counts.size();
+  for (int i=0; i < numRegimes; ++i) {
+    _countsBefore[i] = _started ? _counts[i] : 0;
+    _counts[i] = 0;
+  } // for
+  _tangentChanges = 0;
+  _time = t;
+  _started = true;
+} // _step
+
+// ----------------------------------------------------------------------
+// Write counts of the current state update to the census file.
+void
+contrib::friction::FrictionCensus::_write(void)
+{ // _write
+  assert(_file);
+  assert(_started);
+
+  *_file << _time * _timeScale;
+  const int numRegimes = _counts.size();
+  for (int i=0; i < numRegimes; ++i)
+    *_file << " " << _counts[i];
+  *_file << "\n";
+} // _write
+
+
+// End of file
@@ -0,0 +1,178 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+/** @file FrictionCensus.hh
+ *
+ * @brief Number of fault vertices in each regime of a fault
+ * constitutive model at its state updates.
+ *
+ * The counts of a state update are kept until the next update (the
+ * first vertex counted at a different time), and each finished update
+ * appends a line with the time and counts to the census file, if one
+ * is open.
+ */
+
+#if !defined(pylith_friction_FrictionCensus_hh)
+#define pylith_friction_FrictionCensus_hh
+
+// Include directives ---------------------------------------------------
+#include "pylith/utils/types.hh" // USES PylithScalar
+
+#include <iosfwd> // HOLDSA std::ofstream
+#include <vector> // HASA std::vector
+
+// Forward declarations
+namespace contrib {
+  namespace friction {
+    class FrictionCensus;
+  } // friction
+} // pylith
+
+// FrictionCensus -------------------------------------------------------
+/// Count fault vertices in each regime at the state updates.
+class contrib::friction::FrictionCensus
+{ // class FrictionCensus
+
+  // PUBLIC METHODS /////////////////////////////////////////////////////
+public :
+
+  /** Constructor.
+   *
+   * @param numRegimes Number of regimes.
+   */
+  FrictionCensus(const int numRegimes);
+
+  /// Destructor.
+  ~FrictionCensus(void);
+
+  /** Create census file and start a new census.
+   *
+   * @param filename Name of file.
+   * @param label Label of fault constitutive model.
+   * @param regimeNames Names of regimes in header [numRegimes].
+   */
+  void open(const char* filename,
+	    const char* label,
+	    const char* const* regimeNames);
+
+  /** Write the counts of the current state update, if any, and close
+   * the census file. The next update starts a new census.
+   */
+  void close(void);
+
+  /** Set scale of time, so the file holds dimensioned times.
+   *
+   * @param value Scale of time.
+   */
+  void timeScale(const PylithScalar value);
+
+  /** Check whether a state update has been counted.
+   *
+   * @returns True if a state update has been counted.
+   */
+  bool started(void) const;
+
+  /** Get time of the last state update counted.
+   *
+   * @returns Time (nondimensional).
+   */
+  PylithScalar time(void) const;
+
+  /** Get number of vertices in a regime at the last state update.
+   *
+   * @param regime Regime.
+   * @returns Number of vertices.
+   */
+  int count(const int regime) const;
+
+  /** Get number of vertices in a regime at the state update before
+   * the one at time t.
+   *
+   * @param t Time of state update.
+   * @param regime Regime.
+   * @returns Number of vertices (0 before the first update).
+   */
+  int countBefore(const PylithScalar t,
+		  const int regime) const;
+
+  /** Get number of vertices whose derivative of friction with slip
+   * changed at the last state update.
+   *
+   * @returns Number of vertices.
+   */
+  int tangentChanges(void) const;
+
+  /** Count vertex at the state update at time t.
+   *
+   * @param t Time of state update.
+   * @param regime Regime of vertex.
+   * @param tangentChanged True if the derivative of friction with
+   *   slip at the vertex changed in the update.
+   */
+  void countVertex(const PylithScalar t,
+		   const int regime,
+		   const bool tangentChanged);
+
+  /** Count batch of vertices at the state update at time t.
+   *
+   * @param t Time of state update.
+   * @param counts Number of vertices in each regime [numRegimes].
+   * @param numTangentChanges Number of vertices whose derivative of
+   *   friction with slip changed in the update.
+   */
+  void countBatch(const PylithScalar t,
+		  const int* counts,
+		  const int numTangentChanges);
+
+  // PRIVATE METHODS ////////////////////////////////////////////////////
+private :
+
+  /** Start the state update at time t.
+   *
+   * @param t Time of state update.
+   */
+  void _step(const PylithScalar t);
+
+  /// Write counts of the current state update to the census file.
+  void _write(void);
+
+  // PRIVATE MEMBERS ////////////////////////////////////////////////////
+private :
+
+  std::vector<int> _counts; ///< Number of vertices in each regime.
+  std::vector<int> _countsBefore; ///< Number of vertices in each regime at the previous update.
+  int _tangentChanges; ///< Number of vertices whose derivative changed.
+  PylithScalar _time; ///< Time of state update.
+  PylithScalar _timeScale; ///< Scale of time in file.
+  bool _started; ///< True if a state update has been counted.
+  std::ofstream* _file; ///< Census file (0 if none).
+
+  // NOT IMPLEMENTED ////////////////////////////////////////////////////
+private :
+
+  FrictionCensus(const FrictionCensus&); ///< Not implemented.
+  const FrictionCensus& operator=(const FrictionCensus&); ///< Not implemented
+
+}; // class FrictionCensus
+
+#include "FrictionCensus.icc" // inline methods
+
+#endif // pylith_friction_FrictionCensus_hh
+
+
+// End of file
@@ -0,0 +1,839 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+#include <portinfo> // machine specific info generated by configure
+
+#include "FrictionDB.hh" // implementation of object methods
+
+#include "spatialdata/geocoords/CSCart.hh" // USES CSCart
+
+#include <algorithm> // USES std::min(), std::max()
+#include <cassert> // USES assert()
+#include <cctype> // USES isspace()
+#include <cmath> // USES ceil(), floor(), pow()
+#include <cstdio> // USES FILE, fopen(), fwrite()
+#include <cstdlib> // USES abs(), strtod(), strtol()
+#include <cstring> // USES memcmp(), memcpy()
+#include <fstream> // USES std::ifstream
+#include <sstream> // USES std::ostringstream
+#include <stdexcept> // USES std::runtime_error
+
+#include <fcntl.h> // USES open()
+#include <sys/mman.h> // USES mmap(), munmap(), posix_madvise()
+#include <sys/stat.h> // USES fstat()
+#include <unistd.h> // USES close()
+
+// ----------------------------------------------------------------------
+namespace contrib {
+  namespace friction {
+    namespace _FrictionDB {
+
+      // Header of database file.
+      const char magic[8] = { 'F', 'R', 'I', 'C', 'T', 'D', 'B', '\0' };
+      const int version = 1;
+      const int byteOrder = 0x01020304;
+      const int numHeaderInts = 10;
+      const int numHeaderDoubles = 6;
+
+      // Sections start on page boundaries.
+      const size_t pageSize = 4096;
+
+      // Average number of points in a cell of the grid.
+      const int pointsPerBin = 4;
+
+      /** Round offset up to page boundary.
+       *
+       * @param offset Offset in bytes.
+       * @returns Offset of next page boundary.
+       */
+      size_t
+      pageAlign(const size_t offset)
+      { // pageAlign
+	return (offset + pageSize - 1) / pageSize * pageSize;
+      } // pageAlign
+
+      /** Get index of cell holding coordinate.
+       *
+       * @param x Coordinate.
+       * @param lower Lower bound of grid.
+       * @param binSize Size of cells.
+       * @param numBins Number of cells.
+       * @returns Index of cell (nearest cell for coordinates outside grid).
+       */
+      int
+      binIndex(const double x,
+	       const double lower,
+	       const double binSize,
+	       const int numBins)
+      { // binIndex
+	const double index = floor((x - lower) / binSize);
+	return (index <= 0.0) ? 0 : (index >= numBins-1) ? numBins-1 : int(index);
+      } // binIndex
+
+      /** Get next token of SimpleDB ASCII file, skipping comments.
+       *
+       * @param in Input stream.
+       * @param token Token (output).
+       * @returns True if a token was read, false at the end of the file.
+       */
+      bool
+      nextToken(std::istream& in,
+		std::string* token)
+      { // nextToken
+	assert(token);
+
+	token->clear();
+	int c = 0;
+	while (EOF != (c = in.get())) {
+	  if (isspace(c)) {
+	    if (!token->empty())
+	      return true;
+	  } else if ('/' == c && '/' == in.peek()) {
+	    std::string comment;
+	    std::getline(in, comment);
+	    if (!token->empty())
+	      return true;
+	  } else if ('{' == c || '}' == c || '=' == c) {
+	    if (token->empty())
+	      *token = char(c);
+	    else
+	      in.putback(char(c));
+	    return true;
+	  } else
+	    *token += char(c);
+	} // while
+	return !token->empty();
+      } // nextToken
+
+      /// Reader of tokens of SimpleDB ASCII file.
+      class Reader {
+      public :
+	/** Constructor.
+	 *
+	 * @param in Input stream.
+	 * @param filename Name of file.
+	 */
+	Reader(std::istream& in,
+	       const char* filename) :
+	  _in(in),
+	  _filename(filename)
+	{}
+
+	/** Throw error at current position of file.
+	 *
+	 * @param what Description of error.
+	 */
+	void error(const std::string& what) const {
+	  std::ostringstream msg;
+	  msg << "Error reading SimpleDB file '" << _filename << "': " << what;
+	  throw std::runtime_error(msg.str());
+	} // error
+
+	/** Get next token.
+	 *
+	 * @param what Description of token for error.
+	 * @returns Token.
+	 */
+	std::string token(const char* what) {
+	  std::string value;
+	  if (!nextToken(_in, &value))
+	    error(std::string("Unexpected end of file reading ") + what + ".");
+	  return value;
+	} // token
+
+	/** Check that next token is expected token.
+	 *
+	 * @param expected Expected token.
+	 */
+	void expect(const char* expected) {
+	  const std::string value = token(expected);
+	  if (value != expected)
+	    error("Expected '" + std::string(expected) + "' but found '" + value + "'.");
+	} // expect
+
+	/** Get next token as integer.
+	 *
+	 * @param what Description of value for error.
+	 * @returns Value.
+	 */
+	int integer(const char* what) {
+	  const std::string value = token(what);
+	  char* end = 0;
+	  const long i = strtol(value.c_str(), &end, 10);
+	  if (*end)
+	    error("Could not parse " + std::string(what) + " from '" + value + "'.");
+	  return int(i);
+	} // integer
+
+	/** Get next token as floating point value.
+	 *
+	 * @param what Description of value for error.
+	 * @returns Value.
+	 */
+	double real(const char* what) {
+	  const std::string value = token(what);
+	  char* end = 0;
+	  const double x = strtod(value.c_str(), &end);
+	  if (*end)
+	    error("Could not parse " + std::string(what) + " from '" + value + "'.");
+	  return x;
+	} // real
+
+      private :
+	std::istream& _in; ///< Input stream.
+	const char* _filename; ///< Name of file.
+      }; // Reader
+
+      /** Get factor to convert value to SI units.
+       *
+       * @param units Units of value.
+       * @param reader Reader for error message.
+       * @returns Factor.
+       */
+      double
+      unitScale(const std::string& units,
+		const Reader& reader)
+      { // unitScale
+	const double year = 365.25*24.0*3600.0;
+	const char* names[] = {
+	  "none", "m", "cm", "mm", "km", "m/s", "s", "year",
+	  "Pa", "kPa", "MPa", "GPa", "bar",
+	};
+	const double scales[] = {
+	  1.0, 1.0, 1.0e-2, 1.0e-3, 1.0e+3, 1.0, 1.0, year,
+	  1.0, 1.0e+3, 1.0e+6, 1.0e+9, 1.0e+5,
+	};
+	const int numUnits = sizeof(scales) / sizeof(scales[0]);
+	for (int i=0; i < numUnits; ++i)
+	  if (units == names[i])
+	    return scales[i];
+	reader.error("Unknown units '" + units + "'. Use one of none, m, cm, mm, km, "
+		     "m/s, s, year, Pa, kPa, MPa, GPa, or bar.");
+	return 1.0;
+      } // unitScale
+
+      /** Write values to file.
+       *
+       * @param file File.
+       * @param values Values.
+       * @param size Number of bytes.
+       * @param filename Name of file.
+       */
+      void
+      write(FILE* file,
+	    const void* values,
+	    const size_t size,
+	    const char* filename)
+      { // write
+	if (size > 0 && 1 != fwrite(values, size, 1, file)) {
+	  fclose(file);
+	  std::ostringstream msg;
+	  msg << "Error writing spatial database file '" << filename << "'.";
+	  throw std::runtime_error(msg.str());
+	} // if
+      } // write
+
+      /** Write zeros to file up to offset.
+       *
+       * @param file File.
+       * @param offset Offset of end of padding.
+       * @param filename Name of file.
+       */
+      void
+      pad(FILE* file,
+	  const size_t offset,
+	  const char* filename)
+      { // pad
+	const long position = ftell(file);
+	assert(position >= 0 && size_t(position) <= offset);
+	const std::vector<char> zeros(offset - position + 1, '\0');
+	write(file, &zeros[0], offset - position, filename);
+      } // pad
+
+    } // _FrictionDB
+  } // friction
+} // contrib
+
+// ----------------------------------------------------------------------
+// Default constructor.
+contrib::friction::FrictionDB::FrictionDB(void) :
+  _filename(""),
+  _data(0),
+  _size(0),
+  _binStart(0),
+  _points(0),
+  _spaceDim(0),
+  _numValues(0),
+  _numLocs(0)
+{ // constructor
+} // constructor
+
+// ----------------------------------------------------------------------
+// Constructor with label.
+contrib::friction::FrictionDB::FrictionDB(const char* label) :
+  spatialdata::spatialdb::SpatialDB(label),
+  _filename(""),
+  _data(0),
+  _size(0),
+  _binStart(0),
+  _points(0),
+  _spaceDim(0),
+  _numValues(0),
+  _numLocs(0)
+{ // constructor
+} // constructor
+
+// ----------------------------------------------------------------------
+// Destructor.
+contrib::friction::FrictionDB::~FrictionDB(void)
+{ // destructor
+  close();
+} // destructor
+
+// ----------------------------------------------------------------------
+// Convert SimpleDB ASCII file to binary database.
+void
+contrib::friction::FrictionDB::convert(const char* simpleDBFilename,
+				       const char* filename,
+				       const char* queryType)
+{ // convert
+  assert(simpleDBFilename);
+  assert(filename);
+  assert(queryType);
+
+  if (std::string("nearest") != queryType) {
+    std::ostringstream msg;
+    msg << "Could not convert SimpleDB file '" << simpleDBFilename << "' with query type '"
+	<< queryType << "'. FrictionDB only returns the values at the nearest point "
+	<< "(query type 'nearest') and does not interpolate.";
+    throw std::runtime_error(msg.str());
+  } // if
+
+  std::ifstream fin(simpleDBFilename);
+  if (!fin.is_open() || !fin.good()) {
+    std::ostringstream msg;
+    msg << "Could not open SimpleDB file '" << simpleDBFilename << "'.";
+    throw std::runtime_error(msg.str());
+  } // if
+  _FrictionDB::Reader reader(fin, simpleDBFilename);
+
+  if (reader.token("magic") != "#SPATIAL.ascii" || reader.integer("version") != 1)
+    reader.error("Not a SimpleDB ASCII file (version 1).");
+
+  // Header.
+  int numValues = 0;
+  int numLocs = 0;
+  int spaceDim = 0;
+  double toMeters = 1.0;
+  std::vector<std::string> names;
+  std::vector<double> scales;
+  reader.expect("SimpleDB");
+  reader.expect("{");
+  for (std::string key=reader.token("header"); key != "}"; key=reader.token("header")) {
+    reader.expect("=");
+    if (key == "num-values")
+      numValues = reader.integer("num-values");
+    else if (key == "value-names" || key == "value-units") {
+      if (numValues <= 0)
+	reader.error("num-values must be given before " + key + ".");
+      for (int i=0; i < numValues; ++i)
+	if (key == "value-names")
+	  names.push_back(reader.token("value-names"));
+	else
+	  scales.push_back(_FrictionDB::unitScale(reader.token("value-units"), reader));
+    } else if (key == "num-locs")
+      numLocs = reader.integer("num-locs");
+    else if (key == "data-dim")
+      reader.integer("data-dim");
+    else if (key == "space-dim")
+      spaceDim = reader.integer("space-dim");
+    else if (key == "cs-data") {
+      const std::string csType = reader.token("cs-data");
+      if (csType != "cartesian")
+	reader.error("Only Cartesian coordinate systems are supported, not '" + csType + "'.");
+      reader.expect("{");
+      for (std::string csKey=reader.token("cs-data"); csKey != "}"; csKey=reader.token("cs-data")) {
+	reader.expect("=");
+	if (csKey == "to-meters")
+	  toMeters = reader.real("to-meters");
+	else if (csKey == "space-dim")
+	  spaceDim = reader.integer("space-dim");
+	else
+	  reader.error("Unknown cs-data setting '" + csKey + "'.");
+      } // for
+    } else
+      reader.error("Unknown setting '" + key + "'.");
+  } // for
+  if (numValues <= 0 || numLocs <= 0 || spaceDim < 1 || spaceDim > 3 || toMeters <= 0.0 ||
+      int(names.size()) != numValues || int(scales.size()) != numValues)
+    reader.error("Header must give num-values > 0, value-names, value-units, "
+		 "num-locs > 0, space-dim in [1,3], and to-meters > 0.");
+
+  // Points, converted to meters and SI units.
+  const int pointSize = spaceDim + numValues;
+  std::vector<double> points(size_t(numLocs)*pointSize);
+  double lower[3] = { 0.0, 0.0, 0.0 };
+  double upper[3] = { 0.0, 0.0, 0.0 };
+  for (int iLoc=0, index=0; iLoc < numLocs; ++iLoc) {
+    for (int iDim=0; iDim < spaceDim; ++iDim, ++index) {
+      const double x = toMeters * reader.real("coordinates");
+      points[index] = x;
+      lower[iDim] = (0 == iLoc) ? x : std::min(lower[iDim], x);
+      upper[iDim] = (0 == iLoc) ? x : std::max(upper[iDim], x);
+    } // for
+    for (int iVal=0; iVal < numValues; ++iVal, ++index)
+      points[index] = scales[iVal] * reader.real("values");
+  } // for
+  std::string extra;
+  if (_FrictionDB::nextToken(fin, &extra))
+    reader.error("More points than num-locs.");
+
+  // Cells of about pointsPerBin points. Directions in which the
+  // points barely extend get one cell.
+  double maxExtent = 0.0;
+  for (int iDim=0; iDim < spaceDim; ++iDim)
+    maxExtent = std::max(maxExtent, upper[iDim] - lower[iDim]);
+  double volume = 1.0;
+  int numExtended = 0;
+  for (int iDim=0; iDim < spaceDim; ++iDim) {
+    const double extent = upper[iDim] - lower[iDim];
+    if (extent > 1.0e-6*maxExtent) {
+      volume *= extent;
+      ++numExtended;
+    } // if
+  } // for
+  const int numBinsTarget = std::max(1, numLocs / _FrictionDB::pointsPerBin);
+  double binSize[3] = { 1.0, 1.0, 1.0 };
+  int numBins[3] = { 1, 1, 1 };
+  if (numExtended > 0) {
+    double cellSize = pow(volume / numBinsTarget, 1.0/numExtended);
+    double numBinsTotal = 0.0;
+    do {
+      numBinsTotal = 1.0;
+      for (int iDim=0; iDim < spaceDim; ++iDim) {
+	const double extent = upper[iDim] - lower[iDim];
+	if (extent > 1.0e-6*maxExtent) {
+	  numBins[iDim] = int(std::min(double(numLocs), std::max(1.0, ceil(extent / cellSize))));
+	  binSize[iDim] = extent / numBins[iDim];
+	} // if
+	numBinsTotal *= numBins[iDim];
+      } // for
+      cellSize *= 1.5;
+    } while (numBinsTotal > 4.0*numBinsTarget);
+  } // if
+  const int numBinsTotal = numBins[0]*numBins[1]*numBins[2];
+
+  // Sort points by cell.
+  std::vector<int> pointBin(numLocs);
+  std::vector<int> binStart(numBinsTotal+1, 0);
+  for (int iLoc=0; iLoc < numLocs; ++iLoc) {
+    int bin = 0;
+    for (int iDim=spaceDim-1; iDim >= 0; --iDim)
+      bin = bin*numBins[iDim] + _FrictionDB::binIndex(points[iLoc*pointSize+iDim], lower[iDim],
+						     binSize[iDim], numBins[iDim]);
+    pointBin[iLoc] = bin;
+    ++binStart[bin+1];
+  } // for
+  for (int iBin=0; iBin < numBinsTotal; ++iBin)
+    binStart[iBin+1] += binStart[iBin];
+  std::vector<int> next(binStart.begin(), binStart.end()-1);
+  std::vector<double> pointsSorted(points.size());
+  for (int iLoc=0; iLoc < numLocs; ++iLoc)
+    memcpy(&pointsSorted[size_t(next[pointBin[iLoc]]++)*pointSize],
+	   &points[size_t(iLoc)*pointSize], pointSize*sizeof(double));
+
+  // Write file.
+  size_t headerSize = sizeof(_FrictionDB::magic) + _FrictionDB::numHeaderInts*sizeof(int) +
+    _FrictionDB::numHeaderDoubles*sizeof(double);
+  for (int iVal=0; iVal < numValues; ++iVal)
+    headerSize += sizeof(int) + names[iVal].length();
+  const size_t binsOffset = _FrictionDB::pageAlign(headerSize);
+  const size_t pointsOffset = _FrictionDB::pageAlign(binsOffset + binStart.size()*sizeof(int));
+
+  FILE* file = fopen(filename, "wb");
+  if (!file) {
+    std::ostringstream msg;
+    msg << "Could not create spatial database file '" << filename << "'.";
+    throw std::runtime_error(msg.str());
+  } // if
+  const int header[_FrictionDB::numHeaderInts] = {
+    _FrictionDB::version,
+    _FrictionDB::byteOrder,
+    spaceDim,
+    numValues,
+    numLocs,
+    numBins[0], numBins[1], numBins[2],
+    int(binsOffset),
+    int(pointsOffset),
+  };
+  const double grid[_FrictionDB::numHeaderDoubles] = {
+    lower[0], lower[1], lower[2],
+    binSize[0], binSize[1], binSize[2],
+  };
+  _FrictionDB::write(file, _FrictionDB::magic, sizeof(_FrictionDB::magic), filename);
+  _FrictionDB::write(file, header, sizeof(header), filename);
+  _FrictionDB::write(file, grid, sizeof(grid), filename);
+  for (int iVal=0; iVal < numValues; ++iVal) {
+    const int length = names[iVal].length();
+    _FrictionDB::write(file, &length, sizeof(length), filename);
+    _FrictionDB::write(file, names[iVal].c_str(), length, filename);
+  } // for
+  _FrictionDB::pad(file, binsOffset, filename);
+  _FrictionDB::write(file, &binStart[0], binStart.size()*sizeof(int), filename);
+  _FrictionDB::pad(file, pointsOffset, filename);
+  _FrictionDB::write(file, &pointsSorted[0], pointsSorted.size()*sizeof(double), filename);
+  if (0 != fclose(file)) {
+    std::ostringstream msg;
+    msg << "Error writing spatial database file '" << filename << "'.";
+    throw std::runtime_error(msg.str());
+  } // if
+} // convert
+
+// ----------------------------------------------------------------------
+// Set name of database file.
+void
+contrib::friction::FrictionDB::filename(const char* value)
+{ // filename
+  assert(value);
+  _filename = value;
+} // filename
+
+// ----------------------------------------------------------------------
+// Get name of database file.
+const char*
+contrib::friction::FrictionDB::filename(void) const
+{ // filename
+  return _filename.c_str();
+} // filename
+
+// ----------------------------------------------------------------------
+// Map the database file into memory and check its header.
+void
+contrib::friction::FrictionDB::open(void)
+{ // open
+  close();
+
+  const int fd = ::open(_filename.c_str(), O_RDONLY);
+  struct stat status;
+  if (fd < 0 || 0 != fstat(fd, &status)) {
+    if (fd >= 0)
+      ::close(fd);
+    std::ostringstream msg;
+    msg << "Could not open file '" << _filename << "' of spatial database '"
+	<< label() << "'.";
+    throw std::runtime_error(msg.str());
+  } // if
+  const size_t size = status.st_size;
+  void* data = (size > 0) ? mmap(0, size, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+  ::close(fd);
+  if (MAP_FAILED == data) {
+    std::ostringstream msg;
+    msg << "File '" << _filename << "' of spatial database '" << label()
+	<< "' is empty or could not be mapped into memory.";
+    throw std::runtime_error(msg.str());
+  } // if
+  // Queries jump between cells; read only the pages touched.
+  posix_madvise(data, size, POSIX_MADV_RANDOM);
+  _data = static_cast<const char*>(data);
+  _size = size;
+
+  // Header.
+  int header[_FrictionDB::numHeaderInts];
+  double grid[_FrictionDB::numHeaderDoubles];
+  size_t offset = sizeof(_FrictionDB::magic) + sizeof(header) + sizeof(grid);
+  if (_size < offset || 0 != memcmp(_data, _FrictionDB::magic, sizeof(_FrictionDB::magic))) {
+    close();
+    std::ostringstream msg;
+    msg << "File '" << _filename << "' of spatial database '" << label()
+	<< "' is not a friction spatial database. Use FrictionDB::convert() "
+	<< "(bench/frictiondb) to convert a SimpleDB file.";
+    throw std::runtime_error(msg.str());
+  } // if
+  memcpy(header, _data + sizeof(_FrictionDB::magic), sizeof(header));
+  memcpy(grid, _data + sizeof(_FrictionDB::magic) + sizeof(header), sizeof(grid));
+  if (header[0] != _FrictionDB::version || header[1] != _FrictionDB::byteOrder) {
+    close();
+    std::ostringstream msg;
+    msg << "Spatial database file '" << _filename << "' was written with a different "
+	<< "version or byte order.\n"
+	<< "Version: " << header[0] << "\n";
+    throw std::runtime_error(msg.str());
+  } // if
+  _spaceDim = header[2];
+  _numValues = header[3];
+  _numLocs = header[4];
+  const size_t binsOffset = header[8];
+  const size_t pointsOffset = header[9];
+  bool corrupt = _spaceDim < 1 || _spaceDim > 3 || _numValues <= 0 || _numLocs <= 0;
+  size_t numBinsTotal = 1;
+  for (int iDim=0; iDim < 3; ++iDim) {
+    _numBins[iDim] = header[5+iDim];
+    _lower[iDim] = grid[iDim];
+    _binSize[iDim] = grid[3+iDim];
+    corrupt = corrupt || _numBins[iDim] < 1 || _numBins[iDim] > _numLocs || !(_binSize[iDim] > 0.0);
+    numBinsTotal *= corrupt ? 1 : _numBins[iDim];
+    corrupt = corrupt || numBinsTotal > _size;
+  } // for
+  for (int iVal=0; !corrupt && iVal < _numValues; ++iVal) {
+    int length = 0;
+    corrupt = offset + sizeof(length) > _size;
+    if (!corrupt) {
+      memcpy(&length, _data + offset, sizeof(length));
+      offset += sizeof(length);
+      corrupt = length < 0 || offset + length > _size;
+    } // if
+    if (!corrupt) {
+      _names.push_back(std::string(_data + offset, length));
+      offset += length;
+    } // if
+  } // for
+  const size_t pointSize = _spaceDim + _numValues;
+  corrupt = corrupt || binsOffset < offset || binsOffset % _FrictionDB::pageSize ||
+    pointsOffset < binsOffset + (numBinsTotal+1)*sizeof(int) || pointsOffset % _FrictionDB::pageSize ||
+    pointsOffset + _numLocs*pointSize*sizeof(double) > _size;
+  if (!corrupt) {
+    _binStart = reinterpret_cast<const int*>(_data + binsOffset);
+    _points = reinterpret_cast<const double*>(_data + pointsOffset);
+    // Cells must hold consecutive ranges of points, so a query never
+    // reads past the points.
+    corrupt = 0 != _binStart[0] || _numLocs != _binStart[numBinsTotal];
+    for (size_t iBin=0; !corrupt && iBin < numBinsTotal; ++iBin)
+      corrupt = _binStart[iBin] > _binStart[iBin+1];
+  } // if
+  if (corrupt) {
+    close();
+    std::ostringstream msg;
+    msg << "Corrupt header in file '" << _filename << "' of spatial database '"
+	<< label() << "'.";
+    throw std::runtime_error(msg.str());
+  } // if
+} // open
+
+// ----------------------------------------------------------------------
+// Unmap the database file.
+void
+contrib::friction::FrictionDB::close(void)
+{ // close
+  if (_data)
+    munmap(const_cast<char*>(_data), _size);
+  _data = 0;
+  _size = 0;
+  _binStart = 0;
+  _points = 0;
+  _spaceDim = 0;
+  _numValues = 0;
+  _numLocs = 0;
+  _names.clear();
+  _queryIndices.clear();
+} // close
+
+// ----------------------------------------------------------------------
+// Get number of spatial dimensions of points in open database.
+int
+contrib::friction::FrictionDB::spaceDim(void) const
+{ // spaceDim
+  return _spaceDim;
+} // spaceDim
+
+// ----------------------------------------------------------------------
+// Get number of points in open database.
+int
+contrib::friction::FrictionDB::numLocs(void) const
+{ // numLocs
+  return _numLocs;
+} // numLocs
+
+// ----------------------------------------------------------------------
+// Get number of values at each point in open database.
+int
+contrib::friction::FrictionDB::numValues(void) const
+{ // numValues
+  return _numValues;
+} // numValues
+
+// ----------------------------------------------------------------------
+// Get name of value in open database.
+const char*
+contrib::friction::FrictionDB::valueName(const int index) const
+{ // valueName
+  assert(index >= 0 && index < _numValues);
+  return _names[index].c_str();
+} // valueName
+
+// ----------------------------------------------------------------------
+// Set values to be returned by queries.
+void
+contrib::friction::FrictionDB::queryVals(const char* const* names,
+					 const int numVals)
+{ // queryVals
+  assert(names || 0 == numVals);
+
+  if (!_data) {
+    std::ostringstream msg;
+    msg << "Spatial database '" << label() << "' must be opened before "
+	<< "setting the values to query.";
+    throw std::runtime_error(msg.str());
+  } // if
+  std::vector<int> indices(numVals);
+  for (int iVal=0; iVal < numVals; ++iVal) {
+    const std::vector<std::string>::const_iterator name =
+      std::find(_names.begin(), _names.end(), std::string(names[iVal]));
+    if (name == _names.end()) {
+      std::ostringstream msg;
+      msg << "Could not find value '" << names[iVal] << "' in spatial database '"
+	  << label() << "'. Available values are:";
+      for (int i=0; i < _numValues; ++i)
+	msg << "\n  " << _names[i];
+      throw std::runtime_error(msg.str());
+    } // if
+    indices[iVal] = name - _names.begin();
+  } // for
+  _queryIndices = indices;
+} // queryVals
+
+// ----------------------------------------------------------------------
+// Query the database for the values at the nearest point.
+int
+contrib::friction::FrictionDB::query(double* vals,
+				     const int numVals,
+				     const double* coords,
+				     const int numDims,
+				     const spatialdata::geocoords::CoordSys* csQuery)
+{ // query
+  assert(vals || 0 == numVals);
+  assert(coords);
+
+  if (!_data || numVals != int(_queryIndices.size()) || numDims != _spaceDim) {
+    std::ostringstream msg;
+    msg << "Query of spatial database '" << label() << "' requires the database "
+	<< "to be open, " << _queryIndices.size() << " values (from queryVals()), and "
+	<< _spaceDim << " coordinates. Query has " << numVals << " values and "
+	<< numDims << " coordinates.";
+    throw std::runtime_error(msg.str());
+  } // if
+  double toMeters = 1.0;
+  if (csQuery) {
+    const spatialdata::geocoords::CSCart* csCart =
+      dynamic_cast<const spatialdata::geocoords::CSCart*>(csQuery);
+    if (!csCart) {
+      std::ostringstream msg;
+      msg << "Spatial database '" << label() << "' can only be queried with "
+	  << "Cartesian coordinates.";
+      throw std::runtime_error(msg.str());
+    } // if
+    toMeters = csCart->toMeters();
+  } // if
+
+  double xyz[3] = { 0.0, 0.0, 0.0 };
+  for (int iDim=0; iDim < numDims; ++iDim)
+    xyz[iDim] = toMeters * coords[iDim];
+  const double* point = _point(_nearest(xyz));
+  for (int iVal=0; iVal < numVals; ++iVal)
+    vals[iVal] = point[_spaceDim + _queryIndices[iVal]];
+
+  return 0;
+} // query
+
+// ----------------------------------------------------------------------
+// Query the database for the values at the nearest point.
+int
+contrib::friction::FrictionDB::query(float* vals,
+				     const int numVals,
+				     const float* coords,
+				     const int numDims,
+				     const spatialdata::geocoords::CoordSys* csQuery)
+{ // query
+  assert(vals || 0 == numVals);
+  assert(coords);
+
+  double coordsD[3] = { 0.0, 0.0, 0.0 };
+  for (int iDim=0; iDim < numDims && iDim < 3; ++iDim)
+    coordsD[iDim] = coords[iDim];
+  std::vector<double> valsD(std::max(numVals, 1));
+  const int err = query(&valsD[0], numVals, coordsD, numDims, csQuery);
+  for (int iVal=0; iVal < numVals; ++iVal)
+    vals[iVal] = valsD[iVal];
+
+  return err;
+} // query
+
+// ----------------------------------------------------------------------
+// Find nearest point.
+int
+contrib::friction::FrictionDB::_nearest(const double xyz[3]) const
+{ // _nearest
+  assert(_data);
+
+  // Search rings of cells around the cell of the point until no
+  // closer point can be in the cells outside the ring.
+  int cell[3];
+  int maxRing = 0;
+  double minBinSize = 0.0;
+  for (int iDim=0; iDim < 3; ++iDim) {
+    cell[iDim] = _FrictionDB::binIndex(xyz[iDim], _lower[iDim], _binSize[iDim], _numBins[iDim]);
+    maxRing = std::max(maxRing, _numBins[iDim]-1);
+    if (_numBins[iDim] > 1)
+      minBinSize = (0.0 == minBinSize) ? _binSize[iDim] : std::min(minBinSize, _binSize[iDim]);
+  } // for
+
+  int nearest = -1;
+  double nearestDist2 = 0.0;
+  for (int ring=0; ring <= maxRing; ++ring) {
+    int lower[3];
+    int upper[3];
+    for (int iDim=0; iDim < 3; ++iDim) {
+      lower[iDim] = std::max(0, cell[iDim]-ring);
+      upper[iDim] = std::min(_numBins[iDim]-1, cell[iDim]+ring);
+    } // for
+    for (int k=lower[2]; k <= upper[2]; ++k)
+      for (int j=lower[1]; j <= upper[1]; ++j)
+	for (int i=lower[0]; i <= upper[0]; ++i) {
+	  if (std::max(abs(i-cell[0]), std::max(abs(j-cell[1]), abs(k-cell[2]))) != ring)
+	    continue;
+	  const int bin = i + _numBins[0]*(j + _numBins[1]*k);
+	  for (int iLoc=_binStart[bin]; iLoc < _binStart[bin+1]; ++iLoc) {
+	    const double* point = _point(iLoc);
+	    double dist2 = 0.0;
+	    for (int iDim=0; iDim < _spaceDim; ++iDim)
+	      dist2 += (point[iDim] - xyz[iDim]) * (point[iDim] - xyz[iDim]);
+	    if (nearest < 0 || dist2 < nearestDist2) {
+	      nearest = iLoc;
+	      nearestDist2 = dist2;
+	    } // if
+	  } // for
+	} // for
+    const double outside = ring*minBinSize;
+    if (nearest >= 0 && nearestDist2 <= outside*outside)
+      break;
+  } // for
+  assert(nearest >= 0);
+
+  return nearest;
+} // _nearest
+
+// ----------------------------------------------------------------------
+// Get coordinates and values of point.
+const double*
+contrib::friction::FrictionDB::_point(const int index) const
+{ // _point
+  assert(index >= 0 && index < _numLocs);
+  return _points + size_t(index)*(_spaceDim + _numValues);
+} // _point
+
+
+// End of file
@@ -0,0 +1,234 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+/** @file FrictionDB.hh
+ *
+ * @brief Binary, memory-mapped spatial database of fault properties.
+ *
+ * A FrictionDB holds the same points and values as a SimpleDB ASCII
+ * file (see spatialdb_examples), converted once with convert() (or
+ * bench/frictiondb.cc), so PyLith does not parse the text on every
+ * process. The file is mapped into memory when the database is
+ * opened and points are stored grouped by the cells of a uniform
+ * grid, so the queries of a process only read the pages holding the
+ * points near its part of the fault. Values are stored in SI units
+ * and coordinates in meters. Queries return the values at the nearest
+ * point (the "nearest" query type of SimpleDB).
+ *
+ * File layout (native byte order):
+ *
+ *   header   char[8] "FRICTDB", int32 version, int32 0x01020304 (byte
+ *            order), int32 spaceDim, int32 numValues, int32 numLocs,
+ *            int32 numBins[3], int32 offset of bins, int32 offset of
+ *            points, double lower[3], double binSize[3], and for each
+ *            value int32 length of name, char[length] name.
+ *   bins     int32 binStart[numBins[0]*numBins[1]*numBins[2]+1], index
+ *            of the first point in each cell (x varies fastest).
+ *   points   double [numLocs][spaceDim+numValues], coordinates
+ *            followed by values, sorted by cell.
+ *
+ * The bins and points start on page boundaries.
+ */
+
+#if !defined(pylith_friction_FrictionDB_hh)
+#define pylith_friction_FrictionDB_hh
+
+// Include directives ---------------------------------------------------
+#include "spatialdata/spatialdb/SpatialDB.hh" // ISA SpatialDB
+
+#include <cstddef> // HASA size_t
+#include <string> // HASA std::string
+#include <vector> // HASA std::vector
+
+// Forward declarations
+namespace contrib {
+  namespace friction {
+    class FrictionDB;
+  } // friction
+} // pylith
+
+// FrictionDB -----------------------------------------------------------
+/// Binary, memory-mapped spatial database of fault properties.
+class contrib::friction::FrictionDB : public spatialdata::spatialdb::SpatialDB
+{ // class FrictionDB
+
+  // PUBLIC METHODS /////////////////////////////////////////////////////
+public :
+
+  /// Default constructor.
+  FrictionDB(void);
+
+  /** Constructor with label.
+   *
+   * @param label Label of database.
+   */
+  FrictionDB(const char* label);
+
+  /// Destructor.
+  ~FrictionDB(void);
+
+  /** Convert SimpleDB ASCII file to binary database.
+   *
+   * Only Cartesian coordinate systems are supported. Values are
+   * converted to SI units; the units must be one of none, m, cm, mm,
+   * km, m/s, s, year, Pa, kPa, MPa, GPa, or bar. Queries return the
+   * values at the nearest point, so a SimpleDB queried with the
+   * "linear" query type is refused.
+   *
+   * @param simpleDBFilename Name of SimpleDB ASCII file.
+   * @param filename Name of binary database file.
+   * @param queryType Query type of the SimpleDB ("nearest" or "linear").
+   */
+  static
+  void convert(const char* simpleDBFilename,
+	       const char* filename,
+	       const char* queryType="nearest");
+
+  /** Set name of database file.
+   *
+   * @param value Name of file.
+   */
+  void filename(const char* value);
+
+  /** Get name of database file.
+   *
+   * @returns Name of file.
+   */
+  const char* filename(void) const;
+
+  /// Map the database file into memory and check its header.
+  void open(void);
+
+  /// Unmap the database file.
+  void close(void);
+
+  /** Get number of spatial dimensions of points in open database.
+   *
+   * @returns Number of dimensions.
+   */
+  int spaceDim(void) const;
+
+  /** Get number of points in open database.
+   *
+   * @returns Number of points.
+   */
+  int numLocs(void) const;
+
+  /** Get number of values at each point in open database.
+   *
+   * @returns Number of values.
+   */
+  int numValues(void) const;
+
+  /** Get name of value in open database.
+   *
+   * @param index Index of value.
+   * @returns Name of value.
+   */
+  const char* valueName(const int index) const;
+
+  /** Set values to be returned by queries.
+   *
+   * @param names Names of values to be returned in queries.
+   * @param numVals Number of values to be returned in queries.
+   */
+  void queryVals(const char* const* names,
+		 const int numVals);
+
+  /** Query the database for the values at the nearest point.
+   *
+   * @param vals Array for values (output from query).
+   * @param numVals Number of values expected (size of vals array).
+   * @param coords Coordinates of point for query.
+   * @param numDims Number of dimensions for coordinates.
+   * @param csQuery Coordinate system of coordinates (Cartesian; NULL
+   *   for meters).
+   *
+   * @returns 0 (a database always has a nearest point).
+   */
+  int query(double* vals,
+	    const int numVals,
+	    const double* coords,
+	    const int numDims,
+	    const spatialdata::geocoords::CoordSys* csQuery);
+
+  /** Query the database for the values at the nearest point.
+   *
+   * @param vals Array for values (output from query).
+   * @param numVals Number of values expected (size of vals array).
+   * @param coords Coordinates of point for query.
+   * @param numDims Number of dimensions for coordinates.
+   * @param csQuery Coordinate system of coordinates (Cartesian; NULL
+   *   for meters).
+   *
+   * @returns 0 (a database always has a nearest point).
+   */
+  int query(float* vals,
+	    const int numVals,
+	    const float* coords,
+	    const int numDims,
+	    const spatialdata::geocoords::CoordSys* csQuery);
+
+  // PRIVATE METHODS ////////////////////////////////////////////////////
+private :
+
+  /** Find nearest point.
+   *
+   * @param xyz Coordinates of point in meters [3].
+   *
+   * @returns Index of nearest point.
+   */
+  int _nearest(const double xyz[3]) const;
+
+  /** Get coordinates and values of point.
+   *
+   * @param index Index of point.
+   *
+   * @returns Coordinates followed by values.
+   */
+  const double* _point(const int index) const;
+
+  // PRIVATE MEMBERS ////////////////////////////////////////////////////
+private :
+
+  std::string _filename; ///< Name of database file.
+  std::vector<std::string> _names; ///< Names of values.
+  std::vector<int> _queryIndices; ///< Indices of values returned by queries.
+  const char* _data; ///< Mapped database file.
+  size_t _size; ///< Size of mapped file.
+  const int* _binStart; ///< Index of first point in each cell.
+  const double* _points; ///< Coordinates and values of points.
+  double _lower[3]; ///< Lower corner of grid.
+  double _binSize[3]; ///< Size of cells of grid.
+  int _numBins[3]; ///< Number of cells of grid in each direction.
+  int _spaceDim; ///< Number of spatial dimensions.
+  int _numValues; ///< Number of values at each point.
+  int _numLocs; ///< Number of points.
+
+  // NOT IMPLEMENTED ////////////////////////////////////////////////////
+private :
+
+  FrictionDB(const FrictionDB&); ///< Not implemented.
+  const FrictionDB& operator=(const FrictionDB&); ///< Not implemented
+
+}; // class FrictionDB
+
+#endif // pylith_friction_FrictionDB_hh
+
+
+// End of file
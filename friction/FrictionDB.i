@@ -0,0 +1,113 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+// SWIG interface to C++ FrictionDB object.
+
+/* This is nearly identical to the C++ FrictionDB header file. There
+ * are a few important differences required by SWIG:
+ *
+ * (1) Instead of forward declaring the FrictionDB class, we embed the
+ * class definition within the namespace declarations.
+ *
+ * (2) We only include public members and methods, because this is an
+ * interface file. Queries are made by PyLith through the C++
+ * SpatialDB interface.
+ */
+
+namespace contrib {
+  namespace friction {
+
+    class FrictionDB : public spatialdata::spatialdb::SpatialDB
+    { // class FrictionDB
+
+      // PUBLIC METHODS /////////////////////////////////////////////////
+    public :
+
+      /// Default constructor.
+      FrictionDB(void);
+
+      /** Constructor with label.
+       *
+       * @param label Label of database.
+       */
+      FrictionDB(const char* label);
+
+      /// Destructor.
+      ~FrictionDB(void);
+
+      /** Convert SimpleDB ASCII file to binary database.
+       *
+       * @param simpleDBFilename Name of SimpleDB ASCII file.
+       * @param filename Name of binary database file.
+       * @param queryType Query type of the SimpleDB ("nearest" or "linear").
+       */
+      static
+      void convert(const char* simpleDBFilename,
+		   const char* filename,
+		   const char* queryType="nearest");
+
+      /** Set name of database file.
+       *
+       * @param value Name of file.
+       */
+      void filename(const char* value);
+
+      /** Get name of database file.
+       *
+       * @returns Name of file.
+       */
+      const char* filename(void) const;
+
+      /// Map the database file into memory and check its header.
+      void open(void);
+
+      /// Unmap the database file.
+      void close(void);
+
+      /** Get number of spatial dimensions of points in open database.
+       *
+       * @returns Number of dimensions.
+       */
+      int spaceDim(void) const;
+
+      /** Get number of points in open database.
+       *
+       * @returns Number of points.
+       */
+      int numLocs(void) const;
+
+      /** Get number of values at each point in open database.
+       *
+       * @returns Number of values.
+       */
+      int numValues(void) const;
+
+      /** Get name of value in open database.
+       *
+       * @param index Index of value.
+       * @returns Name of value.
+       */
+      const char* valueName(const int index) const;
+
+    }; // class FrictionDB
+
+  } // friction
+} // pylith
+
+
+// End of file
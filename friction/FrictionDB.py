@@ -0,0 +1,106 @@
+#!/usr/bin/env python
+#
+# ----------------------------------------------------------------------
+#
+# Brad T. Aagaard, U.S. Geological Survey
+# Charles A. Williams, GNS Science
+# Matthew G. Knepley, University of Chicago
+#
+# This code was developed as part of the Computational Infrastructure
+# for Geodynamics (http://geodynamics.org).
+#
+# Copyright (c) 2010-2017 University of California, Davis
+#
+# See COPYING for license information.
+#
+# ----------------------------------------------------------------------
+#
+
+## @file pylith/friction/FrictionDB.py
+##
+## @brief Python object for binary, memory-mapped spatial database of
+## fault properties.
+##
+## Factory: spatial_database
+
+# ISA SpatialDBObj
+from spatialdata.spatialdb.SpatialDBObj import SpatialDBObj
+
+# Import the SWIG module FrictionDB object and rename it
+# ModuleFrictionDB so that it doesn't clash with the local Python
+# class of the same name.
+from frictioncontrib import FrictionDB as ModuleFrictionDB
+
+# FrictionDB class
+class FrictionDB(SpatialDBObj, ModuleFrictionDB):
+  """
+  Python object for binary, memory-mapped spatial database of fault
+  properties, converted from a SimpleDB ASCII file with frictiondb.
+  Queries return the values at the nearest point.
+
+  Inventory
+
+  \b Properties
+  @li \b filename Name of binary database file.
+  @li \b query_type Type of query (only nearest is supported).
+
+  Factory: spatial_database
+  """
+
+  # INVENTORY //////////////////////////////////////////////////////////
+
+  import pyre.inventory
+
+  filename = pyre.inventory.str("filename", default="")
+  filename.meta['tip'] = "Name of binary database file (from frictiondb)."
+
+  queryType = pyre.inventory.str("query_type", default="nearest",
+                                 validator=pyre.inventory.choice(["nearest", "linear"]))
+  queryType.meta['tip'] = "Type of query (only nearest is supported)."
+
+  # PUBLIC METHODS /////////////////////////////////////////////////////
+
+  def __init__(self, name="frictiondb"):
+    """
+    Constructor.
+    """
+    SpatialDBObj.__init__(self, name)
+    return
+
+
+  # PRIVATE METHODS ////////////////////////////////////////////////////
+
+  def _configure(self):
+    """
+    Setup members using inventory.
+    """
+    SpatialDBObj._configure(self)
+    if len(self.inventory.filename) == 0:
+      raise ValueError("Filename for spatial database '%s' not specified." % \
+                       self.inventory.label)
+    if self.inventory.queryType != "nearest":
+      raise ValueError("Spatial database '%s' returns the values at the nearest point "
+                       "and does not support query type '%s'." % \
+                       (self.inventory.label, self.inventory.queryType))
+    ModuleFrictionDB.filename(self, self.inventory.filename)
+    return
+
+
+  def _createModuleObj(self):
+    """
+    Create Python module object.
+    """
+    ModuleFrictionDB.__init__(self)
+    return
+  
+
+# FACTORIES ////////////////////////////////////////////////////////////
+
+def spatial_database():
+  """
+  Factory associated with FrictionDB.
+  """
+  return FrictionDB()
+
+
+# End of file
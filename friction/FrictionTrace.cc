@@ -0,0 +1,341 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+#include <portinfo> // machine specific info generated by configure
+
+#include "FrictionTrace.hh" // implementation of object methods
+
+#include <cassert> // USES assert()
+#include <cstring> // USES memcmp(), memcpy()
+#include <sstream> // USES std::ostringstream
+#include <stdexcept> // USES std::runtime_error
+
+// ----------------------------------------------------------------------
+namespace contrib {
+  namespace friction {
+    namespace _FrictionTrace {
+
+      // Header of trace file.
+      const char magic[8] = { 'F', 'R', 'T', 'R', 'A', 'C', 'E', '\0' };
+      const int version = 1;
+      const int byteOrder = 0x01020304;
+
+      // Record codes. The low bits hold the operation.
+      const unsigned char TIME_STEP = 0x0f;
+      const unsigned char OPERATION_MASK = 0x0f;
+      const unsigned char PROPERTIES_REPEATED = 0x10;
+      const unsigned char STATE_VARS_REPEATED = 0x20;
+
+      // Size of file stream buffer.
+      const size_t bufferSize = 1 << 20;
+
+    } // _FrictionTrace
+  } // friction
+} // contrib
+
+// ----------------------------------------------------------------------
+// Default constructor.
+contrib::friction::FrictionTrace::FrictionTrace(void) :
+  _file(0),
+  _filename(""),
+  _label(""),
+  _dt(0.0),
+  _numProperties(0),
+  _numStateVars(0),
+  _haveRecord(false)
+{ // constructor
+} // constructor
+
+// ----------------------------------------------------------------------
+// Destructor.
+contrib::friction::FrictionTrace::~FrictionTrace(void)
+{ // destructor
+  if (_file) {
+    fclose(_file); _file = 0;
+  } // if
+} // destructor
+
+// ----------------------------------------------------------------------
+// Create trace file for writing.
+void
+contrib::friction::FrictionTrace::openWrite(const char* filename,
+					    const char* label,
+					    const int numProperties,
+					    const int numStateVars)
+{ // openWrite
+  assert(filename);
+  assert(label);
+  assert(numProperties > 0);
+  assert(numStateVars >= 0);
+
+  close();
+
+  _file = fopen(filename, "wb");
+  if (!_file) {
+    std::ostringstream msg;
+    msg << "Could not create trace file '" << filename
+	<< "' for friction model '" << label << "'.";
+    throw std::runtime_error(msg.str());
+  } // if
+  _buffer.resize(_FrictionTrace::bufferSize);
+  setvbuf(_file, &_buffer[0], _IOFBF, _buffer.size());
+
+  _filename = filename;
+  _label = label;
+  _numProperties = numProperties;
+  _numStateVars = numStateVars;
+  _properties.resize(numProperties);
+  _stateVars.resize(numStateVars);
+  _haveRecord = false;
+
+  const int header[5] = {
+    _FrictionTrace::version,
+    _FrictionTrace::byteOrder,
+    int(sizeof(PylithScalar)),
+    numProperties,
+    numStateVars,
+  };
+  const int labelLength = _label.length();
+  _write(_FrictionTrace::magic, sizeof(_FrictionTrace::magic));
+  _write(header, sizeof(header));
+  _write(&labelLength, sizeof(labelLength));
+  _write(_label.c_str(), labelLength);
+} // openWrite
+
+// ----------------------------------------------------------------------
+// Open trace file for reading.
+void
+contrib::friction::FrictionTrace::openRead(const char* filename)
+{ // openRead
+  assert(filename);
+
+  close();
+
+  _file = fopen(filename, "rb");
+  if (!_file) {
+    std::ostringstream msg;
+    msg << "Could not open trace file '" << filename << "'.";
+    throw std::runtime_error(msg.str());
+  } // if
+  _buffer.resize(_FrictionTrace::bufferSize);
+  setvbuf(_file, &_buffer[0], _IOFBF, _buffer.size());
+  _filename = filename;
+
+  char magic[sizeof(_FrictionTrace::magic)];
+  int header[5];
+  if (1 != fread(magic, sizeof(magic), 1, _file) ||
+      0 != memcmp(magic, _FrictionTrace::magic, sizeof(magic)) ||
+      1 != fread(header, sizeof(header), 1, _file)) {
+    std::ostringstream msg;
+    msg << "File '" << filename << "' is not a friction trace.";
+    throw std::runtime_error(msg.str());
+  } // if
+  if (header[0] != _FrictionTrace::version ||
+      header[1] != _FrictionTrace::byteOrder ||
+      header[2] != int(sizeof(PylithScalar))) {
+    std::ostringstream msg;
+    msg << "Friction trace '" << filename << "' was written with a different "
+	<< "version, byte order, or precision.\n"
+	<< "Version: " << header[0] << ", scalar size: " << header[2] << "\n";
+    throw std::runtime_error(msg.str());
+  } // if
+  _numProperties = header[3];
+  _numStateVars = header[4];
+
+  int labelLength = 0;
+  _read(&labelLength, sizeof(labelLength));
+  if (_numProperties <= 0 || _numStateVars < 0 || labelLength < 0) {
+    std::ostringstream msg;
+    msg << "Corrupt header in friction trace '" << filename << "'.";
+    throw std::runtime_error(msg.str());
+  } // if
+  std::vector<char> label(labelLength+1, '\0');
+  _read(&label[0], labelLength);
+  _label = &label[0];
+
+  _properties.resize(_numProperties);
+  _stateVars.resize(_numStateVars);
+  _dt = 0.0;
+  _haveRecord = false;
+} // openRead
+
+// ----------------------------------------------------------------------
+// Close trace file.
+void
+contrib::friction::FrictionTrace::close(void)
+{ // close
+  if (!_file)
+    return;
+
+  const bool failed = 0 != ferror(_file);
+  const int err = fclose(_file); _file = 0;
+  if (failed || err) {
+    std::ostringstream msg;
+    msg << "Error writing or closing trace file '" << _filename << "'.";
+    throw std::runtime_error(msg.str());
+  } // if
+} // close
+
+// ----------------------------------------------------------------------
+// Write record.
+void
+contrib::friction::FrictionTrace::write(const OperationEnum operation,
+					const PylithScalar dt,
+					const PylithScalar t,
+					const PylithScalar slip,
+					const PylithScalar slipRate,
+					const PylithScalar normalTraction,
+					const PylithScalar* properties,
+					const PylithScalar* stateVars)
+{ // write
+  assert(_file);
+  assert(operation >= 0 && operation < NUM_OPERATIONS);
+  assert(properties);
+  assert(stateVars || 0 == _numStateVars);
+
+  if (!_haveRecord || dt != _dt) {
+    const unsigned char code = _FrictionTrace::TIME_STEP;
+    _write(&code, sizeof(code));
+    _write(&dt, sizeof(dt));
+    _dt = dt;
+  } // if
+
+  const size_t propertiesSize = _numProperties*sizeof(PylithScalar);
+  const size_t stateVarsSize = _numStateVars*sizeof(PylithScalar);
+  unsigned char code = operation;
+  if (_haveRecord && 0 == memcmp(properties, &_properties[0], propertiesSize))
+    code |= _FrictionTrace::PROPERTIES_REPEATED;
+  else
+    memcpy(&_properties[0], properties, propertiesSize);
+  if (_haveRecord && 0 == memcmp(stateVars, &_stateVars[0], stateVarsSize))
+    code |= _FrictionTrace::STATE_VARS_REPEATED;
+  else if (_numStateVars > 0)
+    memcpy(&_stateVars[0], stateVars, stateVarsSize);
+  _haveRecord = true;
+
+  const PylithScalar args[4] = { t, slip, slipRate, normalTraction };
+  _write(&code, sizeof(code));
+  _write(args, sizeof(args));
+  if (!(code & _FrictionTrace::PROPERTIES_REPEATED))
+    _write(properties, propertiesSize);
+  if (!(code & _FrictionTrace::STATE_VARS_REPEATED))
+    _write(stateVars, stateVarsSize);
+} // write
+
+// ----------------------------------------------------------------------
+// Read next record.
+bool
+contrib::friction::FrictionTrace::read(Record* record)
+{ // read
+  assert(_file);
+  assert(record);
+
+  unsigned char code = 0;
+  while (true) {
+    if (1 != fread(&code, sizeof(code), 1, _file))
+      return false;
+    if (_FrictionTrace::TIME_STEP != code)
+      break;
+    _read(&_dt, sizeof(_dt));
+  } // while
+
+  const int operation = code & _FrictionTrace::OPERATION_MASK;
+  if (operation >= NUM_OPERATIONS ||
+      (!_haveRecord && (code & (_FrictionTrace::PROPERTIES_REPEATED |
+				_FrictionTrace::STATE_VARS_REPEATED)))) {
+    std::ostringstream msg;
+    msg << "Corrupt record in friction trace '" << _filename << "'.";
+    throw std::runtime_error(msg.str());
+  } // if
+
+  PylithScalar args[4];
+  _read(args, sizeof(args));
+  if (!(code & _FrictionTrace::PROPERTIES_REPEATED))
+    _read(&_properties[0], _numProperties*sizeof(PylithScalar));
+  if (!(code & _FrictionTrace::STATE_VARS_REPEATED) && _numStateVars > 0)
+    _read(&_stateVars[0], _numStateVars*sizeof(PylithScalar));
+  _haveRecord = true;
+
+  record->operation = OperationEnum(operation);
+  record->dt = _dt;
+  record->t = args[0];
+  record->slip = args[1];
+  record->slipRate = args[2];
+  record->normalTraction = args[3];
+  record->properties = _properties;
+  record->stateVars = _stateVars;
+
+  return true;
+} // read
+
+// ----------------------------------------------------------------------
+// Get label of fault constitutive model that wrote the trace.
+const char*
+contrib::friction::FrictionTrace::label(void) const
+{ // label
+  return _label.c_str();
+} // label
+
+// ----------------------------------------------------------------------
+// Get number of properties per vertex.
+int
+contrib::friction::FrictionTrace::numProperties(void) const
+{ // numProperties
+  return _numProperties;
+} // numProperties
+
+// ----------------------------------------------------------------------
+// Get number of state variables per vertex.
+int
+contrib::friction::FrictionTrace::numStateVars(void) const
+{ // numStateVars
+  return _numStateVars;
+} // numStateVars
+
+// ----------------------------------------------------------------------
+// Write values to file.
+void
+contrib::friction::FrictionTrace::_write(const void* values,
+					 const size_t size)
+{ // _write
+  assert(_file);
+
+  if (size > 0 && 1 != fwrite(values, size, 1, _file)) {
+    std::ostringstream msg;
+    msg << "Error writing trace file '" << _filename << "'.";
+    throw std::runtime_error(msg.str());
+  } // if
+} // _write
+
+// ----------------------------------------------------------------------
+// Read values from file.
+void
+contrib::friction::FrictionTrace::_read(void* values,
+					const size_t size)
+{ // _read
+  assert(_file);
+
+  if (size > 0 && 1 != fread(values, size, 1, _file)) {
+    std::ostringstream msg;
+    msg << "Friction trace '" << _filename << "' is truncated.";
+    throw std::runtime_error(msg.str());
+  } // if
+} // _read
+
+
+// End of file
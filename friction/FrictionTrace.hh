@@ -0,0 +1,216 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+/** @file FrictionTrace.hh
+ *
+ * @brief Binary trace of the calls to a fault constitutive model.
+ *
+ * A trace records the arguments of each call to _calcFriction(),
+ * _calcFrictionDeriv() and _updateStateVars() in the order PyLith
+ * makes them, so the workload of a simulation can be fed back through
+ * the kernels of a model (see bench/frictionreplay.cc). Values are
+ * stored as PyLith passes them to the model, i.e., nondimensionalized.
+ *
+ * File layout (native byte order):
+ *
+ *   header   char[8] "FRTRACE", int32 version, int32 0x01020304
+ *            (byte order), int32 sizeof(PylithScalar), int32
+ *            numProperties, int32 numStateVars, int32 length of label,
+ *            char[length] label.
+ *   records  uint8 code, followed by
+ *              TIME_STEP:  dt
+ *              otherwise:  t, slip, slipRate, normalTraction,
+ *                          properties[numProperties] (unless the code
+ *                          has PROPERTIES_REPEATED), stateVars[numStateVars]
+ *                          (unless the code has STATE_VARS_REPEATED).
+ *
+ * Properties and state variables equal to those of the previous
+ * record are not repeated, which keeps the friction/derivative pairs
+ * PyLith requests at each vertex compact. A time step record is
+ * written whenever the time step changes.
+ */
+
+#if !defined(pylith_friction_FrictionTrace_hh)
+#define pylith_friction_FrictionTrace_hh
+
+// Include directives ---------------------------------------------------
+#include "pylith/utils/types.hh" // USES PylithScalar
+
+#include <cstdio> // HASA FILE
+#include <string> // HASA std::string
+#include <vector> // HASA std::vector
+
+// Forward declarations
+namespace contrib {
+  namespace friction {
+    class FrictionTrace;
+  } // friction
+} // pylith
+
+// FrictionTrace --------------------------------------------------------
+/// Write or read a trace of the calls to a fault constitutive model.
+class contrib::friction::FrictionTrace
+{ // class FrictionTrace
+
+  // PUBLIC ENUMS ///////////////////////////////////////////////////////
+public :
+
+  /// Traced functions.
+  enum OperationEnum {
+    FRICTION=0, ///< _calcFriction().
+    FRICTION_DERIV=1, ///< _calcFrictionDeriv().
+    UPDATE_STATE_VARS=2, ///< _updateStateVars() (state variables before the update).
+    NUM_OPERATIONS=3
+  }; // OperationEnum
+
+  // PUBLIC STRUCTS /////////////////////////////////////////////////////
+public :
+
+  /// Arguments of a traced call.
+  struct Record {
+    OperationEnum operation; ///< Traced function.
+    PylithScalar dt; ///< Time step at the call.
+    PylithScalar t; ///< Time in simulation.
+    PylithScalar slip; ///< Slip.
+    PylithScalar slipRate; ///< Slip rate.
+    PylithScalar normalTraction; ///< Normal traction.
+    std::vector<PylithScalar> properties; ///< Properties [numProperties].
+    std::vector<PylithScalar> stateVars; ///< State variables [numStateVars].
+  }; // Record
+
+  // PUBLIC METHODS /////////////////////////////////////////////////////
+public :
+
+  /// Default constructor.
+  FrictionTrace(void);
+
+  /// Destructor.
+  ~FrictionTrace(void);
+
+  /** Create trace file for writing.
+   *
+   * @param filename Name of file.
+   * @param label Label of fault constitutive model.
+   * @param numProperties Number of properties per vertex.
+   * @param numStateVars Number of state variables per vertex.
+   */
+  void openWrite(const char* filename,
+		 const char* label,
+		 const int numProperties,
+		 const int numStateVars);
+
+  /** Open trace file for reading.
+   *
+   * @param filename Name of file.
+   */
+  void openRead(const char* filename);
+
+  /// Close trace file (flushes the records written).
+  void close(void);
+
+  /** Write record.
+   *
+   * @param operation Traced function.
+   * @param dt Time step.
+   * @param t Time in simulation.
+   * @param slip Slip.
+   * @param slipRate Slip rate.
+   * @param normalTraction Normal traction.
+   * @param properties Properties [numProperties].
+   * @param stateVars State variables [numStateVars].
+   */
+  void write(const OperationEnum operation,
+	     const PylithScalar dt,
+	     const PylithScalar t,
+	     const PylithScalar slip,
+	     const PylithScalar slipRate,
+	     const PylithScalar normalTraction,
+	     const PylithScalar* properties,
+	     const PylithScalar* stateVars);
+
+  /** Read next record.
+   *
+   * @param record Record (output).
+   *
+   * @returns True if a record was read, false at the end of the file.
+   */
+  bool read(Record* record);
+
+  /** Get label of fault constitutive model that wrote the trace.
+   *
+   * @returns Label.
+   */
+  const char* label(void) const;
+
+  /** Get number of properties per vertex.
+   *
+   * @returns Number of properties.
+   */
+  int numProperties(void) const;
+
+  /** Get number of state variables per vertex.
+   *
+   * @returns Number of state variables.
+   */
+  int numStateVars(void) const;
+
+  // PRIVATE METHODS ////////////////////////////////////////////////////
+private :
+
+  /** Write values to file.
+   *
+   * @param values Values.
+   * @param size Number of bytes.
+   */
+  void _write(const void* values,
+	      const size_t size);
+
+  /** Read values from file.
+   *
+   * @param values Values (output).
+   * @param size Number of bytes.
+   */
+  void _read(void* values,
+	     const size_t size);
+
+  // PRIVATE MEMBERS ////////////////////////////////////////////////////
+private :
+
+  FILE* _file; ///< Trace file.
+  std::string _filename; ///< Name of trace file.
+  std::string _label; ///< Label of fault constitutive model.
+  std::vector<PylithScalar> _properties; ///< Properties of previous record.
+  std::vector<PylithScalar> _stateVars; ///< State variables of previous record.
+  std::vector<char> _buffer; ///< Buffer of file stream.
+  PylithScalar _dt; ///< Time step of previous record.
+  int _numProperties; ///< Number of properties per vertex.
+  int _numStateVars; ///< Number of state variables per vertex.
+  bool _haveRecord; ///< True if a record was written or read.
+
+  // NOT IMPLEMENTED ////////////////////////////////////////////////////
+private :
+
+  FrictionTrace(const FrictionTrace&); ///< Not implemented.
+  const FrictionTrace& operator=(const FrictionTrace&); ///< Not implemented
+
+}; // class FrictionTrace
+
+#endif // pylith_friction_FrictionTrace_hh
+
+
+// End of file
@@ -0,0 +1,172 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+#include <portinfo> // machine specific info generated by configure
+
+#include "FrictionTraceRecorder.hh" // implementation of object methods
+
+#include <petscsys.h> // USES MPI_Comm_rank()
+
+#include <cassert> // USES assert()
+#include <sstream> // USES std::ostringstream
+
+// ----------------------------------------------------------------------
+namespace contrib {
+  namespace friction {
+    namespace _FrictionTraceRecorder {
+
+      /** Replace "%d" in the name of a file by the MPI rank.
+       *
+       * @param filename Name of file.
+       *
+       * @returns Name of file of this process.
+       */
+      std::string
+      rankFilename(const std::string& filename)
+      { // rankFilename
+	std::string rankName = filename;
+	const size_t pos = rankName.find("%d");
+	if (pos != std::string::npos) {
+	  int rank = 0;
+	  MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
+	  std::ostringstream rankString;
+	  rankString << rank;
+	  rankName.replace(pos, 2, rankString.str());
+	} // if
+	return rankName;
+      } // rankFilename
+
+    } // _FrictionTraceRecorder
+  } // friction
+} // contrib
+
+// ----------------------------------------------------------------------
+// Default constructor.
+contrib::friction::FrictionTraceRecorder::FrictionTraceRecorder(void) :
+  _filename(""),
+  _trace(0),
+  _recording(false)
+{ // constructor
+} // constructor
+
+// ----------------------------------------------------------------------
+// Destructor.
+contrib::friction::FrictionTraceRecorder::~FrictionTraceRecorder(void)
+{ // destructor
+  delete _trace; _trace = 0;
+} // destructor
+
+// ----------------------------------------------------------------------
+// Start recording calls to a new trace file.
+void
+contrib::friction::FrictionTraceRecorder::open(const char* filename)
+{ // open
+  assert(filename);
+
+  close();
+  _filename = filename;
+  _recording = !_filename.empty();
+} // open
+
+// ----------------------------------------------------------------------
+// Get name of trace file.
+const char*
+contrib::friction::FrictionTraceRecorder::filename(void) const
+{ // filename
+  return _filename.c_str();
+} // filename
+
+// ----------------------------------------------------------------------
+// Stop recording and close the trace file.
+void
+contrib::friction::FrictionTraceRecorder::close(void)
+{ // close
+  if (_trace) {
+    _trace->close();
+    delete _trace; _trace = 0;
+  } // if
+  _recording = false;
+} // close
+
+// ----------------------------------------------------------------------
+// Record call.
+void
+contrib::friction::FrictionTraceRecorder::write(const char* label,
+						const FrictionTrace::OperationEnum operation,
+						const PylithScalar dt,
+						const PylithScalar t,
+						const PylithScalar slip,
+						const PylithScalar slipRate,
+						const PylithScalar normalTraction,
+						const PylithScalar* properties,
+						const int numProperties,
+						const PylithScalar* stateVars,
+						const int numStateVars)
+{ // write
+  assert(!_filename.empty());
+
+  if (!_trace) {
+    // Each process writes its own file.
+    const std::string filename = _FrictionTraceRecorder::rankFilename(_filename);
+
+    _trace = new FrictionTrace;
+    try {
+      _trace->openWrite(filename.c_str(), label, numProperties, numStateVars);
+    } catch (...) {
+      delete _trace; _trace = 0;
+      _recording = false;
+      throw;
+    } // try/catch
+  } // if
+  assert(numProperties == _trace->numProperties());
+  assert(numStateVars == _trace->numStateVars());
+
+  _trace->write(operation, dt, t, slip, slipRate, normalTraction,
+		properties, stateVars);
+} // write
+
+// ----------------------------------------------------------------------
+// Record the calls for a batch of vertices.
+void
+contrib::friction::FrictionTraceRecorder::writeBatch(const char* label,
+						     const FrictionTrace::OperationEnum operation,
+						     const bool withDeriv,
+						     const PylithScalar dt,
+						     const PylithScalar t,
+						     const PylithScalar* slip,
+						     const PylithScalar* slipRate,
+						     const PylithScalar* normalTraction,
+						     const PylithScalar* properties,
+						     const int numProperties,
+						     const PylithScalar* stateVars,
+						     const int numStateVars,
+						     const int numVertices)
+{ // writeBatch
+  for (int i=0; i < numVertices; ++i) {
+    const PylithScalar* propertiesVertex = &properties[i*numProperties];
+    const PylithScalar* stateVarsVertex = &stateVars[i*numStateVars];
+    write(label, operation, dt, t, slip[i], slipRate[i], normalTraction[i],
+	  propertiesVertex, numProperties, stateVarsVertex, numStateVars);
+    if (withDeriv)
+      write(label, FrictionTrace::FRICTION_DERIV, dt, t, slip[i], slipRate[i], normalTraction[i],
+	    propertiesVertex, numProperties, stateVarsVertex, numStateVars);
+  } // for
+} // writeBatch
+
+
+// End of file
@@ -0,0 +1,165 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+/** @file FrictionTraceRecorder.hh
+ *
+ * @brief Records the calls to a fault constitutive model in a
+ * FrictionTrace.
+ *
+ * The trace file is created at the first recorded call, when the
+ * number of properties and state variables is known. Each process
+ * writes its own file ("%d" in the name is replaced by the rank).
+ */
+
+#if !defined(pylith_friction_FrictionTraceRecorder_hh)
+#define pylith_friction_FrictionTraceRecorder_hh
+
+// Include directives ---------------------------------------------------
+#include "FrictionTrace.hh" // HOLDSA FrictionTrace
+
+#include <string> // HASA std::string
+
+// Forward declarations
+namespace contrib {
+  namespace friction {
+    class FrictionTraceRecorder;
+  } // friction
+} // pylith
+
+// FrictionTraceRecorder ------------------------------------------------
+/// Record the calls to a fault constitutive model in a trace file.
+class contrib::friction::FrictionTraceRecorder
+{ // class FrictionTraceRecorder
+
+  // PUBLIC METHODS /////////////////////////////////////////////////////
+public :
+
+  /// Default constructor.
+  FrictionTraceRecorder(void);
+
+  /// Destructor.
+  ~FrictionTraceRecorder(void);
+
+  /** Start recording calls to a new trace file.
+   *
+   * @param filename Name of file (empty to stop recording).
+   */
+  void open(const char* filename);
+
+  /** Get name of trace file.
+   *
+   * @returns Name of file (empty if none).
+   */
+  const char* filename(void) const;
+
+  /// Stop recording and close the trace file.
+  void close(void);
+
+  /** Check whether calls are recorded.
+   *
+   * @returns True if calls are recorded.
+   */
+  bool recording(void) const;
+
+  /** Pause or resume recording of an open recorder, e.g., while a
+   * batch function that has been recorded calls the per-vertex
+   * functions.
+   *
+   * @param value True to record calls.
+   */
+  void recording(const bool value);
+
+  /** Record call.
+   *
+   * @param label Label of fault constitutive model.
+   * @param operation Traced function.
+   * @param dt Time step.
+   * @param t Time in simulation.
+   * @param slip Slip.
+   * @param slipRate Slip rate.
+   * @param normalTraction Normal traction.
+   * @param properties Properties [numProperties].
+   * @param numProperties Number of properties.
+   * @param stateVars State variables [numStateVars].
+   * @param numStateVars Number of state variables.
+   */
+  void write(const char* label,
+	     const FrictionTrace::OperationEnum operation,
+	     const PylithScalar dt,
+	     const PylithScalar t,
+	     const PylithScalar slip,
+	     const PylithScalar slipRate,
+	     const PylithScalar normalTraction,
+	     const PylithScalar* properties,
+	     const int numProperties,
+	     const PylithScalar* stateVars,
+	     const int numStateVars);
+
+  /** Record the calls for a batch of vertices, vertex by vertex in
+   * the order PyLith makes them.
+   *
+   * @param label Label of fault constitutive model.
+   * @param operation Traced function.
+   * @param withDeriv Record _calcFrictionDeriv() after _calcFriction()
+   *   at each vertex.
+   * @param dt Time step.
+   * @param t Time in simulation.
+   * @param slip Array of slip [numVertices].
+   * @param slipRate Array of slip rate [numVertices].
+   * @param normalTraction Array of normal traction [numVertices].
+   * @param properties Array of properties [numVertices*numProperties].
+   * @param numProperties Number of properties per vertex.
+   * @param stateVars Array of state variables [numVertices*numStateVars].
+   * @param numStateVars Number of state variables per vertex.
+   * @param numVertices Number of vertices in batch.
+   */
+  void writeBatch(const char* label,
+		  const FrictionTrace::OperationEnum operation,
+		  const bool withDeriv,
+		  const PylithScalar dt,
+		  const PylithScalar t,
+		  const PylithScalar* slip,
+		  const PylithScalar* slipRate,
+		  const PylithScalar* normalTraction,
+		  const PylithScalar* properties,
+		  const int numProperties,
+		  const PylithScalar* stateVars,
+		  const int numStateVars,
+		  const int numVertices);
+
+  // PRIVATE MEMBERS ////////////////////////////////////////////////////
+private :
+
+  std::string _filename; ///< Name of trace file, with "%d" for the rank (empty if none).
+  FrictionTrace* _trace; ///< Trace file (created at first recorded call).
+  bool _recording; ///< True if calls are recorded.
+
+  // NOT IMPLEMENTED ////////////////////////////////////////////////////
+private :
+
+  FrictionTraceRecorder(const FrictionTraceRecorder&); ///< Not implemented.
+  const FrictionTraceRecorder& operator=(const FrictionTraceRecorder&); ///< Not implemented
+
+}; // class FrictionTraceRecorder
+
+#include "FrictionTraceRecorder.icc" // inline methods
+
+#endif // pylith_friction_FrictionTraceRecorder_hh
+
+
+// End of file
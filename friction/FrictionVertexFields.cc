@@ -0,0 +1,204 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+#include <portinfo> // machine specific info generated by configure
+
+#include "FrictionVertexFields.hh" // implementation of object methods
+
+#include <cassert> // USES assert()
+#include <cstring> // USES memcmp()
+#include <sstream> // USES std::ostringstream
+#include <stdexcept> // USES std::runtime_error
+
+// ----------------------------------------------------------------------
+namespace contrib {
+  namespace friction {
+    namespace _FrictionVertexFields {
+
+      // Header of vertex fields file.
+      const char magic[8] = { 'F', 'R', 'F', 'I', 'E', 'L', 'D', '\0' };
+      const int version = 1;
+      const int byteOrder = 0x01020304;
+
+    } // _FrictionVertexFields
+  } // friction
+} // contrib
+
+// ----------------------------------------------------------------------
+// Default constructor.
+contrib::friction::FrictionVertexFields::FrictionVertexFields(void) :
+  _file(0),
+  _filename(""),
+  _label(""),
+  _ok(true)
+{ // constructor
+} // constructor
+
+// ----------------------------------------------------------------------
+// Destructor.
+contrib::friction::FrictionVertexFields::~FrictionVertexFields(void)
+{ // destructor
+  if (_file) {
+    fclose(_file); _file = 0;
+  } // if
+} // destructor
+
+// ----------------------------------------------------------------------
+// Create file for writing and write its header.
+void
+contrib::friction::FrictionVertexFields::openWrite(const char* filename,
+						   const char* label,
+						   const int numProperties,
+						   const int numStateVars,
+						   const int numVertices)
+{ // openWrite
+  assert(filename);
+  assert(label);
+  assert(numProperties > 0);
+  assert(numStateVars >= 0);
+  assert(numVertices >= 0);
+
+  close();
+
+  _file = fopen(filename, "wb");
+  if (!_file) {
+    std::ostringstream msg;
+    msg << "Could not create vertex fields file '" << filename
+	<< "' for friction model '" << label << "'.";
+    throw std::runtime_error(msg.str());
+  } // if
+  _filename = filename;
+  _label = label;
+
+  const int header[6] = {
+    _FrictionVertexFields::version,
+    _FrictionVertexFields::byteOrder,
+    int(sizeof(PylithScalar)),
+    numProperties,
+    numStateVars,
+    numVertices,
+  };
+  _ok = 1 == fwrite(_FrictionVertexFields::magic, sizeof(_FrictionVertexFields::magic), 1, _file) &&
+    1 == fwrite(header, sizeof(header), 1, _file);
+} // openWrite
+
+// ----------------------------------------------------------------------
+// Open file for reading and check that its header matches.
+void
+contrib::friction::FrictionVertexFields::openRead(const char* filename,
+						  const char* label,
+						  const int numProperties,
+						  const int numStateVars,
+						  const int numVertices)
+{ // openRead
+  assert(filename);
+  assert(label);
+  assert(numProperties > 0);
+  assert(numStateVars >= 0);
+  assert(numVertices >= 0);
+
+  close();
+
+  _file = fopen(filename, "rb");
+  if (!_file) {
+    std::ostringstream msg;
+    msg << "Could not open vertex fields file '" << filename
+	<< "' for friction model '" << label << "'.";
+    throw std::runtime_error(msg.str());
+  } // if
+  _filename = filename;
+  _label = label;
+
+  char magic[sizeof(_FrictionVertexFields::magic)];
+  int header[6];
+  const bool haveHeader = 1 == fread(magic, sizeof(magic), 1, _file) &&
+    0 == memcmp(magic, _FrictionVertexFields::magic, sizeof(magic)) &&
+    1 == fread(header, sizeof(header), 1, _file);
+  if (!haveHeader ||
+      header[0] != _FrictionVertexFields::version ||
+      header[1] != _FrictionVertexFields::byteOrder ||
+      header[2] != int(sizeof(PylithScalar)) ||
+      header[3] != numProperties ||
+      header[4] != numStateVars ||
+      header[5] != numVertices) {
+    fclose(_file); _file = 0;
+    std::ostringstream msg;
+    msg << "Vertex fields file '" << filename << "' does not match friction model '"
+	<< label << "'.\n"
+	<< "Expected version " << _FrictionVertexFields::version << " in native byte order "
+	<< "and precision, " << numProperties << " properties, " << numStateVars
+	<< " state variables, and " << numVertices << " vertices.";
+    if (haveHeader)
+      msg << "\nFile has version " << header[0] << ", scalar size " << header[2] << ", "
+	  << header[3] << " properties, " << header[4] << " state variables, and "
+	  << header[5] << " vertices.";
+    throw std::runtime_error(msg.str());
+  } // if
+} // openRead
+
+// ----------------------------------------------------------------------
+// Close file.
+void
+contrib::friction::FrictionVertexFields::close(void)
+{ // close
+  if (!_file)
+    return;
+
+  const bool ok = 0 == fclose(_file) && _ok;
+  _file = 0;
+  _ok = true;
+  if (!ok) {
+    std::ostringstream msg;
+    msg << "Error writing vertex fields file '" << _filename
+	<< "' for friction model '" << _label << "'.";
+    throw std::runtime_error(msg.str());
+  } // if
+} // close
+
+// ----------------------------------------------------------------------
+// Write values.
+void
+contrib::friction::FrictionVertexFields::write(const PylithScalar* values,
+					       const size_t numValues)
+{ // write
+  assert(_file);
+  assert(values || 0 == numValues);
+
+  _ok = _ok && numValues == fwrite(values, sizeof(PylithScalar), numValues, _file);
+} // write
+
+// ----------------------------------------------------------------------
+// Read values.
+void
+contrib::friction::FrictionVertexFields::read(PylithScalar* const values,
+					      const size_t numValues)
+{ // read
+  assert(_file);
+  assert(values || 0 == numValues);
+
+  if (numValues != fread(values, sizeof(PylithScalar), numValues, _file)) {
+    fclose(_file); _file = 0;
+    std::ostringstream msg;
+    msg << "Vertex fields file '" << _filename << "' for friction model '"
+	<< _label << "' is truncated.";
+    throw std::runtime_error(msg.str());
+  } // if
+} // read
+
+
+// End of file
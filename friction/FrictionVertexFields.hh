@@ -0,0 +1,129 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+/** @file FrictionVertexFields.hh
+ *
+ * @brief Binary file of the properties and state variables of a
+ * batch of fault vertices, in the order of the vertices.
+ *
+ * File layout (native byte order):
+ *
+ *   header   char[8] "FRFIELD", int32 version, int32 0x01020304 (byte
+ *            order), int32 sizeof(PylithScalar), int32 numProperties,
+ *            int32 numStateVars, int32 numVertices.
+ *   values   properties[numVertices*numProperties], then
+ *            stateVars[numVertices*numStateVars], in SI units.
+ */
+
+#if !defined(pylith_friction_FrictionVertexFields_hh)
+#define pylith_friction_FrictionVertexFields_hh
+
+// Include directives ---------------------------------------------------
+#include "pylith/utils/types.hh" // USES PylithScalar
+
+#include <cstdio> // HASA FILE
+#include <string> // HASA std::string
+
+// Forward declarations
+namespace contrib {
+  namespace friction {
+    class FrictionVertexFields;
+  } // friction
+} // pylith
+
+// FrictionVertexFields -------------------------------------------------
+/// Write or read the properties and state variables of fault vertices.
+class contrib::friction::FrictionVertexFields
+{ // class FrictionVertexFields
+
+  // PUBLIC METHODS /////////////////////////////////////////////////////
+public :
+
+  /// Default constructor.
+  FrictionVertexFields(void);
+
+  /// Destructor.
+  ~FrictionVertexFields(void);
+
+  /** Create file for writing and write its header.
+   *
+   * @param filename Name of file.
+   * @param label Label of fault constitutive model.
+   * @param numProperties Number of properties per vertex.
+   * @param numStateVars Number of state variables per vertex.
+   * @param numVertices Number of vertices.
+   */
+  void openWrite(const char* filename,
+		 const char* label,
+		 const int numProperties,
+		 const int numStateVars,
+		 const int numVertices);
+
+  /** Open file for reading and check that its header matches.
+   *
+   * @param filename Name of file.
+   * @param label Label of fault constitutive model.
+   * @param numProperties Number of properties per vertex.
+   * @param numStateVars Number of state variables per vertex.
+   * @param numVertices Number of vertices.
+   */
+  void openRead(const char* filename,
+		const char* label,
+		const int numProperties,
+		const int numStateVars,
+		const int numVertices);
+
+  /// Close file, checking that the values were written.
+  void close(void);
+
+  /** Write values (properties of all vertices, then state variables).
+   *
+   * @param values Values [numValues].
+   * @param numValues Number of values.
+   */
+  void write(const PylithScalar* values,
+	     const size_t numValues);
+
+  /** Read values (properties of all vertices, then state variables).
+   *
+   * @param values Values (output) [numValues].
+   * @param numValues Number of values.
+   */
+  void read(PylithScalar* const values,
+	    const size_t numValues);
+
+  // PRIVATE MEMBERS ////////////////////////////////////////////////////
+private :
+
+  FILE* _file; ///< Vertex fields file.
+  std::string _filename; ///< Name of file.
+  std::string _label; ///< Label of fault constitutive model.
+  bool _ok; ///< False after a failed write.
+
+  // NOT IMPLEMENTED ////////////////////////////////////////////////////
+private :
+
+  FrictionVertexFields(const FrictionVertexFields&); ///< Not implemented.
+  const FrictionVertexFields& operator=(const FrictionVertexFields&); ///< Not implemented
+
+}; // class FrictionVertexFields
+
+#endif // pylith_friction_FrictionVertexFields_hh
+
+
+// End of file
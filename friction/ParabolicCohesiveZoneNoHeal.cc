@@ -24,136 +24,73 @@
 
 #include "ParabolicCohesiveZoneNoHeal.hh" // implementation of object methods
 
-#include "pylith/materials/Metadata.hh" // USES Metadata
+#include "SlipWeakeningLaw.icc" // implementation of template methods
 
-#include "pylith/utils/array.hh" // USES scaary_array
+#include "pylith/utils/array.hh" // USES scalar_array
 #include "pylith/utils/constdefs.h" // USES PYLITH_MAXSCALAR
 
-#include "spatialdata/units/Nondimensional.hh" // USES Nondimensional
+#include <algorithm> // USES std::min()
 
 #include <cassert> // USES assert()
 #include <sstream> // USES std::ostringstream
 #include <stdexcept> // USES std::runtime_error
 
 // ----------------------------------------------------------------------
-// Create a local namespace to use for local constants and other
-// information. This insulates all other classes from this information
-// while preventing clashes with other local constants and data (as
-// long as no other object use the same _ParabolicCohesiveZoneNoHeal namespace in
-// the  namespace.
-namespace contrib {
-  namespace friction {
-    namespace _ParabolicCohesiveZoneNoHeal {
-
-      // These are the fault constitutive parameters stored during the
-      // simulation and need not coincide with the physical properties
-      // provided by the user.
-
-      // Number of physical properties.
-      const int numProperties = 5;
-
-      // Friction model parameters.
-      const pylith::materials::Metadata::ParamDescription properties[numProperties] = {
-	{ "static_coefficient", 1, pylith::topology::FieldBase::SCALAR },
-	{ "dynamic_coefficient", 1, pylith::topology::FieldBase::SCALAR },
-	{ "slip_shift", 1, pylith::topology::FieldBase::SCALAR },
-	{ "slip_stretch", 1, pylith::topology::FieldBase::SCALAR },
-	{ "cohesion", 1, pylith::topology::FieldBase::SCALAR },
-      };
-
-      // Number of state variables.
-      const int numStateVars = 2;
-
-      // State Variables.
-      const pylith::materials::Metadata::ParamDescription stateVars[] = {
-	{ "cumulative_slip", 1, pylith::topology::FieldBase::SCALAR },
-	{ "previous_slip", 1, pylith::topology::FieldBase::SCALAR },
-      };
-
-      // Values expected in spatial database
-      const int numDBProperties = 5;
-      const char* dbProperties[numDBProperties] = { 
-	"static_coefficient",
-	"dynamic_coefficient",
-	"slip_shift",
-	"slip_stretch",
-	"cohesion",
-      };
-
-      // These are the state variables stored during the simulation.
-
-      const int numDBStateVars = 2;
-      const char* dbStateVars[numDBStateVars] = { "cumulative_slip",
-	"previous_slip",
-      };      
-      
-    } // _ParabolicCohesiveZoneNoHeal
-  } // friction
-} // contrib
-
-// Indices of fault constitutive parameters.
-const int contrib::friction::ParabolicCohesiveZoneNoHeal::p_coefS = 0;
-const int contrib::friction::ParabolicCohesiveZoneNoHeal::p_coefD = 
-  contrib::friction::ParabolicCohesiveZoneNoHeal::p_coefS + 1;
-const int contrib::friction::ParabolicCohesiveZoneNoHeal::p_slShift = 
-  contrib::friction::ParabolicCohesiveZoneNoHeal::p_coefD + 1;
-const int contrib::friction::ParabolicCohesiveZoneNoHeal::p_slStretch = 
-  contrib::friction::ParabolicCohesiveZoneNoHeal::p_slShift + 1;
-const int contrib::friction::ParabolicCohesiveZoneNoHeal::p_cohesion =
-  contrib::friction::ParabolicCohesiveZoneNoHeal::p_slStretch + 1;
-
-// Indices of database values (order must match dbProperties)
-const int contrib::friction::ParabolicCohesiveZoneNoHeal::db_coefS = 0;
-const int contrib::friction::ParabolicCohesiveZoneNoHeal::db_coefD =
-  contrib::friction::ParabolicCohesiveZoneNoHeal::db_coefS + 1;
-const int contrib::friction::ParabolicCohesiveZoneNoHeal::db_slShift =
-  contrib::friction::ParabolicCohesiveZoneNoHeal::db_coefD + 1;
-const int contrib::friction::ParabolicCohesiveZoneNoHeal::db_slStretch =
-  contrib::friction::ParabolicCohesiveZoneNoHeal::db_slShift + 1;
-const int contrib::friction::ParabolicCohesiveZoneNoHeal::db_cohesion =
-  contrib::friction::ParabolicCohesiveZoneNoHeal::db_slStretch + 1;
-
-// Indices of state variables.
-const int contrib::friction::ParabolicCohesiveZoneNoHeal::s_slipCum = 0;
-const int contrib::friction::ParabolicCohesiveZoneNoHeal::s_slipPrev = 
-  contrib::friction::ParabolicCohesiveZoneNoHeal::s_slipCum + 1;
-
-// Indices of database values (order must match dbProperties)
-const int contrib::friction::ParabolicCohesiveZoneNoHeal::db_slipCum = 0;
-const int contrib::friction::ParabolicCohesiveZoneNoHeal::db_slipPrev = 
-  contrib::friction::ParabolicCohesiveZoneNoHeal::db_slipCum + 1;
-
-// ----------------------------------------------------------------------
-// Default constructor.
-contrib::friction::ParabolicCohesiveZoneNoHeal::ParabolicCohesiveZoneNoHeal(void) :
-  pylith::friction::FrictionModel(pylith::materials::Metadata(_ParabolicCohesiveZoneNoHeal::properties,
-				    _ParabolicCohesiveZoneNoHeal::numProperties,
-				    _ParabolicCohesiveZoneNoHeal::dbProperties,
-				    _ParabolicCohesiveZoneNoHeal::numDBProperties,
-				    _ParabolicCohesiveZoneNoHeal::stateVars,
-				    _ParabolicCohesiveZoneNoHeal::numStateVars,
-				    _ParabolicCohesiveZoneNoHeal::dbStateVars,
-				    _ParabolicCohesiveZoneNoHeal::numDBStateVars))
-                    
-{ // constructor
-} // constructor
-
-// ----------------------------------------------------------------------
-// Destructor.
-contrib::friction::ParabolicCohesiveZoneNoHeal::~ParabolicCohesiveZoneNoHeal(void)
-{ // destructor
-} // destructor
+// Physical properties.
+const pylith::materials::Metadata::ParamDescription
+contrib::friction::ParabolicCohesiveZoneCurve::properties[numProperties] = {
+  { "static_coefficient", 1, pylith::topology::FieldBase::SCALAR },
+  { "dynamic_coefficient", 1, pylith::topology::FieldBase::SCALAR },
+  { "slip_shift", 1, pylith::topology::FieldBase::SCALAR },
+  { "slip_stretch", 1, pylith::topology::FieldBase::SCALAR },
+  { "cohesion", 1, pylith::topology::FieldBase::SCALAR },
+  // Derived properties (not in spatial database).
+  { "weakening_end_slip", 1, pylith::topology::FieldBase::SCALAR },
+  { "weakening_curvature", 1, pylith::topology::FieldBase::SCALAR },
+};
+
+// Values expected in spatial database.
+const char*
+contrib::friction::ParabolicCohesiveZoneCurve::dbProperties[numDBProperties] = {
+  "static_coefficient",
+  "dynamic_coefficient",
+  "slip_shift",
+  "slip_stretch",
+  "cohesion",
+};
+
+// Rules for properties.
+const contrib::friction::ContribFrictionModel::PropertyRule
+contrib::friction::ParabolicCohesiveZoneCurve::propertyRules[numPropertyRules] = {
+  { "static_coefficient > 0", ContribFrictionModel::POSITIVE_RULE, p_coefS, p_coefS, 0 },
+  { "dynamic_coefficient > 0", ContribFrictionModel::POSITIVE_RULE, p_coefD, p_coefD, 0 },
+  { "slip_shift > 0", ContribFrictionModel::POSITIVE_RULE, p_slShift, p_slShift, 0 },
+  { "slip_stretch > 0", ContribFrictionModel::POSITIVE_RULE, p_slStretch, p_slStretch, 0 },
+  { "cohesion >= 0", ContribFrictionModel::NONNEGATIVE_RULE, p_cohesion, p_cohesion, 0 },
+  { "static_coefficient >= dynamic_coefficient", ContribFrictionModel::NOT_LESS_RULE, p_coefS, p_coefD, 0 },
+};
+
+// Dimensions of properties, including derived properties.
+const contrib::friction::ContribFrictionModel::Dimension
+contrib::friction::ParabolicCohesiveZoneCurve::propertyDimensions[numProperties] = {
+  { 0, 0, 0 }, // static_coefficient
+  { 0, 0, 0 }, // dynamic_coefficient
+  { 1, 0, 0 }, // slip_shift
+  { 1, 0, 0 }, // slip_stretch
+  { 0, 1, 0 }, // cohesion
+  { 1, 0, 0 }, // weakening_end_slip
+  { -2, 0, 0 }, // weakening_curvature
+};
 
 // ----------------------------------------------------------------------
 // Compute properties from values in spatial database.
 void
-contrib::friction::ParabolicCohesiveZoneNoHeal::_dbToProperties(PylithScalar* const propValues,
-						    const pylith::scalar_array& dbValues) const
-{ // _dbToProperties
+contrib::friction::ParabolicCohesiveZoneCurve::dbToProperties(PylithScalar* const propValues,
+							      const pylith::scalar_array& dbValues)
+{ // dbToProperties
   // Check consistency of arguments
   assert(propValues);
-  const int numDBValues = dbValues.size();
-  assert(_ParabolicCohesiveZoneNoHeal::numDBProperties == numDBValues);
+  assert(numDBProperties == int(dbValues.size()));
 
   // Extract values from array using our defined indices.
   const PylithScalar coefS = dbValues[db_coefS];
@@ -209,238 +146,147 @@ contrib::friction::ParabolicCohesiveZoneNoHeal::_dbToProperties(PylithScalar* co
   propValues[p_slShift] = slShift;
   propValues[p_slStretch] = slStretch;
   propValues[p_cohesion] = cohesion;
+  _computeDerivedProperties(propValues);
 
-} // _dbToProperties
+} // dbToProperties
 
 // ----------------------------------------------------------------------
-// Nondimensionalize properties.
+// Compute derived properties.
 void
-contrib::friction::ParabolicCohesiveZoneNoHeal::_nondimProperties(PylithScalar* const values,
-						      const int nvalues) const
-{ // _nondimProperties
-  // Check consistency of arguments.
-  assert(_normalizer);
+contrib::friction::ParabolicCohesiveZoneCurve::_computeDerivedProperties(PylithScalar* const values)
+{ // _computeDerivedProperties
   assert(values);
-  assert(nvalues == _ParabolicCohesiveZoneNoHeal::numProperties);
-
-  // Get scales needed to nondimensional parameters from the
-  // Nondimensional object.
-  const PylithScalar lengthScale = _normalizer->lengthScale();
-  const PylithScalar timeScale = _normalizer->timeScale();
-  const PylithScalar pressureScale = _normalizer->pressureScale();
-  const PylithScalar velocityScale = lengthScale / timeScale;
-
-  // Use the Nondimensional::nondimensionalize() function to
-  // nondimensionalize the quantities using the appropriate scale.
-  values[p_slShift] = _normalizer->nondimensionalize(values[p_slShift], lengthScale);
-  values[p_slStretch] = _normalizer->nondimensionalize(values[p_slStretch], lengthScale);
-  values[p_cohesion] = _normalizer->nondimensionalize(values[p_cohesion], pressureScale);
-} // _nondimProperties
 
-// ----------------------------------------------------------------------
-// Dimensionalize properties.
-void
-contrib::friction::ParabolicCohesiveZoneNoHeal::_dimProperties(PylithScalar* const values,
-						   const int nvalues) const
-{ // _dimProperties
-  // Check consistency of arguments.
-  assert(_normalizer);
-  assert(values);
-  assert(nvalues == _ParabolicCohesiveZoneNoHeal::numProperties);
-
-  // Get scales needed to dimensional parameters from the
-  // Nondimensional object.
-  const PylithScalar lengthScale = _normalizer->lengthScale();
-  const PylithScalar timeScale = _normalizer->timeScale();
-  const PylithScalar pressureScale = _normalizer->pressureScale();
-  const PylithScalar velocityScale = lengthScale / timeScale;
-
-  // Use the Nondimensional::dimensionalize() function to
-  // dimensionalize the quantities using the appropriate scale.
-  values[p_slShift] = _normalizer->dimensionalize(values[p_slShift], lengthScale);
-  values[p_slStretch] = _normalizer->dimensionalize(values[p_slStretch], lengthScale);
-  values[p_cohesion] = _normalizer->dimensionalize(values[p_cohesion], pressureScale);
-} // _dimProperties
+  values[p_slEnd] = values[p_slShift] + values[p_slStretch];
+  values[p_curv] = (values[p_coefS] - values[p_coefD]) /
+    (values[p_slStretch] * values[p_slStretch]);
+} // _computeDerivedProperties
 
 // ----------------------------------------------------------------------
-// Compute state variables from values in spatial database.
-void
-contrib::friction::ParabolicCohesiveZoneNoHeal::_dbToStateVars(PylithScalar* const stateValues,
-						   const pylith::scalar_array& dbValues) const
-{ // _dbToStateVars
-  // Check consistency of arguments.
-  assert(stateValues);
-  const int numDBValues = dbValues.size();
-  assert(_ParabolicCohesiveZoneNoHeal::numDBStateVars == numDBValues);
-
-  // Compute friction parameters that we store from the user-supplied
-  // friction parameters.
-  const PylithScalar cumulativeSlip = dbValues[db_slipCum];
-  const PylithScalar previousSlip = dbValues[db_slipPrev];
- 
-  // Store computed friction parameters in the properties array.
-  stateValues[s_slipCum] = cumulativeSlip;
-  stateValues[s_slipPrev] = previousSlip;
-} // _dbToStateVars
+// Compute friction coefficient at a location.
+inline
+PylithScalar
+contrib::friction::ParabolicCohesiveZoneCurve::coefficient(const PylithScalar slipCum,
+							   const PylithScalar* properties,
+							   PylithScalar* const derivCoef)
+{ // coefficient
+  // Rather than branching on whether the vertex is fully weakened,
+  // the cumulative slip is clamped at the end of the parabola, so the
+  // same expressions apply at every vertex (see coefficientSIMD()).
+  // The end of the parabola and its curvature are precomputed, so
+  // there are no divisions.
+  const PylithScalar slipOffset =
+    std::min(slipCum, properties[p_slEnd]) - properties[p_slShift];
+
+  *derivCoef = simd::selectLess(slipCum, properties[p_slEnd],
+				-2 * properties[p_curv] * slipOffset, 0.0);
+  return properties[p_coefS] - properties[p_curv] * slipOffset * slipOffset;
+} // coefficient
 
 // ----------------------------------------------------------------------
-// Nondimensionalize state variables.
-void
-contrib::friction::ParabolicCohesiveZoneNoHeal::_nondimStateVars(PylithScalar* const values,
-						     const int nvalues) const
-{ // _nondimStateVars
-  // Check consistency of arguments.
-  assert(_normalizer);
-  assert(values);
-  assert(nvalues == _ParabolicCohesiveZoneNoHeal::numStateVars);
-
-  // Get scales needed to nondimensional parameters from the
-  // Nondimensional object.
-  const PylithScalar lengthScale = _normalizer->lengthScale();
-  const PylithScalar timeScale = _normalizer->timeScale();
-  const PylithScalar velocityScale = lengthScale / timeScale;
-
-  // Use the Nondimensional::dimensionalize() function to
-  // dimensionalize the quantities using the appropriate scale.
-  values[s_slipCum] = _normalizer->nondimensionalize(values[s_slipCum], lengthScale);
-  values[s_slipPrev] = _normalizer->nondimensionalize(values[s_slipPrev], lengthScale);
-} // _nondimStateVars
+// Get index of weakening segment at a location.
+inline
+int
+contrib::friction::ParabolicCohesiveZoneCurve::segment(const PylithScalar slipCum,
+						       const PylithScalar* properties)
+{ // segment
+  return 0;
+} // segment
 
 // ----------------------------------------------------------------------
-// Dimensionalize state variables.
-void
-contrib::friction::ParabolicCohesiveZoneNoHeal::_dimStateVars(PylithScalar* const values,
-						  const int nvalues) const
-{ // _dimStateVars
-  // Check consistency of arguments.
-  assert(_normalizer);
-  assert(values);
-  assert(nvalues == _ParabolicCohesiveZoneNoHeal::numStateVars);
+// Check whether the friction coefficient no longer changes with slip.
+inline
+bool
+contrib::friction::ParabolicCohesiveZoneCurve::fullyWeakened(const PylithScalar slipCum,
+							     const PylithScalar* properties)
+{ // fullyWeakened
+  return !(slipCum < properties[p_slEnd]);
+} // fullyWeakened
 
-  // Get scales needed to dimensional parameters from the
-  // Nondimensional object.
-  const PylithScalar lengthScale = _normalizer->lengthScale();
-  const PylithScalar timeScale = _normalizer->timeScale();
-  const PylithScalar velocityScale = lengthScale / timeScale;
+// ----------------------------------------------------------------------
+// Check whether a location has reached the end of weakening.
+inline
+bool
+contrib::friction::ParabolicCohesiveZoneCurve::weakeningEnded(const PylithScalar slipCum,
+							      const PylithScalar* properties,
+							      const PylithScalar fraction)
+{ // weakeningEnded
+  return fullyWeakened(slipCum, properties);
+} // weakeningEnded
 
-  // Use the Nondimensional::dimensionalize() function to
-  // dimensionalize the quantities using the appropriate scale.
-  values[s_slipCum] = _normalizer->dimensionalize(values[s_slipCum], lengthScale);
-  values[s_slipPrev] = _normalizer->dimensionalize(values[s_slipPrev], lengthScale);
-} // _dimStateVars
+// ----------------------------------------------------------------------
+// Get number of flops in coefficient() at a location.
+inline
+int
+contrib::friction::ParabolicCohesiveZoneCurve::coefficientFlops(const PylithScalar slipCum,
+								const PylithScalar* properties)
+{ // coefficientFlops
+  // The derivative is evaluated and then selected (see coefficient()).
+  return 6;
+} // coefficientFlops
 
 // ----------------------------------------------------------------------
-// Compute friction from properties and state variables.
+// Get slip from a location to the next breakpoint of the friction
+// coefficient.
+inline
 PylithScalar
-contrib::friction::ParabolicCohesiveZoneNoHeal::_calcFriction(const PylithScalar t,
-						  const PylithScalar slip,
-						  const PylithScalar slipRate,
-						  const PylithScalar normalTraction,
-						  const PylithScalar* properties,
-						  const int numProperties,
-						  const PylithScalar* stateVars,
-						  const int numStateVars)
-{ // _calcFriction
-  // Check consistency of arguments.
-  assert(properties);
-  assert(_ParabolicCohesiveZoneNoHeal::numProperties == numProperties);
-  assert(numStateVars);
-  assert(_ParabolicCohesiveZoneNoHeal::numStateVars == numStateVars);
-
-  // Compute friction traction.
-  PylithScalar friction = 0.0;
-  PylithScalar mu_f = 0.0;
-  if (normalTraction <= 0.0) {
-    // if fault is in compression
-    const PylithScalar slipPrev = stateVars[s_slipPrev];
-    const PylithScalar slipCum = stateVars[s_slipCum] + fabs(slip - slipPrev);
-    
-    if (slipCum < properties[p_slShift] + properties[p_slStretch]) {
-	// if/else linear slip-weakening form of mu_f 
-	mu_f = properties[p_coefS] -
-	  (properties[p_coefS] - properties[p_coefD]) * 
-	  (slipCum - properties[p_slShift]) * (slipCum - properties[p_slShift]) / properties[p_slStretch] / properties[p_slStretch];
-	  } else {
-	mu_f = properties[p_coefD];
-      } // if/else
-    friction = -mu_f * normalTraction + properties[p_cohesion];
-  } else { // else
-    friction = properties[p_cohesion];
-  } // if/else
-
-  PetscLogFlops(10);
-
-  return friction;
-} // _calcFriction
+contrib::friction::ParabolicCohesiveZoneCurve::slipToBreakpoint(const PylithScalar slipCum,
+								const PylithScalar* properties)
+{ // slipToBreakpoint
+  // The parabola has zero slope at the shift slip, so its end is the
+  // only kink.
+  return (slipCum < properties[p_slEnd]) ?
+    properties[p_slEnd] - slipCum : PYLITH_MAXSCALAR;
+} // slipToBreakpoint
 
 // ----------------------------------------------------------------------
-// Compute derivative of friction with slip from properties and state variables.
+// Get friction coefficient at a location once fully weakened.
+inline
 PylithScalar
-contrib::friction::ParabolicCohesiveZoneNoHeal::_calcFrictionDeriv(const PylithScalar t,
-						       const PylithScalar slip,
-						       const PylithScalar slipRate,
-						       const PylithScalar normalTraction,
-						       const PylithScalar* properties,
-						       const int numProperties,
-						       const PylithScalar* stateVars,
-						       const int numStateVars)
-{ // _calcFrictionDeriv
-  // Check consistency of arguments.
-  assert(properties);
-  assert(_ParabolicCohesiveZoneNoHeal::numProperties == numProperties);
-  assert(numStateVars);
-  assert(_ParabolicCohesiveZoneNoHeal::numStateVars == numStateVars);
-
-  // Compute friction traction.
-  PylithScalar frictionDeriv = 0.0;
-  if (normalTraction <= 0.0) {
-    // if fault is in compression
-	const PylithScalar slipPrev = stateVars[s_slipPrev];
-    const PylithScalar slipCum = stateVars[s_slipCum] + fabs(slip - slipPrev);
-    if (slipCum < properties[p_slShift] + properties[p_slStretch]) {
-    frictionDeriv = normalTraction * (-2*(properties[p_coefS] - properties[p_coefD]) * 
-	(slipCum - properties[p_slShift]) / properties[p_slStretch] / properties[p_slStretch]); }
-    } // if/else
-   // if
-
-  return frictionDeriv;
-} // _calcFrictionDeriv
+contrib::friction::ParabolicCohesiveZoneCurve::residualCoefficient(const PylithScalar* properties)
+{ // residualCoefficient
+  return properties[p_coefD];
+} // residualCoefficient
 
 // ----------------------------------------------------------------------
-// Update state variables (for next time step).
-void
-contrib::friction::ParabolicCohesiveZoneNoHeal::_updateStateVars(const PylithScalar t,
-						     const PylithScalar slip,
-						     const PylithScalar slipRate,
-						     const PylithScalar normalTraction,
-						     PylithScalar* const stateVars,
-						     const int numStateVars,
-						     const PylithScalar* properties,
-						     const int numProperties)
-{ // _updateStateVars
-  // Check consistency of arguments.
-  assert(properties);
-  assert(_ParabolicCohesiveZoneNoHeal::numProperties == numProperties);
-  assert(numStateVars);
-  assert(_ParabolicCohesiveZoneNoHeal::numStateVars == numStateVars);
-  
-  const PylithScalar tolerance = 0;
-  if (slipRate >= tolerance) {
-    const PylithScalar slipPrev = stateVars[s_slipPrev];
-
-    stateVars[s_slipPrev] = slip;
-    stateVars[s_slipCum] += fabs(slip - slipPrev);
-  } else {
-    // Sliding has stopped, so reset state variables.
-    stateVars[s_slipPrev] = slip;
-    stateVars[s_slipCum] = 0.0;
-  } // else
-	  
-  //const PylithScalar slipPrev = stateVars[s_slipPrev];
-  //stateVars[s_slipPrev] = slip;
-  //stateVars[s_slipCum] += fabs(slip - slipPrev);
-  
-} // _updateStateVars
+// Compute friction coefficient at a vector of locations.
+inline
+contrib::friction::simd::VecD
+contrib::friction::ParabolicCohesiveZoneCurve::coefficientSIMD(const simd::VecD slipCum,
+							       const double* properties,
+							       const int stride,
+							       simd::VecD* const derivCoef)
+{ // coefficientSIMD
+  const simd::VecD coefS = simd::loads(&properties[p_coefS], stride);
+  const simd::VecD slShift = simd::loads(&properties[p_slShift], stride);
+  const simd::VecD slipEnd = simd::loads(&properties[p_slEnd], stride);
+  const simd::VecD curv = simd::loads(&properties[p_curv], stride);
+
+  // Same expressions as coefficient(), evaluated for all lanes.
+  const simd::VecD slipOffset = simd::sub(simd::min(slipCum, slipEnd), slShift);
+  const simd::MaskD weakening = simd::cmplt(slipCum, slipEnd);
+
+  *derivCoef = simd::select(weakening,
+			    simd::mul(simd::mul(simd::set1(-2.0), curv), slipOffset),
+			    simd::set1(0.0));
+  return simd::sub(coefS, simd::mul(simd::mul(curv, slipOffset), slipOffset));
+} // coefficientSIMD
+
+// ----------------------------------------------------------------------
+// Constructor.
+contrib::friction::ParabolicCohesiveZoneNoHeal::ParabolicCohesiveZoneNoHeal(const bool diagnostics) :
+  SlipWeakeningLaw<ParabolicCohesiveZoneCurve>(diagnostics)
+{ // constructor
+} // constructor
+
+// ----------------------------------------------------------------------
+// Destructor.
+contrib::friction::ParabolicCohesiveZoneNoHeal::~ParabolicCohesiveZoneNoHeal(void)
+{ // destructor
+} // destructor
+
+// Instantiate the slip-weakening law for this friction coefficient.
+template class contrib::friction::SlipWeakeningLaw<contrib::friction::ParabolicCohesiveZoneCurve>;
 
 
 // End of file 
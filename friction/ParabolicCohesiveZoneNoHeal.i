@@ -31,14 +31,17 @@
 namespace contrib {
   namespace friction {
 
-    class ParabolicCohesiveZoneNoHeal : public pylith::friction::FrictionModel
+    class ParabolicCohesiveZoneNoHeal : public contrib::friction::ContribFrictionModel
     { // class ParabolicCohesiveZoneNoHeal
 
       // PUBLIC METHODS /////////////////////////////////////////////////
     public :
 
-      /// Default constructor.
-      ParabolicCohesiveZoneNoHeal(void);
+      /** Constructor.
+       *
+       * @param diagnostics True to add the diagnostic state variables.
+       */
+      ParabolicCohesiveZoneNoHeal(const bool diagnostics=false);
 
       /// Destructor.
       ~ParabolicCohesiveZoneNoHeal(void);
@@ -51,8 +54,8 @@ namespace contrib {
        * @param propValues Array of property values.
        * @param dbValues Array of database values.
        */
-      void _dbToProperties(PylithScalar* const propValues,
-			   const scalar_array& dbValues) const;
+      void _dbValuesToProperties(PylithScalar* const propValues,
+				 const scalar_array& dbValues) const;
 
       /** Nondimensionalize properties.
        *
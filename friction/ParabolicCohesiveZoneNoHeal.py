@@ -35,8 +35,37 @@ class ParabolicCohesiveZoneNoHeal(FrictionModel, ModuleParabolicCohesiveZoneNoHe
   """
   Python object implementing viscous friction.
 
+  Inventory
+
+  \b Properties
+  @li \b num_threads Number of threads for fault vertex loops.
+  @li \b trace_filename Name of file for recording the calls to the model.
+  @li \b census_filename Name of file for the number of vertices in each regime.
+  @li \b diagnostics Add the regime, work, and rupture time state variables.
+
   Factory: friction_model.
   """
+
+  # INVENTORY //////////////////////////////////////////////////////////
+
+  import pyre.inventory
+
+  threadCount = pyre.inventory.int("num_threads", default=0)
+  threadCount.meta['tip'] = "Number of threads for fault vertex loops (0 uses OMP_NUM_THREADS)."
+
+  traceFile = pyre.inventory.str("trace_filename", default="")
+  traceFile.meta['tip'] = "Name of file for recording the calls to the model, " \
+      "with %d replaced by the process rank (empty for no recording)."
+
+  censusFile = pyre.inventory.str("census_filename", default="")
+  censusFile.meta['tip'] = "Name of file for the number of vertices in each regime " \
+      "at each time step, with %d replaced by the process rank (empty for no file)."
+
+  diagnostics = pyre.inventory.bool("diagnostics", default=False)
+  diagnostics.meta['tip'] = "Add the regime, frictional and breakdown work, and " \
+      "rupture and weakening end time state variables, which are updated at " \
+      "every time step."
+
   # PUBLIC METHODS /////////////////////////////////////////////////////
 
   def __init__(self, name="ParabolicCohesiveZoneNoHeal"):
@@ -66,12 +95,37 @@ class ParabolicCohesiveZoneNoHeal(FrictionModel, ModuleParabolicCohesiveZoneNoHe
          'cell': \
            {'info': [],
             'data': []}}
-    self._loggingPrefix = "FrDSlWk " # Prefix that appears in PETSc logging
+    self._loggingPrefix = "FrParCZ " # Prefix that appears in PETSc logging
     return
 
 
   # PRIVATE METHODS ////////////////////////////////////////////////////
-  
+
+  def _configure(self):
+    """
+    Setup members using inventory.
+    """
+    data = ["cumulative_slip",
+            "previous_slip"]
+    if self.inventory.diagnostics:
+      # The diagnostic state variables are part of the metadata, which
+      # is fixed when the C++ object is constructed, so replace the
+      # object from _createModuleObj() with one that has them.
+      self.this = ModuleParabolicCohesiveZoneNoHeal(True).this
+      data += ["regime",
+               "frictional_work",
+               "breakdown_work",
+               "rupture_time",
+               "weakening_end_time"]
+    self.availableFields['vertex']['data'] = data
+    FrictionModel._configure(self)
+    ModuleParabolicCohesiveZoneNoHeal.numThreads(self, self.inventory.threadCount)
+    ModuleParabolicCohesiveZoneNoHeal.traceFilename(self, self.inventory.traceFile)
+    ModuleParabolicCohesiveZoneNoHeal.censusFilename(self, self.inventory.censusFile)
+    ModuleParabolicCohesiveZoneNoHeal.loggingPrefix(self, self._loggingPrefix)
+    return
+
+
   def _createModuleObj(self):
     """
     Call constructor for module object for access to C++ object. This
@@ -0,0 +1,254 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+/* @brief Minimal SIMD layer for the batch friction kernels.
+ *
+ * Provides a double precision vector type VecD with the handful of
+ * operations the fault constitutive model kernels need (arithmetic,
+ * FMA, min/max, compare + select, strided loads) and a vectorized
+ * exponential. The widest instruction set enabled at compile time is
+ * used: AVX-512F (8 lanes), AVX2 (4 lanes), SSE2 (2 lanes), or plain
+ * scalar code (1 lane). Select the instruction set through CXXFLAGS,
+ * e.g., CXXFLAGS="-O3 -march=native".
+ *
+ * Masks are full vectors (or AVX-512 mask registers), so kernels
+ * written with select() have no data-dependent branches.
+ */
+
+#if !defined(pylith_friction_SIMDMath_hh)
+#define pylith_friction_SIMDMath_hh
+
+#include <cmath> // USES exp()
+
+#if defined(__AVX512F__) || defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h> // USES SSE/AVX intrinsics
+#endif
+
+namespace contrib {
+  namespace friction {
+    namespace simd {
+
+#if defined(__AVX512F__)
+      // ------------------------------------------------------------
+      // AVX-512F: 8 doubles per vector.
+      static const int width = 8;
+      typedef __m512d VecD;
+      typedef __mmask8 MaskD;
+      // The unmasked AVX-512 intrinsics of GCC pass an uninitialized
+      // source to the masked builtins, which -Wmaybe-uninitialized
+      // reports wherever they are inlined. The functions below use the
+      // zero-masking (or zero-source) forms with all lanes set, which
+      // compile to the same instructions.
+      static const MaskD allMask = 0xff;
+
+      inline VecD set1(const double a) { return _mm512_set1_pd(a); }
+      inline VecD loadu(const double* p) { return _mm512_loadu_pd(p); }
+      inline void storeu(double* p, const VecD a) { _mm512_storeu_pd(p, a); }
+      inline VecD add(const VecD a, const VecD b) { return _mm512_add_pd(a, b); }
+      inline VecD sub(const VecD a, const VecD b) { return _mm512_sub_pd(a, b); }
+      inline VecD mul(const VecD a, const VecD b) { return _mm512_mul_pd(a, b); }
+      inline VecD div(const VecD a, const VecD b) { return _mm512_div_pd(a, b); }
+      inline VecD fmadd(const VecD a, const VecD b, const VecD c) { return _mm512_fmadd_pd(a, b, c); }
+      inline VecD min(const VecD a, const VecD b) { return _mm512_maskz_min_pd(allMask, a, b); }
+      inline VecD max(const VecD a, const VecD b) { return _mm512_maskz_max_pd(allMask, a, b); }
+      inline VecD abs(const VecD a) {
+	return _mm512_castsi512_pd(_mm512_and_epi64(_mm512_castpd_si512(a), _mm512_set1_epi64(0x7fffffffffffffffLL)));
+      }
+      inline MaskD cmple(const VecD a, const VecD b) { return _mm512_cmp_pd_mask(a, b, _CMP_LE_OQ); }
+      inline MaskD cmplt(const VecD a, const VecD b) { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+      /// Select a where mask is set, b otherwise.
+      inline VecD select(const MaskD m, const VecD a, const VecD b) { return _mm512_mask_blend_pd(m, b, a); }
+      /// Load p[0], p[stride], ..., p[7*stride].
+      inline VecD loads(const double* p, const int stride) {
+	const __m256i index = _mm256_mullo_epi32(_mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0), _mm256_set1_epi32(stride));
+	return _mm512_mask_i32gather_pd(_mm512_setzero_pd(), allMask, index, p, 8);
+      }
+      /// Round to nearest integer.
+      inline VecD round(const VecD a) { return _mm512_maskz_roundscale_pd(allMask, a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+      /// Compute a * 2^n for integral n.
+      inline VecD scale2(const VecD a, const VecD n) { return _mm512_maskz_scalef_pd(allMask, a, n); }
+
+#elif defined(__AVX2__)
+      // ------------------------------------------------------------
+      // AVX2: 4 doubles per vector.
+      static const int width = 4;
+      typedef __m256d VecD;
+      typedef __m256d MaskD;
+
+      inline VecD set1(const double a) { return _mm256_set1_pd(a); }
+      inline VecD loadu(const double* p) { return _mm256_loadu_pd(p); }
+      inline void storeu(double* p, const VecD a) { _mm256_storeu_pd(p, a); }
+      inline VecD add(const VecD a, const VecD b) { return _mm256_add_pd(a, b); }
+      inline VecD sub(const VecD a, const VecD b) { return _mm256_sub_pd(a, b); }
+      inline VecD mul(const VecD a, const VecD b) { return _mm256_mul_pd(a, b); }
+      inline VecD div(const VecD a, const VecD b) { return _mm256_div_pd(a, b); }
+#if defined(__FMA__)
+      inline VecD fmadd(const VecD a, const VecD b, const VecD c) { return _mm256_fmadd_pd(a, b, c); }
+#else
+      inline VecD fmadd(const VecD a, const VecD b, const VecD c) { return _mm256_add_pd(_mm256_mul_pd(a, b), c); }
+#endif
+      inline VecD min(const VecD a, const VecD b) { return _mm256_min_pd(a, b); }
+      inline VecD max(const VecD a, const VecD b) { return _mm256_max_pd(a, b); }
+      inline VecD abs(const VecD a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+      inline MaskD cmple(const VecD a, const VecD b) { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); }
+      inline MaskD cmplt(const VecD a, const VecD b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+      /// Select a where mask is set, b otherwise.
+      inline VecD select(const MaskD m, const VecD a, const VecD b) { return _mm256_blendv_pd(b, a, m); }
+      /// Load p[0], p[stride], p[2*stride], p[3*stride].
+      inline VecD loads(const double* p, const int stride) {
+	const __m128i index = _mm_mullo_epi32(_mm_set_epi32(3, 2, 1, 0), _mm_set1_epi32(stride));
+	return _mm256_i32gather_pd(p, index, 8);
+      }
+      /// Round to nearest integer.
+      inline VecD round(const VecD a) { return _mm256_round_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+      /// Compute a * 2^n for integral n in [-1022, 1023].
+      inline VecD scale2(const VecD a, const VecD n) {
+	// Adding 2^52 puts the biased exponent in the low mantissa bits.
+	const __m256i bits = _mm256_castpd_si256(_mm256_add_pd(n, _mm256_set1_pd(4503599627371519.0))); // 2^52 + 1023
+	return _mm256_mul_pd(a, _mm256_castsi256_pd(_mm256_slli_epi64(bits, 52)));
+      }
+
+#elif defined(__SSE2__)
+      // ------------------------------------------------------------
+      // SSE2: 2 doubles per vector.
+      static const int width = 2;
+      typedef __m128d VecD;
+      typedef __m128d MaskD;
+
+      inline VecD set1(const double a) { return _mm_set1_pd(a); }
+      inline VecD loadu(const double* p) { return _mm_loadu_pd(p); }
+      inline void storeu(double* p, const VecD a) { _mm_storeu_pd(p, a); }
+      inline VecD add(const VecD a, const VecD b) { return _mm_add_pd(a, b); }
+      inline VecD sub(const VecD a, const VecD b) { return _mm_sub_pd(a, b); }
+      inline VecD mul(const VecD a, const VecD b) { return _mm_mul_pd(a, b); }
+      inline VecD div(const VecD a, const VecD b) { return _mm_div_pd(a, b); }
+      inline VecD fmadd(const VecD a, const VecD b, const VecD c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+      inline VecD min(const VecD a, const VecD b) { return _mm_min_pd(a, b); }
+      inline VecD max(const VecD a, const VecD b) { return _mm_max_pd(a, b); }
+      inline VecD abs(const VecD a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+      inline MaskD cmple(const VecD a, const VecD b) { return _mm_cmple_pd(a, b); }
+      inline MaskD cmplt(const VecD a, const VecD b) { return _mm_cmplt_pd(a, b); }
+      /// Select a where mask is set, b otherwise.
+      inline VecD select(const MaskD m, const VecD a, const VecD b) { return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b)); }
+      /// Load p[0], p[stride].
+      inline VecD loads(const double* p, const int stride) { return _mm_set_pd(p[stride], p[0]); }
+      /// Round to nearest integer (|a| < 2^51).
+      inline VecD round(const VecD a) {
+	const VecD magic = _mm_set1_pd(6755399441055744.0); // 2^52 + 2^51
+	return _mm_sub_pd(_mm_add_pd(a, magic), magic);
+      }
+      /// Compute a * 2^n for integral n in [-1022, 1023].
+      inline VecD scale2(const VecD a, const VecD n) {
+	// Adding 2^52 puts the biased exponent in the low mantissa bits.
+	const __m128i bits = _mm_castpd_si128(_mm_add_pd(n, _mm_set1_pd(4503599627371519.0))); // 2^52 + 1023
+	return _mm_mul_pd(a, _mm_castsi128_pd(_mm_slli_epi64(bits, 52)));
+      }
+
+#else
+      // ------------------------------------------------------------
+      // No SIMD instruction set enabled: 1 double per "vector".
+      static const int width = 1;
+      typedef double VecD;
+      typedef bool MaskD;
+
+      inline VecD set1(const double a) { return a; }
+      inline VecD loadu(const double* p) { return *p; }
+      inline void storeu(double* p, const VecD a) { *p = a; }
+      inline VecD add(const VecD a, const VecD b) { return a + b; }
+      inline VecD sub(const VecD a, const VecD b) { return a - b; }
+      inline VecD mul(const VecD a, const VecD b) { return a * b; }
+      inline VecD div(const VecD a, const VecD b) { return a / b; }
+      inline VecD fmadd(const VecD a, const VecD b, const VecD c) { return a * b + c; }
+      inline VecD min(const VecD a, const VecD b) { return (a < b) ? a : b; }
+      inline VecD max(const VecD a, const VecD b) { return (a > b) ? a : b; }
+      inline VecD abs(const VecD a) { return fabs(a); }
+      inline MaskD cmple(const VecD a, const VecD b) { return a <= b; }
+      inline MaskD cmplt(const VecD a, const VecD b) { return a < b; }
+      /// Select a where mask is set, b otherwise.
+      inline VecD select(const MaskD m, const VecD a, const VecD b) { return m ? a : b; }
+      /// Load p[0].
+      inline VecD loads(const double* p, const int stride) { return *p; }
+      /// Round to nearest integer.
+      inline VecD round(const VecD a) { return floor(a + 0.5); }
+      /// Compute a * 2^n for integral n.
+      inline VecD scale2(const VecD a, const VecD n) { return ldexp(a, int(n)); }
+#endif
+
+      /** Vectorized exponential.
+       *
+       * Reduces the argument to x = n ln(2) + r with |r| <= ln(2)/2
+       * and evaluates exp(r) with a degree 13 Taylor polynomial, which
+       * is accurate to about 1 ulp over the reduced range. Arguments
+       * are clamped to [-708, 709], so results below ~3e-308
+       * flush to this value instead of to zero.
+       *
+       * @param x Argument.
+       * @returns exp(x).
+       */
+      inline VecD exp(const VecD x) {
+	const VecD xc = min(max(x, set1(-708.0)), set1(709.0));
+	const VecD n = round(mul(xc, set1(1.4426950408889634074))); // 1/ln(2)
+	// Cody-Waite reduction with ln(2) split into a high and low part.
+	VecD r = fmadd(n, set1(-6.93145751953125e-1), xc);
+	r = fmadd(n, set1(-1.42860682030941723212e-6), r);
+
+	VecD p = set1(1.0/6227020800.0); // 1/13!
+	p = fmadd(p, r, set1(1.0/479001600.0));
+	p = fmadd(p, r, set1(1.0/39916800.0));
+	p = fmadd(p, r, set1(1.0/3628800.0));
+	p = fmadd(p, r, set1(1.0/362880.0));
+	p = fmadd(p, r, set1(1.0/40320.0));
+	p = fmadd(p, r, set1(1.0/5040.0));
+	p = fmadd(p, r, set1(1.0/720.0));
+	p = fmadd(p, r, set1(1.0/120.0));
+	p = fmadd(p, r, set1(1.0/24.0));
+	p = fmadd(p, r, set1(1.0/6.0));
+	p = fmadd(p, r, set1(0.5));
+	p = fmadd(p, r, set1(1.0));
+	p = fmadd(p, r, set1(1.0));
+
+	return scale2(p, n);
+      } // exp
+
+      /** Select a if x < y, b otherwise, without a branch.
+       *
+       * Scalar counterpart of select(cmplt(x, y), a, b) for the
+       * per-vertex kernels, where compilers turn the conditional
+       * operator on doubles into a (often mispredicted) branch.
+       */
+      inline double selectLess(const double x, const double y, const double a, const double b) {
+#if defined(__SSE2__)
+	const __m128d m = _mm_cmplt_sd(_mm_set_sd(x), _mm_set_sd(y));
+	return _mm_cvtsd_f64(_mm_or_pd(_mm_and_pd(m, _mm_set_sd(a)), _mm_andnot_pd(m, _mm_set_sd(b))));
+#else
+	return (x < y) ? a : b;
+#endif
+      } // selectLess
+
+      /// Flops in exp(): a multiply and 17 fused multiply-adds (2 flops
+      /// each). Also used for exp() from <cmath> in the scalar kernels.
+      static const int expFlops = 35;
+
+    } // simd
+  } // friction
+} // contrib
+
+#endif // pylith_friction_SIMDMath_hh
+
+
+// End of file
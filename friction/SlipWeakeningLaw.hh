@@ -0,0 +1,738 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+/* @brief C++ template for slip-weakening fault constitutive models
+ * without healing.
+ *
+ * The friction coefficient depends only on the cumulative slip, D,
+ * which is tracked with the state variables cumulative_slip and
+ * previous_slip and reset when the slip rate becomes negative. The
+ * updates count the vertices in each regime (see
+ * ContribFrictionModel::RegimeEnum) for the census. In compression
+ * the friction is
+ *
+ *   f = -\mu(D) N + cohesion,
+ *
+ * and in tension it is the cohesion.
+ *
+ * Laws constructed with diagnostics on have five more state
+ * variables, which follow the others. The state variable regime holds
+ * the regime of the vertex at the last update. The updates accumulate
+ * the frictional work, \int f dD, and the breakdown work, \int (f - f_d)
+ * dD with f_d the friction at the residual coefficient, over each
+ * slip increment (trapezoidal rule in D), and record the time of the
+ * first update with nonzero cumulative slip (rupture_time) and the
+ * time the vertex first reaches the end of weakening
+ * (weakening_end_time, see Curve::weakeningEnded()). Times are those
+ * of the updates, so they are resolved to the time step; times not
+ * reached are PYLITH_MAXSCALAR. These state variables can be output
+ * at the end of a run in place of the slip and traction history, and
+ * the difference of the two times gives the duration of the cohesive
+ * zone at each vertex. They are off by default, so a simulation that
+ * does not output them does not store or update them.
+ *
+ * Without the regime state variable, the law keeps a tension flag per
+ * vertex to tell whether a vertex entered or left tension (see
+ * ContribFrictionModel::tangentChanged()): batch updates keep them
+ * with the active sets of the state variables, and per-vertex updates
+ * in the order of the calls of each update. Only an update whose
+ * vertices cannot be matched to the previous one (e.g., after a
+ * per-vertex update changed the state of a batch) counts every vertex
+ * as a change after an update with a vertex in tension.
+ *
+ * Everything except the friction coefficient \mu(D) is implemented
+ * here. The friction coefficient is provided at compile time by the
+ * Curve policy, so it is inlined into the per-vertex and batch
+ * kernels. The law holds an instance of the Curve (_curve), so the
+ * functions below may also be const members of a curve with data of
+ * its own (e.g., the tables of TabulatedSlipWeakeningCurve). A Curve
+ * has the public members:
+ *
+ *   static const int numProperties;     // Number of stored properties.
+ *   static const int numDBProperties;   // Number of values in spatial database.
+ *   static const int p_cohesion;        // Index of cohesion in properties.
+ *   static const bool vectorized;       // True if coefficientSIMD() is provided.
+ *   static const pylith::materials::Metadata::ParamDescription properties[];
+ *   static const char* dbProperties[];
+ *   // Rules for the properties (see ContribFrictionModel::validateProperties()).
+ *   static const int numPropertyRules;
+ *   static const ContribFrictionModel::PropertyRule propertyRules[];
+ *   // Dimensions of the properties, including derived properties,
+ *   // which scale the properties of a vertex or a batch (see
+ *   // ContribFrictionModel::_scaleVertex()).
+ *   static const ContribFrictionModel::Dimension propertyDimensions[];
+ *
+ *   // Compute (and check) properties from values in spatial database.
+ *   static void dbToProperties(PylithScalar* const propValues,
+ *                              const pylith::scalar_array& dbValues);
+ *   // Friction coefficient and derivative coefficient at cumulative slip.
+ *   static PylithScalar coefficient(const PylithScalar slipCum,
+ *                                   const PylithScalar* properties,
+ *                                   PylithScalar* const derivCoef);
+ *   // Index of the weakening segment at slipCum (0 or 1, for the
+ *   // census and the regime state variable).
+ *   static int segment(const PylithScalar slipCum,
+ *                      const PylithScalar* properties);
+ *   // True if the friction coefficient is constant from slipCum on.
+ *   static bool fullyWeakened(const PylithScalar slipCum,
+ *                             const PylithScalar* properties);
+ *   // True if slipCum is past the end of weakening; curves that never
+ *   // reach the dynamic coefficient use the fraction of the strength
+ *   // drop (_weakeningEndFraction).
+ *   static bool weakeningEnded(const PylithScalar slipCum,
+ *                              const PylithScalar* properties,
+ *                              const PylithScalar fraction);
+ *   // Number of flops in coefficient() for the branch taken at slipCum
+ *   // (exp() counts as simd::expFlops).
+ *   static int coefficientFlops(const PylithScalar slipCum,
+ *                               const PylithScalar* properties);
+ *   static const int coefficientFlopsSIMD; // Flops per lane in coefficientSIMD().
+ *   // Slip from slipCum to the next kink of the friction coefficient
+ *   // (PYLITH_MAXSCALAR if there is none).
+ *   static PylithScalar slipToBreakpoint(const PylithScalar slipCum,
+ *                                        const PylithScalar* properties);
+ *   // Friction coefficient once fully weakened, and its flops.
+ *   static PylithScalar residualCoefficient(const PylithScalar* properties);
+ *   static const int residualCoefficientFlops;
+ *   // Sign of derivCoef relative to -d(mu)/d(slip).
+ *   static const int derivCoefSign;
+ *   // Same as coefficient() for a vector of vertices (if vectorized),
+ *   // see SIMDMath.hh; properties of the vertices are stride apart.
+ *   static simd::VecD coefficientSIMD(const simd::VecD slipCum,
+ *                                     const double* properties,
+ *                                     const int stride,
+ *                                     simd::VecD* const derivCoef);
+ *
+ * The derivative of friction with slip from _calcFrictionDeriv() in
+ * compression is N*derivCoef, so each law keeps the sign convention of
+ * its original implementation. The tangent holds the true partial
+ * derivatives instead: with slip it is
+ * -N*d(mu)/d(slip) = derivCoefSign*N*derivCoef times the sign of
+ * slip - slipPrev, with normal traction it is -\mu(D), and with slip
+ * rate it is zero.
+ *
+ * updateStateVarsBatch() sorts the vertices into active sets: vertices
+ * that did not slip in the step (locked), fully weakened vertices
+ * (residual), and the rest (weakening). Until the next update the
+ * friction coefficient of locked and residual vertices is fixed, so
+ * the batch functions fill in their friction from values stored with
+ * the sets and only run the full kernel on the weakening vertices and
+ * on locked vertices that have started to slip. Vertices in tension
+ * are identified from the normal traction in each call. The sets
+ * refer to the arrays passed to updateStateVarsBatch(); other arrays,
+ * or state variables updated one vertex at a time, are evaluated in
+ * full.
+ *
+ * Flops are logged for the branches each vertex takes: none in
+ * tension, 5 plus the flops of the Curve in compression (2 and 3 for
+ * residual and locked vertices evaluated from the active sets), and 2
+ * for an update while sliding plus, with diagnostics, the work
+ * accumulated over the slip increment (1 if the vertex did not slip,
+ * 3 in tension, and 12 plus two coefficients and the residual
+ * coefficient in compression). A derivative reused from
+ * _calcFriction() costs nothing. The tangent costs 1 more flop than
+ * the friction in compression. Vectorized lanes evaluate every
+ * expression, so they are counted in full.
+ *
+ * The definitions are in SlipWeakeningLaw.icc, which is included only
+ * by the implementation file of each law, where the template is
+ * explicitly instantiated for the law's Curve.
+ */
+
+#if !defined(pylith_friction_SlipWeakeningLaw_hh)
+#define pylith_friction_SlipWeakeningLaw_hh
+
+// Include directives ---------------------------------------------------
+#include "ContribFrictionModel.hh" // ISA ContribFrictionModel
+
+#include "spatialdata/units/unitsfwd.hh" // USES Nondimensional
+
+#include <vector> // HASA std::vector
+
+// Forward declarations
+namespace contrib {
+  namespace friction {
+    template<typename Curve> class SlipWeakeningLaw;
+  } // friction
+} // pylith
+
+// SlipWeakeningLaw -----------------------------------------------------
+template<typename Curve>
+class contrib::friction::SlipWeakeningLaw : public contrib::friction::ContribFrictionModel
+{ // class SlipWeakeningLaw
+  friend class TestSlipWeakeningLaw; // unit testing
+
+  // PUBLIC METHODS /////////////////////////////////////////////////////
+public :
+
+  /** Constructor.
+   *
+   * @param diagnostics True to add the diagnostic state variables.
+   */
+  SlipWeakeningLaw(const bool diagnostics);
+
+  /// Destructor.
+  ~SlipWeakeningLaw(void);
+
+  /** Get whether the law has the diagnostic state variables.
+   *
+   * @returns True if constructed with diagnostics on.
+   */
+  bool diagnostics(void) const;
+
+  // PROTECTED METHODS //////////////////////////////////////////////////
+protected :
+
+  /** Compute properties from values in spatial database.
+   *
+   * @param propValues Array of property values.
+   * @param dbValues Array of database values.
+   */
+  void _dbValuesToProperties(PylithScalar* const propValues,
+			     const pylith::scalar_array& dbValues) const;
+
+  /** Get rules for the properties at a vertex.
+   *
+   * @param rules Array of rules (rules of the model are appended).
+   */
+  void _propertyRules(std::vector<PropertyRule>* rules) const;
+
+  /** Get dimensions of the properties and state variables.
+   *
+   * @param properties Dimensions of properties [numProperties] (output).
+   * @param stateVars Dimensions of state variables [numStateVars] (output).
+   */
+  void _dimensions(std::vector<Dimension>* properties,
+		   std::vector<Dimension>* stateVars) const;
+
+  /// Invalidate the active sets, whose coefficients were computed
+  /// from the fields before they were rescaled.
+  void _fieldsRescaled(void);
+
+  /** Nondimensionalize properties.
+   *
+   * @param values Array of property values.
+   * @param nvalues Number of values.
+   */
+  void _nondimProperties(PylithScalar* const values,
+			 const int nvalues) const;
+
+  /** Dimensionalize properties.
+   *
+   * @param values Array of property values.
+   * @param nvalues Number of values.
+   */
+  void _dimProperties(PylithScalar* const values,
+		      const int nvalues) const;
+
+  /** Compute state variables from values in spatial database.
+   *
+   * @param stateValues Array of state variable values.
+   * @param dbValues Array of database values.
+   */
+  void _dbToStateVars(PylithScalar* const stateValues,
+		      const pylith::scalar_array& dbValues) const;
+
+  /** Nondimensionalize state variables.
+   *
+   * @param values Array of initial state values.
+   * @param nvalues Number of values.
+   */
+  void _nondimStateVars(PylithScalar* const values,
+			const int nvalues) const;
+
+  /** Dimensionalize state variables.
+   *
+   * @param values Array of initial state values.
+   * @param nvalues Number of values.
+   */
+  void _dimStateVars(PylithScalar* const values,
+		     const int nvalues) const;
+
+  /** Compute friction from properties and state variables.
+   *
+   * @param t Time in simulation.
+   * @param slip Current slip at location.
+   * @param slipRate Current slip rate at location.
+   * @param normalTraction Normal traction at location.
+   * @param properties Properties at location.
+   * @param numProperties Number of properties.
+   * @param stateVars State variables at location.
+   * @param numStateVars Number of state variables.
+   */
+  PylithScalar _calcFriction(const PylithScalar t,
+			     const PylithScalar slip,
+			     const PylithScalar slipRate,
+			     const PylithScalar normalTraction,
+			     const PylithScalar* properties,
+			     const int numProperties,
+			     const PylithScalar* stateVars,
+			     const int numStateVars);
+
+  /** Compute derivative friction with slip from properties and state
+   * variables.
+   *
+   * @param t Time in simulation.
+   * @param slip Current slip at location.
+   * @param slipRate Current slip rate at location.
+   * @param normalTraction Normal traction at location.
+   * @param properties Properties at location.
+   * @param numProperties Number of properties.
+   * @param stateVars State variables at location.
+   * @param numStateVars Number of state variables.
+   *
+   * @returns Derivative of friction (magnitude of shear traction) at vertex.
+   */
+  PylithScalar _calcFrictionDeriv(const PylithScalar t,
+				  const PylithScalar slip,
+				  const PylithScalar slipRate,
+				  const PylithScalar normalTraction,
+				  const PylithScalar* properties,
+				  const int numProperties,
+				  const PylithScalar* stateVars,
+				  const int numStateVars);
+
+  /** Compute friction and its tangent at a location.
+   *
+   * @param tangent Derivatives of friction [NUM_TANGENTS] (output).
+   * @param t Time in simulation.
+   * @param slip Current slip at location.
+   * @param slipRate Current slip rate at location.
+   * @param normalTraction Normal traction at location.
+   * @param properties Properties at location.
+   * @param numProperties Number of properties.
+   * @param stateVars State variables at location.
+   * @param numStateVars Number of state variables.
+   *
+   * @returns Friction (magnitude of shear traction) at location.
+   */
+  PylithScalar _calcFrictionTangent(PylithScalar* const tangent,
+				    const PylithScalar t,
+				    const PylithScalar slip,
+				    const PylithScalar slipRate,
+				    const PylithScalar normalTraction,
+				    const PylithScalar* properties,
+				    const int numProperties,
+				    const PylithScalar* stateVars,
+				    const int numStateVars);
+
+  /** Compute friction at a batch of fault vertices.
+   *
+   * @param friction Array of friction values [numVertices] (output).
+   * @param t Time in simulation.
+   * @param slip Array of slip [numVertices].
+   * @param slipRate Array of slip rate [numVertices].
+   * @param normalTraction Array of normal traction [numVertices].
+   * @param properties Array of properties [numVertices*numProperties].
+   * @param numProperties Number of properties per vertex.
+   * @param stateVars Array of state variables [numVertices*numStateVars].
+   * @param numStateVars Number of state variables per vertex.
+   * @param numVertices Number of vertices in batch.
+   */
+  void _calcFrictionBatch(PylithScalar* const friction,
+			  const PylithScalar t,
+			  const PylithScalar* slip,
+			  const PylithScalar* slipRate,
+			  const PylithScalar* normalTraction,
+			  const PylithScalar* properties,
+			  const int numProperties,
+			  const PylithScalar* stateVars,
+			  const int numStateVars,
+			  const int numVertices);
+
+  /** Compute friction and its derivative with slip at a batch of
+   * fault vertices.
+   *
+   * @param friction Array of friction values [numVertices] (output).
+   * @param frictionDeriv Array of derivatives of friction with slip [numVertices] (output).
+   * @param t Time in simulation.
+   * @param slip Array of slip [numVertices].
+   * @param slipRate Array of slip rate [numVertices].
+   * @param normalTraction Array of normal traction [numVertices].
+   * @param properties Array of properties [numVertices*numProperties].
+   * @param numProperties Number of properties per vertex.
+   * @param stateVars Array of state variables [numVertices*numStateVars].
+   * @param numStateVars Number of state variables per vertex.
+   * @param numVertices Number of vertices in batch.
+   */
+  void _calcFrictionAndDerivBatch(PylithScalar* const friction,
+				  PylithScalar* const frictionDeriv,
+				  const PylithScalar t,
+				  const PylithScalar* slip,
+				  const PylithScalar* slipRate,
+				  const PylithScalar* normalTraction,
+				  const PylithScalar* properties,
+				  const int numProperties,
+				  const PylithScalar* stateVars,
+				  const int numStateVars,
+				  const int numVertices);
+
+  /** Compute friction and its tangent at a batch of fault vertices.
+   *
+   * @param friction Array of friction values [numVertices] (output).
+   * @param tangent Array of derivatives of friction [numVertices*NUM_TANGENTS] (output).
+   * @param t Time in simulation.
+   * @param slip Array of slip [numVertices].
+   * @param slipRate Array of slip rate [numVertices].
+   * @param normalTraction Array of normal traction [numVertices].
+   * @param properties Array of properties [numVertices*numProperties].
+   * @param numProperties Number of properties per vertex.
+   * @param stateVars Array of state variables [numVertices*numStateVars].
+   * @param numStateVars Number of state variables per vertex.
+   * @param numVertices Number of vertices in batch.
+   */
+  void _calcFrictionTangentBatch(PylithScalar* const friction,
+				 PylithScalar* const tangent,
+				 const PylithScalar t,
+				 const PylithScalar* slip,
+				 const PylithScalar* slipRate,
+				 const PylithScalar* normalTraction,
+				 const PylithScalar* properties,
+				 const int numProperties,
+				 const PylithScalar* stateVars,
+				 const int numStateVars,
+				 const int numVertices);
+
+  /** Get distance to the next breakpoint of the friction coefficient
+   * at a batch of fault vertices.
+   *
+   * @param hint Minimum slip and time to the next breakpoint and
+   *   maximum weakening rate over batch (output).
+   * @param slipToBreakpoint Array of slip to next breakpoint
+   *   [numVertices] (output, may be NULL).
+   * @param weakeningRate Array of magnitude of derivative of friction
+   *   with slip [numVertices] (output, may be NULL).
+   * @param slip Array of slip [numVertices].
+   * @param slipRate Array of slip rate [numVertices].
+   * @param normalTraction Array of normal traction [numVertices].
+   * @param properties Array of properties [numVertices*numProperties].
+   * @param numProperties Number of properties per vertex.
+   * @param stateVars Array of state variables [numVertices*numStateVars].
+   * @param numStateVars Number of state variables per vertex.
+   * @param numVertices Number of vertices in batch.
+   */
+  void _breakpointsBatch(BreakpointHint* const hint,
+			 PylithScalar* const slipToBreakpoint,
+			 PylithScalar* const weakeningRate,
+			 const PylithScalar* slip,
+			 const PylithScalar* slipRate,
+			 const PylithScalar* normalTraction,
+			 const PylithScalar* properties,
+			 const int numProperties,
+			 const PylithScalar* stateVars,
+			 const int numStateVars,
+			 const int numVertices);
+
+  /** Update state variables (for next time step) at a batch of fault
+   * vertices and sort the vertices into active sets.
+   *
+   * @param t Time in simulation.
+   * @param slip Array of slip [numVertices].
+   * @param slipRate Array of slip rate [numVertices].
+   * @param normalTraction Array of normal traction [numVertices].
+   * @param stateVars Array of state variables [numVertices*numStateVars].
+   * @param numStateVars Number of state variables per vertex.
+   * @param properties Array of properties [numVertices*numProperties].
+   * @param numProperties Number of properties per vertex.
+   * @param numVertices Number of vertices in batch.
+   */
+  void _updateStateVarsBatch(const PylithScalar t,
+			     const PylithScalar* slip,
+			     const PylithScalar* slipRate,
+			     const PylithScalar* normalTraction,
+			     PylithScalar* const stateVars,
+			     const int numStateVars,
+			     const PylithScalar* properties,
+			     const int numProperties,
+			     const int numVertices);
+
+  /** Update state variables (for next time step).
+   *
+   * @param t Time in simulation.
+   * @param slip Current slip at location.
+   * @param slipRate Current slip rate at location.
+   * @param normalTraction Normal traction at location.
+   * @param stateVars State variables at location.
+   * @param numStateVars Number of state variables.
+   * @param properties Properties at location.
+   * @param numProperties Number of properties.
+   */
+  void _updateStateVars(const PylithScalar t,
+			const PylithScalar slip,
+			const PylithScalar slipRate,
+			const PylithScalar normalTraction,
+			PylithScalar* const stateVars,
+			const int numStateVars,
+			const PylithScalar* properties,
+			const int numProperties);
+
+  // PROTECTED MEMBERS //////////////////////////////////////////////////
+protected :
+
+  /// Indices for state variables in section and spatial database.
+  /// The diagnostic state variables follow the others.
+  static const int s_slipCum = 0;
+  static const int s_slipPrev = s_slipCum + 1;
+  static const int numStateVarsBase = s_slipPrev + 1;
+  static const int s_regime = numStateVarsBase;
+  static const int s_frictionalWork = s_regime + 1;
+  static const int s_breakdownWork = s_frictionalWork + 1;
+  static const int s_ruptureTime = s_breakdownWork + 1;
+  static const int s_weakeningEndTime = s_ruptureTime + 1;
+  static const int numStateVarsDiagnostics = s_weakeningEndTime + 1;
+
+  static const int db_slipCum = 0;
+  static const int db_slipPrev = db_slipCum + 1;
+
+  /// Fraction of the strength drop that ends weakening for curves
+  /// that never reach the dynamic coefficient.
+  PylithScalar _weakeningEndFraction;
+
+  Curve _curve; ///< Friction coefficient.
+
+  const bool _diagnostics; ///< True if the law has the diagnostic state variables.
+
+  // PRIVATE METHODS ////////////////////////////////////////////////////
+private :
+
+  /** Compute friction and its derivative with slip at a location in
+   * one pass. Shared by the per-vertex and batch interfaces.
+   *
+   * @param slip Current slip at location.
+   * @param normalTraction Normal traction at location.
+   * @param properties Properties at location.
+   * @param stateVars State variables at location.
+   * @param frictionDeriv Derivative of friction with slip (output).
+   *
+   * @returns Friction (magnitude of shear traction) at location.
+   */
+  PylithScalar _frictionKernel(const PylithScalar slip,
+			       const PylithScalar normalTraction,
+			       const PylithScalar* properties,
+			       const PylithScalar* stateVars,
+			       PylithScalar* const frictionDeriv) const;
+
+  /** Compute friction and its tangent at a location. Shared by the
+   * per-vertex and batch interfaces.
+   *
+   * The tangent holds the partial derivatives of friction (see
+   * TangentEnum). Cumulative slip grows with |slip - slipPrev|, so
+   * the derivative with slip changes sign when slip is below the
+   * previous slip; at the previous slip it is the derivative for
+   * increasing slip.
+   *
+   * @param slip Current slip at location.
+   * @param normalTraction Normal traction at location.
+   * @param properties Properties at location.
+   * @param stateVars State variables at location.
+   * @param tangent Derivatives of friction [NUM_TANGENTS] (output).
+   *
+   * @returns Friction (magnitude of shear traction) at location.
+   */
+  PylithScalar _tangentKernel(const PylithScalar slip,
+			      const PylithScalar normalTraction,
+			      const PylithScalar* properties,
+			      const PylithScalar* stateVars,
+			      PylithScalar* const tangent) const;
+
+  /** Get number of flops in _frictionKernel() at a location.
+   *
+   * @param slip Current slip at location.
+   * @param normalTraction Normal traction at location.
+   * @param properties Properties at location.
+   * @param stateVars State variables at location.
+   *
+   * @returns Number of flops for the branches taken at location.
+   */
+  int _kernelFlops(const PylithScalar slip,
+		   const PylithScalar normalTraction,
+		   const PylithScalar* properties,
+		   const PylithScalar* stateVars) const;
+
+  /** Update cumulative and previous slip at a location.
+   *
+   * @param slip Current slip at location.
+   * @param slipRate Current slip rate at location.
+   * @param stateVars State variables at location.
+   *
+   * @returns Number of flops.
+   */
+  static
+  int _updateSlip(const PylithScalar slip,
+		   const PylithScalar slipRate,
+		   PylithScalar* const stateVars);
+
+  /** Accumulate frictional and breakdown work over the slip increment
+   * at a location. Must be called before _updateSlip().
+   *
+   * @param slip Current slip at location.
+   * @param normalTraction Normal traction at location.
+   * @param properties Properties at location.
+   * @param stateVars State variables at location.
+   *
+   * @returns Number of flops.
+   */
+  int _updateWork(const PylithScalar slip,
+		  const PylithScalar normalTraction,
+		  const PylithScalar* properties,
+		  PylithScalar* const stateVars) const;
+
+  /** Record the times a location enters and leaves the cohesive zone.
+   *
+   * @param t Time of state update.
+   * @param fraction Fraction of strength drop that ends weakening.
+   * @param properties Properties at location.
+   * @param stateVars Updated state variables at location.
+   */
+  void _updateTimes(const PylithScalar t,
+		    const PylithScalar fraction,
+		    const PylithScalar* properties,
+		    PylithScalar* const stateVars) const;
+
+  /** Get regime of a location after the update of its state variables.
+   *
+   * @param slipped True if the location slipped during the time step.
+   * @param normalTraction Normal traction at location.
+   * @param properties Properties at location.
+   * @param stateVars Updated state variables at location.
+   *
+   * @returns Regime.
+   */
+  RegimeEnum _regime(const bool slipped,
+		     const PylithScalar normalTraction,
+		     const PylithScalar* properties,
+		     const PylithScalar* stateVars) const;
+
+  /** Check whether the derivative of friction with slip at a location
+   * changed in the update of its state variables.
+   *
+   * The derivative changes if the location enters or leaves tension
+   * or if the slope of the friction coefficient differs at the old
+   * and new cumulative slip.
+   *
+   * @param slipCumPrev Cumulative slip before the update.
+   * @param tensionPrev True if the location was in tension before the update.
+   * @param normalTraction Normal traction at location.
+   * @param properties Properties at location.
+   * @param stateVars Updated state variables at location.
+   * @param flops Number of flops (output).
+   *
+   * @returns True if the derivative changed.
+   */
+  bool _tangentChanged(const PylithScalar slipCumPrev,
+		       const bool tensionPrev,
+		       const PylithScalar normalTraction,
+		       const PylithScalar* properties,
+		       const PylithScalar* stateVars,
+		       int* flops) const;
+
+  /** Compute friction and its derivative with slip at a batch of
+   * fault vertices with the full kernel.
+   *
+   * @param friction Array of friction values [numVertices] (output).
+   * @param frictionDeriv Array of derivatives of friction with slip
+   *   [numVertices] (output, may be NULL).
+   * @param slip Array of slip [numVertices].
+   * @param normalTraction Array of normal traction [numVertices].
+   * @param properties Array of properties [numVertices*numProperties].
+   * @param stateVars Array of state variables [numVertices*numStateVars].
+   * @param numVertices Number of vertices in batch.
+   *
+   * Logs the flops of the vectorized lanes and of the branches taken
+   * by the remaining vertices.
+   */
+  void _kernelBatch(PylithScalar* const friction,
+		    PylithScalar* const frictionDeriv,
+		    const PylithScalar* slip,
+		    const PylithScalar* normalTraction,
+		    const PylithScalar* properties,
+		    const PylithScalar* stateVars,
+		    const int numVertices) const;
+
+  /** Compute friction and its derivative with slip at a batch of
+   * fault vertices using the active sets.
+   *
+   * @param friction Array of friction values [numVertices] (output).
+   * @param frictionDeriv Array of derivatives of friction with slip
+   *   [numVertices] (output, may be NULL).
+   * @param slip Array of slip [numVertices].
+   * @param normalTraction Array of normal traction [numVertices].
+   * @param properties Array of properties [numVertices*numProperties].
+   * @param stateVars Array of state variables [numVertices*numStateVars].
+   * @param numVertices Number of vertices in batch.
+   *
+   * @returns Number of vertices evaluated with the full kernel, or -1
+   * if the active sets do not apply to the arrays.
+   */
+  int _activeSetBatch(PylithScalar* const friction,
+		      PylithScalar* const frictionDeriv,
+		      const PylithScalar* slip,
+		      const PylithScalar* normalTraction,
+		      const PylithScalar* properties,
+		      const PylithScalar* stateVars,
+		      const int numVertices);
+
+  // PRIVATE STRUCTS ////////////////////////////////////////////////////
+private :
+
+  /// Vertices sorted by regime at the last batch update.
+  struct ActiveSets {
+    std::vector<int> locked; ///< Vertices that did not slip.
+    std::vector<int> weakening; ///< Vertices that slipped and are not fully weakened.
+    std::vector<int> residual; ///< Fully weakened vertices.
+    std::vector<PylithScalar> lockedCoefs; ///< Friction and derivative coefficients of locked vertices.
+    std::vector<PylithScalar> residualCoefs; ///< Friction coefficients of residual vertices.
+    const PylithScalar* properties; ///< Properties the sets were built from.
+    const PylithScalar* stateVars; ///< State variables the sets were built from.
+    int numVertices; ///< Number of vertices in batch.
+    bool valid; ///< True if state variables have not changed since.
+
+    std::vector<char> regimes; ///< Work space for regimes of vertices in update.
+    std::vector<char> censusRegimes; ///< Census regimes of vertices at the last batch update (also work space).
+    std::vector<char> lockedSlipped; ///< Work space for locked vertices that have slipped.
+    std::vector<int> kernelVertices; ///< Work space for vertices needing the full kernel.
+    std::vector<PylithScalar> kernelValues; ///< Work space for gathered kernel values.
+  }; // ActiveSets
+
+  /// Vertices in tension at the per-vertex state updates, in the order
+  /// of the calls at each update.
+  struct UpdateTension {
+    std::vector<char> previous; ///< Flags of vertices in tension at the previous update.
+    std::vector<char> current; ///< Flags of vertices in tension at the current update.
+    PylithScalar t; ///< Time of the current update.
+    bool started; ///< True if the current update has started.
+  }; // UpdateTension
+
+  // PRIVATE MEMBERS ////////////////////////////////////////////////////
+private :
+
+  ActiveSets _activeSets; ///< Active sets from last batch update.
+  UpdateTension _updateTension; ///< Vertices in tension at per-vertex updates.
+
+  // NOT IMPLEMENTED ////////////////////////////////////////////////////
+private :
+
+  SlipWeakeningLaw(const SlipWeakeningLaw&); ///< Not implemented.
+  const SlipWeakeningLaw& operator=(const SlipWeakeningLaw&); ///< Not implemented
+
+}; // class SlipWeakeningLaw
+
+#endif // pylith_friction_SlipWeakeningLaw_hh
+
+
+// End of file
@@ -0,0 +1,460 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+// See TabulatedSlipWeakeningNoHeal.hh for a description of each C++
+// function and its arguments.
+
+#include <portinfo> // machine specific info generated by configure
+
+#include "TabulatedSlipWeakeningNoHeal.hh" // implementation of object methods
+
+#include "SlipWeakeningLaw.icc" // implementation of template methods
+#include "SIMDMath.hh" // USES simd::selectLess()
+
+#include "pylith/utils/array.hh" // USES scalar_array
+#include "pylith/utils/constdefs.h" // USES PYLITH_MAXSCALAR
+
+#include "spatialdata/units/Nondimensional.hh" // USES Nondimensional
+
+#include <algorithm> // USES std::min(), std::max()
+#include <cassert> // USES assert()
+#include <fstream> // USES std::ifstream
+#include <sstream> // USES std::ostringstream, std::istringstream
+#include <stdexcept> // USES std::runtime_error
+
+// ----------------------------------------------------------------------
+// Physical properties.
+const pylith::materials::Metadata::ParamDescription
+contrib::friction::TabulatedSlipWeakeningCurve::properties[numProperties] = {
+  { "curve_index", 1, pylith::topology::FieldBase::SCALAR },
+  { "cohesion", 1, pylith::topology::FieldBase::SCALAR },
+};
+
+// Values expected in spatial database.
+const char*
+contrib::friction::TabulatedSlipWeakeningCurve::dbProperties[numDBProperties] = {
+  "curve_index",
+  "cohesion",
+};
+
+// Rules for properties.
+const contrib::friction::ContribFrictionModel::PropertyRule
+contrib::friction::TabulatedSlipWeakeningCurve::propertyRules[numPropertyRules] = {
+  { "cohesion >= 0", ContribFrictionModel::NONNEGATIVE_RULE, p_cohesion, p_cohesion, 0 },
+};
+
+// Dimensions of properties.
+const contrib::friction::ContribFrictionModel::Dimension
+contrib::friction::TabulatedSlipWeakeningCurve::propertyDimensions[numProperties] = {
+  { 0, 0, 0 }, // curve_index
+  { 0, 1, 0 }, // cohesion
+};
+
+// ----------------------------------------------------------------------
+// Default constructor.
+contrib::friction::TabulatedSlipWeakeningCurve::TabulatedSlipWeakeningCurve(void) :
+  _lengthScale(1.0)
+{ // constructor
+} // constructor
+
+// ----------------------------------------------------------------------
+// Add table of friction coefficients.
+int
+contrib::friction::TabulatedSlipWeakeningCurve::addTable(const PylithScalar* values,
+							 const int numPoints,
+							 const PylithScalar slipSpacing,
+							 const bool cubic)
+{ // addTable
+  // Check consistency of arguments.
+  assert(values);
+  assert(numPoints >= 2);
+  assert(slipSpacing > 0.0);
+
+  TableInfo table;
+  table.offset = _coefs.size();
+  table.numIntervals = numPoints - 1;
+  table.slipSpacing = slipSpacing;
+  table.invSpacing = _lengthScale / slipSpacing;
+
+  // Store a cubic polynomial in the local coordinate u in [0,1] for
+  // each interval, mu = c0 + u*(c1 + u*(c2 + u*c3)). Linear
+  // interpolation has c2 = c3 = 0. Cubic interpolation uses Hermite
+  // polynomials with Catmull-Rom slopes (one-sided at the ends), so it
+  // passes through the tabulated values and has a continuous
+  // derivative.
+  _coefs.resize(table.offset + _coefsPerInterval*table.numIntervals);
+  for (int i=0; i < table.numIntervals; ++i) {
+    PylithScalar* c = &_coefs[table.offset + _coefsPerInterval*i];
+    const PylithScalar mu0 = values[i];
+    const PylithScalar mu1 = values[i+1];
+    if (cubic) {
+      const PylithScalar slope0 = (i > 0) ?
+	0.5*(mu1 - values[i-1]) : mu1 - mu0;
+      const PylithScalar slope1 = (i+2 < numPoints) ?
+	0.5*(values[i+2] - mu0) : mu1 - mu0;
+      c[0] = mu0;
+      c[1] = slope0;
+      c[2] = 3.0*(mu1 - mu0) - 2.0*slope0 - slope1;
+      c[3] = 2.0*(mu0 - mu1) + slope0 + slope1;
+    } else {
+      c[0] = mu0;
+      c[1] = mu1 - mu0;
+      c[2] = 0.0;
+      c[3] = 0.0;
+    } // if/else
+  } // for
+
+  _tables.push_back(table);
+  return _tables.size() - 1;
+} // addTable
+
+// ----------------------------------------------------------------------
+// Remove all tables.
+void
+contrib::friction::TabulatedSlipWeakeningCurve::clearTables(void)
+{ // clearTables
+  _tables.clear();
+  _coefs.clear();
+} // clearTables
+
+// ----------------------------------------------------------------------
+// Get number of tables.
+int
+contrib::friction::TabulatedSlipWeakeningCurve::numTables(void) const
+{ // numTables
+  return _tables.size();
+} // numTables
+
+// ----------------------------------------------------------------------
+// Set the length scale of the normalizer.
+void
+contrib::friction::TabulatedSlipWeakeningCurve::lengthScale(const PylithScalar value)
+{ // lengthScale
+  assert(value > 0.0);
+
+  _lengthScale = value;
+  const int numTables = _tables.size();
+  for (int i=0; i < numTables; ++i)
+    _tables[i].invSpacing = _lengthScale / _tables[i].slipSpacing;
+} // lengthScale
+
+// ----------------------------------------------------------------------
+// Compute properties from values in spatial database.
+void
+contrib::friction::TabulatedSlipWeakeningCurve::dbToProperties(PylithScalar* const propValues,
+							       const pylith::scalar_array& dbValues)
+{ // dbToProperties
+  // Check consistency of arguments
+  assert(propValues);
+  assert(numDBProperties == int(dbValues.size()));
+
+  // Extract values from array using our defined indices.
+  const PylithScalar curveIndex = dbValues[db_curveIndex];
+  const PylithScalar cohesion = dbValues[db_cohesion];
+
+  // Check for reasonable values. If user supplied unreasonable values
+  // throw an exception.
+  if (curveIndex < 0.0 || curveIndex != PylithScalar(int(curveIndex))) {
+    std::ostringstream msg;
+    msg << "Spatial database returned invalid value for curve index. "
+	<< "Curve index must be a nonnegative integer.\n"
+	<< "Curve index: " << curveIndex << "\n";
+    throw std::runtime_error(msg.str());
+  } // if
+
+  if (cohesion < 0.0) {
+    std::ostringstream msg;
+    msg << "Spatial database returned negative value for cohesion.\n"
+	<< "Cohesion: " << cohesion << "\n";
+    throw std::runtime_error(msg.str());
+  } // if
+
+  // Compute parameters that we store from the user-supplied parameters.
+  propValues[p_curveIndex] = curveIndex;
+  propValues[p_cohesion] = cohesion;
+} // dbToProperties
+
+// ----------------------------------------------------------------------
+// Get table of a location.
+inline
+const contrib::friction::TabulatedSlipWeakeningCurve::TableInfo&
+contrib::friction::TabulatedSlipWeakeningCurve::_table(const PylithScalar* properties) const
+{ // _table
+  const int curveIndex = int(properties[p_curveIndex]);
+  assert(0 <= curveIndex && curveIndex < int(_tables.size()));
+  return _tables[curveIndex];
+} // _table
+
+// ----------------------------------------------------------------------
+// Compute friction coefficient at a location.
+inline
+PylithScalar
+contrib::friction::TabulatedSlipWeakeningCurve::coefficient(const PylithScalar slipCum,
+							    const PylithScalar* properties,
+							    PylithScalar* const derivCoef) const
+{ // coefficient
+  // Position on the grid, clamped to the tabulated range. Past the
+  // end of the table the coefficient is the last value and the
+  // derivative is zero.
+  const TableInfo& table = _table(properties);
+  const int numIntervals = table.numIntervals;
+  const PylithScalar x = slipCum * table.invSpacing;
+  const PylithScalar xClamped =
+    std::min(std::max(x, PylithScalar(0.0)), PylithScalar(numIntervals));
+  const int i = std::min(int(xClamped), numIntervals-1);
+  const PylithScalar u = xClamped - i;
+
+  const PylithScalar* c = &_coefs[table.offset + _coefsPerInterval*i];
+
+  // The derivative follows the sign convention of
+  // DoubleSlipWeakeningFrictionNoHeal, i.e., -dmu/dD.
+  const PylithScalar dmudu = c[1] + u*(2.0*c[2] + 3.0*u*c[3]);
+  *derivCoef = simd::selectLess(x, PylithScalar(numIntervals),
+				-dmudu * table.invSpacing, 0.0);
+  return c[0] + u*(c[1] + u*(c[2] + u*c[3]));
+} // coefficient
+
+// ----------------------------------------------------------------------
+// Get index of weakening segment at a location.
+inline
+int
+contrib::friction::TabulatedSlipWeakeningCurve::segment(const PylithScalar slipCum,
+							const PylithScalar* properties)
+{ // segment
+  return 0;
+} // segment
+
+// ----------------------------------------------------------------------
+// Check whether the friction coefficient no longer changes with slip.
+inline
+bool
+contrib::friction::TabulatedSlipWeakeningCurve::fullyWeakened(const PylithScalar slipCum,
+							      const PylithScalar* properties) const
+{ // fullyWeakened
+  // Same test as in coefficient().
+  const TableInfo& table = _table(properties);
+  return !(slipCum * table.invSpacing < PylithScalar(table.numIntervals));
+} // fullyWeakened
+
+// ----------------------------------------------------------------------
+// Check whether a location has reached the end of weakening.
+inline
+bool
+contrib::friction::TabulatedSlipWeakeningCurve::weakeningEnded(const PylithScalar slipCum,
+							       const PylithScalar* properties,
+							       const PylithScalar fraction) const
+{ // weakeningEnded
+  return fullyWeakened(slipCum, properties);
+} // weakeningEnded
+
+// ----------------------------------------------------------------------
+// Get number of flops in coefficient() at a location.
+inline
+int
+contrib::friction::TabulatedSlipWeakeningCurve::coefficientFlops(const PylithScalar slipCum,
+								 const PylithScalar* properties)
+{ // coefficientFlops
+  // The derivative is evaluated and then selected (see coefficient()).
+  return 15;
+} // coefficientFlops
+
+// ----------------------------------------------------------------------
+// Get slip from a location to the next breakpoint of the friction
+// coefficient.
+inline
+PylithScalar
+contrib::friction::TabulatedSlipWeakeningCurve::slipToBreakpoint(const PylithScalar slipCum,
+								 const PylithScalar* properties) const
+{ // slipToBreakpoint
+  // Same test as in coefficient().
+  const TableInfo& table = _table(properties);
+  const PylithScalar x = slipCum * table.invSpacing;
+  if (!(x < PylithScalar(table.numIntervals)))
+    return PYLITH_MAXSCALAR;
+  return (int(x) + 1) / table.invSpacing - slipCum;
+} // slipToBreakpoint
+
+// ----------------------------------------------------------------------
+// Get friction coefficient at a location once fully weakened.
+inline
+PylithScalar
+contrib::friction::TabulatedSlipWeakeningCurve::residualCoefficient(const PylithScalar* properties) const
+{ // residualCoefficient
+  // Value at the end of the last interval (u = 1 in coefficient()).
+  const TableInfo& table = _table(properties);
+  const PylithScalar* c =
+    &_coefs[table.offset + _coefsPerInterval*(table.numIntervals-1)];
+  return c[0] + c[1] + c[2] + c[3];
+} // residualCoefficient
+
+// ----------------------------------------------------------------------
+// Constructor.
+contrib::friction::TabulatedSlipWeakeningNoHeal::TabulatedSlipWeakeningNoHeal(const bool diagnostics) :
+  SlipWeakeningLaw<TabulatedSlipWeakeningCurve>(diagnostics)
+{ // constructor
+  _scalesChanged();
+} // constructor
+
+// ----------------------------------------------------------------------
+// Destructor.
+contrib::friction::TabulatedSlipWeakeningNoHeal::~TabulatedSlipWeakeningNoHeal(void)
+{ // destructor
+} // destructor
+
+// ----------------------------------------------------------------------
+// Read tables of friction coefficients from file.
+void
+contrib::friction::TabulatedSlipWeakeningNoHeal::filename(const char* value)
+{ // filename
+  assert(value);
+
+  _filename = value;
+  _curve.clearTables();
+
+  std::ifstream fin(value);
+  if (!fin.is_open() || !fin.good()) {
+    std::ostringstream msg;
+    msg << "Could not open file '" << value
+	<< "' with tabulated friction coefficients.";
+    throw std::runtime_error(msg.str());
+  } // if
+
+  // Strip comments, then parse the remaining values.
+  std::ostringstream contents;
+  std::string line;
+  while (std::getline(fin, line)) {
+    const size_t pos = line.find("//");
+    contents << line.substr(0, pos) << "\n";
+  } // while
+  fin.close();
+  std::istringstream sin(contents.str());
+
+  int numTables = 0;
+  sin >> numTables;
+  if (sin.fail() || numTables <= 0) {
+    std::ostringstream msg;
+    msg << "Could not read number of tables from file '" << value
+	<< "'. Number of tables must be positive.";
+    throw std::runtime_error(msg.str());
+  } // if
+
+  pylith::scalar_array values;
+  for (int iTable=0; iTable < numTables; ++iTable) {
+    int numPoints = 0;
+    PylithScalar slipSpacing = 0.0;
+    std::string interpolation;
+    sin >> numPoints >> slipSpacing >> interpolation;
+    if (sin.fail() || numPoints < 2 || slipSpacing <= 0.0 ||
+	(interpolation != "linear" && interpolation != "cubic")) {
+      std::ostringstream msg;
+      msg << "Error reading header of table " << iTable << " in file '"
+	  << value << "'.\n"
+	  << "Expected number of points (at least 2), positive slip spacing, "
+	  << "and interpolation ('linear' or 'cubic').";
+      throw std::runtime_error(msg.str());
+    } // if
+
+    values.resize(numPoints);
+    for (int iPoint=0; iPoint < numPoints; ++iPoint) {
+      sin >> values[iPoint];
+      if (sin.fail()) {
+	std::ostringstream msg;
+	msg << "Error reading value " << iPoint << " of table " << iTable
+	    << " in file '" << value << "'.";
+	throw std::runtime_error(msg.str());
+      } // if
+      if (values[iPoint] <= 0.0) {
+	std::ostringstream msg;
+	msg << "Found nonpositive friction coefficient in table " << iTable
+	    << " in file '" << value << "'.\n"
+	    << "Friction coefficient " << iPoint << ": " << values[iPoint];
+	throw std::runtime_error(msg.str());
+      } // if
+    } // for
+
+    addTable(&values[0], numPoints, slipSpacing, "cubic" == interpolation);
+  } // for
+} // filename
+
+// ----------------------------------------------------------------------
+// Add table of friction coefficients.
+int
+contrib::friction::TabulatedSlipWeakeningNoHeal::addTable(const PylithScalar* values,
+							  const int numPoints,
+							  const PylithScalar slipSpacing,
+							  const bool cubic)
+{ // addTable
+  return _curve.addTable(values, numPoints, slipSpacing, cubic);
+} // addTable
+
+// ----------------------------------------------------------------------
+// Get number of tables.
+int
+contrib::friction::TabulatedSlipWeakeningNoHeal::numTables(void) const
+{ // numTables
+  return _curve.numTables();
+} // numTables
+
+// ----------------------------------------------------------------------
+// Compute properties from values in spatial database.
+void
+contrib::friction::TabulatedSlipWeakeningNoHeal::_dbValuesToProperties(PylithScalar* const propValues,
+								       const pylith::scalar_array& dbValues) const
+{ // _dbValuesToProperties
+  SlipWeakeningLaw<TabulatedSlipWeakeningCurve>::_dbValuesToProperties(propValues, dbValues);
+
+  const int curveIndex = int(propValues[TabulatedSlipWeakeningCurve::p_curveIndex]);
+  if (curveIndex >= _curve.numTables()) {
+    std::ostringstream msg;
+    msg << "Spatial database returned curve index " << curveIndex
+	<< ", but only " << _curve.numTables() << " tables were read from '"
+	<< _filename << "'.";
+    throw std::runtime_error(msg.str());
+  } // if
+} // _dbValuesToProperties
+
+// ----------------------------------------------------------------------
+// Get rules for the properties at a vertex.
+void
+contrib::friction::TabulatedSlipWeakeningNoHeal::_propertyRules(std::vector<PropertyRule>* rules) const
+{ // _propertyRules
+  assert(rules);
+
+  SlipWeakeningLaw<TabulatedSlipWeakeningCurve>::_propertyRules(rules);
+  const PropertyRule curveIndex = {
+    "curve_index is the index of a table", INDEX_RULE,
+    TabulatedSlipWeakeningCurve::p_curveIndex, TabulatedSlipWeakeningCurve::p_curveIndex,
+    _curve.numTables(),
+  };
+  rules->push_back(curveIndex);
+} // _propertyRules
+
+// ----------------------------------------------------------------------
+// Rescale the slip spacing of the tables.
+void
+contrib::friction::TabulatedSlipWeakeningNoHeal::_scalesChanged(void)
+{ // _scalesChanged
+  assert(_normalizer);
+  _curve.lengthScale(_normalizer->lengthScale());
+} // _scalesChanged
+
+// Instantiate the slip-weakening law for this friction coefficient.
+template class contrib::friction::SlipWeakeningLaw<contrib::friction::TabulatedSlipWeakeningCurve>;
+
+
+// End of file
@@ -0,0 +1,353 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+/* @brief C++ TabulatedSlipWeakeningNoHeal object that implements
+ * friction with an arbitrary, tabulated dependence on slip.
+ *
+ * The friction coefficient is given as a table of values on a uniform
+ * grid of cumulative slip, D = 0, h, 2h, ..., (n-1)h, and is
+ * interpolated linearly or with a C1 cubic (Catmull-Rom) between grid
+ * points. Beyond the last grid point the friction coefficient is the
+ * last value in the table. A fault may use several tables; the
+ * physical properties are the index of the table (curve_index) and
+ * the cohesion.
+ *
+ * The tables are read from a file (see filename()) with the format
+ *
+ *   // Comments start with // and continue to the end of the line.
+ *   num-tables
+ *   num-points slip-spacing(m) linear|cubic mu_0 mu_1 ... mu_{n-1}
+ *   ...
+ *
+ * i.e., the number of tables followed by one entry per table. Values
+ * may be split across lines.
+ *
+ * Each table is converted to one cubic polynomial per interval, so
+ * evaluating the friction and its derivative costs a lookup and a few
+ * multiply-adds regardless of the shape of the curve.
+ */
+
+#if !defined(pylith_friction_TabulatedSlipWeakeningNoHeal_hh)
+#define pylith_friction_TabulatedSlipWeakeningNoHeal_hh
+
+// Include directives ---------------------------------------------------
+#include "SlipWeakeningLaw.hh" // ISA SlipWeakeningLaw
+
+#include "pylith/materials/Metadata.hh" // HASA ParamDescription
+
+#include <string> // HASA std::string
+#include <vector> // HASA std::vector
+
+// Forward declarations
+namespace contrib {
+  namespace friction {
+    class TabulatedSlipWeakeningCurve;
+    class TabulatedSlipWeakeningNoHeal;
+  } // friction
+} // pylith
+
+// TabulatedSlipWeakeningCurve ------------------------------------------
+/** Friction coefficient for TabulatedSlipWeakeningNoHeal (see
+ * SlipWeakeningLaw).
+ *
+ * Each curve object holds its own tables, with the interpolation
+ * coefficients of all of them in one array. The kernels locate the
+ * table of a vertex from its curve_index, the position of the table
+ * in the object, so the properties do not depend on the tables of
+ * other objects.
+ */
+class contrib::friction::TabulatedSlipWeakeningCurve
+{ // class TabulatedSlipWeakeningCurve
+  friend class TestTabulatedSlipWeakeningNoHeal; // unit testing
+
+  // PUBLIC MEMBERS /////////////////////////////////////////////////////
+public :
+
+  // --------------------------------------------------------------------
+  // We use these constants for consistent access into the arrays of
+  // physical properties.
+  // --------------------------------------------------------------------
+
+  static const int p_curveIndex = 0;
+  static const int p_cohesion = p_curveIndex + 1;
+  static const int numProperties = p_cohesion + 1;
+
+  /// Indices of values in spatial database (order must match dbProperties).
+  static const int db_curveIndex = 0;
+  static const int db_cohesion = db_curveIndex + 1;
+  static const int numDBProperties = db_cohesion + 1;
+
+  static const bool vectorized = false;
+  static const int residualCoefficientFlops = 3;
+
+  /// Sign of derivCoef from coefficient() relative to -d(mu)/d(slip).
+  static const int derivCoefSign = 1;
+
+  static const pylith::materials::Metadata::ParamDescription properties[numProperties];
+  static const char* dbProperties[numDBProperties];
+
+  /// Rules for properties (see ContribFrictionModel::validateProperties()).
+  static const int numPropertyRules = 1;
+  static const ContribFrictionModel::PropertyRule propertyRules[numPropertyRules];
+
+  /// Dimensions of properties (see ContribFrictionModel::Dimension).
+  static const ContribFrictionModel::Dimension propertyDimensions[numProperties];
+
+  // PUBLIC METHODS /////////////////////////////////////////////////////
+public :
+
+  /// Default constructor (no tables).
+  TabulatedSlipWeakeningCurve(void);
+
+  /** Add table of friction coefficients.
+   *
+   * @param values Friction coefficients at grid points [numPoints].
+   * @param numPoints Number of grid points.
+   * @param slipSpacing Spacing of grid points in slip (dimensional).
+   * @param cubic True for cubic interpolation, false for linear.
+   *
+   * @returns Index of table (curve_index of the vertices using it).
+   */
+  int addTable(const PylithScalar* values,
+	       const int numPoints,
+	       const PylithScalar slipSpacing,
+	       const bool cubic);
+
+  /// Remove all tables.
+  void clearTables(void);
+
+  /** Get number of tables.
+   *
+   * @returns Number of tables.
+   */
+  int numTables(void) const;
+
+  /** Set the length scale of the normalizer, which scales the slip
+   * spacing of the tables in the kernels.
+   *
+   * @param value Length scale.
+   */
+  void lengthScale(const PylithScalar value);
+
+  /** Compute properties from values in spatial database.
+   *
+   * @param propValues Array of property values.
+   * @param dbValues Array of database values.
+   */
+  static
+  void dbToProperties(PylithScalar* const propValues,
+		      const pylith::scalar_array& dbValues);
+
+  /** Compute friction coefficient at a location.
+   *
+   * @param slipCum Cumulative slip at location.
+   * @param properties Properties at location.
+   * @param derivCoef Derivative of friction with slip divided by
+   *   normal traction (output).
+   *
+   * @returns Friction coefficient at location.
+   */
+  PylithScalar coefficient(const PylithScalar slipCum,
+			   const PylithScalar* properties,
+			   PylithScalar* const derivCoef) const;
+
+  /** Get index of weakening segment at a location.
+   *
+   * @param slipCum Cumulative slip at location.
+   * @param properties Properties at location.
+   *
+   * @returns 0 (one weakening segment).
+   */
+  static
+  int segment(const PylithScalar slipCum,
+	      const PylithScalar* properties);
+
+  /** Check whether the friction coefficient no longer changes with
+   * slip at a location.
+   *
+   * @param slipCum Cumulative slip at location.
+   * @param properties Properties at location.
+   *
+   * @returns True if the friction coefficient is constant for all
+   * cumulative slip greater than or equal to slipCum.
+   */
+  bool fullyWeakened(const PylithScalar slipCum,
+		     const PylithScalar* properties) const;
+
+  /** Check whether a location has reached the end of weakening.
+   *
+   * @param slipCum Cumulative slip at location.
+   * @param properties Properties at location.
+   * @param fraction Fraction of the strength drop that ends weakening
+   *   (only used by curves without a finite end).
+   *
+   * @returns True past the end of the table (same as fullyWeakened()).
+   */
+  bool weakeningEnded(const PylithScalar slipCum,
+		      const PylithScalar* properties,
+		      const PylithScalar fraction) const;
+
+  /** Get number of flops in coefficient() at a location.
+   *
+   * @param slipCum Cumulative slip at location.
+   * @param properties Properties at location.
+   *
+   * @returns Number of flops for the branch taken at location.
+   */
+  static
+  int coefficientFlops(const PylithScalar slipCum,
+		       const PylithScalar* properties);
+
+  /** Get slip from a location to the next breakpoint (kink) of the
+   * friction coefficient.
+   *
+   * @param slipCum Cumulative slip at location.
+   * @param properties Properties at location.
+   *
+   * @returns Slip to the next grid point of the table (the kinks of
+   * linear tables), or PYLITH_MAXSCALAR past the table.
+   */
+  PylithScalar slipToBreakpoint(const PylithScalar slipCum,
+				const PylithScalar* properties) const;
+
+  /** Get friction coefficient at a location once fully weakened.
+   *
+   * @param properties Properties at location.
+   *
+   * @returns Last value of the table.
+   */
+  PylithScalar residualCoefficient(const PylithScalar* properties) const;
+
+  // PRIVATE STRUCTS ////////////////////////////////////////////////////
+private :
+
+  /// Location of a table in the array of interpolation coefficients.
+  struct TableInfo {
+    int offset; ///< Index of first coefficient.
+    int numIntervals; ///< Number of intervals (number of points - 1).
+    PylithScalar slipSpacing; ///< Spacing of grid points in slip (dimensional).
+    PylithScalar invSpacing; ///< Inverse of nondimensional spacing of grid points.
+  }; // TableInfo
+
+  // PRIVATE METHODS ////////////////////////////////////////////////////
+private :
+
+  /** Get table of a location.
+   *
+   * @param properties Properties at location.
+   *
+   * @returns Table given by the curve index.
+   */
+  const TableInfo& _table(const PylithScalar* properties) const;
+
+  // PRIVATE MEMBERS ////////////////////////////////////////////////////
+private :
+
+  /// Number of interpolation coefficients per interval.
+  static const int _coefsPerInterval = 4;
+
+  PylithScalar _lengthScale; ///< Length scale of normalizer.
+  std::vector<TableInfo> _tables; ///< Tables added with addTable().
+  std::vector<PylithScalar> _coefs; ///< Interpolation coefficients of all tables.
+
+}; // class TabulatedSlipWeakeningCurve
+
+// TabulatedSlipWeakeningNoHeal -----------------------------------------
+class contrib::friction::TabulatedSlipWeakeningNoHeal : public contrib::friction::SlipWeakeningLaw<contrib::friction::TabulatedSlipWeakeningCurve>
+{ // class TabulatedSlipWeakeningNoHeal
+  friend class TestTabulatedSlipWeakeningNoHeal; // unit testing
+
+  // PUBLIC METHODS /////////////////////////////////////////////////////
+public :
+
+  /** Constructor.
+   *
+   * @param diagnostics True to add the diagnostic state variables
+   *   (see SlipWeakeningLaw).
+   */
+  TabulatedSlipWeakeningNoHeal(const bool diagnostics=false);
+
+  /// Destructor.
+  ~TabulatedSlipWeakeningNoHeal(void);
+
+  /** Read tables of friction coefficients from file, replacing any
+   * tables added before.
+   *
+   * @param value Name of file.
+   */
+  void filename(const char* value);
+
+  /** Add table of friction coefficients.
+   *
+   * @param values Friction coefficients at grid points [numPoints].
+   * @param numPoints Number of grid points.
+   * @param slipSpacing Spacing of grid points in slip.
+   * @param cubic True for cubic interpolation, false for linear.
+   *
+   * @returns Index of table (curve_index of the vertices using it).
+   */
+  int addTable(const PylithScalar* values,
+	       const int numPoints,
+	       const PylithScalar slipSpacing,
+	       const bool cubic);
+
+  /** Get number of tables.
+   *
+   * @returns Number of tables.
+   */
+  int numTables(void) const;
+
+  // PROTECTED METHODS //////////////////////////////////////////////////
+protected :
+
+  /** Compute properties from values in spatial database.
+   *
+   * @param propValues Array of property values.
+   * @param dbValues Array of database values.
+   */
+  void _dbValuesToProperties(PylithScalar* const propValues,
+			     const pylith::scalar_array& dbValues) const;
+
+  /** Get rules for the properties at a vertex, including that the
+   * curve index refers to one of the tables read.
+   *
+   * @param rules Array of rules (rules of the model are appended).
+   */
+  void _propertyRules(std::vector<PropertyRule>* rules) const;
+
+  /// Rescale the slip spacing of the tables with the length scale
+  /// of the normalizer.
+  void _scalesChanged(void);
+
+  // PRIVATE MEMBERS ////////////////////////////////////////////////////
+private :
+
+  std::string _filename; ///< Name of file with tables.
+
+  // NOT IMPLEMENTED ////////////////////////////////////////////////////
+private :
+
+  TabulatedSlipWeakeningNoHeal(const TabulatedSlipWeakeningNoHeal&); ///< Not implemented.
+  const TabulatedSlipWeakeningNoHeal& operator=(const TabulatedSlipWeakeningNoHeal&); ///< Not implemented
+
+}; // class TabulatedSlipWeakeningNoHeal
+
+#endif // pylith_friction_TabulatedSlipWeakeningNoHeal_hh
+
+
+// End of file
@@ -0,0 +1,156 @@
+#!/usr/bin/env python
+#
+# ----------------------------------------------------------------------
+#
+# Brad T. Aagaard, U.S. Geological Survey
+# Charles A. Williams, GNS Science
+# Matthew G. Knepley, University of Chicago
+#
+# This code was developed as part of the Computational Infrastructure
+# for Geodynamics (http://geodynamics.org).
+#
+# Copyright (c) 2010-2017 University of California, Davis
+#
+# See COPYING for license information.
+#
+# ----------------------------------------------------------------------
+#
+
+## @file pylith/friction/TabulatedSlipWeakeningNoHeal.py
+##
+## @brief Python object implementing tabulated slip-weakening friction.
+##
+## Factory: friction_model.
+
+# ISA FrictionModel
+from pylith.friction.FrictionModel import FrictionModel
+
+# Import the SWIG module TabulatedSlipWeakeningNoHeal object and rename it
+# ModuleTabulatedSlipWeakeningNoHeal so that it doesn't clash with the local Python
+# class of the same name.
+from frictioncontrib import TabulatedSlipWeakeningNoHeal as ModuleTabulatedSlipWeakeningNoHeal
+
+# TabulatedSlipWeakeningNoHeal class
+class TabulatedSlipWeakeningNoHeal(FrictionModel, ModuleTabulatedSlipWeakeningNoHeal):
+  """
+  Python object implementing tabulated slip-weakening friction.
+
+  Inventory
+
+  \b Properties
+  @li \b filename Name of file with tables of friction coefficients.
+  @li \b num_threads Number of threads for fault vertex loops.
+  @li \b trace_filename Name of file for recording the calls to the model.
+  @li \b census_filename Name of file for the number of vertices in each regime.
+  @li \b diagnostics Add the regime, work, and rupture time state variables.
+
+  Factory: friction_model.
+  """
+
+  # INVENTORY //////////////////////////////////////////////////////////
+
+  import pyre.inventory
+
+  tableFilename = pyre.inventory.str("filename", default="")
+  tableFilename.meta['tip'] = "Name of file with tables of friction coefficients."
+
+  threadCount = pyre.inventory.int("num_threads", default=0)
+  threadCount.meta['tip'] = "Number of threads for fault vertex loops (0 uses OMP_NUM_THREADS)."
+
+  traceFile = pyre.inventory.str("trace_filename", default="")
+  traceFile.meta['tip'] = "Name of file for recording the calls to the model, " \
+      "with %d replaced by the process rank (empty for no recording)."
+
+  censusFile = pyre.inventory.str("census_filename", default="")
+  censusFile.meta['tip'] = "Name of file for the number of vertices in each regime " \
+      "at each time step, with %d replaced by the process rank (empty for no file)."
+
+  diagnostics = pyre.inventory.bool("diagnostics", default=False)
+  diagnostics.meta['tip'] = "Add the regime, frictional and breakdown work, and " \
+      "rupture and weakening end time state variables, which are updated at " \
+      "every time step."
+
+  # PUBLIC METHODS /////////////////////////////////////////////////////
+
+  def __init__(self, name="TabulatedSlipWeakeningNoHeal"):
+    """
+    Constructor.
+    """
+    FrictionModel.__init__(self, name)
+    # Set the fields that are available for output. These are the
+    # stored physical properties and state variables. The friction
+    # model information is output with the fault information, so we
+    # can also output slip, slip rate and the fault tractions.
+    #
+    # There are no cell fields because the fault constitutive model
+    # operations on quantities evaluated at the fault vertices.
+    #
+    # Do not change the name of this variable. The output manager will
+    # request this variable by name.
+    self.availableFields = \
+        {'vertex': \
+           {'info': ["curve_index",
+                     "cohesion"],
+            'data': ["cumulative_slip",
+                     "previous_slip"]},
+         'cell': \
+           {'info': [],
+            'data': []}}
+    self._loggingPrefix = "FrTabSW " # Prefix that appears in PETSc logging
+    return
+
+
+  # PRIVATE METHODS ////////////////////////////////////////////////////
+
+  def _configure(self):
+    """
+    Setup members using inventory.
+    """
+    data = ["cumulative_slip",
+            "previous_slip"]
+    if self.inventory.diagnostics:
+      # The diagnostic state variables are part of the metadata, which
+      # is fixed when the C++ object is constructed, so replace the
+      # object from _createModuleObj() with one that has them.
+      self.this = ModuleTabulatedSlipWeakeningNoHeal(True).this
+      data += ["regime",
+               "frictional_work",
+               "breakdown_work",
+               "rupture_time",
+               "weakening_end_time"]
+    self.availableFields['vertex']['data'] = data
+    FrictionModel._configure(self)
+    ModuleTabulatedSlipWeakeningNoHeal.numThreads(self, self.inventory.threadCount)
+    ModuleTabulatedSlipWeakeningNoHeal.traceFilename(self, self.inventory.traceFile)
+    ModuleTabulatedSlipWeakeningNoHeal.censusFilename(self, self.inventory.censusFile)
+    ModuleTabulatedSlipWeakeningNoHeal.loggingPrefix(self, self._loggingPrefix)
+    if len(self.inventory.tableFilename) == 0:
+      raise ValueError("Filename for tables of friction coefficients of "
+                       "friction model '%s' not specified." % self.name)
+    ModuleTabulatedSlipWeakeningNoHeal.filename(self, self.inventory.tableFilename)
+    return
+
+
+  def _createModuleObj(self):
+    """
+    Call constructor for module object for access to C++ object. This
+    function is called automatically by the generic Python FrictionModel
+    object. It must have this name and self as the only argument.
+    """
+    ModuleTabulatedSlipWeakeningNoHeal.__init__(self)
+    return
+  
+
+# FACTORIES ////////////////////////////////////////////////////////////
+
+# This is the function that is called when you invoke
+# friction = pylith.pylith.contrib.TabulatedSlipWeakeningNoHeal
+# The name of this function MUST be 'friction_model'.
+def friction_model():
+  """
+  Factory associated with TabulatedSlipWeakeningNoHeal.
+  """
+  return TabulatedSlipWeakeningNoHeal() # Return our object
+
+
+# End of file
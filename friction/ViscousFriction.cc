@@ -66,6 +66,16 @@ namespace contrib {
 	{ "slip_rate", 1, pylith::topology::FieldBase::SCALAR },
       };
 
+      // Dimensions of properties and state variables.
+      const ContribFrictionModel::Dimension propertyDimensions[numProperties] = {
+	{ 0, 0, 0 }, // static_coefficient
+	{ 1, 0, -1 }, // reference_slip_rate
+	{ 0, 1, 0 }, // cohesion
+      };
+      const ContribFrictionModel::Dimension stateVarDimensions[numStateVars] = {
+	{ 1, 0, -1 }, // slip_rate
+      };
+
       // Values expected in spatial database
       const int numDBProperties = 3;
       const char* dbProperties[numDBProperties] = { 
@@ -112,7 +122,7 @@ const int contrib::friction::ViscousFriction::db_slipRate = 0;
 // ----------------------------------------------------------------------
 // Default constructor.
 contrib::friction::ViscousFriction::ViscousFriction(void) :
-  pylith::friction::FrictionModel(pylith::materials::Metadata(_ViscousFriction::properties,
+  ContribFrictionModel(pylith::materials::Metadata(_ViscousFriction::properties,
 				    _ViscousFriction::numProperties,
 				    _ViscousFriction::dbProperties,
 				    _ViscousFriction::numDBProperties,
@@ -121,6 +131,7 @@ contrib::friction::ViscousFriction::ViscousFriction(void) :
 				    _ViscousFriction::dbStateVars,
 				    _ViscousFriction::numDBStateVars))
 { // constructor
+  _updateScales();
 } // constructor
 
 // ----------------------------------------------------------------------
@@ -132,9 +143,9 @@ contrib::friction::ViscousFriction::~ViscousFriction(void)
 // ----------------------------------------------------------------------
 // Compute properties from values in spatial database.
 void
-contrib::friction::ViscousFriction::_dbToProperties(PylithScalar* const propValues,
-						    const pylith::scalar_array& dbValues) const
-{ // _dbToProperties
+contrib::friction::ViscousFriction::_dbValuesToProperties(PylithScalar* const propValues,
+							  const pylith::scalar_array& dbValues) const
+{ // _dbValuesToProperties
   // Check consistency of arguments
   assert(propValues);
   const int numDBValues = dbValues.size();
@@ -151,7 +162,7 @@ contrib::friction::ViscousFriction::_dbToProperties(PylithScalar* const propValu
     std::ostringstream msg;
     msg << "Spatial database returned nonpositive value for static "
 	<< "coefficient of friction.\n"
-	<< "Static coefficient of friction: " << v0 << "\n";
+	<< "Static coefficient of friction: " << coefS << "\n";
     throw std::runtime_error(msg.str());
   } // if
 
@@ -164,10 +175,39 @@ contrib::friction::ViscousFriction::_dbToProperties(PylithScalar* const propValu
 
   // Compute parameters that we store from the user-supplied parameters.
   propValues[p_coefS] = coefS;
-  propValues[p_v0] = db_v0;
+  propValues[p_v0] = v0;
   propValues[p_cohesion] = cohesion;
+} // _dbValuesToProperties
+
+// ----------------------------------------------------------------------
+// Get rules for the properties at a vertex.
+void
+contrib::friction::ViscousFriction::_propertyRules(std::vector<PropertyRule>* rules) const
+{ // _propertyRules
+  assert(rules);
+
+  // Friction divides by the reference slip rate.
+  const PropertyRule viscousRules[3] = {
+    { "static_coefficient > 0", POSITIVE_RULE, p_coefS, p_coefS, 0 },
+    { "reference_slip_rate > 0", POSITIVE_RULE, p_v0, p_v0, 0 },
+    { "cohesion >= 0", NONNEGATIVE_RULE, p_cohesion, p_cohesion, 0 },
+  };
+  rules->insert(rules->end(), viscousRules, viscousRules+3);
+} // _propertyRules
 
-} // _dbToProperties
+// ----------------------------------------------------------------------
+// Get dimensions of the properties and state variables.
+void
+contrib::friction::ViscousFriction::_dimensions(std::vector<Dimension>* properties,
+						std::vector<Dimension>* stateVars) const
+{ // _dimensions
+  assert(properties);
+  assert(stateVars);
+  properties->assign(_ViscousFriction::propertyDimensions,
+		     _ViscousFriction::propertyDimensions + _ViscousFriction::numProperties);
+  stateVars->assign(_ViscousFriction::stateVarDimensions,
+		    _ViscousFriction::stateVarDimensions + _ViscousFriction::numStateVars);
+} // _dimensions
 
 // ----------------------------------------------------------------------
 // Nondimensionalize properties.
@@ -180,18 +220,7 @@ contrib::friction::ViscousFriction::_nondimProperties(PylithScalar* const values
   assert(values);
   assert(nvalues == _ViscousFriction::numProperties);
 
-  // Get scales needed to nondimensional parameters from the
-  // Nondimensional object.
-  const PylithScalar lengthScale = _normalizer->lengthScale();
-  const PylithScalar timeScale = _normalizer->timeScale();
-  const PylithScalar pressureScale = _normalizer->pressureScale();
-  const PylithScalar velocityScale = lengthScale / timeScale;
-
-  // Use the Nondimensional::nondimensionalize() function to
-  // nondimensionalize the quantities using the appropriate scale.
-  values[p_v0] = _normalizer->nondimensionalize(values[p_v0], velocityScale);
-  values[p_cohesion] = 
-    _normalizer->nondimensionalize(values[p_cohesion], pressureScale);
+  _scaleVertex(values, nvalues, false, true);
 } // _nondimProperties
 
 // ----------------------------------------------------------------------
@@ -205,18 +234,7 @@ contrib::friction::ViscousFriction::_dimProperties(PylithScalar* const values,
   assert(values);
   assert(nvalues == _ViscousFriction::numProperties);
 
-  // Get scales needed to dimensional parameters from the
-  // Nondimensional object.
-  const PylithScalar lengthScale = _normalizer->lengthScale();
-  const PylithScalar timeScale = _normalizer->timeScale();
-  const PylithScalar pressureScale = _normalizer->pressureScale();
-  const PylithScalar velocityScale = lengthScale / timeScale;
-
-  // Use the Nondimensional::dimensionalize() function to
-  // dimensionalize the quantities using the appropriate scale.
-  values[p_v0] = _normalizer->dimensionalize(values[p_v0], velocityScale);
-  values[p_cohesion] = 
-    _normalizer->dimensionalize(values[p_cohesion], pressureScale);
+  _scaleVertex(values, nvalues, false, false);
 } // _dimProperties
 
 // ----------------------------------------------------------------------
@@ -249,16 +267,7 @@ contrib::friction::ViscousFriction::_nondimStateVars(PylithScalar* const values,
   assert(values);
   assert(nvalues == _ViscousFriction::numStateVars);
 
-  // Get scales needed to nondimensional parameters from the
-  // Nondimensional object.
-  const PylithScalar lengthScale = _normalizer->lengthScale();
-  const PylithScalar timeScale = _normalizer->timeScale();
-  const PylithScalar velocityScale = lengthScale / timeScale;
-
-  // Use the Nondimensional::dimensionalize() function to
-  // dimensionalize the quantities using the appropriate scale.
-  values[s_slipRate] = 
-    _normalizer->nondimensionalize(values[s_slipRate], velocityScale);
+  _scaleVertex(values, nvalues, true, true);
 } // _nondimStateVars
 
 // ----------------------------------------------------------------------
@@ -272,18 +281,31 @@ contrib::friction::ViscousFriction::_dimStateVars(PylithScalar* const values,
   assert(values);
   assert(nvalues == _ViscousFriction::numStateVars);
 
-  // Get scales needed to dimensional parameters from the
-  // Nondimensional object.
-  const PylithScalar lengthScale = _normalizer->lengthScale();
-  const PylithScalar timeScale = _normalizer->timeScale();
-  const PylithScalar velocityScale = lengthScale / timeScale;
-
-  // Use the Nondimensional::dimensionalize() function to
-  // dimensionalize the quantities using the appropriate scale.
-  values[s_slipRate] = 
-    _normalizer->dimensionalize(values[s_slipRate], velocityScale);
+  _scaleVertex(values, nvalues, true, false);
 } // _dimStateVars
 
+// ----------------------------------------------------------------------
+// Compute friction at a location.
+inline
+PylithScalar
+contrib::friction::ViscousFriction::_frictionKernel(const PylithScalar slip,
+						    const PylithScalar slipRate,
+						    const PylithScalar normalTraction,
+						    const PylithScalar* properties,
+						    const PylithScalar* stateVars)
+{ // _frictionKernel
+  // Compute friction traction.
+  PylithScalar friction = 0.0;
+  PylithScalar mu_f = 0.0;
+  if (normalTraction <= 0.0) {
+    // if fault is in compression
+    mu_f = properties[p_coefS] * (1.0 + fabs(slipRate) / properties[p_v0]);
+    friction = - mu_f * normalTraction + properties[p_cohesion];
+  } // if
+
+  return friction;
+} // _frictionKernel
+
 // ----------------------------------------------------------------------
 // Compute friction from properties and state variables.
 PylithScalar
@@ -302,17 +324,83 @@ contrib::friction::ViscousFriction::_calcFriction(const PylithScalar t,
   assert(numStateVars);
   assert(_ViscousFriction::numStateVars == numStateVars);
 
-  // Compute friction traction.
-  PylithScalar friction = 0.0;
-  PylithScalar mu_f = 0.0;
+  _traceCall(FrictionTrace::FRICTION, t, slip, slipRate, normalTraction,
+	     properties, numProperties, stateVars, numStateVars);
+
+  const PylithScalar friction =
+    _frictionKernel(slip, slipRate, normalTraction, properties, stateVars);
+
+  // Friction takes 5 flops in compression and none in tension.
+  PetscLogFlops((normalTraction <= 0.0) ? 5 : 0);
+
+  return friction;
+} // _calcFriction
+
+// ----------------------------------------------------------------------
+// Compute friction at a batch of fault vertices.
+void
+contrib::friction::ViscousFriction::_calcFrictionBatch(PylithScalar* const friction,
+						       const PylithScalar t,
+						       const PylithScalar* slip,
+						       const PylithScalar* slipRate,
+						       const PylithScalar* normalTraction,
+						       const PylithScalar* properties,
+						       const int numProperties,
+						       const PylithScalar* stateVars,
+						       const int numStateVars,
+						       const int numVertices)
+{ // _calcFrictionBatch
+  // Check consistency of arguments.
+  assert(_ViscousFriction::numProperties == numProperties);
+  assert(_ViscousFriction::numStateVars == numStateVars);
+
+  // Use the compile-time sizes as strides, so the compiler can
+  // resolve the offsets into the property and state variable arrays.
+  const int propsStride = _ViscousFriction::numProperties;
+  const int varsStride = _ViscousFriction::numStateVars;
+  int numCompression = 0;
+  const int numThreads = _batchThreads(numVertices);
+#if defined(_OPENMP)
+#pragma omp parallel for num_threads(numThreads) schedule(static) reduction(+:numCompression)
+#endif
+  for (int i=0; i < numVertices; ++i) {
+    friction[i] = _frictionKernel(slip[i], slipRate[i], normalTraction[i],
+				  &properties[i*propsStride],
+				  &stateVars[i*varsStride]);
+    numCompression += (normalTraction[i] <= 0.0) ? 1 : 0;
+  } // for
+
+  PetscLogFlops(numCompression*5);
+} // _calcFrictionBatch
+
+// ----------------------------------------------------------------------
+// Compute derivative of friction with slip at a location.
+inline
+PylithScalar
+contrib::friction::ViscousFriction::_frictionDerivKernel(const PylithScalar slipRate,
+							 const PylithScalar normalTraction,
+							 const PylithScalar* properties,
+							 const PylithScalar dt)
+{ // _frictionDerivKernel
+  assert(dt > 0.0);
+
+  PylithScalar frictionDeriv = 0.0;
   if (normalTraction <= 0.0) {
     // if fault is in compression
-    mu_f = properties[p_coefS] * (1.0 + fabs(slipRate) / properties[p_v0]);
-    friction = - mu_f * normalTraction + properties[p_cohesion];
+
+    // We want the derivative of friction with respect to slip. The
+    // fault integrator computes the slip rate from the slip increment
+    // over the time step, so d(slipRate)/d(slip) = 1/dt, and the
+    // friction depends on the magnitude of the slip rate. At zero
+    // slip rate we use the derivative for increasing slip rate,
+    // which is the direction the fault starts to slide in.
+    const PylithScalar slipRateSign = (slipRate < 0.0) ? -1.0 : 1.0;
+    frictionDeriv = -slipRateSign * normalTraction * properties[p_coefS] /
+      (properties[p_v0] * dt);
   } // if
 
-  return friction;
-} // _calcFriction
+  return frictionDeriv;
+} // _frictionDerivKernel
 
 // ----------------------------------------------------------------------
 // Compute derivative of friction with slip from properties and state variables.
@@ -332,21 +420,159 @@ contrib::friction::ViscousFriction::_calcFrictionDeriv(const PylithScalar t,
   assert(numStateVars);
   assert(_ViscousFriction::numStateVars == numStateVars);
 
-  // Compute friction traction.
-  PylithScalar frictionDeriv = 0.0;
-  if (normalTraction <= 0.0) {
-    // if fault is in compression
+  _traceCall(FrictionTrace::FRICTION_DERIV, t, slip, slipRate, normalTraction,
+	     properties, numProperties, stateVars, numStateVars);
 
-    // We want the derivative of friction with respect to
-    // slip. Because the friction model depends on slip rate, we
-    // approximate the derivative with respect to slip by taking the
-    // derivative with respect to slip rate and multiplying by the time step (dt).
-    frictionDeriv = -normalTraction * properties[p_coefS] / (properties[p_v0] * _dt);
-  } // if
+  const PylithScalar frictionDeriv =
+    _frictionDerivKernel(slipRate, normalTraction, properties, _dt);
+
+  // Derivative takes 3 flops in compression and none in tension.
+  PetscLogFlops((normalTraction <= 0.0) ? 3 : 0);
 
   return frictionDeriv;
 } // _calcFrictionDeriv
 
+// ----------------------------------------------------------------------
+// Compute friction and its derivative with slip at a batch of fault
+// vertices.
+void
+contrib::friction::ViscousFriction::_calcFrictionAndDerivBatch(PylithScalar* const friction,
+							       PylithScalar* const frictionDeriv,
+							       const PylithScalar t,
+							       const PylithScalar* slip,
+							       const PylithScalar* slipRate,
+							       const PylithScalar* normalTraction,
+							       const PylithScalar* properties,
+							       const int numProperties,
+							       const PylithScalar* stateVars,
+							       const int numStateVars,
+							       const int numVertices)
+{ // _calcFrictionAndDerivBatch
+  // Check consistency of arguments.
+  assert(_ViscousFriction::numProperties == numProperties);
+  assert(_ViscousFriction::numStateVars == numStateVars);
+
+  const int propsStride = _ViscousFriction::numProperties;
+  const int varsStride = _ViscousFriction::numStateVars;
+  const PylithScalar dt = _dt;
+  int numCompression = 0;
+  const int numThreads = _batchThreads(numVertices);
+#if defined(_OPENMP)
+#pragma omp parallel for num_threads(numThreads) schedule(static) reduction(+:numCompression)
+#endif
+  for (int i=0; i < numVertices; ++i) {
+    const PylithScalar* propertiesVertex = &properties[i*propsStride];
+    friction[i] = _frictionKernel(slip[i], slipRate[i], normalTraction[i],
+				  propertiesVertex, &stateVars[i*varsStride]);
+    frictionDeriv[i] = _frictionDerivKernel(slipRate[i], normalTraction[i], propertiesVertex, dt);
+    numCompression += (normalTraction[i] <= 0.0) ? 1 : 0;
+  } // for
+
+  PetscLogFlops(numCompression*(5+3));
+} // _calcFrictionAndDerivBatch
+
+// ----------------------------------------------------------------------
+// Compute friction and its tangent at a location.
+inline
+PylithScalar
+contrib::friction::ViscousFriction::_tangentKernel(const PylithScalar slip,
+						   const PylithScalar slipRate,
+						   const PylithScalar normalTraction,
+						   const PylithScalar* properties,
+						   const PylithScalar* stateVars,
+						   PylithScalar* const tangent)
+{ // _tangentKernel
+  const PylithScalar friction =
+    _frictionKernel(slip, slipRate, normalTraction, properties, stateVars);
+  // Friction does not depend on slip at fixed slip rate; the change of
+  // slip rate with slip over the time step is left to the integrator.
+  tangent[TANGENT_SLIP] = 0.0;
+  tangent[TANGENT_NORMAL_TRACTION] = 0.0;
+  tangent[TANGENT_SLIP_RATE] = 0.0;
+  if (normalTraction <= 0.0) {
+    // if fault is in compression
+    const PylithScalar slipRateSign = (slipRate < 0.0) ? -1.0 : 1.0;
+    tangent[TANGENT_NORMAL_TRACTION] =
+      -properties[p_coefS] * (1.0 + fabs(slipRate) / properties[p_v0]);
+    tangent[TANGENT_SLIP_RATE] =
+      -slipRateSign * normalTraction * properties[p_coefS] / properties[p_v0];
+  } // if
+
+  return friction;
+} // _tangentKernel
+
+// ----------------------------------------------------------------------
+// Compute friction and its tangent at a location.
+PylithScalar
+contrib::friction::ViscousFriction::_calcFrictionTangent(PylithScalar* const tangent,
+							 const PylithScalar t,
+							 const PylithScalar slip,
+							 const PylithScalar slipRate,
+							 const PylithScalar normalTraction,
+							 const PylithScalar* properties,
+							 const int numProperties,
+							 const PylithScalar* stateVars,
+							 const int numStateVars)
+{ // _calcFrictionTangent
+  // Check consistency of arguments.
+  assert(tangent);
+  assert(properties);
+  assert(_ViscousFriction::numProperties == numProperties);
+  assert(numStateVars);
+  assert(_ViscousFriction::numStateVars == numStateVars);
+
+  _traceCall(FrictionTrace::FRICTION, t, slip, slipRate, normalTraction,
+	     properties, numProperties, stateVars, numStateVars);
+  _traceCall(FrictionTrace::FRICTION_DERIV, t, slip, slipRate, normalTraction,
+	     properties, numProperties, stateVars, numStateVars);
+
+  const PylithScalar friction =
+    _tangentKernel(slip, slipRate, normalTraction, properties, stateVars, tangent);
+
+  // Tangent takes 12 flops in compression (5 for friction, 4 for the
+  // derivative with normal traction, and 3 with slip rate) and none
+  // in tension.
+  PetscLogFlops((normalTraction <= 0.0) ? 12 : 0);
+
+  return friction;
+} // _calcFrictionTangent
+
+// ----------------------------------------------------------------------
+// Compute friction and its tangent at a batch of fault vertices.
+void
+contrib::friction::ViscousFriction::_calcFrictionTangentBatch(PylithScalar* const friction,
+							      PylithScalar* const tangent,
+							      const PylithScalar t,
+							      const PylithScalar* slip,
+							      const PylithScalar* slipRate,
+							      const PylithScalar* normalTraction,
+							      const PylithScalar* properties,
+							      const int numProperties,
+							      const PylithScalar* stateVars,
+							      const int numStateVars,
+							      const int numVertices)
+{ // _calcFrictionTangentBatch
+  // Check consistency of arguments.
+  assert(_ViscousFriction::numProperties == numProperties);
+  assert(_ViscousFriction::numStateVars == numStateVars);
+
+  const int propsStride = _ViscousFriction::numProperties;
+  const int varsStride = _ViscousFriction::numStateVars;
+  int numCompression = 0;
+  const int numThreads = _batchThreads(numVertices);
+#if defined(_OPENMP)
+#pragma omp parallel for num_threads(numThreads) schedule(static) reduction(+:numCompression)
+#endif
+  for (int i=0; i < numVertices; ++i) {
+    friction[i] = _tangentKernel(slip[i], slipRate[i], normalTraction[i],
+				 &properties[i*propsStride],
+				 &stateVars[i*varsStride], &tangent[i*NUM_TANGENTS]);
+    numCompression += (normalTraction[i] <= 0.0) ? 1 : 0;
+  } // for
+
+  PetscLogFlops(numCompression*12);
+} // _calcFrictionTangentBatch
+
 // ----------------------------------------------------------------------
 // Update state variables (for next time step).
 void
@@ -365,6 +591,9 @@ contrib::friction::ViscousFriction::_updateStateVars(const PylithScalar t,
   assert(numStateVars);
   assert(_ViscousFriction::numStateVars == numStateVars);
 
+  _traceCall(FrictionTrace::UPDATE_STATE_VARS, t, slip, slipRate, normalTraction,
+	     properties, numProperties, stateVars, numStateVars);
+
   // Store state variables.
   stateVars[s_slipRate] = stateVars[s_slipRate]; 
 } // _updateStateVars
@@ -28,13 +28,16 @@
  * friction, and a reference slip rate.
  *
  * $\mu_f = \mu_s (1 + \dot{D} / v_0)
+ *
+ * In the tangent, the derivative with normal traction is -\mu_f and
+ * the derivative with slip rate is -N \mu_s sgn(\dot{D}) / v_0.
  */
 
 #if !defined(pylith_friction_viscousfriction_hh)
 #define pylith_friction_viscousfriction_hh
 
 // Include directives ---------------------------------------------------
-#include "pylith/friction/FrictionModel.hh" // ISA FrictionModel
+#include "ContribFrictionModel.hh" // ISA ContribFrictionModel
 
 // Forward declarations
 namespace contrib {
@@ -44,7 +47,7 @@ namespace contrib {
 } // pylith
 
 // ViscousFriction -------------------------------------------------------
-class contrib::friction::ViscousFriction : public pylith::friction::FrictionModel
+class contrib::friction::ViscousFriction : public contrib::friction::ContribFrictionModel
 { // class ViscousFriction
   friend class TestViscousFriction; // unit testing
 
@@ -72,8 +75,22 @@ protected :
    * @param propValues Array of property values.
    * @param dbValues Array of database values.
    */
-  void _dbToProperties(PylithScalar* const propValues,
-		       const pylith::scalar_array& dbValues) const;
+  void _dbValuesToProperties(PylithScalar* const propValues,
+			     const pylith::scalar_array& dbValues) const;
+
+  /** Get rules for the properties at a vertex.
+   *
+   * @param rules Array of rules (rules of the model are appended).
+   */
+  void _propertyRules(std::vector<PropertyRule>* rules) const;
+
+  /** Get dimensions of the properties and state variables.
+   *
+   * @param properties Dimensions of properties [numProperties] (output).
+   * @param stateVars Dimensions of state variables [numStateVars] (output).
+   */
+  void _dimensions(std::vector<Dimension>* properties,
+		   std::vector<Dimension>* stateVars) const;
 
   /** Nondimensionalize properties.
    *
@@ -163,6 +180,107 @@ protected :
 				  const PylithScalar* stateVars,
 				  const int numStateVars);
   
+  /** Compute friction at a batch of fault vertices.
+   *
+   * @param friction Array of friction values [numVertices] (output).
+   * @param t Time in simulation.
+   * @param slip Array of slip [numVertices].
+   * @param slipRate Array of slip rate [numVertices].
+   * @param normalTraction Array of normal traction [numVertices].
+   * @param properties Array of properties [numVertices*numProperties].
+   * @param numProperties Number of properties per vertex.
+   * @param stateVars Array of state variables [numVertices*numStateVars].
+   * @param numStateVars Number of state variables per vertex.
+   * @param numVertices Number of vertices in batch.
+   */
+  void _calcFrictionBatch(PylithScalar* const friction,
+			  const PylithScalar t,
+			  const PylithScalar* slip,
+			  const PylithScalar* slipRate,
+			  const PylithScalar* normalTraction,
+			  const PylithScalar* properties,
+			  const int numProperties,
+			  const PylithScalar* stateVars,
+			  const int numStateVars,
+			  const int numVertices);
+
+  /** Compute friction and its derivative with slip at a batch of
+   * fault vertices.
+   *
+   * @param friction Array of friction values [numVertices] (output).
+   * @param frictionDeriv Array of derivatives of friction with slip [numVertices] (output).
+   * @param t Time in simulation.
+   * @param slip Array of slip [numVertices].
+   * @param slipRate Array of slip rate [numVertices].
+   * @param normalTraction Array of normal traction [numVertices].
+   * @param properties Array of properties [numVertices*numProperties].
+   * @param numProperties Number of properties per vertex.
+   * @param stateVars Array of state variables [numVertices*numStateVars].
+   * @param numStateVars Number of state variables per vertex.
+   * @param numVertices Number of vertices in batch.
+   */
+  void _calcFrictionAndDerivBatch(PylithScalar* const friction,
+				  PylithScalar* const frictionDeriv,
+				  const PylithScalar t,
+				  const PylithScalar* slip,
+				  const PylithScalar* slipRate,
+				  const PylithScalar* normalTraction,
+				  const PylithScalar* properties,
+				  const int numProperties,
+				  const PylithScalar* stateVars,
+				  const int numStateVars,
+				  const int numVertices);
+
+  /** Compute friction and its tangent at a location.
+   *
+   * @param tangent Derivatives of friction [NUM_TANGENTS] (output).
+   * @param t Time in simulation.
+   * @param slip Current slip at location.
+   * @param slipRate Current slip rate at location.
+   * @param normalTraction Normal traction at location.
+   * @param properties Properties at location.
+   * @param numProperties Number of properties.
+   * @param stateVars State variables at location.
+   * @param numStateVars Number of state variables.
+   *
+   * @returns Friction (magnitude of shear traction) at location.
+   */
+  PylithScalar _calcFrictionTangent(PylithScalar* const tangent,
+				    const PylithScalar t,
+				    const PylithScalar slip,
+				    const PylithScalar slipRate,
+				    const PylithScalar normalTraction,
+				    const PylithScalar* properties,
+				    const int numProperties,
+				    const PylithScalar* stateVars,
+				    const int numStateVars);
+
+  /** Compute friction and its tangent at a batch of fault vertices.
+   *
+   * @param friction Array of friction values [numVertices] (output).
+   * @param tangent Array of derivatives of friction [numVertices*NUM_TANGENTS] (output).
+   * @param t Time in simulation.
+   * @param slip Array of slip [numVertices].
+   * @param slipRate Array of slip rate [numVertices].
+   * @param normalTraction Array of normal traction [numVertices].
+   * @param properties Array of properties [numVertices*numProperties].
+   * @param numProperties Number of properties per vertex.
+   * @param stateVars Array of state variables [numVertices*numStateVars].
+   * @param numStateVars Number of state variables per vertex.
+   * @param numVertices Number of vertices in batch.
+   */
+  void _calcFrictionTangentBatch(PylithScalar* const friction,
+				 PylithScalar* const tangent,
+				 const PylithScalar t,
+				 const PylithScalar* slip,
+				 const PylithScalar* slipRate,
+				 const PylithScalar* normalTraction,
+				 const PylithScalar* properties,
+				 const int numProperties,
+				 const PylithScalar* stateVars,
+				 const int numStateVars,
+				 const int numVertices);
+
   // --------------------------------------------------------------------
   // Optional function in the PyLith interface for a fault
   // constitutive model. Even though this function is optional, for it
@@ -190,6 +308,68 @@ protected :
 			const PylithScalar* properties,
 			const int numProperties);
 
+  // PRIVATE METHODS ////////////////////////////////////////////////////
+private :
+
+  /** Compute friction at a location. Shared by the per-vertex and
+   * batch interfaces.
+   *
+   * @param slip Current slip at location.
+   * @param slipRate Current slip rate at location.
+   * @param normalTraction Normal traction at location.
+   * @param properties Properties at location.
+   * @param stateVars State variables at location.
+   *
+   * @returns Friction (magnitude of shear traction) at location.
+   */
+  static
+  PylithScalar _frictionKernel(const PylithScalar slip,
+			       const PylithScalar slipRate,
+			       const PylithScalar normalTraction,
+			       const PylithScalar* properties,
+			       const PylithScalar* stateVars);
+
+  /** Compute derivative of friction with slip at a location. Shared
+   * by the per-vertex and batch interfaces.
+   *
+   * The derivative is consistent with the slip rate the fault
+   * integrator computes from the slip increment over the time step,
+   * i.e., d(slipRate)/d(slip) = 1/dt, including the sign of the slip
+   * rate and zero in tension.
+   *
+   * @param slipRate Current slip rate at location.
+   * @param normalTraction Normal traction at location.
+   * @param properties Properties at location.
+   * @param dt Time step.
+   *
+   * @returns Derivative of friction (magnitude of shear traction) at location.
+   */
+  static
+  PylithScalar _frictionDerivKernel(const PylithScalar slipRate,
+				    const PylithScalar normalTraction,
+				    const PylithScalar* properties,
+				    const PylithScalar dt);
+
+  /** Compute friction and its tangent at a location. Shared by the
+   * per-vertex and batch interfaces.
+   *
+   * @param slip Current slip at location.
+   * @param slipRate Current slip rate at location.
+   * @param normalTraction Normal traction at location.
+   * @param properties Properties at location.
+   * @param stateVars State variables at location.
+   * @param tangent Derivatives of friction [NUM_TANGENTS] (output).
+   *
+   * @returns Friction (magnitude of shear traction) at location.
+   */
+  static
+  PylithScalar _tangentKernel(const PylithScalar slip,
+			      const PylithScalar slipRate,
+			      const PylithScalar normalTraction,
+			      const PylithScalar* properties,
+			      const PylithScalar* stateVars,
+			      PylithScalar* const tangent);
+
   // PRIVATE MEMBERS ////////////////////////////////////////////////////
 private :
 
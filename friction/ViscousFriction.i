@@ -31,7 +31,7 @@
 namespace contrib {
   namespace friction {
 
-    class ViscousFriction : public pylith::friction::FrictionModel
+    class ViscousFriction : public contrib::friction::ContribFrictionModel
     { // class ViscousFriction
 
       // PUBLIC METHODS /////////////////////////////////////////////////
@@ -51,8 +51,8 @@ namespace contrib {
        * @param propValues Array of property values.
        * @param dbValues Array of database values.
        */
-      void _dbToProperties(PylithScalar* const propValues,
-			   const scalar_array& dbValues) const;
+      void _dbValuesToProperties(PylithScalar* const propValues,
+				 const scalar_array& dbValues) const;
 
       /** Nondimensionalize properties.
        *
@@ -35,9 +35,26 @@ class ViscousFriction(FrictionModel, ModuleViscousFriction):
   """
   Python object implementing viscous friction.
 
+  Inventory
+
+  \b Properties
+  @li \b num_threads Number of threads for fault vertex loops.
+  @li \b trace_filename Name of file for recording the calls to the model.
+
   Factory: friction_model.
   """
 
+  # INVENTORY //////////////////////////////////////////////////////////
+
+  import pyre.inventory
+
+  threadCount = pyre.inventory.int("num_threads", default=0)
+  threadCount.meta['tip'] = "Number of threads for fault vertex loops (0 uses OMP_NUM_THREADS)."
+
+  traceFile = pyre.inventory.str("trace_filename", default="")
+  traceFile.meta['tip'] = "Name of file for recording the calls to the model, " \
+      "with %d replaced by the process rank (empty for no recording)."
+
   # PUBLIC METHODS /////////////////////////////////////////////////////
 
   def __init__(self, name="viscousfriction"):
@@ -69,6 +86,17 @@ class ViscousFriction(FrictionModel, ModuleViscousFriction):
 
   # PRIVATE METHODS ////////////////////////////////////////////////////
 
+  def _configure(self):
+    """
+    Setup members using inventory.
+    """
+    FrictionModel._configure(self)
+    ModuleViscousFriction.numThreads(self, self.inventory.threadCount)
+    ModuleViscousFriction.traceFilename(self, self.inventory.traceFile)
+    ModuleViscousFriction.loggingPrefix(self, self._loggingPrefix)
+    return
+
+
   def _createModuleObj(self):
     """
     Call constructor for module object for access to C++ object. This
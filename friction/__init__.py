@@ -23,7 +23,9 @@
 __all__ = ['ViscousFriction',
            'ParabolicCohesiveZoneNoHeal',
 		   'DoubleSlipWeakeningFrictionNoHeal',
-		   'ExponentialCohesiveZoneNoHeal'
+		   'ExponentialCohesiveZoneNoHeal',
+		   'TabulatedSlipWeakeningNoHeal',
+		   'FrictionDB'
            ]
 
 
@@ -0,0 +1,638 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+/* Microbenchmark for the contrib fault constitutive models.
+ *
+ * Times the per-vertex functions PyLith calls (_calcFriction(),
+ * _calcFrictionDeriv() and _updateStateVars()) and the batch
+ * functions of ContribFrictionModel over synthetic faults. The
+ * vertices of a fault are assigned at random to the regimes
+ *
+ *   locked     no slip since the last update,
+ *   weakening  slipping with the friction coefficient changing,
+ *   residual   slipping past the end of weakening,
+ *   tension    positive normal traction,
+ *
+ * in proportions given on the command line. For each model, fault
+ * size and function we report the time per vertex, the throughput
+ * and the floating point rate from the flops the models log with
+ * PetscLogFlops().
+ *
+ * Usage: frictionbench [options]
+ *
+ *   --models=viscous,dsw,pcz,ecz,tab  Models to run.
+ *   --sizes=1000,10000,...            Numbers of fault vertices.
+ *   --mix=L,W,R,T                     Relative fractions of locked,
+ *                                     weakening, residual and tension
+ *                                     vertices (default 0.6,0.2,0.15,0.05).
+ *   --min-time=SECONDS                Minimum time per measurement.
+ *   --threads=N                       Threads for the batch functions.
+ */
+
+#include <portinfo> // machine specific info generated by configure
+
+#include "ViscousFriction.hh" // USES ViscousFriction
+#include "DoubleSlipWeakeningFrictionNoHeal.hh" // USES DoubleSlipWeakeningFrictionNoHeal
+#include "ParabolicCohesiveZoneNoHeal.hh" // USES ParabolicCohesiveZoneNoHeal
+#include "ExponentialCohesiveZoneNoHeal.hh" // USES ExponentialCohesiveZoneNoHeal
+#include "TabulatedSlipWeakeningNoHeal.hh" // USES TabulatedSlipWeakeningNoHeal
+
+#include "pylith/utils/array.hh" // USES scalar_array
+
+#include <petscsys.h> // USES PetscInitialize(), PetscGetFlops()
+#include <petsctime.h> // USES PetscTime()
+
+#include <cstdio> // USES printf()
+#include <cstdlib> // USES atoi(), atof()
+#include <cassert> // USES assert()
+#include <cstring> // USES strncmp()
+#include <string> // USES std::string
+#include <vector> // USES std::vector
+
+// ----------------------------------------------------------------------
+namespace contrib {
+  namespace friction {
+    namespace _FrictionBench {
+
+      /// Regimes of fault vertices.
+      enum Regime { LOCKED=0, WEAKENING=1, RESIDUAL=2, TENSION=3, NUM_REGIMES=4 };
+
+      /// Benchmark settings.
+      struct Settings {
+	std::vector<std::string> models; ///< Models to run.
+	std::vector<int> sizes; ///< Numbers of fault vertices.
+	double mix[NUM_REGIMES]; ///< Cumulative fractions of vertices in each regime.
+	double minTime; ///< Minimum time per measurement (s).
+	int numThreads; ///< Threads for batch functions.
+      }; // Settings
+
+      /// Synthetic fault (inputs of the friction functions).
+      struct Fault {
+	int numVertices;
+	int numProperties;
+	int numStateVars;
+	std::vector<PylithScalar> slip;
+	std::vector<PylithScalar> slipRate;
+	std::vector<PylithScalar> normalTraction;
+	std::vector<PylithScalar> properties;
+	std::vector<PylithScalar> stateVars;
+	std::vector<PylithScalar> friction;
+	std::vector<PylithScalar> frictionDeriv;
+      }; // Fault
+
+      /// Minimal linear congruential generator, so faults are the
+      /// same on every platform.
+      class Random {
+      public :
+	Random(void) : _state(12345u) {}
+	double operator()(void) {
+	  _state = 1664525u*_state + 1013904223u;
+	  return double(_state >> 8) / double(1u << 24);
+	} // operator()
+      private :
+	unsigned int _state;
+      }; // Random
+
+      /** Expose the protected per-vertex interface of a model.
+       *
+       * PyLith calls these functions through FrictionModel, which
+       * requires a PyLith fault; the benchmark calls them directly.
+       */
+      template<typename Model>
+      class Harness : public Model {
+      public :
+	using Model::_dbToProperties;
+	using Model::_dbToStateVars;
+	using Model::_calcFriction;
+	using Model::_calcFrictionDeriv;
+	using Model::_updateStateVars;
+      }; // Harness
+
+      // ----------------------------------------------------------------
+      // Models. Each provides its properties, the number of
+      // properties, and the cumulative slip at the end of weakening
+      // (zero if the model does not weaken with slip). The
+      // slip-weakening laws run without diagnostics, as by default in
+      // a simulation.
+      // ----------------------------------------------------------------
+
+      struct ViscousModel {
+	typedef ViscousFriction Model;
+	static const char* name(void) { return "viscous"; }
+	static const int numProperties = 3;
+	static PylithScalar residualSlip(void) { return 0.0; }
+	static void properties(Harness<Model>& model, PylithScalar* const values) {
+	  pylith::scalar_array dbValues(3);
+	  dbValues[0] = 0.6; // static_coefficient
+	  dbValues[1] = 1.0e-6; // reference_slip_rate
+	  dbValues[2] = 1.0e+3; // cohesion
+	  model._dbToProperties(values, dbValues);
+	} // properties
+      }; // ViscousModel
+
+      struct DSWModel {
+	typedef DoubleSlipWeakeningFrictionNoHeal Model;
+	static const char* name(void) { return "dsw"; }
+	static const int numProperties = DoubleSlipWeakeningCurve::numProperties;
+	static PylithScalar residualSlip(void) { return 0.03; }
+	static void properties(Harness<Model>& model, PylithScalar* const values) {
+	  pylith::scalar_array dbValues(6);
+	  dbValues[0] = 0.7; // static_coefficient
+	  dbValues[1] = 0.6; // transition_coefficient
+	  dbValues[2] = 0.4; // dynamic_coefficient
+	  dbValues[3] = 0.01; // transition_slip_distance
+	  dbValues[4] = 0.03; // final_slip_distance
+	  dbValues[5] = 1.0e+3; // cohesion
+	  model._dbToProperties(values, dbValues);
+	} // properties
+      }; // DSWModel
+
+      struct PCZModel {
+	typedef ParabolicCohesiveZoneNoHeal Model;
+	static const char* name(void) { return "pcz"; }
+	static const int numProperties = ParabolicCohesiveZoneCurve::numProperties;
+	static PylithScalar residualSlip(void) { return 0.03; }
+	static void properties(Harness<Model>& model, PylithScalar* const values) {
+	  pylith::scalar_array dbValues(5);
+	  dbValues[0] = 0.7; // static_coefficient
+	  dbValues[1] = 0.4; // dynamic_coefficient
+	  dbValues[2] = 0.01; // slip_shift
+	  dbValues[3] = 0.02; // slip_stretch
+	  dbValues[4] = 1.0e+3; // cohesion
+	  model._dbToProperties(values, dbValues);
+	} // properties
+      }; // PCZModel
+
+      struct ECZModel {
+	typedef ExponentialCohesiveZoneNoHeal Model;
+	static const char* name(void) { return "ecz"; }
+	static const int numProperties = ExponentialCohesiveZoneCurve::numProperties;
+	// The exponential never reaches the dynamic value; past this
+	// slip it is within 1e-8 of it.
+	static PylithScalar residualSlip(void) { return 0.2; }
+	static void properties(Harness<Model>& model, PylithScalar* const values) {
+	  pylith::scalar_array dbValues(5);
+	  dbValues[0] = 0.7; // static_coefficient
+	  dbValues[1] = 0.4; // dynamic_coefficient
+	  dbValues[2] = 0.001; // slip_shift
+	  dbValues[3] = 0.01; // slip_stretch
+	  dbValues[4] = 1.0e+3; // cohesion
+	  model._dbToProperties(values, dbValues);
+	} // properties
+      }; // ECZModel
+
+      struct TabModel {
+	typedef TabulatedSlipWeakeningNoHeal Model;
+	static const char* name(void) { return "tab"; }
+	static const int numProperties = TabulatedSlipWeakeningCurve::numProperties;
+	static PylithScalar residualSlip(void) { return 0.03; }
+	static void properties(Harness<Model>& model, PylithScalar* const values) {
+	  // Cubic table of the DSW curve above on a 1 mm grid.
+	  if (0 == model.numTables()) {
+	    const int numPoints = 31;
+	    PylithScalar mu[numPoints];
+	    for (int i=0; i < numPoints; ++i) {
+	      const PylithScalar slip = 0.001*i;
+	      mu[i] = (slip < 0.01) ? 0.7 - 10.0*slip : 0.6 - 10.0*(slip-0.01);
+	    } // for
+	    model.addTable(mu, numPoints, 0.001, true);
+	  } // if
+	  pylith::scalar_array dbValues(2);
+	  dbValues[0] = 0; // curve_index
+	  dbValues[1] = 1.0e+3; // cohesion
+	  model._dbToProperties(values, dbValues);
+	} // properties
+      }; // TabModel
+
+      // ----------------------------------------------------------------
+      /** Create synthetic fault.
+       *
+       * @param fault Fault (output).
+       * @param model Friction model.
+       * @param numVertices Number of vertices.
+       * @param settings Benchmark settings.
+       */
+      template<typename Setup>
+      void
+      createFault(Fault* fault,
+		  Harness<typename Setup::Model>& model,
+		  const int numVertices,
+		  const Settings& settings)
+      { // createFault
+	const int numProperties = Setup::numProperties;
+	const int numStateVars = model.numStateVars();
+
+	fault->numVertices = numVertices;
+	fault->numProperties = numProperties;
+	fault->numStateVars = numStateVars;
+	fault->slip.resize(numVertices);
+	fault->slipRate.resize(numVertices);
+	fault->normalTraction.resize(numVertices);
+	fault->properties.resize(numVertices*numProperties);
+	fault->stateVars.resize(numVertices*numStateVars);
+	fault->friction.resize(numVertices);
+	fault->frictionDeriv.resize(numVertices);
+
+	std::vector<PylithScalar> propertiesVertex(numProperties);
+	Setup::properties(model, &propertiesVertex[0]);
+	pylith::scalar_array dbStateValues(2);
+
+	// Weakening vertices have cumulative slip in the first 90% of
+	// weakening, residual vertices up to 50% past the end.
+	const PylithScalar slipResidual = Setup::residualSlip();
+	Random random;
+	for (int i=0; i < numVertices; ++i) {
+	  const double r = random();
+	  const Regime regime =
+	    (r < settings.mix[LOCKED]) ? LOCKED :
+	    (r < settings.mix[WEAKENING]) ? WEAKENING :
+	    (r < settings.mix[RESIDUAL]) ? RESIDUAL : TENSION;
+
+	  for (int iProp=0; iProp < numProperties; ++iProp)
+	    fault->properties[i*numProperties+iProp] = propertiesVertex[iProp];
+
+	  const PylithScalar slipPrev = 0.1*random();
+	  PylithScalar slipCum = 0.0;
+	  PylithScalar slipIncr = 1.0e-4*(1.0 + random());
+	  switch (regime) {
+	  case LOCKED :
+	    slipCum = 0.5*slipResidual*random();
+	    slipIncr = 0.0;
+	    break;
+	  case WEAKENING :
+	  case TENSION :
+	    slipCum = 0.9*slipResidual*random();
+	    break;
+	  case RESIDUAL :
+	    slipCum = slipResidual*(1.0 + 0.5*random());
+	    break;
+	  default :
+	    assert(0);
+	  } // switch
+	  fault->slip[i] = slipPrev + slipIncr;
+	  fault->slipRate[i] = slipIncr / 1.0e-3;
+	  fault->normalTraction[i] = (TENSION == regime) ?
+	    1.0e+6*random() : -1.0e+6*(1.0 + random());
+
+	  PylithScalar* stateVarsVertex = &fault->stateVars[i*numStateVars];
+	  if (1 == numStateVars) {
+	    stateVarsVertex[0] = fault->slipRate[i];
+	  } else {
+	    dbStateValues[0] = slipCum; // cumulative_slip
+	    dbStateValues[1] = slipPrev; // previous_slip
+	    model._dbToStateVars(stateVarsVertex, dbStateValues);
+	  } // if/else
+	} // for
+      } // createFault
+
+      // ----------------------------------------------------------------
+      /// Functions that are timed.
+      enum Kernel {
+	FRICTION=0, ///< _calcFriction() at each vertex.
+	FRICTION_DERIV=1, ///< _calcFrictionDeriv() at each vertex.
+	FRICTION_AND_DERIV=2, ///< _calcFriction() then _calcFrictionDeriv() at each vertex (as in PyLith).
+	UPDATE=3, ///< _updateStateVars() at each vertex.
+	BATCH_FRICTION=4, ///< calcFrictionBatch().
+	BATCH_FRICTION_AND_DERIV=5, ///< calcFrictionAndDerivBatch().
+	BATCH_UPDATE=6, ///< updateStateVarsBatch() then calcFrictionAndDerivBatch().
+	NUM_KERNELS=7
+      }; // Kernel
+
+      const char* kernelNames[NUM_KERNELS] = {
+	"friction",
+	"deriv",
+	"friction+deriv",
+	"update",
+	"batch friction",
+	"batch friction+deriv",
+	"batch update+eval",
+      };
+
+      /** Run kernel once over the fault.
+       *
+       * @param kernel Kernel to run.
+       * @param model Friction model.
+       * @param fault Fault.
+       *
+       * @returns Checksum of the results, so the work is not optimized away.
+       */
+      template<typename Model>
+      PylithScalar
+      runKernel(const Kernel kernel,
+		Harness<Model>& model,
+		Fault* fault)
+      { // runKernel
+	const int numVertices = fault->numVertices;
+	const int numProperties = fault->numProperties;
+	const int numStateVars = fault->numStateVars;
+	const PylithScalar t = 0.0;
+	const PylithScalar* slip = &fault->slip[0];
+	const PylithScalar* slipRate = &fault->slipRate[0];
+	const PylithScalar* normalTraction = &fault->normalTraction[0];
+	const PylithScalar* properties = &fault->properties[0];
+	PylithScalar* stateVars = &fault->stateVars[0];
+	PylithScalar* friction = &fault->friction[0];
+	PylithScalar* frictionDeriv = &fault->frictionDeriv[0];
+
+	PylithScalar checksum = 0.0;
+	switch (kernel) {
+	case FRICTION :
+	  for (int i=0; i < numVertices; ++i)
+	    checksum += model._calcFriction(t, slip[i], slipRate[i], normalTraction[i],
+					    &properties[i*numProperties], numProperties,
+					    &stateVars[i*numStateVars], numStateVars);
+	  break;
+	case FRICTION_DERIV :
+	  for (int i=0; i < numVertices; ++i)
+	    checksum += model._calcFrictionDeriv(t, slip[i], slipRate[i], normalTraction[i],
+						 &properties[i*numProperties], numProperties,
+						 &stateVars[i*numStateVars], numStateVars);
+	  break;
+	case FRICTION_AND_DERIV :
+	  for (int i=0; i < numVertices; ++i) {
+	    checksum += model._calcFriction(t, slip[i], slipRate[i], normalTraction[i],
+					    &properties[i*numProperties], numProperties,
+					    &stateVars[i*numStateVars], numStateVars);
+	    checksum += model._calcFrictionDeriv(t, slip[i], slipRate[i], normalTraction[i],
+						 &properties[i*numProperties], numProperties,
+						 &stateVars[i*numStateVars], numStateVars);
+	  } // for
+	  break;
+	case UPDATE :
+	  for (int i=0; i < numVertices; ++i)
+	    model._updateStateVars(t, slip[i], slipRate[i], normalTraction[i],
+				   &stateVars[i*numStateVars], numStateVars,
+				   &properties[i*numProperties], numProperties);
+	  checksum += stateVars[0];
+	  break;
+	case BATCH_FRICTION :
+	  model.calcFrictionBatch(friction, t, slip, slipRate, normalTraction,
+				  properties, numProperties, stateVars, numStateVars,
+				  numVertices);
+	  checksum += friction[numVertices-1];
+	  break;
+	case BATCH_FRICTION_AND_DERIV :
+	  model.calcFrictionAndDerivBatch(friction, frictionDeriv, t, slip, slipRate,
+					  normalTraction, properties, numProperties,
+					  stateVars, numStateVars, numVertices);
+	  checksum += friction[numVertices-1] + frictionDeriv[numVertices-1];
+	  break;
+	case BATCH_UPDATE :
+	  model.updateStateVarsBatch(t, slip, slipRate, normalTraction,
+				     stateVars, numStateVars,
+				     properties, numProperties, numVertices);
+	  model.calcFrictionAndDerivBatch(friction, frictionDeriv, t, slip, slipRate,
+					  normalTraction, properties, numProperties,
+					  stateVars, numStateVars, numVertices);
+	  checksum += friction[numVertices-1] + frictionDeriv[numVertices-1];
+	  break;
+	default :
+	  assert(0);
+	} // switch
+
+	return checksum;
+      } // runKernel
+
+      // ----------------------------------------------------------------
+      /** Run benchmark for a model.
+       *
+       * @param settings Benchmark settings.
+       */
+      template<typename Setup>
+      void
+      benchModel(const Settings& settings)
+      { // benchModel
+	Harness<typename Setup::Model> model;
+	model.numThreads(settings.numThreads);
+	model.timeStep(1.0e-3);
+
+	const int numSizes = settings.sizes.size();
+	for (int iSize=0; iSize < numSizes; ++iSize) {
+	  Fault fault;
+	  createFault<Setup>(&fault, model, settings.sizes[iSize], settings);
+	  const std::vector<PylithScalar> stateVarsOrig(fault.stateVars);
+
+	  for (int iKernel=0; iKernel < NUM_KERNELS; ++iKernel) {
+	    const Kernel kernel = Kernel(iKernel);
+
+	    // Warm up (and build the active sets for the batch functions).
+	    model.updateStateVarsBatch(0.0, &fault.slip[0], &fault.slipRate[0],
+				       &fault.normalTraction[0],
+				       &fault.stateVars[0], fault.numStateVars,
+				       &fault.properties[0], fault.numProperties,
+				       fault.numVertices);
+	    fault.stateVars = stateVarsOrig;
+	    PylithScalar checksum = runKernel(kernel, model, &fault);
+
+	    // The update functions change the state variables, so reset
+	    // them before each repetition (not timed).
+	    const bool resetState = UPDATE == kernel || BATCH_UPDATE == kernel;
+	    PetscLogDouble elapsed = 0.0;
+	    PetscLogDouble flops = 0.0;
+	    int numReps = 0;
+	    while (elapsed < settings.minTime || 0 == numReps) {
+	      if (resetState)
+		fault.stateVars = stateVarsOrig;
+
+	      PetscLogDouble flopsStart = 0.0, flopsEnd = 0.0;
+	      PetscLogDouble timeStart = 0.0, timeEnd = 0.0;
+	      PetscGetFlops(&flopsStart);
+	      PetscTime(&timeStart);
+	      checksum += runKernel(kernel, model, &fault);
+	      PetscTime(&timeEnd);
+	      PetscGetFlops(&flopsEnd);
+
+	      elapsed += timeEnd - timeStart;
+	      flops += flopsEnd - flopsStart;
+	      ++numReps;
+	    } // while
+	    fault.stateVars = stateVarsOrig;
+
+	    const double numEvals = double(numReps) * fault.numVertices;
+	    printf("%-8s %10d  %-22s %10.2f %12.4g %10.3f   %g\n",
+		   Setup::name(), fault.numVertices, kernelNames[kernel],
+		   1.0e+9 * elapsed / numEvals,
+		   1.0e-6 * numEvals / elapsed,
+		   1.0e-9 * flops / elapsed,
+		   checksum);
+	  } // for
+	} // for
+      } // benchModel
+
+      // ----------------------------------------------------------------
+      /** Split comma separated list.
+       *
+       * @param value Comma separated list.
+       *
+       * @returns Items in list.
+       */
+      std::vector<std::string>
+      splitList(const char* value)
+      { // splitList
+	std::vector<std::string> items;
+	std::string item;
+	for (const char* c=value; *c; ++c) {
+	  if (',' == *c) {
+	    items.push_back(item);
+	    item.clear();
+	  } else {
+	    item += *c;
+	  } // if/else
+	} // for
+	items.push_back(item);
+	return items;
+      } // splitList
+
+      /** Parse command line arguments.
+       *
+       * @param settings Benchmark settings (output).
+       * @param argc Number of arguments.
+       * @param argv Arguments.
+       *
+       * @returns True if arguments are valid.
+       */
+      bool
+      parseArgs(Settings* settings,
+		int argc,
+		char** argv)
+      { // parseArgs
+	settings->models = splitList("viscous,dsw,pcz,ecz,tab");
+	const std::vector<std::string> sizes = splitList("1000,10000,100000,1000000,10000000");
+	double mix[NUM_REGIMES] = { 0.6, 0.2, 0.15, 0.05 };
+	settings->minTime = 0.2;
+	settings->numThreads = 0;
+
+	std::vector<std::string> sizesArg = sizes;
+	for (int iArg=1; iArg < argc; ++iArg) {
+	  const char* arg = argv[iArg];
+	  if (0 == strncmp(arg, "--models=", 9)) {
+	    settings->models = splitList(arg+9);
+	  } else if (0 == strncmp(arg, "--sizes=", 8)) {
+	    sizesArg = splitList(arg+8);
+	  } else if (0 == strncmp(arg, "--mix=", 6)) {
+	    const std::vector<std::string> items = splitList(arg+6);
+	    if (items.size() != NUM_REGIMES) {
+	      fprintf(stderr, "--mix needs %d values.\n", NUM_REGIMES);
+	      return false;
+	    } // if
+	    for (int i=0; i < NUM_REGIMES; ++i)
+	      mix[i] = atof(items[i].c_str());
+	  } else if (0 == strncmp(arg, "--min-time=", 11)) {
+	    settings->minTime = atof(arg+11);
+	  } else if (0 == strncmp(arg, "--threads=", 10)) {
+	    settings->numThreads = atoi(arg+10);
+	  } else if (0 == strncmp(arg, "-", 1) && 0 != strncmp(arg, "--", 2)) {
+	    // PETSc option; skip it and its value.
+	    if (iArg+1 < argc && '-' != argv[iArg+1][0])
+	      ++iArg;
+	  } else {
+	    fprintf(stderr, "Unknown argument '%s'.\n", arg);
+	    return false;
+	  } // if/else
+	} // for
+
+	settings->sizes.clear();
+	for (size_t i=0; i < sizesArg.size(); ++i) {
+	  const int numVertices = atoi(sizesArg[i].c_str());
+	  if (numVertices <= 0) {
+	    fprintf(stderr, "Invalid fault size '%s'.\n", sizesArg[i].c_str());
+	    return false;
+	  } // if
+	  settings->sizes.push_back(numVertices);
+	} // for
+
+	double total = 0.0;
+	for (int i=0; i < NUM_REGIMES; ++i) {
+	  if (mix[i] < 0.0) {
+	    fprintf(stderr, "Fractions in --mix must be nonnegative.\n");
+	    return false;
+	  } // if
+	  total += mix[i];
+	} // for
+	if (total <= 0.0) {
+	  fprintf(stderr, "Fractions in --mix must not all be zero.\n");
+	  return false;
+	} // if
+	double cumulative = 0.0;
+	for (int i=0; i < NUM_REGIMES; ++i) {
+	  cumulative += mix[i] / total;
+	  settings->mix[i] = cumulative;
+	} // for
+
+	return true;
+      } // parseArgs
+
+    } // _FrictionBench
+  } // friction
+} // contrib
+
+// ----------------------------------------------------------------------
+int
+main(int argc,
+     char** argv)
+{ // main
+  using namespace contrib::friction::_FrictionBench;
+
+  PetscErrorCode err = PetscInitialize(&argc, &argv, NULL, NULL);CHKERRQ(err);
+
+  Settings settings;
+  if (!parseArgs(&settings, argc, argv)) {
+    PetscFinalize();
+    return 1;
+  } // if
+
+  printf("# Regime mix (locked, weakening, residual, tension): %.3f %.3f %.3f %.3f\n",
+	 settings.mix[LOCKED],
+	 settings.mix[WEAKENING] - settings.mix[LOCKED],
+	 settings.mix[RESIDUAL] - settings.mix[WEAKENING],
+	 settings.mix[TENSION] - settings.mix[RESIDUAL]);
+  printf("# %-6s %10s  %-22s %10s %12s %10s   %s\n",
+	 "model", "vertices", "function", "ns/vertex", "Mvertex/s", "GFLOP/s", "checksum");
+
+  const int numModels = settings.models.size();
+  for (int i=0; i < numModels; ++i) {
+    const std::string& name = settings.models[i];
+    try {
+      if (name == ViscousModel::name()) {
+	benchModel<ViscousModel>(settings);
+      } else if (name == DSWModel::name()) {
+	benchModel<DSWModel>(settings);
+      } else if (name == PCZModel::name()) {
+	benchModel<PCZModel>(settings);
+      } else if (name == ECZModel::name()) {
+	benchModel<ECZModel>(settings);
+      } else if (name == TabModel::name()) {
+	benchModel<TabModel>(settings);
+      } else {
+	fprintf(stderr, "Unknown model '%s'.\n", name.c_str());
+	PetscFinalize();
+	return 1;
+      } // if/else
+    } catch (const std::exception& err) {
+      fprintf(stderr, "Error: %s\n", err.what());
+      PetscFinalize();
+      return 1;
+    } // try/catch
+  } // for
+
+  err = PetscFinalize();CHKERRQ(err);
+  return 0;
+} // main
+
+
+// End of file
@@ -0,0 +1,79 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+/* Convert a SimpleDB ASCII file of fault properties to the binary,
+ * memory-mapped spatial database read by FrictionDB (see
+ * FrictionDB.hh), or print a summary of a binary database.
+ *
+ * Usage: frictiondb [--query-type=TYPE] SIMPLEDB FILE   Convert SIMPLEDB to FILE.
+ *        frictiondb FILE                              Print summary of FILE.
+ *
+ * TYPE is the query type of the SimpleDB (default nearest); FrictionDB
+ * returns the values at the nearest point, so linear is refused.
+ */
+
+#include <portinfo> // machine specific info generated by configure
+
+#include "FrictionDB.hh" // USES FrictionDB
+
+#include <cstdio> // USES printf(), fprintf()
+#include <cstring> // USES strncmp(), strlen()
+#include <stdexcept> // USES std::runtime_error
+
+// ----------------------------------------------------------------------
+int
+main(int argc,
+     char** argv)
+{ // main
+  // Query type of the SimpleDB (--query-type=TYPE).
+  const char* queryType = "nearest";
+  const char* queryOption = "--query-type=";
+  int iArg = 1;
+  if (argc > 1 && 0 == strncmp(argv[1], queryOption, strlen(queryOption)))
+    queryType = argv[iArg++] + strlen(queryOption);
+  const int numArgs = argc - iArg;
+  if (numArgs < 1 || numArgs > 2) {
+    fprintf(stderr, "Usage: %s [--query-type=TYPE] SIMPLEDB FILE  (convert SIMPLEDB to FILE)\n"
+	    "       %s FILE                              (print summary of FILE)\n", argv[0], argv[0]);
+    return 1;
+  } // if
+
+  try {
+    const char* filename = argv[argc-1];
+    if (2 == numArgs)
+      contrib::friction::FrictionDB::convert(argv[iArg], filename, queryType);
+
+    contrib::friction::FrictionDB db(filename);
+    db.filename(filename);
+    db.open();
+    printf("# Spatial database '%s': %d points in %d dimensions, %d values:",
+	   filename, db.numLocs(), db.spaceDim(), db.numValues());
+    for (int i=0; i < db.numValues(); ++i)
+      printf(" %s", db.valueName(i));
+    printf("\n");
+    db.close();
+  } catch (const std::exception& err) {
+    fprintf(stderr, "Error: %s\n", err.what());
+    return 1;
+  } // try/catch
+
+  return 0;
+} // main
+
+
+// End of file
@@ -0,0 +1,666 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+/* Replay a trace of the calls to a contrib fault constitutive model.
+ *
+ * A trace recorded with the trace_filename property of a model (see
+ * FrictionTrace.hh) holds the arguments of every call PyLith made to
+ * the model. This driver feeds the calls back through the kernels of
+ * a model and reports the time per call, the throughput, the floating
+ * point rate and checksums of the results (sums of the friction, the
+ * derivatives and the updated state variables), so kernels can be
+ * tuned against the workload of a real simulation and checked for
+ * unchanged results.
+ *
+ * By default the calls are replayed one at a time through the
+ * per-vertex functions, in the recorded order. With --batch,
+ * consecutive calls at the same time are grouped into batches (one
+ * per iteration once the number of fault vertices is known from an
+ * update): the friction calls (with the derivative requests at the
+ * same vertices) go through calcFrictionAndDerivBatch() and the
+ * updates through updateStateVarsBatch(). Friction batches after an
+ * update of the same vertices use the properties and state variables
+ * of the replayed update, as PyLith would. Each replayed update starts from
+ * the recorded state variables; copying them is included in the time.
+ *
+ * Usage: frictionreplay --model=NAME [options] TRACE
+ *
+ *   --model=viscous|dsw|pcz|ecz|tab  Model to replay the trace through
+ *                                    (must have the same properties as
+ *                                    the model that wrote the trace).
+ *   --tables=FILE                    Tables for the tab model (the file
+ *                                    used in the simulation).
+ *   --batch                          Replay through the batch functions.
+ *   --min-time=SECONDS               Minimum time of measurement.
+ *   --threads=N                      Threads for the batch functions.
+ */
+
+#include <portinfo> // machine specific info generated by configure
+
+#include "ViscousFriction.hh" // USES ViscousFriction
+#include "DoubleSlipWeakeningFrictionNoHeal.hh" // USES DoubleSlipWeakeningFrictionNoHeal
+#include "ParabolicCohesiveZoneNoHeal.hh" // USES ParabolicCohesiveZoneNoHeal
+#include "ExponentialCohesiveZoneNoHeal.hh" // USES ExponentialCohesiveZoneNoHeal
+#include "TabulatedSlipWeakeningNoHeal.hh" // USES TabulatedSlipWeakeningNoHeal
+#include "FrictionTrace.hh" // USES FrictionTrace
+
+#include <petscsys.h> // USES PetscInitialize(), PetscGetFlops()
+#include <petsctime.h> // USES PetscTime()
+
+#include <cstdio> // USES printf()
+#include <cstdlib> // USES atoi(), atof()
+#include <cassert> // USES assert()
+#include <cstring> // USES strcmp(), strncmp()
+#include <sstream> // USES std::ostringstream
+#include <stdexcept> // USES std::runtime_error
+#include <string> // USES std::string
+#include <vector> // USES std::vector
+
+// ----------------------------------------------------------------------
+namespace contrib {
+  namespace friction {
+    namespace _FrictionReplay {
+
+      /// Replay settings.
+      struct Settings {
+	std::string model; ///< Model to replay the trace through.
+	std::string tablesFilename; ///< Tables for the tab model.
+	std::string traceFilename; ///< Trace to replay.
+	bool batch; ///< True to replay through the batch functions.
+	double minTime; ///< Minimum time of measurement (s).
+	int numThreads; ///< Threads for batch functions.
+      }; // Settings
+
+      /// Calls in a trace, stored by field.
+      struct Trace {
+	std::string label;
+	int numProperties;
+	int numStateVars;
+	int numRecords;
+	int numCalls[FrictionTrace::NUM_OPERATIONS];
+	std::vector<char> operation;
+	std::vector<PylithScalar> dt;
+	std::vector<PylithScalar> t;
+	std::vector<PylithScalar> slip;
+	std::vector<PylithScalar> slipRate;
+	std::vector<PylithScalar> normalTraction;
+	std::vector<PylithScalar> properties;
+	std::vector<PylithScalar> stateVars;
+      }; // Trace
+
+      /// Consecutive calls at the same time replayed as one batch.
+      struct Batch {
+	bool update; ///< True for updateStateVarsBatch(), false for calcFrictionAndDerivBatch().
+	PylithScalar t;
+	PylithScalar dt;
+	int numVertices;
+	int numDerivs; ///< Number of derivative requests in the batch.
+	int chained; ///< Update batch whose state variables this batch uses (-1 if none).
+	std::vector<PylithScalar> slip;
+	std::vector<PylithScalar> slipRate;
+	std::vector<PylithScalar> normalTraction;
+	std::vector<PylithScalar> properties;
+	std::vector<PylithScalar> stateVarsTrace; ///< Recorded state variables.
+	std::vector<PylithScalar> stateVars; ///< State variables replayed.
+	std::vector<PylithScalar> friction;
+	std::vector<PylithScalar> frictionDeriv;
+      }; // Batch
+
+      /// Checksums of replayed results.
+      struct Checksums {
+	PylithScalar friction;
+	PylithScalar frictionDeriv;
+	PylithScalar stateVars;
+      }; // Checksums
+
+      /** Expose the protected per-vertex interface of a model.
+       *
+       * PyLith calls these functions through FrictionModel, which
+       * requires a PyLith fault; the replay calls them directly.
+       */
+      template<typename Model>
+      class Harness : public Model {
+      public :
+	/// Default constructor.
+	Harness(void) {}
+
+	/** Constructor for the slip-weakening laws.
+	 *
+	 * @param diagnostics True to add the diagnostic state variables.
+	 */
+	Harness(const bool diagnostics) : Model(diagnostics) {}
+
+	using Model::_calcFriction;
+	using Model::_calcFrictionDeriv;
+	using Model::_updateStateVars;
+      }; // Harness
+
+      /** Create a slip-weakening law with the state variables of a
+       * trace, which has the diagnostic state variables if the
+       * simulation turned them on.
+       *
+       * @param trace Trace.
+       *
+       * @returns Friction model (caller owns it).
+       */
+      template<typename Model>
+      Harness<Model>*
+      createSlipWeakening(const Trace& trace)
+      { // createSlipWeakening
+	Harness<Model>* model = new Harness<Model>(false);
+	if (model->numStateVars() != trace.numStateVars) {
+	  delete model; model = new Harness<Model>(true);
+	} // if
+	return model;
+      } // createSlipWeakening
+
+      // ----------------------------------------------------------------
+      // Models. Each provides the number of properties, to check the
+      // trace against, creates the model for the trace, and sets it
+      // up for the replay.
+      // ----------------------------------------------------------------
+
+      struct ViscousModel {
+	typedef ViscousFriction Model;
+	static const char* name(void) { return "viscous"; }
+	static const int numProperties = 3;
+	static Harness<Model>* create(const Trace&) { return new Harness<Model>; }
+	static void setup(Harness<Model>&, const Settings&) {}
+      }; // ViscousModel
+
+      struct DSWModel {
+	typedef DoubleSlipWeakeningFrictionNoHeal Model;
+	static const char* name(void) { return "dsw"; }
+	static const int numProperties = DoubleSlipWeakeningCurve::numProperties;
+	static Harness<Model>* create(const Trace& trace) { return createSlipWeakening<Model>(trace); }
+	static void setup(Harness<Model>&, const Settings&) {}
+      }; // DSWModel
+
+      struct PCZModel {
+	typedef ParabolicCohesiveZoneNoHeal Model;
+	static const char* name(void) { return "pcz"; }
+	static const int numProperties = ParabolicCohesiveZoneCurve::numProperties;
+	static Harness<Model>* create(const Trace& trace) { return createSlipWeakening<Model>(trace); }
+	static void setup(Harness<Model>&, const Settings&) {}
+      }; // PCZModel
+
+      struct ECZModel {
+	typedef ExponentialCohesiveZoneNoHeal Model;
+	static const char* name(void) { return "ecz"; }
+	static const int numProperties = ExponentialCohesiveZoneCurve::numProperties;
+	static Harness<Model>* create(const Trace& trace) { return createSlipWeakening<Model>(trace); }
+	static void setup(Harness<Model>&, const Settings&) {}
+      }; // ECZModel
+
+      struct TabModel {
+	typedef TabulatedSlipWeakeningNoHeal Model;
+	static const char* name(void) { return "tab"; }
+	static const int numProperties = TabulatedSlipWeakeningCurve::numProperties;
+	static Harness<Model>* create(const Trace& trace) { return createSlipWeakening<Model>(trace); }
+	static void setup(Harness<Model>& model, const Settings& settings) {
+	  // The properties in the trace refer to the tables by their
+	  // position, so the tables must be read first and in the same
+	  // order as in the simulation.
+	  if (settings.tablesFilename.empty())
+	    throw std::runtime_error("The tab model needs the tables of the simulation (--tables).");
+	  model.filename(settings.tablesFilename.c_str());
+	} // setup
+      }; // TabModel
+
+      // ----------------------------------------------------------------
+      /** Read trace into memory.
+       *
+       * @param trace Trace (output).
+       * @param filename Name of trace file.
+       */
+      void
+      readTrace(Trace* trace,
+		const char* filename)
+      { // readTrace
+	assert(trace);
+
+	FrictionTrace reader;
+	reader.openRead(filename);
+	trace->label = reader.label();
+	trace->numProperties = reader.numProperties();
+	trace->numStateVars = reader.numStateVars();
+	trace->numRecords = 0;
+	for (int i=0; i < FrictionTrace::NUM_OPERATIONS; ++i)
+	  trace->numCalls[i] = 0;
+
+	FrictionTrace::Record record;
+	while (reader.read(&record)) {
+	  trace->operation.push_back(char(record.operation));
+	  trace->dt.push_back(record.dt);
+	  trace->t.push_back(record.t);
+	  trace->slip.push_back(record.slip);
+	  trace->slipRate.push_back(record.slipRate);
+	  trace->normalTraction.push_back(record.normalTraction);
+	  trace->properties.insert(trace->properties.end(),
+				   record.properties.begin(), record.properties.end());
+	  trace->stateVars.insert(trace->stateVars.end(),
+				  record.stateVars.begin(), record.stateVars.end());
+	  ++trace->numCalls[record.operation];
+	  ++trace->numRecords;
+	} // while
+	reader.close();
+      } // readTrace
+
+      // ----------------------------------------------------------------
+      /** Group consecutive calls at the same time into batches.
+       *
+       * @param batches Batches (output).
+       * @param trace Trace.
+       */
+      void
+      createBatches(std::vector<Batch>* batches,
+		    const Trace& trace)
+      { // createBatches
+	assert(batches);
+
+	const int numProperties = trace.numProperties;
+	const int numStateVars = trace.numStateVars;
+	batches->clear();
+	int numVerticesFault = 0; // vertices in last update
+	for (int i=0; i < trace.numRecords; ++i) {
+	  const bool update = FrictionTrace::UPDATE_STATE_VARS == trace.operation[i];
+	  // PyLith evaluates the friction at every vertex in each
+	  // iteration of a time step, so an iteration ends when it
+	  // covers the vertices of the last update.
+	  const bool iterationDone = !update && !batches->empty() &&
+	    batches->back().numVertices == numVerticesFault &&
+	    FrictionTrace::FRICTION == trace.operation[i];
+	  if (batches->empty() ||
+	      batches->back().update != update ||
+	      batches->back().t != trace.t[i] ||
+	      batches->back().dt != trace.dt[i] ||
+	      iterationDone) {
+	    if (!batches->empty() && batches->back().update)
+	      numVerticesFault = batches->back().numVertices;
+	    batches->push_back(Batch());
+	    Batch& batch = batches->back();
+	    batch.update = update;
+	    batch.t = trace.t[i];
+	    batch.dt = trace.dt[i];
+	    batch.numVertices = 0;
+	    batch.numDerivs = 0;
+	    batch.chained = -1;
+	  } // if
+	  Batch& batch = batches->back();
+
+	  // Derivatives come with the friction of the same vertex.
+	  if (FrictionTrace::FRICTION_DERIV == trace.operation[i]) {
+	    ++batch.numDerivs;
+	    continue;
+	  } // if
+
+	  batch.slip.push_back(trace.slip[i]);
+	  batch.slipRate.push_back(trace.slipRate[i]);
+	  batch.normalTraction.push_back(trace.normalTraction[i]);
+	  batch.properties.insert(batch.properties.end(),
+				  &trace.properties[i*numProperties],
+				  &trace.properties[(i+1)*numProperties]);
+	  if (numStateVars > 0)
+	    batch.stateVarsTrace.insert(batch.stateVarsTrace.end(),
+					&trace.stateVars[i*numStateVars],
+					&trace.stateVars[(i+1)*numStateVars]);
+	  ++batch.numVertices;
+	} // for
+
+	const int numBatches = batches->size();
+	int lastUpdate = -1;
+	for (int iBatch=0; iBatch < numBatches; ++iBatch) {
+	  Batch& batch = (*batches)[iBatch];
+	  batch.stateVars = batch.stateVarsTrace;
+	  batch.friction.resize(batch.numVertices);
+	  batch.frictionDeriv.resize(batch.numVertices);
+
+	  // Friction after an update of the same vertices.
+	  if (batch.update) {
+	    lastUpdate = iBatch;
+	  } else if (lastUpdate >= 0) {
+	    const Batch& update = (*batches)[lastUpdate];
+	    if (update.numVertices == batch.numVertices &&
+		update.properties == batch.properties)
+	      batch.chained = lastUpdate;
+	  } // if/else
+	} // for
+      } // createBatches
+
+      // ----------------------------------------------------------------
+      /** Replay calls one at a time through the per-vertex functions.
+       *
+       * @param model Friction model.
+       * @param trace Trace.
+       *
+       * @returns Checksums of results.
+       */
+      template<typename Model>
+      Checksums
+      replayVertices(Harness<Model>& model,
+		     const Trace& trace)
+      { // replayVertices
+	const int numProperties = trace.numProperties;
+	const int numStateVars = trace.numStateVars;
+	std::vector<PylithScalar> stateVarsUpdated(numStateVars+1);
+
+	Checksums checksums = { 0.0, 0.0, 0.0 };
+	PylithScalar dt = model.timeStep();
+	for (int i=0; i < trace.numRecords; ++i) {
+	  if (trace.dt[i] != dt) {
+	    dt = trace.dt[i];
+	    model.timeStep(dt);
+	  } // if
+	  const PylithScalar* properties = &trace.properties[i*numProperties];
+	  const PylithScalar* stateVars = numStateVars > 0 ? &trace.stateVars[i*numStateVars] : 0;
+	  switch (trace.operation[i]) {
+	  case FrictionTrace::FRICTION :
+	    checksums.friction +=
+	      model._calcFriction(trace.t[i], trace.slip[i], trace.slipRate[i],
+				  trace.normalTraction[i], properties, numProperties,
+				  stateVars, numStateVars);
+	    break;
+	  case FrictionTrace::FRICTION_DERIV :
+	    checksums.frictionDeriv +=
+	      model._calcFrictionDeriv(trace.t[i], trace.slip[i], trace.slipRate[i],
+				       trace.normalTraction[i], properties, numProperties,
+				       stateVars, numStateVars);
+	    break;
+	  case FrictionTrace::UPDATE_STATE_VARS :
+	    for (int j=0; j < numStateVars; ++j)
+	      stateVarsUpdated[j] = stateVars[j];
+	    model._updateStateVars(trace.t[i], trace.slip[i], trace.slipRate[i],
+				   trace.normalTraction[i], &stateVarsUpdated[0], numStateVars,
+				   properties, numProperties);
+	    for (int j=0; j < numStateVars; ++j)
+	      checksums.stateVars += stateVarsUpdated[j];
+	    break;
+	  default :
+	    assert(0);
+	  } // switch
+	} // for
+
+	return checksums;
+      } // replayVertices
+
+      // ----------------------------------------------------------------
+      /** Replay batches through the batch functions.
+       *
+       * @param model Friction model.
+       * @param batches Batches.
+       * @param numProperties Number of properties per vertex.
+       * @param numStateVars Number of state variables per vertex.
+       *
+       * @returns Checksums of results.
+       */
+      template<typename Model>
+      Checksums
+      replayBatches(Harness<Model>& model,
+		    std::vector<Batch>* batches,
+		    const int numProperties,
+		    const int numStateVars)
+      { // replayBatches
+	assert(batches);
+
+	Checksums checksums = { 0.0, 0.0, 0.0 };
+	const int numBatches = batches->size();
+	for (int iBatch=0; iBatch < numBatches; ++iBatch) {
+	  Batch& batch = (*batches)[iBatch];
+	  if (batch.numVertices <= 0)
+	    continue;
+	  if (batch.dt != model.timeStep())
+	    model.timeStep(batch.dt);
+
+	  if (batch.update) {
+	    batch.stateVars = batch.stateVarsTrace;
+	    PylithScalar* stateVars = numStateVars > 0 ? &batch.stateVars[0] : 0;
+	    model.updateStateVarsBatch(batch.t, &batch.slip[0], &batch.slipRate[0],
+				       &batch.normalTraction[0], stateVars, numStateVars,
+				       &batch.properties[0], numProperties, batch.numVertices);
+	    const int size = batch.stateVars.size();
+	    for (int i=0; i < size; ++i)
+	      checksums.stateVars += batch.stateVars[i];
+	  } else {
+	    // Use the properties and state variables of the update, so
+	    // the model sees the same fault as after an update in PyLith.
+	    Batch& source = (batch.chained >= 0) ? (*batches)[batch.chained] : batch;
+	    const PylithScalar* stateVars = numStateVars > 0 ? &source.stateVars[0] : 0;
+	    model.calcFrictionAndDerivBatch(&batch.friction[0], &batch.frictionDeriv[0], batch.t,
+					    &batch.slip[0], &batch.slipRate[0],
+					    &batch.normalTraction[0],
+					    &source.properties[0], numProperties,
+					    stateVars, numStateVars, batch.numVertices);
+	    for (int i=0; i < batch.numVertices; ++i) {
+	      checksums.friction += batch.friction[i];
+	      checksums.frictionDeriv += batch.frictionDeriv[i];
+	    } // for
+	  } // if/else
+	} // for
+
+	return checksums;
+      } // replayBatches
+
+      // ----------------------------------------------------------------
+      /** Replay trace through a model and print the timing.
+       *
+       * @param model Friction model.
+       * @param settings Replay settings.
+       * @param trace Trace.
+       */
+      template<typename Setup>
+      void
+      replayHarness(Harness<typename Setup::Model>& model,
+		    const Settings& settings,
+		    const Trace& trace)
+      { // replayHarness
+	Setup::setup(model, settings);
+	model.numThreads(settings.numThreads);
+
+	std::vector<Batch> batches;
+	long numCalls = trace.numRecords;
+	if (settings.batch) {
+	  createBatches(&batches, trace);
+	  numCalls = 0;
+	  for (size_t i=0; i < batches.size(); ++i)
+	    numCalls += batches[i].numVertices + batches[i].numDerivs;
+	} // if
+
+	// First pass gives the checksums (and warms up).
+	const Checksums checksums = settings.batch ?
+	  replayBatches(model, &batches, trace.numProperties, trace.numStateVars) :
+	  replayVertices(model, trace);
+
+	PetscLogDouble elapsed = 0.0;
+	PetscLogDouble flops = 0.0;
+	int numReps = 0;
+	while (elapsed < settings.minTime || 0 == numReps) {
+	  PetscLogDouble flopsStart = 0.0, flopsEnd = 0.0;
+	  PetscLogDouble timeStart = 0.0, timeEnd = 0.0;
+	  PetscGetFlops(&flopsStart);
+	  PetscTime(&timeStart);
+	  if (settings.batch)
+	    replayBatches(model, &batches, trace.numProperties, trace.numStateVars);
+	  else
+	    replayVertices(model, trace);
+	  PetscTime(&timeEnd);
+	  PetscGetFlops(&flopsEnd);
+
+	  elapsed += timeEnd - timeStart;
+	  flops += flopsEnd - flopsStart;
+	  ++numReps;
+	} // while
+
+	if (settings.batch)
+	  printf("# %d batches, %.1f calls per batch\n",
+		 int(batches.size()),
+		 batches.empty() ? 0.0 : double(numCalls) / batches.size());
+	printf("# %-6s %-7s %10s %12s %10s   %-18s %-18s %-18s\n",
+	       "model", "mode", "ns/call", "Mcall/s", "GFLOP/s",
+	       "friction", "deriv", "state");
+	const double numEvals = double(numReps) * numCalls;
+	printf("%-8s %-7s %10.2f %12.4g %10.3f   %-18.10e %-18.10e %-18.10e\n",
+	       Setup::name(), settings.batch ? "batch" : "vertex",
+	       1.0e+9 * elapsed / numEvals,
+	       1.0e-6 * numEvals / elapsed,
+	       1.0e-9 * flops / elapsed,
+	       checksums.friction, checksums.frictionDeriv, checksums.stateVars);
+      } // replayHarness
+
+      // ----------------------------------------------------------------
+      /** Replay trace through a model.
+       *
+       * @param settings Replay settings.
+       * @param trace Trace.
+       */
+      template<typename Setup>
+      void
+      replayModel(const Settings& settings,
+		  const Trace& trace)
+      { // replayModel
+	if (trace.numProperties != Setup::numProperties) {
+	  std::ostringstream msg;
+	  msg << "Trace has " << trace.numProperties << " properties per vertex, "
+	      << "but model '" << Setup::name() << "' has " << Setup::numProperties << ".";
+	  throw std::runtime_error(msg.str());
+	} // if
+
+	Harness<typename Setup::Model>* model = Setup::create(trace);
+	try {
+	  if (trace.numStateVars != model->numStateVars()) {
+	    std::ostringstream msg;
+	    msg << "Trace has " << trace.numStateVars << " state variables per vertex, "
+		<< "but model '" << Setup::name() << "' has " << model->numStateVars() << ".";
+	    throw std::runtime_error(msg.str());
+	  } // if
+	  replayHarness<Setup>(*model, settings, trace);
+	} catch (...) {
+	  delete model; model = 0;
+	  throw;
+	} // try/catch
+	delete model; model = 0;
+      } // replayModel
+
+      // ----------------------------------------------------------------
+      /** Parse command line arguments.
+       *
+       * @param settings Replay settings (output).
+       * @param argc Number of arguments.
+       * @param argv Arguments.
+       *
+       * @returns True if arguments are valid.
+       */
+      bool
+      parseArgs(Settings* settings,
+		int argc,
+		char** argv)
+      { // parseArgs
+	settings->batch = false;
+	settings->minTime = 0.2;
+	settings->numThreads = 0;
+
+	for (int iArg=1; iArg < argc; ++iArg) {
+	  const char* arg = argv[iArg];
+	  if (0 == strncmp(arg, "--model=", 8)) {
+	    settings->model = arg+8;
+	  } else if (0 == strncmp(arg, "--tables=", 9)) {
+	    settings->tablesFilename = arg+9;
+	  } else if (0 == strcmp(arg, "--batch")) {
+	    settings->batch = true;
+	  } else if (0 == strncmp(arg, "--min-time=", 11)) {
+	    settings->minTime = atof(arg+11);
+	  } else if (0 == strncmp(arg, "--threads=", 10)) {
+	    settings->numThreads = atoi(arg+10);
+	  } else if (0 == strncmp(arg, "-", 1) && 0 != strncmp(arg, "--", 2)) {
+	    // PETSc option; skip it and its value.
+	    if (iArg+1 < argc && '-' != argv[iArg+1][0])
+	      ++iArg;
+	  } else if ('-' != arg[0] && settings->traceFilename.empty()) {
+	    settings->traceFilename = arg;
+	  } else {
+	    fprintf(stderr, "Unknown argument '%s'.\n", arg);
+	    return false;
+	  } // if/else
+	} // for
+
+	if (settings->model.empty() || settings->traceFilename.empty()) {
+	  fprintf(stderr, "Usage: %s --model=viscous|dsw|pcz|ecz|tab [--tables=FILE] "
+		  "[--batch] [--min-time=SECONDS] [--threads=N] TRACE\n", argv[0]);
+	  return false;
+	} // if
+
+	return true;
+      } // parseArgs
+
+    } // _FrictionReplay
+  } // friction
+} // contrib
+
+// ----------------------------------------------------------------------
+int
+main(int argc,
+     char** argv)
+{ // main
+  using namespace contrib::friction::_FrictionReplay;
+
+  PetscErrorCode err = PetscInitialize(&argc, &argv, NULL, NULL);CHKERRQ(err);
+
+  Settings settings;
+  if (!parseArgs(&settings, argc, argv)) {
+    PetscFinalize();
+    return 1;
+  } // if
+
+  try {
+    Trace trace;
+    readTrace(&trace, settings.traceFilename.c_str());
+    printf("# Trace '%s' from model '%s': %d calls (friction %d, deriv %d, update %d)\n",
+	   settings.traceFilename.c_str(), trace.label.c_str(), trace.numRecords,
+	   trace.numCalls[contrib::friction::FrictionTrace::FRICTION],
+	   trace.numCalls[contrib::friction::FrictionTrace::FRICTION_DERIV],
+	   trace.numCalls[contrib::friction::FrictionTrace::UPDATE_STATE_VARS]);
+    if (0 == trace.numRecords)
+      throw std::runtime_error("Trace has no calls.");
+
+    const std::string& name = settings.model;
+    if (name == ViscousModel::name()) {
+      replayModel<ViscousModel>(settings, trace);
+    } else if (name == DSWModel::name()) {
+      replayModel<DSWModel>(settings, trace);
+    } else if (name == PCZModel::name()) {
+      replayModel<PCZModel>(settings, trace);
+    } else if (name == ECZModel::name()) {
+      replayModel<ECZModel>(settings, trace);
+    } else if (name == TabModel::name()) {
+      replayModel<TabModel>(settings, trace);
+    } else {
+      fprintf(stderr, "Unknown model '%s'.\n", name.c_str());
+      PetscFinalize();
+      return 1;
+    } // if/else
+  } catch (const std::exception& err) {
+    fprintf(stderr, "Error: %s\n", err.what());
+    PetscFinalize();
+    return 1;
+  } // try/catch
+
+  err = PetscFinalize();CHKERRQ(err);
+  return 0;
+} // main
+
+
+// End of file
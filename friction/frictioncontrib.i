@@ -28,10 +28,13 @@
 #include "spatialdata/spatialdb/spatialdbfwd.hh" // forward declarations
 #include "spatialdata/units/unitsfwd.hh" // forward declarations
 
+#include "ContribFrictionModel.hh"
 #include "ViscousFriction.hh"
 #include "ParabolicCohesiveZoneNoHeal.hh"
 #include "DoubleSlipWeakeningFrictionNoHeal.hh"
 #include "ExponentialCohesiveZoneNoHeal.hh"
+#include "TabulatedSlipWeakeningNoHeal.hh"
+#include "FrictionDB.hh"
 
 #include "pylith/utils/types.hh"
 #include "pylith/utils/array.hh"
@@ -61,11 +64,15 @@ import_array();
 
 
 // Interface files.
+%import "spatialdata/spatialdb/SpatialDB.i"
 %include "friction/FrictionModel.i"
+%include "ContribFrictionModel.i"
 %include "ViscousFriction.i"
 %include "ParabolicCohesiveZoneNoHeal.i"
 %include "DoubleSlipWeakeningFrictionNoHeal.i"
 %include "ExponentialCohesiveZoneNoHeal.i"
+%include "TabulatedSlipWeakeningNoHeal.i"
+%include "FrictionDB.i"
 
 
 // End of file
@@ -0,0 +1,177 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+// Stand-in for the PETSc functions declared in petscsys.h and
+// petsctime.h (standalone build).
+
+#include <portinfo> // machine specific info generated by configure
+
+#include "petscsys.h" // implementation of functions
+#include "petsctime.h" // implementation of functions
+
+#include <cstdio> // USES printf()
+#include <cstring> // USES strcmp()
+#include <string> // USES std::string
+#include <vector> // USES std::vector
+#include <sys/time.h> // USES gettimeofday()
+
+PetscLogDouble petsc_TotalFlops = 0.0;
+int petsc_logActive = 0;
+
+// ----------------------------------------------------------------------
+namespace _Petsc {
+
+  /// Performance of a log event.
+  struct EventInfo {
+    std::string name; ///< Name of event.
+    int depth; ///< Number of nested calls in progress.
+    int count; ///< Number of calls.
+    PetscLogDouble timeStart; ///< Time at start of outermost call.
+    PetscLogDouble flopsStart; ///< Flops at start of outermost call.
+    PetscLogDouble time; ///< Total time of calls.
+    PetscLogDouble flops; ///< Total flops of calls.
+  }; // EventInfo
+
+  std::vector<EventInfo> events; ///< Registered events.
+  int numClasses = 0; ///< Number of registered classes.
+
+} // _Petsc
+
+// ----------------------------------------------------------------------
+// Initialize logging.
+PetscErrorCode
+PetscInitialize(int* argc,
+		char*** argv,
+		const char file[],
+		const char help[])
+{ // PetscInitialize
+  petsc_TotalFlops = 0.0;
+  petsc_logActive = 0;
+  if (argc && argv)
+    for (int i=1; i < *argc; ++i)
+      if (0 == strcmp((*argv)[i], "-log_view"))
+	petsc_logActive = 1;
+  return 0;
+} // PetscInitialize
+
+// ----------------------------------------------------------------------
+// Finalize logging.
+PetscErrorCode
+PetscFinalize(void)
+{ // PetscFinalize
+  if (petsc_logActive) {
+    printf("Event                 Count      Time (sec)     Flop     Mflop/s\n");
+    const int numEvents = _Petsc::events.size();
+    for (int i=0; i < numEvents; ++i) {
+      const _Petsc::EventInfo& info = _Petsc::events[i];
+      if (0 == info.count)
+	continue;
+      printf("%-20s %7d %14.4e %10.2e %10.0f\n",
+	     info.name.c_str(), info.count, info.time, info.flops,
+	     (info.time > 0.0) ? 1.0e-6 * info.flops / info.time : 0.0);
+    } // for
+  } // if
+  petsc_logActive = 0;
+  return 0;
+} // PetscFinalize
+
+// ----------------------------------------------------------------------
+// Get number of flops logged since PetscInitialize().
+PetscErrorCode
+PetscGetFlops(PetscLogDouble* flops)
+{ // PetscGetFlops
+  *flops = petsc_TotalFlops;
+  return 0;
+} // PetscGetFlops
+
+// ----------------------------------------------------------------------
+// Register class of objects for logging.
+PetscErrorCode
+PetscClassIdRegister(const char name[],
+		     PetscClassId* classid)
+{ // PetscClassIdRegister
+  *classid = _Petsc::numClasses++;
+  return 0;
+} // PetscClassIdRegister
+
+// ----------------------------------------------------------------------
+// Register log event.
+PetscErrorCode
+PetscLogEventRegister(const char name[],
+		      const PetscClassId classid,
+		      PetscLogEvent* event)
+{ // PetscLogEventRegister
+  _Petsc::EventInfo info;
+  info.name = name;
+  info.depth = 0;
+  info.count = 0;
+  info.timeStart = 0.0;
+  info.flopsStart = 0.0;
+  info.time = 0.0;
+  info.flops = 0.0;
+  *event = _Petsc::events.size();
+  _Petsc::events.push_back(info);
+  return 0;
+} // PetscLogEventRegister
+
+// ----------------------------------------------------------------------
+// Start timing of log event.
+PetscErrorCode
+PetscLogEventBeginDefault(const PetscLogEvent event)
+{ // PetscLogEventBeginDefault
+  if (event < 0 || event >= int(_Petsc::events.size()))
+    return 1;
+  _Petsc::EventInfo& info = _Petsc::events[event];
+  // Nested calls of the same event are included in the outermost one.
+  if (info.depth++ > 0)
+    return 0;
+  ++info.count;
+  info.flopsStart = petsc_TotalFlops;
+  return PetscTime(&info.timeStart);
+} // PetscLogEventBeginDefault
+
+// ----------------------------------------------------------------------
+// End timing of log event.
+PetscErrorCode
+PetscLogEventEndDefault(const PetscLogEvent event)
+{ // PetscLogEventEndDefault
+  if (event < 0 || event >= int(_Petsc::events.size()))
+    return 1;
+  _Petsc::EventInfo& info = _Petsc::events[event];
+  if (info.depth <= 0 || --info.depth > 0)
+    return 0;
+  PetscLogDouble timeEnd = 0.0;
+  PetscTime(&timeEnd);
+  info.time += timeEnd - info.timeStart;
+  info.flops += petsc_TotalFlops - info.flopsStart;
+  return 0;
+} // PetscLogEventEndDefault
+
+// ----------------------------------------------------------------------
+// Get wall clock time.
+PetscErrorCode
+PetscTime(PetscLogDouble* t)
+{ // PetscTime
+  struct timeval tv;
+  gettimeofday(&tv, 0);
+  *t = tv.tv_sec + 1.0e-6*tv.tv_usec;
+  return 0;
+} // PetscTime
+
+
+// End of file
@@ -0,0 +1,142 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+/** @file standalone/petscsys.h
+ *
+ * @brief Stand-in for the PETSc system and logging functions used by
+ * the contrib models, tests, and benchmark (standalone build).
+ *
+ * Flops are counted as in PETSc; like PETSc, PetscLogFlops() is not
+ * thread safe and must be called outside parallel regions. The same
+ * holds for the log events, which record the number of calls, the
+ * time, and the flops of each event when the program is run with
+ * -log_view; the summary is printed by PetscFinalize(). The
+ * standalone build runs on a single process, so MPI_Comm_rank()
+ * always returns rank 0.
+ */
+
+#if !defined(petscsys_h)
+#define petscsys_h
+
+typedef int PetscErrorCode;
+typedef int PetscInt;
+typedef double PetscReal;
+typedef double PetscScalar;
+typedef double PetscLogDouble;
+typedef int PetscClassId;
+typedef int PetscLogEvent;
+typedef int MPI_Comm;
+
+#define PETSC_COMM_WORLD 0
+
+/// Total number of flops logged with PetscLogFlops().
+extern PetscLogDouble petsc_TotalFlops;
+
+/// Nonzero if log events are recorded (-log_view).
+extern int petsc_logActive;
+
+#define CHKERRQ(err) do { if (err) return err; } while (0)
+
+/** Initialize logging.
+ *
+ * @param argc Number of command line arguments.
+ * @param argv Command line arguments.
+ * @param file Name of options file (ignored).
+ * @param help Help message (ignored).
+ */
+PetscErrorCode PetscInitialize(int* argc,
+			       char*** argv,
+			       const char file[],
+			       const char help[]);
+
+/// Finalize logging.
+PetscErrorCode PetscFinalize(void);
+
+/** Get number of flops logged since PetscInitialize().
+ *
+ * @param flops Number of flops (output).
+ */
+PetscErrorCode PetscGetFlops(PetscLogDouble* flops);
+
+/** Add flops to the total.
+ *
+ * @param n Number of flops.
+ */
+inline
+PetscErrorCode
+PetscLogFlops(const PetscLogDouble n)
+{ // PetscLogFlops
+  if (n < 0.0)
+    return 1;
+  petsc_TotalFlops += n;
+  return 0;
+} // PetscLogFlops
+
+/** Register class of objects for logging.
+ *
+ * @param name Name of class.
+ * @param classid Identifier of class (output).
+ */
+PetscErrorCode PetscClassIdRegister(const char name[],
+				    PetscClassId* classid);
+
+/** Register log event.
+ *
+ * @param name Name of event.
+ * @param classid Identifier of class of event.
+ * @param event Identifier of event (output).
+ */
+PetscErrorCode PetscLogEventRegister(const char name[],
+				     const PetscClassId classid,
+				     PetscLogEvent* event);
+
+/** Start timing of log event (use PetscLogEventBegin()).
+ *
+ * @param event Identifier of event.
+ */
+PetscErrorCode PetscLogEventBeginDefault(const PetscLogEvent event);
+
+/** End timing of log event (use PetscLogEventEnd()).
+ *
+ * @param event Identifier of event.
+ */
+PetscErrorCode PetscLogEventEndDefault(const PetscLogEvent event);
+
+#define PetscLogEventBegin(e,o1,o2,o3,o4) \
+  (petsc_logActive ? PetscLogEventBeginDefault(e) : 0)
+#define PetscLogEventEnd(e,o1,o2,o3,o4) \
+  (petsc_logActive ? PetscLogEventEndDefault(e) : 0)
+
+/** Get rank of process in communicator.
+ *
+ * @param comm Communicator.
+ * @param rank Rank of process (output).
+ */
+inline
+int
+MPI_Comm_rank(const MPI_Comm /* comm */,
+	      int* rank)
+{ // MPI_Comm_rank
+  *rank = 0;
+  return 0;
+} // MPI_Comm_rank
+
+#endif // petscsys_h
+
+
+// End of file
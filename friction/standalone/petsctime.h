@@ -0,0 +1,38 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+/** @file standalone/petsctime.h
+ *
+ * @brief Stand-in for the PETSc wall clock timer (standalone build).
+ */
+
+#if !defined(petsctime_h)
+#define petsctime_h
+
+#include "petscsys.h" // USES PetscLogDouble
+
+/** Get wall clock time.
+ *
+ * @param t Time in seconds (output).
+ */
+PetscErrorCode PetscTime(PetscLogDouble* t);
+
+#endif // petsctime_h
+
+
+// End of file
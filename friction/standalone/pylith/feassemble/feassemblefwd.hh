@@ -0,0 +1,38 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+/** @file standalone/pylith/feassemble/feassemblefwd.hh
+ *
+ * @brief Forward declarations for PyLith feassemble (standalone
+ * build). The friction models do not use the quadrature passed to
+ * FrictionModel::initialize(), so only its declaration is provided.
+ */
+
+#if !defined(pylith_feassemble_feassemblefwd_hh)
+#define pylith_feassemble_feassemblefwd_hh
+
+namespace pylith {
+  namespace feassemble {
+    class Quadrature;
+  } // feassemble
+} // pylith
+
+#endif // pylith_feassemble_feassemblefwd_hh
+
+
+// End of file
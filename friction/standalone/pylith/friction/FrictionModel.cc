@@ -0,0 +1,278 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+#include <portinfo> // machine specific info generated by configure
+
+#include "FrictionModel.hh" // implementation of object methods
+
+#include "pylith/topology/Mesh.hh" // USES Mesh
+
+#include "spatialdata/spatialdb/SpatialDB.hh" // USES SpatialDB
+#include "spatialdata/units/Nondimensional.hh" // USES Nondimensional
+
+#include <cassert> // USES assert()
+#include <sstream> // USES std::ostringstream
+#include <stdexcept> // USES std::runtime_error
+
+// ----------------------------------------------------------------------
+// Default constructor.
+pylith::friction::FrictionModel::FrictionModel(const pylith::materials::Metadata& metadata) :
+  _normalizer(new spatialdata::units::Nondimensional),
+  _dt(0.0),
+  _propsFiberDim(0),
+  _varsFiberDim(0),
+  _dbProperties(0),
+  _dbInitialState(0),
+  _metadata(metadata),
+  _label("")
+{ // constructor
+  const pylith::string_vector& properties = _metadata.properties();
+  for (size_t i=0; i < properties.size(); ++i)
+    _propsFiberDim += _metadata.getProperty(properties[i].c_str()).fiberDim;
+  const pylith::string_vector& stateVars = _metadata.stateVars();
+  for (size_t i=0; i < stateVars.size(); ++i)
+    _varsFiberDim += _metadata.getStateVar(stateVars[i].c_str()).fiberDim;
+} // constructor
+
+// ----------------------------------------------------------------------
+// Destructor.
+pylith::friction::FrictionModel::~FrictionModel(void)
+{ // destructor
+  deallocate();
+} // destructor
+
+// ----------------------------------------------------------------------
+// Deallocate PETSc and local data structures.
+void
+pylith::friction::FrictionModel::deallocate(void)
+{ // deallocate
+  delete _normalizer; _normalizer = 0;
+} // deallocate
+
+// ----------------------------------------------------------------------
+// Set label of fault constitutive model.
+void
+pylith::friction::FrictionModel::label(const char* value)
+{ // label
+  _label = value;
+} // label
+
+// ----------------------------------------------------------------------
+// Get label of fault constitutive model.
+const char*
+pylith::friction::FrictionModel::label(void) const
+{ // label
+  return _label.c_str();
+} // label
+
+// ----------------------------------------------------------------------
+// Set current time step.
+void
+pylith::friction::FrictionModel::timeStep(const PylithScalar dt)
+{ // timeStep
+  _dt = dt;
+} // timeStep
+
+// ----------------------------------------------------------------------
+// Get current time step.
+PylithScalar
+pylith::friction::FrictionModel::timeStep(void) const
+{ // timeStep
+  return _dt;
+} // timeStep
+
+// ----------------------------------------------------------------------
+// Set scales used to nondimensionalize physical properties.
+void
+pylith::friction::FrictionModel::normalizer(const spatialdata::units::Nondimensional& dim)
+{ // normalizer
+  if (!_normalizer)
+    _normalizer = new spatialdata::units::Nondimensional(dim);
+  else
+    *_normalizer = dim;
+} // normalizer
+
+// ----------------------------------------------------------------------
+// Set database for physical property parameters.
+void
+pylith::friction::FrictionModel::dbProperties(spatialdata::spatialdb::SpatialDB* value)
+{ // dbProperties
+  _dbProperties = value;
+} // dbProperties
+
+// ----------------------------------------------------------------------
+// Set database for initial state variables.
+void
+pylith::friction::FrictionModel::dbInitialState(spatialdata::spatialdb::SpatialDB* value)
+{ // dbInitialState
+  _dbInitialState = value;
+} // dbInitialState
+
+// ----------------------------------------------------------------------
+// Create the fields of physical properties and state variables and
+// fill them from the spatial databases.
+void
+pylith::friction::FrictionModel::initialize(const pylith::topology::Mesh& faultMesh,
+					    pylith::feassemble::Quadrature* quadrature)
+{ // initialize
+  assert(_dbProperties);
+  assert(_normalizer);
+
+  _setupPropsStateVars(faultMesh);
+
+  const int numVertices = faultMesh.numVertices();
+  const int spaceDim = faultMesh.spaceDim();
+  const PylithScalar lengthScale = _normalizer->lengthScale();
+  pylith::scalar_array coordsVertex(spaceDim);
+
+  // Query database for properties.
+  const int numDBProperties = _metadata.numDBProperties();
+  pylith::scalar_array propertiesDBQuery(numDBProperties);
+  _dbProperties->open();
+  _dbProperties->queryVals(_metadata.dbProperties(), numDBProperties);
+  for (int v=0; v < numVertices; ++v) {
+    for (int i=0; i < spaceDim; ++i)
+      coordsVertex[i] = faultMesh.coordinates(v)[i];
+    _normalizer->dimensionalize(&coordsVertex[0], spaceDim, lengthScale);
+
+    const int err = _dbProperties->query(&propertiesDBQuery[0], numDBProperties,
+					 &coordsVertex[0], spaceDim, faultMesh.coordsys());
+    if (err) {
+      std::ostringstream msg;
+      msg << "Could not find parameters for physical properties at \n" << "(";
+      for (int i=0; i < spaceDim; ++i)
+	msg << "  " << coordsVertex[i];
+      msg << ") in friction model " << label() << "\n"
+	  << "using spatial database '" << _dbProperties->label() << "'.";
+      throw std::runtime_error(msg.str());
+    } // if
+    PylithScalar* propertiesVertex = &_propertiesField[size_t(v)*_propsFiberDim];
+    _dbToProperties(propertiesVertex, propertiesDBQuery);
+    _nondimProperties(propertiesVertex, _propsFiberDim);
+  } // for
+  _dbProperties->close();
+
+  // Query database for initial state variables.
+  const int numDBStateVars = _metadata.numDBStateVars();
+  if (_dbInitialState && numDBStateVars > 0) {
+    pylith::scalar_array stateVarsDBQuery(numDBStateVars);
+    _dbInitialState->open();
+    _dbInitialState->queryVals(_metadata.dbStateVars(), numDBStateVars);
+    for (int v=0; v < numVertices; ++v) {
+      for (int i=0; i < spaceDim; ++i)
+	coordsVertex[i] = faultMesh.coordinates(v)[i];
+      _normalizer->dimensionalize(&coordsVertex[0], spaceDim, lengthScale);
+
+      const int err = _dbInitialState->query(&stateVarsDBQuery[0], numDBStateVars,
+					     &coordsVertex[0], spaceDim, faultMesh.coordsys());
+      if (err) {
+	std::ostringstream msg;
+	msg << "Could not find initial state variables at \n" << "(";
+	for (int i=0; i < spaceDim; ++i)
+	  msg << "  " << coordsVertex[i];
+	msg << ") in friction model " << label() << "\n"
+	    << "using spatial database '" << _dbInitialState->label() << "'.";
+	throw std::runtime_error(msg.str());
+      } // if
+      PylithScalar* stateVarsVertex = &_stateVarsField[size_t(v)*_varsFiberDim];
+      _dbToStateVars(stateVarsVertex, stateVarsDBQuery);
+      _nondimStateVars(stateVarsVertex, _varsFiberDim);
+    } // for
+    _dbInitialState->close();
+  } // if
+} // initialize
+
+// ----------------------------------------------------------------------
+// Retrieve the properties and state variables of a vertex.
+void
+pylith::friction::FrictionModel::retrievePropsStateVars(const int point)
+{ // retrievePropsStateVars
+  assert(size_t(point+1)*_propsFiberDim <= _propertiesField.size());
+
+  _propsStateVarsVertex.resize(_propsFiberDim+_varsFiberDim);
+  for (int i=0; i < _propsFiberDim; ++i)
+    _propsStateVarsVertex[i] = _propertiesField[size_t(point)*_propsFiberDim+i];
+  for (int i=0; i < _varsFiberDim; ++i)
+    _propsStateVarsVertex[_propsFiberDim+i] = _stateVarsField[size_t(point)*_varsFiberDim+i];
+} // retrievePropsStateVars
+
+// ----------------------------------------------------------------------
+// Compute friction at the vertex of the last retrievePropsStateVars().
+PylithScalar
+pylith::friction::FrictionModel::calcFriction(const PylithScalar t,
+					      const PylithScalar slip,
+					      const PylithScalar slipRate,
+					      const PylithScalar normalTraction)
+{ // calcFriction
+  assert(_propsStateVarsVertex.size() == size_t(_propsFiberDim+_varsFiberDim));
+
+  return _calcFriction(t, slip, slipRate, normalTraction,
+		       &_propsStateVarsVertex[0], _propsFiberDim,
+		       &_propsStateVarsVertex[0]+_propsFiberDim, _varsFiberDim);
+} // calcFriction
+
+// ----------------------------------------------------------------------
+// Create the fields of physical properties and state variables.
+void
+pylith::friction::FrictionModel::_setupPropsStateVars(const pylith::topology::Mesh& faultMesh)
+{ // _setupPropsStateVars
+  const size_t numVertices = faultMesh.numVertices();
+  _propertiesField.resize(numVertices*_propsFiberDim, 0.0);
+  _stateVarsField.resize(numVertices*_varsFiberDim, 0.0);
+} // _setupPropsStateVars
+
+// ----------------------------------------------------------------------
+// Compute initial state variables from values in spatial database.
+void
+pylith::friction::FrictionModel::_dbToStateVars(PylithScalar* const stateValues,
+						const pylith::scalar_array& dbValues) const
+{ // _dbToStateVars
+} // _dbToStateVars
+
+// ----------------------------------------------------------------------
+// Nondimensionalize state variables.
+void
+pylith::friction::FrictionModel::_nondimStateVars(PylithScalar* const values,
+						  const int nvalues) const
+{ // _nondimStateVars
+} // _nondimStateVars
+
+// ----------------------------------------------------------------------
+// Dimensionalize state variables.
+void
+pylith::friction::FrictionModel::_dimStateVars(PylithScalar* const values,
+					       const int nvalues) const
+{ // _dimStateVars
+} // _dimStateVars
+
+// ----------------------------------------------------------------------
+// Update state variables (for next time step).
+void
+pylith::friction::FrictionModel::_updateStateVars(const PylithScalar t,
+						  const PylithScalar slip,
+						  const PylithScalar slipRate,
+						  const PylithScalar normalTraction,
+						  PylithScalar* const stateVars,
+						  const int numStateVars,
+						  const PylithScalar* properties,
+						  const int numProperties)
+{ // _updateStateVars
+} // _updateStateVars
+
+
+// End of file
@@ -0,0 +1,327 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+/** @file standalone/pylith/friction/FrictionModel.hh
+ *
+ * @brief Stand-in for PyLith FrictionModel (standalone build).
+ *
+ * Provides the part of the PyLith interface for fault constitutive
+ * models that the contrib models use: the label, time step,
+ * nondimensionalization, initialization of the fields of properties
+ * and state variables from spatial databases, the friction at a
+ * vertex, and the protected functions implemented by each model. As
+ * in PyLith, the fields are private; here they are arrays in the
+ * order of the vertices of the fault mesh (see
+ * standalone/pylith/topology/Mesh.hh).
+ */
+
+#if !defined(pylith_friction_frictionmodel_hh)
+#define pylith_friction_frictionmodel_hh
+
+// Include directives ---------------------------------------------------
+#include "pylith/materials/Metadata.hh" // HASA Metadata
+#include "pylith/utils/array.hh" // USES scalar_array
+
+#include "pylith/feassemble/feassemblefwd.hh" // USES Quadrature
+
+#include "spatialdata/spatialdb/spatialdbfwd.hh" // HOLDSA SpatialDB
+#include "spatialdata/units/unitsfwd.hh" // HOLDSA Nondimensional
+
+#include <string> // HASA std::string
+
+// Forward declarations
+namespace pylith {
+  namespace friction {
+    class FrictionModel;
+  } // friction
+  namespace topology {
+    class Mesh;
+  } // topology
+} // pylith
+
+// FrictionModel --------------------------------------------------------
+/** Abstract base class for fault constitutive models.
+ *
+ * Interface definition for fault constitutive models.
+ */
+class pylith::friction::FrictionModel
+{ // class FrictionModel
+
+  // PUBLIC METHODS /////////////////////////////////////////////////////
+public :
+
+  /** Default constructor.
+   *
+   * @param metadata Metadata for physical properties and state variables.
+   */
+  FrictionModel(const pylith::materials::Metadata& metadata);
+
+  /// Destructor.
+  virtual
+  ~FrictionModel(void);
+
+  /// Deallocate data structures.
+  virtual
+  void deallocate(void);
+
+  /** Set label of fault constitutive model.
+   *
+   * @param value Label of fault constitutive model.
+   */
+  void label(const char* value);
+
+  /** Get label of fault constitutive model.
+   *
+   * @returns Label of fault constitutive model.
+   */
+  const char* label(void) const;
+
+  /** Set current time step.
+   *
+   * @param dt Current time step.
+   */
+  void timeStep(const PylithScalar dt);
+
+  /** Get current time step.
+   *
+   * @returns Current time step.
+   */
+  PylithScalar timeStep(void) const;
+
+  /** Set scales used to nondimensionalize physical properties.
+   *
+   * @param dim Nondimensionalizer
+   */
+  void normalizer(const spatialdata::units::Nondimensional& dim);
+
+  /** Set database for physical property parameters.
+   *
+   * @param value Pointer to database.
+   */
+  void dbProperties(spatialdata::spatialdb::SpatialDB* value);
+
+  /** Set database for initial state variables.
+   *
+   * @param value Pointer to database.
+   */
+  void dbInitialState(spatialdata::spatialdb::SpatialDB* value);
+
+  /** Create the fields of physical properties and state variables and
+   * fill them from the spatial databases.
+   *
+   * At each vertex the databases are queried, the values are
+   * converted with _dbToProperties() and _dbToStateVars(), and then
+   * nondimensionalized. State variables are zero without a database
+   * for the initial state.
+   *
+   * @param faultMesh Finite-element mesh of subdomain.
+   * @param quadrature Quadrature for finite-element integration (not used).
+   */
+  virtual
+  void initialize(const pylith::topology::Mesh& faultMesh,
+		  pylith::feassemble::Quadrature* quadrature);
+
+  /** Retrieve the properties and state variables of a vertex.
+   *
+   * @param point Index of the vertex in the fault mesh.
+   */
+  void retrievePropsStateVars(const int point);
+
+  /** Compute friction at the vertex of the last
+   * retrievePropsStateVars().
+   *
+   * @param t Time in simulation.
+   * @param slip Current slip at location.
+   * @param slipRate Current slip rate at location.
+   * @param normalTraction Normal traction at location.
+   *
+   * @returns Friction (magnitude of shear traction) at vertex.
+   */
+  PylithScalar calcFriction(const PylithScalar t,
+			    const PylithScalar slip,
+			    const PylithScalar slipRate,
+			    const PylithScalar normalTraction);
+
+  // PROTECTED METHODS //////////////////////////////////////////////////
+protected :
+
+  /** Compute properties from values in spatial database.
+   *
+   * @param propValues Array of property values.
+   * @param dbValues Array of database values.
+   */
+  virtual
+  void _dbToProperties(PylithScalar* const propValues,
+		       const pylith::scalar_array& dbValues) const = 0;
+
+  /** Nondimensionalize properties.
+   *
+   * @param values Array of property values.
+   * @param nvalues Number of values.
+   */
+  virtual
+  void _nondimProperties(PylithScalar* const values,
+			 const int nvalues) const = 0;
+
+  /** Dimensionalize properties.
+   *
+   * @param values Array of property values.
+   * @param nvalues Number of values.
+   */
+  virtual
+  void _dimProperties(PylithScalar* const values,
+		      const int nvalues) const = 0;
+
+  /** Compute initial state variables from values in spatial database.
+   *
+   * @param stateValues Array of initial state values.
+   * @param dbValues Array of database values.
+   */
+  virtual
+  void _dbToStateVars(PylithScalar* const stateValues,
+		      const pylith::scalar_array& dbValues) const;
+
+  /** Nondimensionalize state variables.
+   *
+   * @param values Array of initial state values.
+   * @param nvalues Number of values.
+   */
+  virtual
+  void _nondimStateVars(PylithScalar* const values,
+			const int nvalues) const;
+
+  /** Dimensionalize state variables.
+   *
+   * @param values Array of initial state values.
+   * @param nvalues Number of values.
+   */
+  virtual
+  void _dimStateVars(PylithScalar* const values,
+		     const int nvalues) const;
+
+  /** Compute friction from properties and state variables.
+   *
+   * @param t Time in simulation.
+   * @param slip Current slip at location.
+   * @param slipRate Current slip rate at location.
+   * @param normalTraction Normal traction at location.
+   * @param properties Properties at location.
+   * @param numProperties Number of properties.
+   * @param stateVars State variables at location.
+   * @param numStateVars Number of state variables.
+   *
+   * @returns Friction (magnitude of shear traction) at vertex.
+   */
+  virtual
+  PylithScalar _calcFriction(const PylithScalar t,
+			     const PylithScalar slip,
+			     const PylithScalar slipRate,
+			     const PylithScalar normalTraction,
+			     const PylithScalar* properties,
+			     const int numProperties,
+			     const PylithScalar* stateVars,
+			     const int numStateVars) = 0;
+
+  /** Compute derivative of friction with slip from properties and
+   * state variables.
+   *
+   * @param t Time in simulation.
+   * @param slip Current slip at location.
+   * @param slipRate Current slip rate at location.
+   * @param normalTraction Normal traction at location.
+   * @param properties Properties at location.
+   * @param numProperties Number of properties.
+   * @param stateVars State variables at location.
+   * @param numStateVars Number of state variables.
+   *
+   * @returns Derivative of friction (magnitude of shear traction) at vertex.
+   */
+  virtual
+  PylithScalar _calcFrictionDeriv(const PylithScalar t,
+				  const PylithScalar slip,
+				  const PylithScalar slipRate,
+				  const PylithScalar normalTraction,
+				  const PylithScalar* properties,
+				  const int numProperties,
+				  const PylithScalar* stateVars,
+				  const int numStateVars) = 0;
+
+  /** Update state variables (for next time step).
+   *
+   * @param t Time in simulation.
+   * @param slip Current slip at location.
+   * @param slipRate Current slip rate at location.
+   * @param normalTraction Normal traction at location.
+   * @param stateVars State variables at location.
+   * @param numStateVars Number of state variables.
+   * @param properties Properties at location.
+   * @param numProperties Number of properties.
+   */
+  virtual
+  void _updateStateVars(const PylithScalar t,
+			const PylithScalar slip,
+			const PylithScalar slipRate,
+			const PylithScalar normalTraction,
+			PylithScalar* const stateVars,
+			const int numStateVars,
+			const PylithScalar* properties,
+			const int numProperties);
+
+  // PROTECTED MEMBERS //////////////////////////////////////////////////
+protected :
+
+  spatialdata::units::Nondimensional* _normalizer; ///< Nondimensionalizer
+  PylithScalar _dt; ///< Current time step
+
+  // PRIVATE METHODS ////////////////////////////////////////////////////
+private :
+
+  /** Create the fields of physical properties and state variables
+   * (filled with zeros) on the vertices of a fault mesh.
+   *
+   * @param faultMesh Finite-element mesh of subdomain.
+   */
+  void _setupPropsStateVars(const pylith::topology::Mesh& faultMesh);
+
+  // PRIVATE MEMBERS ////////////////////////////////////////////////////
+private :
+
+  pylith::scalar_array _propsStateVarsVertex; ///< Properties and state variables of current vertex.
+  pylith::scalar_array _propertiesField; ///< Properties at vertices.
+  pylith::scalar_array _stateVarsField; ///< State variables at vertices.
+  int _propsFiberDim; ///< Number of properties per vertex.
+  int _varsFiberDim; ///< Number of state variables per vertex.
+
+  spatialdata::spatialdb::SpatialDB* _dbProperties; ///< Database of properties.
+  spatialdata::spatialdb::SpatialDB* _dbInitialState; ///< Database of initial state variables.
+
+  const pylith::materials::Metadata _metadata; ///< Property and state variable metadata.
+  std::string _label; ///< Label of fault constitutive model.
+
+  // NOT IMPLEMENTED ////////////////////////////////////////////////////
+private :
+
+  FrictionModel(const FrictionModel&); ///< Not implemented.
+  const FrictionModel& operator=(const FrictionModel&); ///< Not implemented
+
+}; // class FrictionModel
+
+#endif // pylith_friction_frictionmodel_hh
+
+
+// End of file
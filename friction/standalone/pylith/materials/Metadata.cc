@@ -0,0 +1,150 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+#include <portinfo> // machine specific info generated by configure
+
+#include "Metadata.hh" // implementation of class methods
+
+#include <sstream> // USES std::ostringstream
+#include <stdexcept> // USES std::runtime_error
+
+// ----------------------------------------------------------------------
+// Constructor.
+pylith::materials::Metadata::Metadata(const ParamDescription* properties,
+				      const int numProperties,
+				      const char* dbProperties[],
+				      const int numDBProperties,
+				      const ParamDescription* stateVars,
+				      const int numStateVars,
+				      const char* dbStateVars[],
+				      const int numDBStateVars) :
+  _propDescriptions(properties, properties+numProperties),
+  _stateVarDescriptions(stateVars, stateVars+numStateVars),
+  _dbProperties(dbProperties),
+  _dbStateVars(dbStateVars),
+  _numDBProperties(numDBProperties),
+  _numDBStateVars(numDBStateVars)
+{ // constructor
+  for (int i=0; i < numProperties; ++i)
+    _properties.push_back(properties[i].name);
+  for (int i=0; i < numStateVars; ++i)
+    _stateVars.push_back(stateVars[i].name);
+} // constructor
+
+// ----------------------------------------------------------------------
+// Copy constructor.
+pylith::materials::Metadata::Metadata(const Metadata& m) :
+  _propDescriptions(m._propDescriptions),
+  _stateVarDescriptions(m._stateVarDescriptions),
+  _properties(m._properties),
+  _stateVars(m._stateVars),
+  _dbProperties(m._dbProperties),
+  _dbStateVars(m._dbStateVars),
+  _numDBProperties(m._numDBProperties),
+  _numDBStateVars(m._numDBStateVars)
+{ // copy constructor
+} // copy constructor
+
+// ----------------------------------------------------------------------
+// Destructor.
+pylith::materials::Metadata::~Metadata(void)
+{ // destructor
+} // destructor
+
+// ----------------------------------------------------------------------
+// Get names of physical properties.
+const pylith::string_vector&
+pylith::materials::Metadata::properties(void) const
+{ // properties
+  return _properties;
+} // properties
+
+// ----------------------------------------------------------------------
+// Get names of state variables.
+const pylith::string_vector&
+pylith::materials::Metadata::stateVars(void) const
+{ // stateVars
+  return _stateVars;
+} // stateVars
+
+// ----------------------------------------------------------------------
+// Get description of physical property.
+const pylith::materials::Metadata::ParamDescription&
+pylith::materials::Metadata::getProperty(const char* name) const
+{ // getProperty
+  return _find(_propDescriptions, name);
+} // getProperty
+
+// ----------------------------------------------------------------------
+// Get description of state variable.
+const pylith::materials::Metadata::ParamDescription&
+pylith::materials::Metadata::getStateVar(const char* name) const
+{ // getStateVar
+  return _find(_stateVarDescriptions, name);
+} // getStateVar
+
+// ----------------------------------------------------------------------
+// Get names of database values for physical properties.
+const char* const*
+pylith::materials::Metadata::dbProperties(void) const
+{ // dbProperties
+  return _dbProperties;
+} // dbProperties
+
+// ----------------------------------------------------------------------
+// Get number of database values for physical properties.
+int
+pylith::materials::Metadata::numDBProperties(void) const
+{ // numDBProperties
+  return _numDBProperties;
+} // numDBProperties
+
+// ----------------------------------------------------------------------
+// Get names of database values for state variables.
+const char* const*
+pylith::materials::Metadata::dbStateVars(void) const
+{ // dbStateVars
+  return _dbStateVars;
+} // dbStateVars
+
+// ----------------------------------------------------------------------
+// Get number of database values for state variables.
+int
+pylith::materials::Metadata::numDBStateVars(void) const
+{ // numDBStateVars
+  return _numDBStateVars;
+} // numDBStateVars
+
+// ----------------------------------------------------------------------
+// Find description of parameter.
+const pylith::materials::Metadata::ParamDescription&
+pylith::materials::Metadata::_find(const std::vector<ParamDescription>& descriptions,
+				   const char* name)
+{ // _find
+  const size_t size = descriptions.size();
+  for (size_t i=0; i < size; ++i)
+    if (descriptions[i].name == name)
+      return descriptions[i];
+
+  std::ostringstream msg;
+  msg << "Could not find parameter '" << name << "' in metadata.";
+  throw std::runtime_error(msg.str());
+} // _find
+
+
+// End of file
@@ -0,0 +1,172 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+/** @file standalone/pylith/materials/Metadata.hh
+ *
+ * @brief Stand-in for PyLith Metadata (standalone build), the names
+ * and descriptions of the physical properties and state variables of
+ * a constitutive model.
+ */
+
+#if !defined(pylith_materials_metadata_hh)
+#define pylith_materials_metadata_hh
+
+#include "pylith/topology/FieldBase.hh" // USES FieldBase::VectorFieldEnum
+
+#include <string> // HASA std::string
+#include <vector> // HASA std::vector
+
+namespace pylith {
+  namespace materials {
+    class Metadata;
+  } // materials
+
+  typedef std::vector<std::string> string_vector;
+} // pylith
+
+/// Metadata for physical properties and state variables.
+class pylith::materials::Metadata
+{ // class Metadata
+
+  // PUBLIC STRUCTS /////////////////////////////////////////////////////
+public :
+
+  struct ParamDescription {
+    std::string name; ///< Name of parameter.
+    int fiberDim; ///< Fiber dimension of parameter.
+    pylith::topology::FieldBase::VectorFieldEnum fieldType; ///< Type of field.
+  }; // ParamDescription
+
+  // PUBLIC METHODS /////////////////////////////////////////////////////
+public :
+
+  /** Constructor.
+   *
+   * @param properties Array of property descriptions.
+   * @param numProperties Number of physical properties.
+   * @param dbProperties Array of names for database values for properties.
+   * @param numDBProperties Number of database values for properties.
+   * @param stateVars Array of state variable descriptions.
+   * @param numStateVars Number of state variables.
+   * @param dbStateVars Array of names for database values for state variables.
+   * @param numDBStateVars Number of database values for state variables.
+   */
+  Metadata(const ParamDescription* properties,
+	   const int numProperties,
+	   const char* dbProperties[],
+	   const int numDBProperties,
+	   const ParamDescription* stateVars,
+	   const int numStateVars,
+	   const char* dbStateVars[],
+	   const int numDBStateVars);
+
+  /** Copy constructor.
+   *
+   * @param m Metadata to copy.
+   */
+  Metadata(const Metadata& m);
+
+  /// Destructor.
+  ~Metadata(void);
+
+  /** Get names of physical properties.
+   *
+   * @returns Array of names of physical properties.
+   */
+  const string_vector& properties(void) const;
+
+  /** Get names of state variables.
+   *
+   * @returns Array of names of state variables.
+   */
+  const string_vector& stateVars(void) const;
+
+  /** Get description of physical property.
+   *
+   * @param name Name of physical property.
+   * @returns Description of physical property.
+   */
+  const ParamDescription& getProperty(const char* name) const;
+
+  /** Get description of state variable.
+   *
+   * @param name Name of state variable.
+   * @returns Description of state variable.
+   */
+  const ParamDescription& getStateVar(const char* name) const;
+
+  /** Get names of database values for physical properties.
+   *
+   * @returns Array of names.
+   */
+  const char* const* dbProperties(void) const;
+
+  /** Get number of database values for physical properties.
+   *
+   * @returns Number of database values.
+   */
+  int numDBProperties(void) const;
+
+  /** Get names of database values for state variables.
+   *
+   * @returns Array of names.
+   */
+  const char* const* dbStateVars(void) const;
+
+  /** Get number of database values for state variables.
+   *
+   * @returns Number of database values.
+   */
+  int numDBStateVars(void) const;
+
+  // PRIVATE METHODS ////////////////////////////////////////////////////
+private :
+
+  /** Find description of parameter.
+   *
+   * @param descriptions Descriptions of parameters.
+   * @param name Name of parameter.
+   * @returns Description of parameter.
+   */
+  static
+  const ParamDescription& _find(const std::vector<ParamDescription>& descriptions,
+				const char* name);
+
+  // PRIVATE MEMBERS ////////////////////////////////////////////////////
+private :
+
+  std::vector<ParamDescription> _propDescriptions; ///< Descriptions of physical properties.
+  std::vector<ParamDescription> _stateVarDescriptions; ///< Descriptions of state variables.
+  string_vector _properties; ///< Names of physical properties.
+  string_vector _stateVars; ///< Names of state variables.
+  const char* const* _dbProperties; ///< Names of database values for physical properties.
+  const char* const* _dbStateVars; ///< Names of database values for state variables.
+  int _numDBProperties; ///< Number of database values for physical properties.
+  int _numDBStateVars; ///< Number of database values for state variables.
+
+  // NOT IMPLEMENTED ////////////////////////////////////////////////////
+private :
+
+  const Metadata& operator=(const Metadata&); ///< Not implemented
+
+}; // class Metadata
+
+#endif // pylith_materials_metadata_hh
+
+
+// End of file
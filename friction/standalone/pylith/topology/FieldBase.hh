@@ -0,0 +1,59 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+
+/** @file standalone/pylith/topology/FieldBase.hh
+ *
+ * @brief Stand-in for PyLith FieldBase (standalone build). Only the
+ * vector field types used in the metadata of the friction models are
+ * provided.
+ */
+
+#if !defined(pylith_topology_fieldbase_hh)
+#define pylith_topology_fieldbase_hh
+
+namespace pylith {
+  namespace topology {
+    class FieldBase;
+  } // topology
+} // pylith
+
+/// Basic information related to a vector field.
+class pylith::topology::FieldBase
+{ // FieldBase
+
+  // PUBLIC ENUMS ///////////////////////////////////////////////////////
+public :
+
+  enum VectorFieldEnum {
+    SCALAR=0, ///< Scalar.
+    VECTOR=1, ///< Vector.
+    TENSOR=2, ///< Tensor.
+    OTHER=3, ///< Not a scalar, vector, or tensor.
+    MULTI_SCALAR=4, ///< Scalar at multiple points.
+    MULTI_VECTOR=5, ///< Vector at multiple points.
+    MULTI_TENSOR=6, ///< Tensor at multiple points.
+    MULTI_OTHER=7 ///< Not a scalar, vector, or tensor at multiple points.
+  }; // VectorFieldEnum
+
+}; // FieldBase
+
+#endif // pylith_topology_fieldbase_hh
+
+
+// End of file
@@ -0,0 +1,74 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+#include <portinfo> // machine specific info generated by configure
+
+#include "Mesh.hh" // implementation of class methods
+
+#include <cassert> // USES assert()
+
+// ----------------------------------------------------------------------
+// Constructor.
+pylith::topology::Mesh::Mesh(const PylithScalar* coordinates,
+			     const int numVertices,
+			     const int spaceDim,
+			     const spatialdata::geocoords::CoordSys* cs) :
+  _coordinates(coordinates, size_t(numVertices)*spaceDim),
+  _cs(cs),
+  _numVertices(numVertices),
+  _spaceDim(spaceDim)
+{ // constructor
+  assert(coordinates || 0 == numVertices);
+  assert(spaceDim > 0 && spaceDim <= 3);
+} // constructor
+
+// ----------------------------------------------------------------------
+// Get coordinate system.
+const spatialdata::geocoords::CoordSys*
+pylith::topology::Mesh::coordsys(void) const
+{ // coordsys
+  return _cs;
+} // coordsys
+
+// ----------------------------------------------------------------------
+// Get number of spatial dimensions of coordinates.
+int
+pylith::topology::Mesh::spaceDim(void) const
+{ // spaceDim
+  return _spaceDim;
+} // spaceDim
+
+// ----------------------------------------------------------------------
+// Get number of vertices.
+int
+pylith::topology::Mesh::numVertices(void) const
+{ // numVertices
+  return _numVertices;
+} // numVertices
+
+// ----------------------------------------------------------------------
+// Get coordinates of a vertex.
+const PylithScalar*
+pylith::topology::Mesh::coordinates(const int vertex) const
+{ // coordinates
+  assert(0 <= vertex && vertex < _numVertices);
+  return &_coordinates[size_t(vertex)*_spaceDim];
+} // coordinates
+
+
+// End of file
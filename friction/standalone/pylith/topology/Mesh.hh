@@ -0,0 +1,103 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+/** @file standalone/pylith/topology/Mesh.hh
+ *
+ * @brief Stand-in for PyLith Mesh (standalone build). Only the
+ * vertices of a fault mesh and their coordinates are provided, in
+ * place of the PETSc DM of PyLith.
+ */
+
+#if !defined(pylith_topology_mesh_hh)
+#define pylith_topology_mesh_hh
+
+#include "pylith/utils/array.hh" // HASA scalar_array
+
+#include "spatialdata/geocoords/geocoordsfwd.hh" // HOLDSA CoordSys
+
+namespace pylith {
+  namespace topology {
+    class Mesh;
+  } // topology
+} // pylith
+
+/// Vertices of a fault mesh.
+class pylith::topology::Mesh
+{ // Mesh
+
+  // PUBLIC METHODS /////////////////////////////////////////////////////
+public :
+
+  /** Constructor.
+   *
+   * @param coordinates Nondimensional coordinates of vertices [numVertices*spaceDim].
+   * @param numVertices Number of vertices.
+   * @param spaceDim Number of spatial dimensions.
+   * @param cs Coordinate system of coordinates.
+   */
+  Mesh(const PylithScalar* coordinates,
+       const int numVertices,
+       const int spaceDim,
+       const spatialdata::geocoords::CoordSys* cs);
+
+  /** Get coordinate system.
+   *
+   * @returns Coordinate system.
+   */
+  const spatialdata::geocoords::CoordSys* coordsys(void) const;
+
+  /** Get number of spatial dimensions of coordinates.
+   *
+   * @returns Number of dimensions.
+   */
+  int spaceDim(void) const;
+
+  /** Get number of vertices.
+   *
+   * @returns Number of vertices.
+   */
+  int numVertices(void) const;
+
+  /** Get coordinates of a vertex.
+   *
+   * @param vertex Index of vertex.
+   *
+   * @returns Nondimensional coordinates [spaceDim].
+   */
+  const PylithScalar* coordinates(const int vertex) const;
+
+  // PRIVATE MEMBERS ////////////////////////////////////////////////////
+private :
+
+  pylith::scalar_array _coordinates; ///< Coordinates of vertices.
+  const spatialdata::geocoords::CoordSys* _cs; ///< Coordinate system.
+  int _numVertices; ///< Number of vertices.
+  int _spaceDim; ///< Number of spatial dimensions.
+
+  // NOT IMPLEMENTED ////////////////////////////////////////////////////
+private :
+
+  Mesh(const Mesh&); ///< Not implemented
+  const Mesh& operator=(const Mesh&); ///< Not implemented
+
+}; // Mesh
+
+#endif // pylith_topology_mesh_hh
+
+
+// End of file
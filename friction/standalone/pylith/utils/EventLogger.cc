@@ -0,0 +1,111 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+#include <portinfo> // machine specific info generated by configure
+
+#include "EventLogger.hh" // implementation of class methods
+
+#include <cassert> // USES assert()
+#include <sstream> // USES std::ostringstream
+#include <stdexcept> // USES std::runtime_error
+
+// ----------------------------------------------------------------------
+// Constructor
+pylith::utils::EventLogger::EventLogger(void) :
+  _className(""),
+  _classId(0)
+{ // constructor
+} // constructor
+
+// ----------------------------------------------------------------------
+// Destructor
+pylith::utils::EventLogger::~EventLogger(void)
+{ // destructor
+} // destructor
+
+// ----------------------------------------------------------------------
+// Set name of logging class.
+void
+pylith::utils::EventLogger::className(const char* name)
+{ // className
+  _className = name;
+} // className
+
+// ----------------------------------------------------------------------
+// Get name of logging class.
+const char*
+pylith::utils::EventLogger::className(void) const
+{ // className
+  return _className.c_str();
+} // className
+
+// ----------------------------------------------------------------------
+// Setup logging class.
+void
+pylith::utils::EventLogger::initialize(void)
+{ // initialize
+  if ("" == _className)
+    throw std::logic_error("Must set logging class name before "
+			   "initializing EventLogger.");
+
+  PetscErrorCode err = PetscClassIdRegister(_className.c_str(), &_classId);
+  if (err) {
+    std::ostringstream msg;
+    msg << "Could not register logging class '" << _className << "'.";
+    throw std::runtime_error(msg.str());
+  } // if
+  assert(_classId >= 0);
+} // initialize
+
+// ----------------------------------------------------------------------
+// Register event.
+int
+pylith::utils::EventLogger::registerEvent(const char* name)
+{ // registerEvent
+  assert(_classId >= 0);
+
+  PetscLogEvent id = -1;
+  PetscErrorCode err = PetscLogEventRegister(name, _classId, &id);
+  if (err) {
+    std::ostringstream msg;
+    msg << "Could not register logging event '" << name
+	<< "' for logging class '" << _className << "'.";
+    throw std::runtime_error(msg.str());
+  } // if
+  _events[name] = id;
+  return id;
+} // registerEvent
+
+// ----------------------------------------------------------------------
+// Get event identifier.
+int
+pylith::utils::EventLogger::eventId(const char* name)
+{ // eventId
+  map_event_type::iterator iter = _events.find(name);
+  if (iter == _events.end()) {
+    std::ostringstream msg;
+    msg << "Could not find logging event '" << name
+	<< "' in logging class '" << _className << "'.";
+    throw std::runtime_error(msg.str());
+  } // if
+
+  return iter->second;
+} // eventId
+
+
+// End of file
@@ -0,0 +1,117 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+/** @file standalone/pylith/utils/EventLogger.hh
+ *
+ * @brief Stand-in for PyLith EventLogger (standalone build), which
+ * registers PETSc log events of a class of objects.
+ */
+
+#if !defined(pylith_utils_eventlogger_hh)
+#define pylith_utils_eventlogger_hh
+
+// Include directives ---------------------------------------------------
+#include <petscsys.h> // USES PetscClassId, PetscLogEventBegin()
+
+#include <map> // USES std::map
+#include <string> // USES std::string
+
+// Forward declarations
+namespace pylith {
+  namespace utils {
+    class EventLogger;
+  } // utils
+} // pylith
+
+// EventLogger ----------------------------------------------------------
+/// C++ object for managing event logging using PETSc.
+class pylith::utils::EventLogger
+{ // class EventLogger
+
+  // PUBLIC METHODS /////////////////////////////////////////////////////
+public :
+
+  /// Constructor.
+  EventLogger(void);
+
+  /// Destructor.
+  ~EventLogger(void);
+
+  /** Set name of logging class.
+   *
+   * @param name Name of logging class.
+   */
+  void className(const char* name);
+
+  /** Get name of logging class.
+   *
+   * @returns Name of logging class.
+   */
+  const char* className(void) const;
+
+  /// Setup logging class.
+  void initialize(void);
+
+  /** Register event.
+   *
+   * @param name Name of event.
+   *
+   * @returns Event identifier.
+   */
+  int registerEvent(const char* name);
+
+  /** Get event identifier.
+   *
+   * @param name Name of event.
+   *
+   * @returns Event identifier.
+   */
+  int eventId(const char* name);
+
+  /** Log event begin.
+   *
+   * @param id Event identifier.
+   */
+  void eventBegin(const int id);
+
+  /** Log event end.
+   *
+   * @param id Event identifier.
+   */
+  void eventEnd(const int id);
+
+  // PRIVATE TYPEDEFS ///////////////////////////////////////////////////
+private :
+
+  typedef std::map<std::string,int> map_event_type;
+
+  // PRIVATE MEMBERS ////////////////////////////////////////////////////
+private :
+
+  std::string _className; ///< Name of class.
+  PetscClassId _classId; ///< PETSc logging identifier for class.
+  map_event_type _events; ///< PETSc logging identifiers for events.
+
+}; // class EventLogger
+
+#include "EventLogger.icc" // inline methods
+
+#endif // pylith_utils_eventlogger_hh
+
+
+// End of file
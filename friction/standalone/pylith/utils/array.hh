@@ -0,0 +1,40 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+
+/** @file standalone/pylith/utils/array.hh
+ *
+ * @brief Stand-in for PyLith array types (standalone build).
+ */
+
+#if !defined(pylith_utils_array_hh)
+#define pylith_utils_array_hh
+
+#include "types.hh" // USES PylithScalar
+
+#include <valarray> // USES std::valarray
+
+namespace pylith {
+  typedef std::valarray<PylithScalar> scalar_array;
+  typedef std::valarray<int> int_array;
+} // pylith
+
+#endif // pylith_utils_array_hh
+
+
+// End of file
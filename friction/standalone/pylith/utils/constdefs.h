@@ -0,0 +1,33 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+
+/** @file standalone/pylith/utils/constdefs.h
+ *
+ * @brief Stand-in for PyLith constants (standalone build).
+ */
+
+#if !defined(pylith_utils_constdefs_h)
+#define pylith_utils_constdefs_h
+
+#define PYLITH_MAXSCALAR 1.0e+99
+
+#endif // pylith_utils_constdefs_h
+
+
+// End of file
@@ -0,0 +1,39 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+
+/** @file standalone/pylith/utils/types.hh
+ *
+ * @brief Stand-in for PyLith scalar types (standalone build). As in
+ * PyLith, the types come from PETSc, and including this header
+ * provides the PETSc logging functions.
+ */
+
+#if !defined(pylith_utils_types_hh)
+#define pylith_utils_types_hh
+
+#include "petscsys.h" // USES PetscScalar, PetscReal, PetscInt
+
+typedef PetscInt PylithInt;
+typedef PetscReal PylithReal;
+typedef PetscScalar PylithScalar;
+
+#endif // pylith_utils_types_hh
+
+
+// End of file
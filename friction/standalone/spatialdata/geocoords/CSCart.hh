@@ -0,0 +1,65 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+/** @file standalone/spatialdata/geocoords/CSCart.hh
+ *
+ * @brief Stand-in for spatialdata CSCart (standalone build), a
+ * Cartesian coordinate system.
+ */
+
+#if !defined(spatialdata_geocoords_cscart_hh)
+#define spatialdata_geocoords_cscart_hh
+
+#include "CoordSys.hh" // ISA CoordSys
+
+/// Cartesian coordinate system.
+class spatialdata::geocoords::CSCart : public CoordSys
+{ // class CSCart
+
+  // PUBLIC METHODS /////////////////////////////////////////////////////
+public :
+
+  /// Default constructor (coordinates in meters).
+  CSCart(void);
+
+  /// Default destructor.
+  ~CSCart(void);
+
+  /** Set factor to convert coordinates to meters.
+   *
+   * @param factor Factor to convert coordinates to meters.
+   */
+  void toMeters(const double factor);
+
+  /** Get factor to convert coordinates to meters.
+   *
+   * @returns Factor to convert coordinates to meters.
+   */
+  double toMeters(void) const;
+
+  // PRIVATE MEMBERS ////////////////////////////////////////////////////
+private :
+
+  double _toMeters; ///< Factor to convert coordinates to meters.
+
+}; // class CSCart
+
+#endif // spatialdata_geocoords_cscart_hh
+
+
+// End of file
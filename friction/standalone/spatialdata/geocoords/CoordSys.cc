@@ -0,0 +1,87 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+#include <portinfo> // machine specific info generated by configure
+
+#include "CoordSys.hh" // implementation of class methods
+#include "CSCart.hh" // implementation of class methods
+
+#include <cassert> // USES assert()
+
+// ----------------------------------------------------------------------
+// Default constructor
+spatialdata::geocoords::CoordSys::CoordSys(void) :
+  _spaceDim(3)
+{ // constructor
+} // constructor
+
+// ----------------------------------------------------------------------
+// Default destructor
+spatialdata::geocoords::CoordSys::~CoordSys(void)
+{ // destructor
+} // destructor
+
+// ----------------------------------------------------------------------
+// Set number of spatial dimensions in coordinate system.
+void
+spatialdata::geocoords::CoordSys::setSpaceDim(const int ndims)
+{ // setSpaceDim
+  assert(ndims > 0 && ndims <= 3);
+  _spaceDim = ndims;
+} // setSpaceDim
+
+// ----------------------------------------------------------------------
+// Get number of spatial dimensions in coordinate system.
+int
+spatialdata::geocoords::CoordSys::spaceDim(void) const
+{ // spaceDim
+  return _spaceDim;
+} // spaceDim
+
+// ----------------------------------------------------------------------
+// Default constructor
+spatialdata::geocoords::CSCart::CSCart(void) :
+  _toMeters(1.0)
+{ // constructor
+} // constructor
+
+// ----------------------------------------------------------------------
+// Default destructor
+spatialdata::geocoords::CSCart::~CSCart(void)
+{ // destructor
+} // destructor
+
+// ----------------------------------------------------------------------
+// Set factor to convert coordinates to meters.
+void
+spatialdata::geocoords::CSCart::toMeters(const double factor)
+{ // toMeters
+  assert(factor > 0.0);
+  _toMeters = factor;
+} // toMeters
+
+// ----------------------------------------------------------------------
+// Get factor to convert coordinates to meters.
+double
+spatialdata::geocoords::CSCart::toMeters(void) const
+{ // toMeters
+  return _toMeters;
+} // toMeters
+
+
+// End of file
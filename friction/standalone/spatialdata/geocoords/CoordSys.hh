@@ -0,0 +1,65 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+/** @file standalone/spatialdata/geocoords/CoordSys.hh
+ *
+ * @brief Stand-in for spatialdata CoordSys (standalone build), the
+ * interface of coordinate systems.
+ */
+
+#if !defined(spatialdata_geocoords_coordsys_hh)
+#define spatialdata_geocoords_coordsys_hh
+
+#include "geocoordsfwd.hh" // forward declarations
+
+/// Interface of coordinate systems.
+class spatialdata::geocoords::CoordSys
+{ // class CoordSys
+
+  // PUBLIC METHODS /////////////////////////////////////////////////////
+public :
+
+  /// Default constructor (3-D).
+  CoordSys(void);
+
+  /// Default destructor.
+  virtual ~CoordSys(void);
+
+  /** Set number of spatial dimensions in coordinate system.
+   *
+   * @param ndims Number of dimensions.
+   */
+  void setSpaceDim(const int ndims);
+
+  /** Get number of spatial dimensions in coordinate system.
+   *
+   * @returns Number of dimensions.
+   */
+  int spaceDim(void) const;
+
+  // PRIVATE MEMBERS ////////////////////////////////////////////////////
+private :
+
+  int _spaceDim; ///< Number of spatial dimensions.
+
+}; // class CoordSys
+
+#endif // spatialdata_geocoords_coordsys_hh
+
+
+// End of file
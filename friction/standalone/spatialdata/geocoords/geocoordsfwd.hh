@@ -0,0 +1,37 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+/** @file standalone/spatialdata/geocoords/geocoordsfwd.hh
+ *
+ * @brief Forward declarations for spatialdata geocoords (standalone build).
+ */
+
+#if !defined(spatialdata_geocoords_geocoordsfwd_hh)
+#define spatialdata_geocoords_geocoordsfwd_hh
+
+namespace spatialdata {
+  namespace geocoords {
+    class CoordSys;
+    class CSCart;
+  } // geocoords
+} // spatialdata
+
+#endif // spatialdata_geocoords_geocoordsfwd_hh
+
+
+// End of file
@@ -0,0 +1,63 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+#include <portinfo> // machine specific info generated by configure
+
+#include "SpatialDB.hh" // implementation of class methods
+
+#include <cassert> // USES assert()
+
+// ----------------------------------------------------------------------
+// Default constructor
+spatialdata::spatialdb::SpatialDB::SpatialDB(void) :
+  _label("")
+{ // constructor
+} // constructor
+
+// ----------------------------------------------------------------------
+// Constructor with label
+spatialdata::spatialdb::SpatialDB::SpatialDB(const char* label) :
+  _label(label)
+{ // constructor
+} // constructor
+
+// ----------------------------------------------------------------------
+// Default destructor
+spatialdata::spatialdb::SpatialDB::~SpatialDB(void)
+{ // destructor
+} // destructor
+
+// ----------------------------------------------------------------------
+// Set label of spatial database.
+void
+spatialdata::spatialdb::SpatialDB::label(const char* label)
+{ // label
+  assert(label);
+  _label = label;
+} // label
+
+// ----------------------------------------------------------------------
+// Get label of spatial database.
+const char*
+spatialdata::spatialdb::SpatialDB::label(void) const
+{ // label
+  return _label.c_str();
+} // label
+
+
+// End of file
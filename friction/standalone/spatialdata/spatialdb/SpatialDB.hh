@@ -0,0 +1,126 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+/** @file standalone/spatialdata/spatialdb/SpatialDB.hh
+ *
+ * @brief Stand-in for spatialdata SpatialDB (standalone build), the
+ * interface of spatial databases.
+ */
+
+#if !defined(spatialdata_spatialdb_spatialdb_hh)
+#define spatialdata_spatialdb_spatialdb_hh
+
+#include "spatialdbfwd.hh" // forward declarations
+#include "spatialdata/geocoords/geocoordsfwd.hh" // USES CoordSys
+
+#include <string> // HASA std::string
+
+/// Interface of spatial databases.
+class spatialdata::spatialdb::SpatialDB
+{ // class SpatialDB
+
+  // PUBLIC METHODS /////////////////////////////////////////////////////
+public :
+
+  /// Default constructor.
+  SpatialDB(void);
+
+  /** Constructor with label.
+   *
+   * @param label Label for database.
+   */
+  SpatialDB(const char* label);
+
+  /// Default destructor.
+  virtual ~SpatialDB(void);
+
+  /** Set label of spatial database.
+   *
+   * @param label Label for database.
+   */
+  void label(const char* label);
+
+  /** Get label of spatial database.
+   *
+   * @returns Label for database.
+   */
+  const char* label(void) const;
+
+  /// Open the database and prepare for querying.
+  virtual void open(void) = 0;
+
+  /// Close the database.
+  virtual void close(void) = 0;
+
+  /** Set values to be returned by queries.
+   *
+   * @param names Names of values to be returned in queries.
+   * @param numVals Number of values to be returned in queries.
+   */
+  virtual void queryVals(const char* const* names,
+			 const int numVals) = 0;
+
+  /** Query the database.
+   *
+   * @param vals Array for computed values (output from query).
+   * @param numVals Number of values expected (size of pVals array).
+   * @param coords Coordinates of point for query.
+   * @param numDims Number of dimensions for coordinates.
+   * @param csQuery Coordinate system of coordinates.
+   *
+   * @returns 0 on success, 1 on failure (i.e., could not interpolate).
+   */
+  virtual int query(double* vals,
+		    const int numVals,
+		    const double* coords,
+		    const int numDims,
+		    const spatialdata::geocoords::CoordSys* csQuery) = 0;
+
+  /** Query the database.
+   *
+   * @param vals Array for computed values (output from query).
+   * @param numVals Number of values expected (size of pVals array).
+   * @param coords Coordinates of point for query.
+   * @param numDims Number of dimensions for coordinates.
+   * @param csQuery Coordinate system of coordinates.
+   *
+   * @returns 0 on success, 1 on failure (i.e., could not interpolate).
+   */
+  virtual int query(float* vals,
+		    const int numVals,
+		    const float* coords,
+		    const int numDims,
+		    const spatialdata::geocoords::CoordSys* csQuery) = 0;
+
+  // PRIVATE MEMBERS ////////////////////////////////////////////////////
+private :
+
+  std::string _label; ///< Label of spatial database.
+
+  // NOT IMPLEMENTED ////////////////////////////////////////////////////
+private :
+
+  SpatialDB(const SpatialDB&); ///< Not implemented
+  const SpatialDB& operator=(const SpatialDB&); ///< Not implemented
+
+}; // class SpatialDB
+
+#endif // spatialdata_spatialdb_spatialdb_hh
+
+
+// End of file
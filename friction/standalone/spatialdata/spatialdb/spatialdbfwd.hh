@@ -0,0 +1,36 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+/** @file standalone/spatialdata/spatialdb/spatialdbfwd.hh
+ *
+ * @brief Forward declarations for spatialdata spatialdb (standalone build).
+ */
+
+#if !defined(spatialdata_spatialdb_spatialdbfwd_hh)
+#define spatialdata_spatialdb_spatialdbfwd_hh
+
+namespace spatialdata {
+  namespace spatialdb {
+    class SpatialDB;
+  } // spatialdb
+} // spatialdata
+
+#endif // spatialdata_spatialdb_spatialdbfwd_hh
+
+
+// End of file
@@ -0,0 +1,149 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+#include <portinfo> // machine specific info generated by configure
+
+#include "Nondimensional.hh" // implementation of class methods
+
+#include <cassert> // USES assert()
+
+// ----------------------------------------------------------------------
+// Default constructor
+spatialdata::units::Nondimensional::Nondimensional(void) :
+  _length(1.0),
+  _pressure(1.0),
+  _time(1.0),
+  _density(1.0)
+{ // constructor
+} // constructor
+
+// ----------------------------------------------------------------------
+// Default destructor
+spatialdata::units::Nondimensional::~Nondimensional(void)
+{ // destructor
+} // destructor
+
+// ----------------------------------------------------------------------
+// Set value to nondimensionalize length scale.
+void
+spatialdata::units::Nondimensional::lengthScale(const double value)
+{ // lengthScale
+  _length = value;
+} // lengthScale
+
+// ----------------------------------------------------------------------
+// Get value to nondimensionalize length scale.
+double
+spatialdata::units::Nondimensional::lengthScale(void) const
+{ // lengthScale
+  return _length;
+} // lengthScale
+
+// ----------------------------------------------------------------------
+// Set value to nondimensionalize pressure scale.
+void
+spatialdata::units::Nondimensional::pressureScale(const double value)
+{ // pressureScale
+  _pressure = value;
+} // pressureScale
+
+// ----------------------------------------------------------------------
+// Get value to nondimensionalize pressure scale.
+double
+spatialdata::units::Nondimensional::pressureScale(void) const
+{ // pressureScale
+  return _pressure;
+} // pressureScale
+
+// ----------------------------------------------------------------------
+// Set value to nondimensionalize time scale.
+void
+spatialdata::units::Nondimensional::timeScale(const double value)
+{ // timeScale
+  _time = value;
+} // timeScale
+
+// ----------------------------------------------------------------------
+// Get value to nondimensionalize time scale.
+double
+spatialdata::units::Nondimensional::timeScale(void) const
+{ // timeScale
+  return _time;
+} // timeScale
+
+// ----------------------------------------------------------------------
+// Set value to nondimensionalize density scale.
+void
+spatialdata::units::Nondimensional::densityScale(const double value)
+{ // densityScale
+  _density = value;
+} // densityScale
+
+// ----------------------------------------------------------------------
+// Get value to nondimensionalize density scale.
+double
+spatialdata::units::Nondimensional::densityScale(void) const
+{ // densityScale
+  return _density;
+} // densityScale
+
+// ----------------------------------------------------------------------
+// Make value dimensionless.
+double
+spatialdata::units::Nondimensional::nondimensionalize(const double value,
+						      const double scale) const
+{ // nondimensionalize
+  assert(scale > 0.0);
+  return value / scale;
+} // nondimensionalize
+
+// ----------------------------------------------------------------------
+// Make value dimensional.
+double
+spatialdata::units::Nondimensional::dimensionalize(const double value,
+						   const double scale) const
+{ // dimensionalize
+  return value * scale;
+} // dimensionalize
+
+// ----------------------------------------------------------------------
+// Make values dimensionless.
+void
+spatialdata::units::Nondimensional::nondimensionalize(double* const values,
+						      const int nvalues,
+						      const double scale) const
+{ // nondimensionalize
+  assert(scale > 0.0);
+  const double scaleInv = 1.0 / scale;
+  for (int i=0; i < nvalues; ++i)
+    values[i] *= scaleInv;
+} // nondimensionalize
+
+// ----------------------------------------------------------------------
+// Make values dimensional.
+void
+spatialdata::units::Nondimensional::dimensionalize(double* const values,
+						   const int nvalues,
+						   const double scale) const
+{ // dimensionalize
+  for (int i=0; i < nvalues; ++i)
+    values[i] *= scale;
+} // dimensionalize
+
+
+// End of file
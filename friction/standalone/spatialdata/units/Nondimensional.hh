@@ -0,0 +1,142 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+/** @file standalone/spatialdata/units/Nondimensional.hh
+ *
+ * @brief Stand-in for spatialdata Nondimensional (standalone build),
+ * the scales used to nondimensionalize problems.
+ */
+
+#if !defined(spatialdata_units_nondimensional_hh)
+#define spatialdata_units_nondimensional_hh
+
+#include "unitsfwd.hh" // forward declarations
+
+/// Nondimensionalize and dimensionalize values.
+class spatialdata::units::Nondimensional
+{ // class Nondimensional
+
+  // PUBLIC METHODS /////////////////////////////////////////////////////
+public :
+
+  /// Default constructor (all scales equal to 1).
+  Nondimensional(void);
+
+  /// Destructor.
+  ~Nondimensional(void);
+
+  /** Set value to nondimensionalize length scale in meters (SI units).
+   *
+   * @param value Length scale in meters (SI units).
+   */
+  void lengthScale(const double value);
+
+  /** Get value to nondimensionalize length scale in meters (SI units).
+   *
+   * @returns Length scale in meters (SI units).
+   */
+  double lengthScale(void) const;
+
+  /** Set value to nondimensionalize pressure scale in Pascals (SI units).
+   *
+   * @param value Pressure scale in Pascals (SI units).
+   */
+  void pressureScale(const double value);
+
+  /** Get value to nondimensionalize pressure scale in Pascals (SI units).
+   *
+   * @returns Pressure scale in Pascals (SI units).
+   */
+  double pressureScale(void) const;
+
+  /** Set value to nondimensionalize time scale in seconds (SI units).
+   *
+   * @param value Time scale in seconds (SI units).
+   */
+  void timeScale(const double value);
+
+  /** Get value to nondimensionalize time scale in seconds (SI units).
+   *
+   * @returns Time scale in seconds (SI units).
+   */
+  double timeScale(void) const;
+
+  /** Set value to nondimensionalize density scale in kg/m^3 (SI units).
+   *
+   * @param value Density scale in kg/m^3 (SI units).
+   */
+  void densityScale(const double value);
+
+  /** Get value to nondimensionalize density scale in kg/m^3 (SI units).
+   *
+   * @returns Density scale in kg/m^3 (SI units).
+   */
+  double densityScale(void) const;
+
+  /** Make value dimensionless.
+   *
+   * @param value Value in SI units.
+   * @param scale Value of scale in SI units.
+   * @returns Dimensionless value.
+   */
+  double nondimensionalize(const double value,
+			   const double scale) const;
+
+  /** Make value dimensional.
+   *
+   * @param value Dimensionless value.
+   * @param scale Value of scale in SI units.
+   * @returns Value in SI units.
+   */
+  double dimensionalize(const double value,
+			const double scale) const;
+
+  /** Make values dimensionless.
+   *
+   * @param values Array of values in SI units.
+   * @param nvalues Number of values.
+   * @param scale Value of scale in SI units.
+   */
+  void nondimensionalize(double* const values,
+			 const int nvalues,
+			 const double scale) const;
+
+  /** Make values dimensional.
+   *
+   * @param values Array of dimensionless values.
+   * @param nvalues Number of values.
+   * @param scale Value of scale in SI units.
+   */
+  void dimensionalize(double* const values,
+		      const int nvalues,
+		      const double scale) const;
+
+  // PRIVATE MEMBERS ////////////////////////////////////////////////////
+private :
+
+  double _length; ///< Length scale in meters.
+  double _pressure; ///< Pressure scale in Pascals.
+  double _time; ///< Time scale in seconds.
+  double _density; ///< Density scale in kg/m^3.
+
+}; // class Nondimensional
+
+#endif // spatialdata_units_nondimensional_hh
+
+
+// End of file
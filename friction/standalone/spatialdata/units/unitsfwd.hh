@@ -0,0 +1,36 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+/** @file standalone/spatialdata/units/unitsfwd.hh
+ *
+ * @brief Forward declarations for spatialdata units (standalone build).
+ */
+
+#if !defined(spatialdata_units_unitsfwd_hh)
+#define spatialdata_units_unitsfwd_hh
+
+namespace spatialdata {
+  namespace units {
+    class Nondimensional;
+  } // units
+} // spatialdata
+
+#endif // spatialdata_units_unitsfwd_hh
+
+
+// End of file
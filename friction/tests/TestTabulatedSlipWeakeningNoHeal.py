@@ -0,0 +1,92 @@
+#!/usr/bin/env python
+#
+# ======================================================================
+#
+# Brad T. Aagaard, U.S. Geological Survey
+# Charles A. Williams, GNS Science
+# Matthew G. Knepley, University of Chicago
+#
+# This code was developed as part of the Computational Infrastructure
+# for Geodynamics (http://geodynamics.org).
+#
+# Copyright (c) 2010-2017 University of California, Davis
+#
+# See COPYING for license information.
+#
+# ======================================================================
+#
+
+# We cannot test the low-level functionality of the TabulatedSlipWeakeningNoHeal
+# object because it is not exposed to Python. You should really setup
+# C++ unit tests using CppUnit as is done for PyLith in addition to
+# the simple Python unit tests here.
+
+import unittest
+
+
+class TestTabulatedSlipWeakeningNoHeal(unittest.TestCase):
+  """
+  Unit testing of TabulatedSlipWeakeningNoHeal object.
+  """
+
+  def setUp(self):
+    """
+    Setup test subject.
+    """
+    from pylith.friction.contrib.TabulatedSlipWeakeningNoHeal import TabulatedSlipWeakeningNoHeal
+    self.model = TabulatedSlipWeakeningNoHeal()
+    return
+  
+
+  def test_label(self):
+    """
+    Test constructor.
+    """
+    label = "tabulated slip weakening friction"
+    self.model.label(label)
+    self.assertEqual(label, self.model.label())
+    return
+
+
+  def test_timeStep(self):
+    """
+    Test constructor.
+    """
+    dt = 2.4
+    self.model.timeStep(dt)
+    self.assertAlmostEqual(dt, self.model.timeStep(), 5)
+    return
+
+
+  def test_filename(self):
+    """
+    Test reading tables from file.
+    """
+    import os
+    import tempfile
+    (fd, filename) = tempfile.mkstemp()
+    os.write(fd, "// Two tables\n"
+             "2\n"
+             "3 0.01 linear 0.6 0.5 0.4\n"
+             "4 0.02 cubic 0.7 0.6 0.5 0.45\n")
+    os.close(fd)
+    try:
+      self.model.filename(filename)
+      self.assertEqual(2, self.model.numTables())
+    finally:
+      os.remove(filename)
+
+    self.assertRaises(RuntimeError, self.model.filename, filename)
+    return
+
+
+  def test_factory(self):
+    """
+    Test factory method.
+    """
+    from pylith.friction.contrib.TabulatedSlipWeakeningNoHeal import friction_model
+    f = friction_model()
+    return
+
+
+# End of file
@@ -0,0 +1,145 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+#include <portinfo> // machine specific info generated by configure
+
+#include "TestFrictionModel.hh" // Implementation of class methods
+
+#include <cassert> // USES assert()
+#include <cmath> // USES fabs()
+#include <cstdio> // USES printf()
+
+// ----------------------------------------------------------------------
+// Default constructor.
+contrib::friction::TestFrictionModel::TestFrictionModel(void) :
+  _group(""),
+  _numChecks(0),
+  _numFailures(0)
+{ // constructor
+} // constructor
+
+// ----------------------------------------------------------------------
+// Start group of checks.
+void
+contrib::friction::TestFrictionModel::start(const char* name)
+{ // start
+  _group = name;
+  printf("%s\n", name);
+} // start
+
+// ----------------------------------------------------------------------
+// Check condition.
+void
+contrib::friction::TestFrictionModel::check(const bool condition,
+					    const std::string& what)
+{ // check
+  ++_numChecks;
+  if (!condition) {
+    ++_numFailures;
+    printf("  FAILED: %s: %s\n", _group.c_str(), what.c_str());
+  } // if
+} // check
+
+// ----------------------------------------------------------------------
+// Check value against expected value.
+void
+contrib::friction::TestFrictionModel::checkClose(const PylithScalar valueE,
+						 const PylithScalar value,
+						 const PylithScalar tolerance,
+						 const std::string& what)
+{ // checkClose
+  const PylithScalar scale = fabs(valueE) > 1.0 ? fabs(valueE) : 1.0;
+  const bool close = fabs(value - valueE) <= tolerance*scale;
+  check(close, what);
+  if (!close)
+    printf("    expected %.12g, got %.12g\n", valueE, value);
+} // checkClose
+
+// ----------------------------------------------------------------------
+// Get number of failed checks.
+int
+contrib::friction::TestFrictionModel::numFailures(void) const
+{ // numFailures
+  return _numFailures;
+} // numFailures
+
+// ----------------------------------------------------------------------
+// Get number of checks.
+int
+contrib::friction::TestFrictionModel::numChecks(void) const
+{ // numChecks
+  return _numChecks;
+} // numChecks
+
+// ----------------------------------------------------------------------
+// Create random fault.
+void
+contrib::friction::TestFrictionModel::createFault(Fault* fault,
+						  const int numVertices,
+						  const PylithScalar* propertiesVertex,
+						  const int numProperties,
+						  const int numStateVars,
+						  const PylithScalar maxSlip)
+{ // createFault
+  assert(fault);
+  assert(propertiesVertex);
+  assert(numStateVars > 0);
+
+  fault->numVertices = numVertices;
+  fault->numProperties = numProperties;
+  fault->numStateVars = numStateVars;
+  fault->slip.resize(numVertices);
+  fault->slipRate.resize(numVertices);
+  fault->normalTraction.resize(numVertices);
+  fault->properties.resize(numVertices*numProperties);
+  fault->stateVars.resize(numVertices*numStateVars);
+
+  // Linear congruential generator, so the fault is the same on every
+  // platform.
+  unsigned int state = 2017u;
+  for (int i=0; i < numVertices; ++i) {
+    PylithScalar r[4];
+    for (int j=0; j < 4; ++j) {
+      state = 1664525u*state + 1013904223u;
+      r[j] = PylithScalar(state >> 8) / PylithScalar(1u << 24);
+    } // for
+
+    for (int iProp=0; iProp < numProperties; ++iProp)
+      fault->properties[i*numProperties+iProp] = propertiesVertex[iProp];
+
+    // 30% locked, 60% slipping, 10% in tension.
+    const bool locked = r[0] < 0.3;
+    const bool tension = r[0] > 0.9;
+    const PylithScalar slipPrev = 0.1*r[1];
+    const PylithScalar slipIncr = locked ? 0.0 : 1.0e-4*(0.5 + r[1]);
+    fault->slip[i] = slipPrev + slipIncr;
+    fault->slipRate[i] = slipIncr / 1.0e-3;
+    fault->normalTraction[i] = tension ? 1.0e+6*r[2] : -1.0e+6*(0.5 + r[2]);
+    if (1 == numStateVars) {
+      fault->stateVars[i*numStateVars+0] = fault->slipRate[i];
+    } else {
+      fault->stateVars[i*numStateVars+0] = maxSlip*r[3];
+      fault->stateVars[i*numStateVars+1] = slipPrev;
+      for (int iVar=2; iVar < numStateVars; ++iVar)
+	fault->stateVars[i*numStateVars+iVar] = 0.0;
+    } // if/else
+  } // for
+} // createFault
+
+
+// End of file
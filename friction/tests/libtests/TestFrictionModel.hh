@@ -0,0 +1,210 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+/** @file tests/libtests/TestFrictionModel.hh
+ *
+ * @brief Checks shared by the C++ tests of the contrib friction
+ * models.
+ *
+ * The tests call the protected per-vertex functions of a model
+ * through Harness<Model>, compare them with the expected values, with
+ * finite differences, and with the batch functions of
+ * ContribFrictionModel over a random fault.
+ */
+
+#if !defined(pylith_friction_TestFrictionModel_hh)
+#define pylith_friction_TestFrictionModel_hh
+
+// Include directives ---------------------------------------------------
+#include "pylith/utils/array.hh" // USES scalar_array
+
+#include <string> // USES std::string
+#include <vector> // USES std::vector
+
+// Forward declarations
+namespace contrib {
+  namespace friction {
+    class TestFrictionModel;
+  } // friction
+} // pylith
+
+// TestFrictionModel ----------------------------------------------------
+/// Record the outcome of checks.
+class contrib::friction::TestFrictionModel
+{ // class TestFrictionModel
+
+  // PUBLIC STRUCTS /////////////////////////////////////////////////////
+public :
+
+  /// Random fault (inputs of the friction functions).
+  struct Fault {
+    int numVertices;
+    int numProperties;
+    int numStateVars;
+    std::vector<PylithScalar> slip;
+    std::vector<PylithScalar> slipRate;
+    std::vector<PylithScalar> normalTraction;
+    std::vector<PylithScalar> properties;
+    std::vector<PylithScalar> stateVars;
+  }; // Fault
+
+  /** Expose the protected per-vertex interface of a model.
+   *
+   * PyLith calls these functions through FrictionModel, which
+   * requires a PyLith fault; the tests call them directly.
+   */
+  template<typename Model>
+  class Harness : public Model {
+  public :
+    /// Default constructor.
+    Harness(void) {}
+
+    /** Constructor for the slip-weakening laws.
+     *
+     * @param diagnostics True to add the diagnostic state variables.
+     */
+    Harness(const bool diagnostics) : Model(diagnostics) {}
+
+    using Model::_dbToProperties;
+    using Model::_nondimProperties;
+    using Model::_dimProperties;
+    using Model::_dbToStateVars;
+    using Model::_nondimStateVars;
+    using Model::_dimStateVars;
+    using Model::_calcFriction;
+    using Model::_calcFrictionDeriv;
+    using Model::_calcFrictionTangent;
+    using Model::_updateStateVars;
+  }; // Harness
+
+  // PUBLIC METHODS /////////////////////////////////////////////////////
+public :
+
+  /// Default constructor.
+  TestFrictionModel(void);
+
+  /** Start group of checks.
+   *
+   * @param name Name of group.
+   */
+  void start(const char* name);
+
+  /** Check condition.
+   *
+   * @param condition Condition that should hold.
+   * @param what Description of check.
+   */
+  void check(const bool condition,
+	     const std::string& what);
+
+  /** Check value against expected value.
+   *
+   * @param valueE Expected value.
+   * @param value Value.
+   * @param tolerance Relative tolerance (absolute for |valueE| < 1).
+   * @param what Description of check.
+   */
+  void checkClose(const PylithScalar valueE,
+		  const PylithScalar value,
+		  const PylithScalar tolerance,
+		  const std::string& what);
+
+  /** Get number of failed checks.
+   *
+   * @returns Number of failed checks.
+   */
+  int numFailures(void) const;
+
+  /** Get number of checks.
+   *
+   * @returns Number of checks.
+   */
+  int numChecks(void) const;
+
+  /** Create random fault.
+   *
+   * Vertices are locked (no slip since the last update), slipping, or
+   * in tension, with cumulative slip between 0 and maxSlip.
+   *
+   * @param fault Fault (output).
+   * @param numVertices Number of vertices.
+   * @param propertiesVertex Properties (same at all vertices).
+   * @param numProperties Number of properties.
+   * @param numStateVars Number of state variables (1 for slip rate,
+   *   otherwise cumulative and previous slip of the slip-weakening
+   *   laws followed by state variables set to zero).
+   * @param maxSlip Maximum cumulative slip.
+   */
+  static
+  void createFault(Fault* fault,
+		   const int numVertices,
+		   const PylithScalar* propertiesVertex,
+		   const int numProperties,
+		   const int numStateVars,
+		   const PylithScalar maxSlip);
+
+  /** Check friction and every component of its tangent against
+   * finite differences of the friction.
+   *
+   * @param model Friction model.
+   * @param properties Properties at vertex.
+   * @param stateVars State variables at vertex.
+   * @param slip Slip at vertex.
+   * @param slipRate Slip rate at vertex.
+   * @param normalTraction Normal traction at vertex.
+   * @param what Description of check.
+   */
+  template<typename Model>
+  void checkTangent(Harness<Model>& model,
+		    const pylith::scalar_array& properties,
+		    const pylith::scalar_array& stateVars,
+		    const PylithScalar slip,
+		    const PylithScalar slipRate,
+		    const PylithScalar normalTraction,
+		    const std::string& what);
+
+  /** Check batch functions against per-vertex functions over a fault.
+   *
+   * @param model Friction model.
+   * @param fault Fault.
+   * @param numThreads Number of threads for batch functions.
+   * @param tolerance Relative tolerance.
+   * @param what Description of check.
+   */
+  template<typename Model>
+  void checkBatch(Harness<Model>& model,
+		  const Fault& fault,
+		  const int numThreads,
+		  const PylithScalar tolerance,
+		  const std::string& what);
+
+  // PRIVATE MEMBERS ////////////////////////////////////////////////////
+private :
+
+  std::string _group; ///< Name of current group of checks.
+  int _numChecks; ///< Number of checks.
+  int _numFailures; ///< Number of failed checks.
+
+}; // class TestFrictionModel
+
+#include "TestFrictionModel.icc" // template methods
+
+#endif // pylith_friction_TestFrictionModel_hh
+
+
+// End of file
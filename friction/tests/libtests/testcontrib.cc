@@ -0,0 +1,1862 @@
+// -*- C++ -*-
+//
+// ----------------------------------------------------------------------
+//
+// Brad T. Aagaard, U.S. Geological Survey
+// Charles A. Williams, GNS Science
+// Matthew G. Knepley, University of Chicago
+//
+// This code was developed as part of the Computational Infrastructure
+// for Geodynamics (http://geodynamics.org).
+//
+// Copyright (c) 2010-2017 University of California, Davis
+//
+// See COPYING for license information.
+//
+// ----------------------------------------------------------------------
+//
+
+// C++ tests of the contrib friction models (standalone build).
+//
+// Each test checks the friction and its derivative of one model
+// against the equations in the model's header, the derivative
+// against finite differences, and the batch functions against the
+// per-vertex functions.
+
+#include <portinfo> // machine specific info generated by configure
+
+#include "TestFrictionModel.hh" // USES TestFrictionModel
+
+#include "ViscousFriction.hh" // USES ViscousFriction
+#include "DoubleSlipWeakeningFrictionNoHeal.hh" // USES DoubleSlipWeakeningFrictionNoHeal
+#include "ParabolicCohesiveZoneNoHeal.hh" // USES ParabolicCohesiveZoneNoHeal
+#include "ExponentialCohesiveZoneNoHeal.hh" // USES ExponentialCohesiveZoneNoHeal
+#include "TabulatedSlipWeakeningNoHeal.hh" // USES TabulatedSlipWeakeningNoHeal
+#include "FrictionTrace.hh" // USES FrictionTrace
+#include "FrictionDB.hh" // USES FrictionDB
+
+#include "pylith/topology/Mesh.hh" // USES Mesh
+#include "pylith/utils/constdefs.h" // USES PYLITH_MAXSCALAR
+
+#include "spatialdata/units/Nondimensional.hh" // USES Nondimensional
+#include "spatialdata/geocoords/CSCart.hh" // USES CSCart
+
+#include <petscsys.h> // USES PetscInitialize(), PetscGetFlops()
+
+#include <algorithm> // USES std::max()
+#include <cmath> // USES exp(), fabs(), sin(), cos()
+#include <cstdio> // USES printf(), remove()
+#include <fstream> // USES std::ofstream, std::ifstream, std::fstream
+#include <stdexcept> // USES std::runtime_error
+
+// ----------------------------------------------------------------------
+namespace contrib {
+  namespace friction {
+    namespace _TestContrib {
+
+      typedef TestFrictionModel::Fault Fault;
+
+      const int numVertices = 5000; // more than one block per thread
+      const PylithScalar tolerance = 1.0e-12;
+      const PylithScalar normalTraction = -2.0e+6;
+      const PylithScalar cohesion = 1.0e+5;
+      const int numStateVarsSW = 2; // state variables of slip-weakening laws
+      const int numStateVarsDiagnostics = 7; // ... with diagnostics
+
+      // Indices of state variables of slip-weakening laws.
+      const int s_regime = 2;
+      const int s_frictionalWork = 3;
+      const int s_breakdownWork = 4;
+      const int s_ruptureTime = 5;
+      const int s_weakeningEndTime = 6;
+
+      /** Check that function throws std::runtime_error.
+       *
+       * @param test Test results.
+       * @param model Friction model.
+       * @param dbValues Database values.
+       * @param numProperties Number of properties.
+       * @param what Description of check.
+       */
+      template<typename Model>
+      void
+      checkDBError(TestFrictionModel* test,
+		   TestFrictionModel::Harness<Model>& model,
+		   const pylith::scalar_array& dbValues,
+		   const int numProperties,
+		   const char* what)
+      { // checkDBError
+	pylith::scalar_array propValues(numProperties);
+	bool caught = false;
+	try {
+	  model._dbToProperties(&propValues[0], dbValues);
+	} catch (const std::runtime_error& err) {
+	  caught = true;
+	} // try/catch
+	test->check(caught, what);
+      } // checkDBError
+
+      /** Check friction of slip-weakening model against friction coefficient.
+       *
+       * @param test Test results.
+       * @param model Friction model.
+       * @param properties Properties.
+       * @param slipCum Cumulative slip.
+       * @param muE Expected friction coefficient.
+       * @param what Description of check.
+       */
+      template<typename Model>
+      void
+      checkCoefficient(TestFrictionModel* test,
+		       TestFrictionModel::Harness<Model>& model,
+		       const pylith::scalar_array& properties,
+		       const PylithScalar slipCum,
+		       const PylithScalar muE,
+		       const char* what)
+      { // checkCoefficient
+	// Split cumulative slip between the state variable and the
+	// slip since the last update.
+	pylith::scalar_array stateVars(numStateVarsSW);
+	stateVars[0] = 0.5*slipCum; // cumulative slip
+	stateVars[1] = 0.1; // previous slip
+	const PylithScalar slip = stateVars[1] - 0.5*slipCum;
+	const PylithScalar friction =
+	  model._calcFriction(0.0, slip, 0.0, normalTraction,
+			      &properties[0], properties.size(), &stateVars[0], stateVars.size());
+	test->checkClose(-muE*normalTraction + cohesion, friction, tolerance, what);
+      } // checkCoefficient
+
+      /** Check slip-weakening model in tension and state variable update.
+       *
+       * @param test Test results.
+       * @param model Friction model.
+       * @param properties Properties.
+       */
+      template<typename Model>
+      void
+      checkTensionAndUpdate(TestFrictionModel* test,
+			    TestFrictionModel::Harness<Model>& model,
+			    const pylith::scalar_array& properties)
+      { // checkTensionAndUpdate
+	pylith::scalar_array stateVars(numStateVarsSW);
+	stateVars[0] = 0.002;
+	stateVars[1] = 0.1;
+	const PylithScalar friction =
+	  model._calcFriction(0.0, 0.099, 0.0, 1.0e+6,
+			      &properties[0], properties.size(), &stateVars[0], stateVars.size());
+	test->checkClose(cohesion, friction, tolerance, "friction in tension");
+	const PylithScalar frictionDeriv =
+	  model._calcFrictionDeriv(0.0, 0.099, 0.0, 1.0e+6,
+				   &properties[0], properties.size(), &stateVars[0], stateVars.size());
+	test->checkClose(0.0, frictionDeriv, tolerance, "derivative in tension");
+
+	test->checkTangent(model, properties, stateVars, 0.099, 0.0, normalTraction,
+			   "tangent for slip below previous slip");
+	test->checkTangent(model, properties, stateVars, 0.099, 0.0, 1.0e+6, "tangent in tension");
+
+	model._updateStateVars(0.0, 0.099, 0.0, normalTraction,
+			       &stateVars[0], stateVars.size(), &properties[0], properties.size());
+	test->checkClose(0.003, stateVars[0], tolerance, "cumulative slip after update");
+	test->checkClose(0.099, stateVars[1], tolerance, "previous slip after update");
+      } // checkTensionAndUpdate
+
+      /** Check batch functions with 1 and 3 threads.
+       *
+       * @param test Test results.
+       * @param model Friction model.
+       * @param properties Properties.
+       * @param numStateVars Number of state variables.
+       * @param maxSlip Maximum cumulative slip on fault.
+       */
+      template<typename Model>
+      void
+      checkBatchThreads(TestFrictionModel* test,
+			TestFrictionModel::Harness<Model>& model,
+			const pylith::scalar_array& properties,
+			const int numStateVars,
+			const PylithScalar maxSlip)
+      { // checkBatchThreads
+	Fault fault;
+	TestFrictionModel::createFault(&fault, numVertices, &properties[0], properties.size(),
+				       numStateVars, maxSlip);
+	test->checkBatch(model, fault, 1, tolerance, "1 thread");
+	test->checkBatch(model, fault, 3, tolerance, "3 threads");
+      } // checkBatchThreads
+
+      /** Check that scaling a batch matches scaling each vertex.
+       *
+       * @param test Test results.
+       * @param model Friction model (with normalizer).
+       * @param properties Properties at each vertex.
+       * @param numStateVars Number of state variables.
+       * @param what Description of check.
+       */
+      template<typename Model>
+      void
+      checkScalingBatch(TestFrictionModel* test,
+			TestFrictionModel::Harness<Model>& model,
+			const pylith::scalar_array& properties,
+			const int numStateVars,
+			const char* what)
+      { // checkScalingBatch
+	Fault fault;
+	TestFrictionModel::createFault(&fault, numVertices, &properties[0], properties.size(),
+				       numStateVars, 0.04);
+	const int numProperties = fault.numProperties;
+	// Work and times reached at every other vertex with diagnostics.
+	if (numStateVarsDiagnostics == numStateVars)
+	  for (int i=0; i < numVertices; ++i) {
+	    const bool reached = 1 == i % 2;
+	    fault.stateVars[i*numStateVars+s_frictionalWork] = reached ? 2.0e+3 : 0.0;
+	    fault.stateVars[i*numStateVars+s_breakdownWork] = reached ? 1.0e+3 : 0.0;
+	    fault.stateVars[i*numStateVars+s_ruptureTime] = reached ? 1.5 : PYLITH_MAXSCALAR;
+	    fault.stateVars[i*numStateVars+s_weakeningEndTime] = reached ? 2.5 : PYLITH_MAXSCALAR;
+	  } // for
+
+	std::vector<PylithScalar> propertiesVertex(fault.properties);
+	std::vector<PylithScalar> stateVarsVertex(fault.stateVars);
+	for (int i=0; i < numVertices; ++i) {
+	  model._nondimProperties(&propertiesVertex[i*numProperties], numProperties);
+	  model._nondimStateVars(&stateVarsVertex[i*numStateVars], numStateVars);
+	} // for
+	std::vector<PylithScalar> propertiesBatch(fault.properties);
+	std::vector<PylithScalar> stateVarsBatch(fault.stateVars);
+	model.nondimPropertiesBatch(&propertiesBatch[0], numProperties, numVertices);
+	model.nondimStateVarsBatch(&stateVarsBatch[0], numStateVars, numVertices);
+
+	int numMismatch = 0;
+	for (size_t i=0; i < propertiesBatch.size(); ++i)
+	  if (fabs(propertiesBatch[i] - propertiesVertex[i]) > tolerance*fabs(propertiesVertex[i]))
+	    ++numMismatch;
+	for (size_t i=0; i < stateVarsBatch.size(); ++i)
+	  if (fabs(stateVarsBatch[i] - stateVarsVertex[i]) > tolerance*fabs(stateVarsVertex[i]))
+	    ++numMismatch;
+
+	// Dimensionalizing restores the values.
+	model.dimPropertiesBatch(&propertiesBatch[0], numProperties, numVertices);
+	model.dimStateVarsBatch(&stateVarsBatch[0], numStateVars, numVertices);
+	for (size_t i=0; i < propertiesBatch.size(); ++i)
+	  if (fabs(propertiesBatch[i] - fault.properties[i]) > tolerance*fabs(fault.properties[i]))
+	    ++numMismatch;
+	for (size_t i=0; i < stateVarsBatch.size(); ++i)
+	  if (fabs(stateVarsBatch[i] - fault.stateVars[i]) > tolerance*fabs(fault.stateVars[i]))
+	    ++numMismatch;
+	test->check(0 == numMismatch, what);
+      } // checkScalingBatch
+
+      // ----------------------------------------------------------------
+      // ViscousFriction
+      void
+      testViscousFriction(TestFrictionModel* test)
+      { // testViscousFriction
+	test->start("ViscousFriction");
+
+	TestFrictionModel::Harness<ViscousFriction> model;
+	model.timeStep(0.01);
+
+	pylith::scalar_array dbValues(3);
+	dbValues[0] = 0.6; // static_coefficient
+	dbValues[1] = 1.0e-3; // reference_slip_rate
+	dbValues[2] = cohesion;
+	pylith::scalar_array properties(3);
+	model._dbToProperties(&properties[0], dbValues);
+
+	pylith::scalar_array stateVars(1);
+	stateVars[0] = 0.0;
+	const PylithScalar slipRate = 2.0e-3;
+	const PylithScalar friction =
+	  model._calcFriction(0.0, 0.0, slipRate, normalTraction,
+			      &properties[0], properties.size(), &stateVars[0], stateVars.size());
+	test->checkClose(-0.6*(1.0 + 2.0)*normalTraction + cohesion, friction, tolerance, "friction");
+
+	const PylithScalar frictionDeriv =
+	  model._calcFrictionDeriv(0.0, 0.0, slipRate, normalTraction,
+				   &properties[0], properties.size(), &stateVars[0], stateVars.size());
+	test->checkClose(-normalTraction*0.6/(1.0e-3*0.01), frictionDeriv, tolerance, "derivative");
+
+	// Derivative must match the friction when the slip rate follows
+	// the slip increment over the time step, for either sign of the
+	// slip rate.
+	const PylithScalar dt = 0.01;
+	const PylithScalar h = 1.0e-9;
+	const PylithScalar slipRates[2] = { slipRate, -slipRate };
+	const char* whatDeriv[2] = { "derivative vs finite difference",
+				     "derivative vs finite difference for negative slip rate" };
+	for (int i=0; i < 2; ++i) {
+	  const PylithScalar frictionP =
+	    model._calcFriction(0.0, h, slipRates[i] + h/dt, normalTraction,
+				&properties[0], properties.size(), &stateVars[0], stateVars.size());
+	  const PylithScalar frictionM =
+	    model._calcFriction(0.0, -h, slipRates[i] - h/dt, normalTraction,
+				&properties[0], properties.size(), &stateVars[0], stateVars.size());
+	  const PylithScalar frictionDerivI =
+	    model._calcFrictionDeriv(0.0, 0.0, slipRates[i], normalTraction,
+				     &properties[0], properties.size(), &stateVars[0], stateVars.size());
+	  test->checkClose((frictionP - frictionM)/(2.0*h), frictionDerivI, 1.0e-6, whatDeriv[i]);
+	} // for
+	test->checkTangent(model, properties, stateVars, 0.0, slipRate, normalTraction,
+			   "tangent");
+	test->checkTangent(model, properties, stateVars, 0.0, -slipRate, normalTraction,
+			   "tangent for negative slip rate");
+
+	const PylithScalar frictionT =
+	  model._calcFriction(0.0, 0.0, slipRate, 1.0e+6,
+			      &properties[0], properties.size(), &stateVars[0], stateVars.size());
+	test->checkClose(0.0, frictionT, tolerance, "friction in tension");
+	const PylithScalar frictionDerivT =
+	  model._calcFrictionDeriv(0.0, 0.0, -slipRate, 1.0e+6,
+				   &properties[0], properties.size(), &stateVars[0], stateVars.size());
+	test->checkClose(0.0, frictionDerivT, tolerance, "derivative in tension");
+	test->checkTangent(model, properties, stateVars, 0.0, slipRate, 1.0e+6,
+			   "tangent in tension");
+
+	dbValues[0] = 0.0;
+	checkDBError(test, model, dbValues, properties.size(), "zero static coefficient");
+
+	checkBatchThreads(test, model, properties, 1, 0.0);
+      } // testViscousFriction
+
+      // ----------------------------------------------------------------
+      // DoubleSlipWeakeningFrictionNoHeal
+      void
+      testDoubleSlipWeakening(TestFrictionModel* test)
+      { // testDoubleSlipWeakening
+	test->start("DoubleSlipWeakeningFrictionNoHeal");
+
+	TestFrictionModel::Harness<DoubleSlipWeakeningFrictionNoHeal> model;
+
+	pylith::scalar_array dbValues(6);
+	dbValues[0] = 0.7; // static_coefficient
+	dbValues[1] = 0.6; // transition_coefficient
+	dbValues[2] = 0.4; // dynamic_coefficient
+	dbValues[3] = 0.01; // transition_slip_distance
+	dbValues[4] = 0.03; // final_slip_distance
+	dbValues[5] = cohesion;
+	pylith::scalar_array properties(DoubleSlipWeakeningCurve::numProperties);
+	model._dbToProperties(&properties[0], dbValues);
+
+	checkCoefficient(test, model, properties, 0.0, 0.7, "friction at zero slip");
+	checkCoefficient(test, model, properties, 0.004, 0.66, "friction in first segment");
+	checkCoefficient(test, model, properties, 0.02, 0.5, "friction in second segment");
+	checkCoefficient(test, model, properties, 0.05, 0.4, "friction past final slip");
+
+	pylith::scalar_array stateVars(numStateVarsSW);
+	stateVars[0] = 0.004;
+	stateVars[1] = 0.1;
+	test->checkTangent(model, properties, stateVars, 0.101, 0.0, normalTraction,
+			   "tangent in first segment");
+	stateVars[0] = 0.015;
+	test->checkTangent(model, properties, stateVars, 0.101, 0.0, normalTraction,
+			   "tangent in second segment");
+	stateVars[0] = 0.04;
+	test->checkTangent(model, properties, stateVars, 0.101, 0.0, normalTraction,
+			   "tangent past final slip");
+
+	checkTensionAndUpdate(test, model, properties);
+
+	dbValues[3] = 0.0;
+	checkDBError(test, model, dbValues, properties.size(), "zero transition slip distance");
+
+	checkBatchThreads(test, model, properties, numStateVarsSW, 0.04);
+      } // testDoubleSlipWeakening
+
+      // ----------------------------------------------------------------
+      // ParabolicCohesiveZoneNoHeal
+      void
+      testParabolicCohesiveZone(TestFrictionModel* test)
+      { // testParabolicCohesiveZone
+	test->start("ParabolicCohesiveZoneNoHeal");
+
+	TestFrictionModel::Harness<ParabolicCohesiveZoneNoHeal> model;
+
+	pylith::scalar_array dbValues(5);
+	dbValues[0] = 0.7; // static_coefficient
+	dbValues[1] = 0.4; // dynamic_coefficient
+	dbValues[2] = 0.01; // slip_shift
+	dbValues[3] = 0.02; // slip_stretch
+	dbValues[4] = cohesion;
+	pylith::scalar_array properties(ParabolicCohesiveZoneCurve::numProperties);
+	model._dbToProperties(&properties[0], dbValues);
+
+	checkCoefficient(test, model, properties, 0.01, 0.7, "friction at shift slip");
+	checkCoefficient(test, model, properties, 0.02, 0.7 - 0.3*0.25, "friction in parabola");
+	checkCoefficient(test, model, properties, 0.05, 0.4, "friction past parabola");
+
+	pylith::scalar_array stateVars(numStateVarsSW);
+	stateVars[0] = 0.02;
+	stateVars[1] = 0.1;
+	test->checkTangent(model, properties, stateVars, 0.101, 0.0, normalTraction,
+			   "tangent in parabola");
+	stateVars[0] = 0.04;
+	test->checkTangent(model, properties, stateVars, 0.101, 0.0, normalTraction,
+			   "tangent past parabola");
+
+	checkTensionAndUpdate(test, model, properties);
+
+	dbValues[3] = 0.0;
+	checkDBError(test, model, dbValues, properties.size(), "zero stretch slip");
+
+	checkBatchThreads(test, model, properties, numStateVarsSW, 0.04);
+      } // testParabolicCohesiveZone
+
+      // ----------------------------------------------------------------
+      // ExponentialCohesiveZoneNoHeal
+      void
+      testExponentialCohesiveZone(TestFrictionModel* test)
+      { // testExponentialCohesiveZone
+	test->start("ExponentialCohesiveZoneNoHeal");
+
+	TestFrictionModel::Harness<ExponentialCohesiveZoneNoHeal> model;
+
+	pylith::scalar_array dbValues(5);
+	dbValues[0] = 0.7; // static_coefficient
+	dbValues[1] = 0.4; // dynamic_coefficient
+	dbValues[2] = 0.005; // slip_shift
+	dbValues[3] = 0.01; // slip_stretch
+	dbValues[4] = cohesion;
+	pylith::scalar_array properties(ExponentialCohesiveZoneCurve::numProperties);
+	model._dbToProperties(&properties[0], dbValues);
+
+	checkCoefficient(test, model, properties, 0.005, 0.7, "friction at peak");
+	const PylithScalar x = (0.03 + 0.005) / 0.01;
+	checkCoefficient(test, model, properties, 0.03, 0.4 + 0.3*x*exp(1.0-x), "friction after peak");
+
+	pylith::scalar_array stateVars(numStateVarsSW);
+	stateVars[0] = 0.001;
+	stateVars[1] = 0.1;
+	test->checkTangent(model, properties, stateVars, 0.101, 0.0, normalTraction,
+			   "tangent before peak");
+	stateVars[0] = 0.02;
+	test->checkTangent(model, properties, stateVars, 0.101, 0.0, normalTraction,
+			   "tangent after peak");
+
+	checkTensionAndUpdate(test, model, properties);
+
+	dbValues[0] = -0.1;
+	checkDBError(test, model, dbValues, properties.size(), "negative static coefficient");
+
+	// Vectorized exponential differs from exp() in the last bits.
+	Fault fault;
+	TestFrictionModel::createFault(&fault, numVertices, &properties[0], properties.size(), numStateVarsSW, 0.1);
+	test->checkBatch(model, fault, 1, 1.0e-10, "1 thread");
+	test->checkBatch(model, fault, 3, 1.0e-10, "3 threads");
+      } // testExponentialCohesiveZone
+
+      // ----------------------------------------------------------------
+      // TabulatedSlipWeakeningNoHeal
+      void
+      testTabulatedSlipWeakening(TestFrictionModel* test)
+      { // testTabulatedSlipWeakening
+	test->start("TabulatedSlipWeakeningNoHeal");
+
+	// Linear table of the double slip-weakening curve above; the
+	// kinks fall on grid points, so the curves are identical.
+	const char* filename = "testcontrib_tables.tmp";
+	std::ofstream fout(filename);
+	fout << "// Double slip weakening curve\n"
+	     << "1\n"
+	     << "7 0.005 linear 0.7 0.65 0.6 0.55 0.5 0.45 0.4\n";
+	fout.close();
+
+	TestFrictionModel::Harness<TabulatedSlipWeakeningNoHeal> model;
+	model.filename(filename);
+	remove(filename);
+	test->check(1 == model.numTables(), "number of tables");
+
+	pylith::scalar_array dbValues(2);
+	dbValues[0] = 0; // curve_index
+	dbValues[1] = cohesion;
+	pylith::scalar_array properties(TabulatedSlipWeakeningCurve::numProperties);
+	model._dbToProperties(&properties[0], dbValues);
+
+	checkCoefficient(test, model, properties, 0.0, 0.7, "friction at zero slip");
+	checkCoefficient(test, model, properties, 0.004, 0.66, "friction in first segment");
+	checkCoefficient(test, model, properties, 0.02, 0.5, "friction in second segment");
+	checkCoefficient(test, model, properties, 0.05, 0.4, "friction past table");
+
+	pylith::scalar_array stateVars(numStateVarsSW);
+	stateVars[0] = 0.004;
+	stateVars[1] = 0.1;
+	test->checkTangent(model, properties, stateVars, 0.101, 0.0, normalTraction,
+			   "tangent in first segment");
+	stateVars[0] = 0.017;
+	test->checkTangent(model, properties, stateVars, 0.101, 0.0, normalTraction,
+			   "tangent in second segment");
+
+	checkTensionAndUpdate(test, model, properties);
+
+	dbValues[0] = 1;
+	checkDBError(test, model, dbValues, properties.size(), "curve index out of range");
+
+	checkBatchThreads(test, model, properties, numStateVarsSW, 0.04);
+
+	// Each model has its own tables, so table 0 of another model
+	// does not change the friction of this one.
+	TestFrictionModel::Harness<TabulatedSlipWeakeningNoHeal> modelOther;
+	const PylithScalar muOther[2] = { 0.3, 0.3 };
+	test->check(0 == modelOther.addTable(muOther, 2, 0.01, false), "index of added table");
+	checkCoefficient(test, model, properties, 0.004, 0.66, "tables of model");
+	checkCoefficient(test, modelOther, properties, 0.004, 0.3, "tables of other model");
+
+	// The slip spacing of the tables follows the normalizer.
+	spatialdata::units::Nondimensional normalizer;
+	normalizer.lengthScale(1.0e+3);
+	model.normalizer(normalizer);
+	checkCoefficient(test, model, properties, 0.004/1.0e+3, 0.66, "nondimensional slip spacing");
+      } // testTabulatedSlipWeakening
+
+      // ----------------------------------------------------------------
+      // Nondimensionalization of properties and state variables.
+      void
+      testNondimensional(TestFrictionModel* test)
+      { // testNondimensional
+	test->start("Nondimensionalization");
+
+	spatialdata::units::Nondimensional normalizer;
+	normalizer.lengthScale(1.0e+3);
+	normalizer.pressureScale(2.25e+10);
+	normalizer.timeScale(2.0);
+
+	TestFrictionModel::Harness<DoubleSlipWeakeningFrictionNoHeal> model;
+	model.normalizer(normalizer);
+
+	pylith::scalar_array dbValues(6);
+	dbValues[0] = 0.7; // static_coefficient
+	dbValues[1] = 0.6; // transition_coefficient
+	dbValues[2] = 0.4; // dynamic_coefficient
+	dbValues[3] = 0.01; // transition_slip_distance
+	dbValues[4] = 0.03; // final_slip_distance
+	dbValues[5] = cohesion;
+	const int numProperties = DoubleSlipWeakeningCurve::numProperties;
+	pylith::scalar_array properties(numProperties);
+	model._dbToProperties(&properties[0], dbValues);
+	pylith::scalar_array propertiesND(properties);
+	model._nondimProperties(&propertiesND[0], numProperties);
+
+	test->checkClose(0.7, propertiesND[DoubleSlipWeakeningCurve::p_coefS], tolerance,
+			 "nondimensional friction coefficient");
+	test->checkClose(0.01, 1.0e+3*propertiesND[DoubleSlipWeakeningCurve::p_distT], tolerance,
+			 "nondimensional slip distance");
+	test->checkClose(cohesion, 2.25e+10*propertiesND[DoubleSlipWeakeningCurve::p_cohesion], tolerance,
+			 "nondimensional cohesion");
+
+	// Friction is proportional to normal traction, so it scales the
+	// same way.
+	pylith::scalar_array stateVars(numStateVarsSW);
+	stateVars[0] = 0.02;
+	stateVars[1] = 0.1;
+	pylith::scalar_array stateVarsND(stateVars);
+	stateVarsND /= 1.0e+3;
+	const PylithScalar friction =
+	  model._calcFriction(0.0, 0.1, 0.0, normalTraction,
+			      &properties[0], numProperties, &stateVars[0], numStateVarsSW);
+	const PylithScalar frictionND =
+	  model._calcFriction(0.0, 0.1/1.0e+3, 0.0, normalTraction/2.25e+10,
+			      &propertiesND[0], numProperties, &stateVarsND[0], numStateVarsSW);
+	test->checkClose(friction, 2.25e+10*frictionND, tolerance, "nondimensional friction");
+
+	model._dimProperties(&propertiesND[0], numProperties);
+	int numMismatch = 0;
+	for (int i=0; i < numProperties; ++i)
+	  if (fabs(propertiesND[i] - properties[i]) > tolerance*std::max(PylithScalar(1.0), fabs(properties[i])))
+	    ++numMismatch;
+	test->check(0 == numMismatch, "dimensionalize nondimensional properties");
+      } // testNondimensional
+
+      // ----------------------------------------------------------------
+      // Number of threads.
+      void
+      testNumThreads(TestFrictionModel* test)
+      { // testNumThreads
+	test->start("ContribFrictionModel");
+
+	TestFrictionModel::Harness<ViscousFriction> model;
+	test->check(0 == model.numThreads(), "default number of threads");
+	model.numThreads(4);
+	test->check(4 == model.numThreads(), "number of threads");
+
+	bool caught = false;
+	try {
+	  model.numThreads(-1);
+	} catch (const std::runtime_error& err) {
+	  caught = true;
+	} // try/catch
+	test->check(caught, "negative number of threads");
+      } // testNumThreads
+
+      // ----------------------------------------------------------------
+      // Recording calls in a trace file.
+      void
+      testTrace(TestFrictionModel* test)
+      { // testTrace
+	test->start("FrictionTrace");
+
+	TestFrictionModel::Harness<DoubleSlipWeakeningFrictionNoHeal> model;
+	model.label("fault");
+	model.timeStep(1.0e-3);
+
+	pylith::scalar_array dbValues(6);
+	dbValues[0] = 0.7; // static_coefficient
+	dbValues[1] = 0.6; // transition_coefficient
+	dbValues[2] = 0.4; // dynamic_coefficient
+	dbValues[3] = 0.01; // transition_slip_distance
+	dbValues[4] = 0.03; // final_slip_distance
+	dbValues[5] = cohesion;
+	pylith::scalar_array properties(DoubleSlipWeakeningCurve::numProperties);
+	model._dbToProperties(&properties[0], dbValues);
+
+	const int numVerticesTrace = 100;
+	Fault fault;
+	TestFrictionModel::createFault(&fault, numVerticesTrace, &properties[0],
+				       properties.size(), numStateVarsSW, 0.04);
+	const int numProperties = fault.numProperties;
+	const int numStateVars = fault.numStateVars;
+	const PylithScalar t = 0.5;
+
+	// Per-vertex calls as PyLith makes them, then batch calls, then
+	// an update with a new time step.
+	model.traceFilename("testcontrib_trace%d.tmp");
+	test->check(std::string("testcontrib_trace%d.tmp") == model.traceFilename(),
+		    "trace filename");
+	model._calcFriction(t, fault.slip[0], fault.slipRate[0], fault.normalTraction[0],
+			    &fault.properties[0], numProperties,
+			    &fault.stateVars[0], numStateVars);
+	model._calcFrictionDeriv(t, fault.slip[0], fault.slipRate[0], fault.normalTraction[0],
+				 &fault.properties[0], numProperties,
+				 &fault.stateVars[0], numStateVars);
+	std::vector<PylithScalar> friction(numVerticesTrace);
+	std::vector<PylithScalar> frictionDeriv(numVerticesTrace);
+	model.calcFrictionAndDerivBatch(&friction[0], &frictionDeriv[0], t,
+					&fault.slip[0], &fault.slipRate[0],
+					&fault.normalTraction[0],
+					&fault.properties[0], numProperties,
+					&fault.stateVars[0], numStateVars, numVerticesTrace);
+	const std::vector<PylithScalar> stateVarsOrig(fault.stateVars);
+	model.timeStep(2.0e-3);
+	model.updateStateVarsBatch(t, &fault.slip[0], &fault.slipRate[0],
+				   &fault.normalTraction[0],
+				   &fault.stateVars[0], numStateVars,
+				   &fault.properties[0], numProperties, numVerticesTrace);
+	model.traceFilename("");
+	model._calcFriction(t, fault.slip[0], fault.slipRate[0], fault.normalTraction[0],
+			    &fault.properties[0], numProperties,
+			    &fault.stateVars[0], numStateVars);
+
+	FrictionTrace trace;
+	trace.openRead("testcontrib_trace0.tmp");
+	test->check(std::string("fault") == trace.label(), "trace label");
+	test->check(numProperties == trace.numProperties(), "trace number of properties");
+	test->check(numStateVars == trace.numStateVars(), "trace number of state variables");
+
+	// Expected calls.
+	std::vector<int> vertex;
+	std::vector<FrictionTrace::OperationEnum> operation;
+	vertex.push_back(0); operation.push_back(FrictionTrace::FRICTION);
+	vertex.push_back(0); operation.push_back(FrictionTrace::FRICTION_DERIV);
+	for (int i=0; i < numVerticesTrace; ++i) {
+	  vertex.push_back(i); operation.push_back(FrictionTrace::FRICTION);
+	  vertex.push_back(i); operation.push_back(FrictionTrace::FRICTION_DERIV);
+	} // for
+	for (int i=0; i < numVerticesTrace; ++i) {
+	  vertex.push_back(i); operation.push_back(FrictionTrace::UPDATE_STATE_VARS);
+	} // for
+
+	FrictionTrace::Record record;
+	int numRecords = 0;
+	int numMismatch = 0;
+	PylithScalar frictionReplay = 0.0;
+	PylithScalar frictionSum = 0.0;
+	while (trace.read(&record)) {
+	  if (numRecords >= int(operation.size())) {
+	    ++numRecords;
+	    continue;
+	  } // if
+	  const int i = vertex[numRecords];
+	  const bool update = FrictionTrace::UPDATE_STATE_VARS == operation[numRecords];
+	  bool match = record.operation == operation[numRecords] &&
+	    record.dt == (update ? 2.0e-3 : 1.0e-3) &&
+	    record.t == t &&
+	    record.slip == fault.slip[i] &&
+	    record.slipRate == fault.slipRate[i] &&
+	    record.normalTraction == fault.normalTraction[i];
+	  for (int j=0; j < numProperties; ++j)
+	    match = match && record.properties[j] == fault.properties[i*numProperties+j];
+	  for (int j=0; j < numStateVars; ++j)
+	    match = match && record.stateVars[j] == stateVarsOrig[i*numStateVars+j];
+	  if (!match)
+	    ++numMismatch;
+
+	  // Replay the friction of the batch.
+	  if (numRecords >= 2 && FrictionTrace::FRICTION == record.operation) {
+	    frictionReplay +=
+	      model._calcFriction(record.t, record.slip, record.slipRate, record.normalTraction,
+				  &record.properties[0], numProperties,
+				  &record.stateVars[0], numStateVars);
+	    frictionSum += friction[i];
+	  } // if
+	  ++numRecords;
+	} // while
+	trace.close();
+	remove("testcontrib_trace0.tmp");
+
+	test->check(int(operation.size()) == numRecords, "number of trace records");
+	test->check(0 == numMismatch, "trace records");
+	test->checkClose(frictionSum, frictionReplay, tolerance, "replayed friction");
+
+	bool caught = false;
+	try {
+	  trace.openRead("testcontrib_trace0.tmp");
+	} catch (const std::runtime_error& err) {
+	  caught = true;
+	} // try/catch
+	test->check(caught, "missing trace file");
+      } // testTrace
+
+      // ----------------------------------------------------------------
+      // Flops logged for the branches taken.
+      void
+      testFlops(TestFrictionModel* test)
+      { // testFlops
+	test->start("PetscLogFlops");
+
+	TestFrictionModel::Harness<DoubleSlipWeakeningFrictionNoHeal> model;
+	model.loggingPrefix("FrDSlWk ");
+	model.timeStep(1.0e-3);
+
+	pylith::scalar_array dbValues(6);
+	dbValues[0] = 0.7; // static_coefficient
+	dbValues[1] = 0.6; // transition_coefficient
+	dbValues[2] = 0.4; // dynamic_coefficient
+	dbValues[3] = 0.01; // transition_slip_distance
+	dbValues[4] = 0.03; // final_slip_distance
+	dbValues[5] = cohesion;
+	pylith::scalar_array properties(DoubleSlipWeakeningCurve::numProperties);
+	model._dbToProperties(&properties[0], dbValues);
+	const int numProperties = properties.size();
+	PylithScalar stateVars[numStateVarsSW] = { 0.0 };
+	const PylithScalar t = 0.5;
+	const PylithScalar slip = 0.005;
+
+	PetscLogDouble flops0 = 0;
+	PetscLogDouble flops = 0;
+	PetscGetFlops(&flops0);
+	model._calcFriction(t, slip, 1.0, normalTraction, &properties[0], numProperties,
+			    stateVars, numStateVarsSW);
+	PetscGetFlops(&flops);
+	test->check(10 == flops-flops0, "friction in compression");
+
+	flops0 = flops;
+	model._calcFrictionDeriv(t, slip, 1.0, normalTraction, &properties[0], numProperties,
+				 stateVars, numStateVarsSW);
+	PetscGetFlops(&flops);
+	test->check(10 == flops-flops0, "derivative in compression");
+
+	flops0 = flops;
+	model._calcFriction(t, slip, 1.0, -normalTraction, &properties[0], numProperties,
+			    stateVars, numStateVarsSW);
+	model._calcFrictionDeriv(t, slip, 1.0, -normalTraction, &properties[0], numProperties,
+				 stateVars, numStateVarsSW);
+	PetscGetFlops(&flops);
+	test->check(0 == flops-flops0, "friction in tension");
+
+	const int numVerticesFlops = 37; // not a multiple of the SIMD width
+	Fault fault;
+	TestFrictionModel::createFault(&fault, numVerticesFlops, &properties[0],
+				       numProperties, numStateVarsSW, 0.04);
+	for (int i=0; i < numVerticesFlops; ++i)
+	  fault.normalTraction[i] = normalTraction;
+	std::vector<PylithScalar> friction(numVerticesFlops);
+	std::vector<PylithScalar> frictionDeriv(numVerticesFlops);
+	flops0 = flops;
+	model.calcFrictionAndDerivBatch(&friction[0], &frictionDeriv[0], t,
+					&fault.slip[0], &fault.slipRate[0],
+					&fault.normalTraction[0],
+					&fault.properties[0], numProperties,
+					&fault.stateVars[0], numStateVarsSW, numVerticesFlops);
+	PetscGetFlops(&flops);
+	test->check(10*numVerticesFlops == flops-flops0, "batch friction in compression");
+
+	flops0 = flops;
+	model._updateStateVars(t, slip, 1.0, normalTraction, stateVars, numStateVarsSW,
+			       &properties[0], numProperties);
+	PetscGetFlops(&flops);
+	test->check(2+2*5 == flops-flops0, "update while sliding");
+
+	flops0 = flops;
+	model._updateStateVars(t, slip, -1.0, normalTraction, stateVars, numStateVarsSW,
+			       &properties[0], numProperties);
+	PetscGetFlops(&flops);
+	test->check(0+2*5 == flops-flops0, "update after sliding stopped");
+
+	// The work adds 12 flops and two coefficients in compression, and
+	// 1 flop if the vertex did not slip.
+	TestFrictionModel::Harness<DoubleSlipWeakeningFrictionNoHeal> modelDiagnostics(true);
+	PylithScalar stateVarsDiagnostics[numStateVarsDiagnostics] = { 0.0 };
+	flops0 = flops;
+	modelDiagnostics._updateStateVars(t, slip, 1.0, normalTraction,
+					  stateVarsDiagnostics, numStateVarsDiagnostics,
+					  &properties[0], numProperties);
+	PetscGetFlops(&flops);
+	test->check(2+(12+2*5)+2*5 == flops-flops0, "update while sliding with diagnostics");
+
+	flops0 = flops;
+	modelDiagnostics._updateStateVars(t, slip, -1.0, normalTraction,
+					  stateVarsDiagnostics, numStateVarsDiagnostics,
+					  &properties[0], numProperties);
+	PetscGetFlops(&flops);
+	test->check(0+1+2*5 == flops-flops0, "update after sliding stopped with diagnostics");
+
+	TestFrictionModel::Harness<ViscousFriction> modelVisc;
+	modelVisc.loggingPrefix("FrVisc ");
+	modelVisc.timeStep(1.0e-3);
+	const PylithScalar propertiesVisc[3] = { 0.6, 1.0e-3, cohesion };
+	PylithScalar stateVarsVisc[1] = { 0.0 };
+	flops0 = flops;
+	modelVisc._calcFriction(t, slip, 1.0, normalTraction, propertiesVisc, 3,
+				stateVarsVisc, 1);
+	modelVisc._calcFrictionDeriv(t, slip, 1.0, normalTraction, propertiesVisc, 3,
+				     stateVarsVisc, 1);
+	PetscGetFlops(&flops);
+	test->check(5+3 == flops-flops0, "viscous friction in compression");
+      } // testFlops
+
+      // ----------------------------------------------------------------
+      // Census of vertices in each regime at the state updates.
+      void
+      testCensus(TestFrictionModel* test)
+      { // testCensus
+	test->start("Census");
+
+	// The regime state variable is only stored with diagnostics.
+	TestFrictionModel::Harness<DoubleSlipWeakeningFrictionNoHeal> model(true);
+	model.label("fault");
+
+	pylith::scalar_array dbValues(6);
+	dbValues[0] = 0.7; // static_coefficient
+	dbValues[1] = 0.6; // transition_coefficient
+	dbValues[2] = 0.4; // dynamic_coefficient
+	dbValues[3] = 0.01; // transition_slip_distance
+	dbValues[4] = 0.03; // final_slip_distance
+	dbValues[5] = cohesion;
+	const int numProperties = DoubleSlipWeakeningCurve::numProperties;
+	const int numStateVars = numStateVarsDiagnostics;
+	const int numVerticesCensus = 5;
+	pylith::scalar_array properties(numVerticesCensus*numProperties);
+	model._dbToProperties(&properties[0], dbValues);
+	for (int i=1; i < numVerticesCensus; ++i)
+	  for (int j=0; j < numProperties; ++j)
+	    properties[i*numProperties+j] = properties[j];
+
+	// One vertex in each regime (in tension, locked, first and
+	// second weakening segments, fully weakened).
+	const PylithScalar slipCum[numVerticesCensus] = { 0.0, 0.0, 0.004, 0.02, 0.05 };
+	const PylithScalar slipIncr[numVerticesCensus] = { 0.001, 0.0, 0.001, 0.001, 0.001 };
+	const PylithScalar tractionN[numVerticesCensus] = {
+	  -normalTraction, normalTraction, normalTraction, normalTraction, normalTraction,
+	};
+	const ContribFrictionModel::RegimeEnum regimeE[numVerticesCensus] = {
+	  ContribFrictionModel::TENSION_REGIME,
+	  ContribFrictionModel::LOCKED_REGIME,
+	  ContribFrictionModel::WEAKENING_REGIME,
+	  ContribFrictionModel::WEAKENING2_REGIME,
+	  ContribFrictionModel::RESIDUAL_REGIME,
+	};
+	std::vector<PylithScalar> slip(numVerticesCensus);
+	std::vector<PylithScalar> slipRate(numVerticesCensus);
+	std::vector<PylithScalar> stateVarsInitial(numVerticesCensus*numStateVars);
+	for (int i=0; i < numVerticesCensus; ++i) {
+	  slip[i] = 0.1 + slipIncr[i];
+	  slipRate[i] = slipIncr[i] / 1.0e-3;
+	  stateVarsInitial[i*numStateVars+0] = slipCum[i];
+	  stateVarsInitial[i*numStateVars+1] = 0.1;
+	  stateVarsInitial[i*numStateVars+s_regime] = 0.0;
+	} // for
+
+	model.censusFilename("testcontrib_census%d.tmp");
+	test->check(std::string("testcontrib_census%d.tmp") == model.censusFilename(),
+		    "census filename");
+
+	// Per-vertex updates.
+	std::vector<PylithScalar> stateVars(stateVarsInitial);
+	for (int i=0; i < numVerticesCensus; ++i)
+	  model._updateStateVars(1.0, slip[i], slipRate[i], tractionN[i],
+				 &stateVars[i*numStateVars], numStateVars,
+				 &properties[i*numProperties], numProperties);
+	int numMismatch = 0;
+	for (int i=0; i < numVerticesCensus; ++i)
+	  if (PylithScalar(regimeE[i]) != stateVars[i*numStateVars+s_regime])
+	    ++numMismatch;
+	test->check(0 == numMismatch, "regime state variables");
+	test->check(1.0 == model.censusTime(), "census time");
+	for (int i=0; i < ContribFrictionModel::NUM_REGIMES; ++i)
+	  test->check(1 == model.regimeCount(ContribFrictionModel::RegimeEnum(i)), "regime count");
+
+	// Batch update of the same vertices twice.
+	stateVars = stateVarsInitial;
+	model.updateStateVarsBatch(2.0, &slip[0], &slipRate[0], tractionN,
+				   &stateVars[0], numStateVars,
+				   &properties[0], numProperties, numVerticesCensus);
+	numMismatch = 0;
+	for (int i=0; i < numVerticesCensus; ++i)
+	  if (PylithScalar(regimeE[i]) != stateVars[i*numStateVars+s_regime])
+	    ++numMismatch;
+	test->check(0 == numMismatch, "batch regime state variables");
+	stateVars = stateVarsInitial;
+	model.updateStateVarsBatch(2.0, &slip[0], &slipRate[0], tractionN,
+				   &stateVars[0], numStateVars,
+				   &properties[0], numProperties, numVerticesCensus);
+	test->check(2.0 == model.censusTime(), "batch census time");
+	for (int i=0; i < ContribFrictionModel::NUM_REGIMES; ++i)
+	  test->check(2 == model.regimeCount(ContribFrictionModel::RegimeEnum(i)),
+		      "batch regime count");
+	model.censusFilename("");
+
+	std::ifstream fin("testcontrib_census0.tmp");
+	std::string header;
+	std::getline(fin, header);
+	test->check(std::string("# time locked weakening weakening2 residual tension") == header,
+		    "census header");
+	PylithScalar t = 0.0;
+	int counts[2*ContribFrictionModel::NUM_REGIMES];
+	fin >> t;
+	for (int i=0; i < ContribFrictionModel::NUM_REGIMES; ++i)
+	  fin >> counts[i];
+	test->check(1.0 == t, "census time of first update");
+	fin >> t;
+	for (int i=0; i < ContribFrictionModel::NUM_REGIMES; ++i)
+	  fin >> counts[ContribFrictionModel::NUM_REGIMES+i];
+	test->check(!fin.fail() && 2.0 == t, "census time of second update");
+	numMismatch = 0;
+	for (int i=0; i < ContribFrictionModel::NUM_REGIMES; ++i)
+	  if (1 != counts[i] || 2 != counts[ContribFrictionModel::NUM_REGIMES+i])
+	    ++numMismatch;
+	test->check(0 == numMismatch, "census counts");
+	fin.close();
+	remove("testcontrib_census0.tmp");
+
+	// The census does not need the regime state variable.
+	TestFrictionModel::Harness<DoubleSlipWeakeningFrictionNoHeal> modelDefault;
+	std::vector<PylithScalar> stateVarsDefault(numVerticesCensus*numStateVarsSW);
+	for (int i=0; i < numVerticesCensus; ++i) {
+	  stateVarsDefault[i*numStateVarsSW+0] = slipCum[i];
+	  stateVarsDefault[i*numStateVarsSW+1] = 0.1;
+	} // for
+	modelDefault.updateStateVarsBatch(1.0, &slip[0], &slipRate[0], tractionN,
+					  &stateVarsDefault[0], numStateVarsSW,
+					  &properties[0], numProperties, numVerticesCensus);
+	numMismatch = 0;
+	for (int i=0; i < ContribFrictionModel::NUM_REGIMES; ++i)
+	  if (1 != modelDefault.regimeCount(ContribFrictionModel::RegimeEnum(i)))
+	    ++numMismatch;
+	test->check(0 == numMismatch, "regime count without diagnostics");
+      } // testCensus
+
+      // ----------------------------------------------------------------
+      // Changes of the derivative of friction with slip at the state
+      // updates (reuse of the fault Jacobian).
+      void
+      testTangentChanges(TestFrictionModel* test)
+      { // testTangentChanges
+	test->start("Tangent changes");
+
+	// The regime state variable tells which vertices were in tension.
+	TestFrictionModel::Harness<DoubleSlipWeakeningFrictionNoHeal> model(true);
+	test->check(model.tangentChanged(), "tangent changed before first update");
+
+	pylith::scalar_array dbValues(6);
+	dbValues[0] = 0.7; // static_coefficient
+	dbValues[1] = 0.6; // transition_coefficient
+	dbValues[2] = 0.4; // dynamic_coefficient
+	dbValues[3] = 0.01; // transition_slip_distance
+	dbValues[4] = 0.03; // final_slip_distance
+	dbValues[5] = cohesion;
+	const int numProperties = DoubleSlipWeakeningCurve::numProperties;
+	const int numStateVars = numStateVarsDiagnostics;
+	const int numVerticesTangent = 6;
+	pylith::scalar_array properties(numVerticesTangent*numProperties);
+	model._dbToProperties(&properties[0], dbValues);
+	for (int i=1; i < numVerticesTangent; ++i)
+	  for (int j=0; j < numProperties; ++j)
+	    properties[i*numProperties+j] = properties[j];
+
+	// Locked, slipping within the first segment, crossing the
+	// transition slip, crossing the final slip, fully weakened, and
+	// entering tension.
+	const PylithScalar slipCum[numVerticesTangent] = { 0.0, 0.004, 0.0095, 0.0295, 0.05, 0.004 };
+	const PylithScalar slipIncr[numVerticesTangent] = { 0.0, 0.001, 0.001, 0.001, 0.001, 0.001 };
+	const bool changedE[numVerticesTangent] = { false, false, true, true, false, true };
+	std::vector<PylithScalar> slip(numVerticesTangent);
+	std::vector<PylithScalar> slipRate(numVerticesTangent);
+	std::vector<PylithScalar> tractionN(numVerticesTangent, normalTraction);
+	std::vector<PylithScalar> stateVars(numVerticesTangent*numStateVars);
+	for (int i=0; i < numVerticesTangent; ++i) {
+	  slip[i] = 0.1 + slipIncr[i];
+	  slipRate[i] = slipIncr[i] / 1.0e-3;
+	  stateVars[i*numStateVars+0] = slipCum[i];
+	  stateVars[i*numStateVars+1] = 0.1;
+	  stateVars[i*numStateVars+s_regime] = 0.0;
+	} // for
+	tractionN[numVerticesTangent-1] = -normalTraction;
+
+	// Per-vertex updates.
+	const std::vector<PylithScalar> stateVarsInitial(stateVars);
+	int numChangedE = 0;
+	for (int i=0; i < numVerticesTangent; ++i) {
+	  model._updateStateVars(1.0, slip[i], slipRate[i], tractionN[i],
+				 &stateVars[i*numStateVars], numStateVars,
+				 &properties[i*numProperties], numProperties);
+	  if (changedE[i])
+	    ++numChangedE;
+	  test->check(numChangedE == model.tangentChangeCount(), "tangent change count");
+	} // for
+	test->check(model.tangentChanged(), "tangent changed");
+
+	// Batch update with the same slip leaves every tangent unchanged,
+	// including the vertex remaining in tension.
+	model.updateStateVarsBatch(2.0, &slip[0], &slipRate[0], &tractionN[0],
+				   &stateVars[0], numStateVars,
+				   &properties[0], numProperties, numVerticesTangent);
+	test->check(0 == model.tangentChangeCount(), "batch tangent change count unchanged");
+	test->check(!model.tangentChanged(), "batch tangent unchanged");
+
+	// Batch update from the initial state matches the per-vertex updates.
+	stateVars = stateVarsInitial;
+	model.updateStateVarsBatch(3.0, &slip[0], &slipRate[0], &tractionN[0],
+				   &stateVars[0], numStateVars,
+				   &properties[0], numProperties, numVerticesTangent);
+	test->check(numChangedE == model.tangentChangeCount(), "batch tangent change count");
+
+	// Without diagnostics, the batch updates keep which vertices were
+	// in tension, so a vertex remaining in tension is not a change.
+	TestFrictionModel::Harness<DoubleSlipWeakeningFrictionNoHeal> modelDefault;
+	std::vector<PylithScalar> stateVarsDefault(numVerticesTangent*numStateVarsSW);
+	for (int i=0; i < numVerticesTangent; ++i) {
+	  stateVarsDefault[i*numStateVarsSW+0] = slipCum[i];
+	  stateVarsDefault[i*numStateVarsSW+1] = 0.1;
+	} // for
+	modelDefault.updateStateVarsBatch(1.0, &slip[0], &slipRate[0], &tractionN[0],
+					  &stateVarsDefault[0], numStateVarsSW,
+					  &properties[0], numProperties, numVerticesTangent);
+	test->check(numChangedE == modelDefault.tangentChangeCount(),
+		    "tangent change count without diagnostics");
+	modelDefault.updateStateVarsBatch(2.0, &slip[0], &slipRate[0], &tractionN[0],
+					  &stateVarsDefault[0], numStateVarsSW,
+					  &properties[0], numProperties, numVerticesTangent);
+	test->check(0 == modelDefault.tangentChangeCount(),
+		    "batch tangent change count with a vertex in tension without diagnostics");
+
+	// Leaving tension changes only that vertex.
+	tractionN[numVerticesTangent-1] = normalTraction;
+	modelDefault.updateStateVarsBatch(3.0, &slip[0], &slipRate[0], &tractionN[0],
+					  &stateVarsDefault[0], numStateVarsSW,
+					  &properties[0], numProperties, numVerticesTangent);
+	test->check(1 == modelDefault.tangentChangeCount(),
+		    "batch tangent change count leaving tension without diagnostics");
+
+	// Per-vertex updates match the vertices by the order of the calls.
+	const PylithScalar tractionNTangent[3] = { normalTraction, -normalTraction, -normalTraction };
+	const int numChangedTension[3] = { 0, 1, 0 };
+	for (int iUpdate=0; iUpdate < 3; ++iUpdate) {
+	  tractionN[numVerticesTangent-1] = tractionNTangent[iUpdate];
+	  for (int i=0; i < numVerticesTangent; ++i)
+	    modelDefault._updateStateVars(4.0+iUpdate, slip[i], slipRate[i], tractionN[i],
+					  &stateVarsDefault[i*numStateVarsSW], numStateVarsSW,
+					  &properties[i*numProperties], numProperties);
+	  test->check(numChangedTension[iUpdate] == modelDefault.tangentChangeCount(),
+		      "per-vertex tangent change count with tension without diagnostics");
+	} // for
+
+	// Models without a census always report a change.
+	TestFrictionModel::Harness<ViscousFriction> modelViscous;
+	test->check(modelViscous.tangentChanged(), "viscous tangent changed");
+      } // testTangentChanges
+
+      // ----------------------------------------------------------------
+      // Frictional and breakdown work and cohesive zone times
+      // accumulated by the state updates.
+      void
+      testWork(TestFrictionModel* test)
+      { // testWork
+	test->start("Work");
+
+	// The work and times are only stored with diagnostics.
+	TestFrictionModel::Harness<DoubleSlipWeakeningFrictionNoHeal> modelDefault;
+	test->check(!modelDefault.diagnostics() && numStateVarsSW == modelDefault.numStateVars(),
+		    "no diagnostic state variables by default");
+
+	TestFrictionModel::Harness<DoubleSlipWeakeningFrictionNoHeal> model(true);
+	test->check(model.diagnostics() && numStateVarsDiagnostics == model.numStateVars(),
+		    "diagnostic state variables with diagnostics");
+
+	pylith::scalar_array dbValues(6);
+	dbValues[0] = 0.7; // static_coefficient
+	dbValues[1] = 0.6; // transition_coefficient
+	dbValues[2] = 0.4; // dynamic_coefficient
+	dbValues[3] = 0.0078125; // transition_slip_distance
+	dbValues[4] = 0.0234375; // final_slip_distance
+	dbValues[5] = cohesion;
+	const int numProperties = DoubleSlipWeakeningCurve::numProperties;
+	pylith::scalar_array properties(numProperties);
+	model._dbToProperties(&properties[0], dbValues);
+
+	pylith::scalar_array dbStateValues(2);
+	dbStateValues[0] = 0.0; // cumulative_slip
+	dbStateValues[1] = 0.1; // previous_slip
+	pylith::scalar_array stateVars(numStateVarsDiagnostics);
+	model._dbToStateVars(&stateVars[0], dbStateValues);
+	test->check(PYLITH_MAXSCALAR == stateVars[s_ruptureTime] &&
+		    PYLITH_MAXSCALAR == stateVars[s_weakeningEndTime],
+		    "cohesive zone times not reached");
+
+	// Steps land exactly (in binary) on the transition and final slip
+	// distances, so the trapezoidal rule is exact.
+	const PylithScalar slipIncr = 0.001953125;
+	const int numSteps = 16;
+	int numLocked = 0;
+	for (int iStep=0; iStep <= numSteps; ++iStep) {
+	  const PylithScalar t = iStep;
+	  const PylithScalar slip = 0.1 + iStep*slipIncr;
+	  model._updateStateVars(t, slip, slipIncr / 1.0e-3, normalTraction,
+				 &stateVars[0], numStateVarsDiagnostics,
+				 &properties[0], numProperties);
+	  if (0 == iStep && PYLITH_MAXSCALAR == stateVars[s_ruptureTime])
+	    ++numLocked;
+	} // for
+	test->check(1 == numLocked, "no rupture before slip");
+
+	// Integral of the friction coefficient over the slip.
+	const PylithScalar slipTotal = numSteps*slipIncr;
+	const PylithScalar coefIntegral = 0.5*(0.7+0.6)*0.0078125 +
+	  0.5*(0.6+0.4)*(0.0234375-0.0078125) + 0.4*(slipTotal-0.0234375);
+	test->checkClose(cohesion*slipTotal - coefIntegral*normalTraction,
+			 stateVars[s_frictionalWork], tolerance, "frictional work");
+	test->checkClose(-(coefIntegral - 0.4*slipTotal)*normalTraction,
+			 stateVars[s_breakdownWork], tolerance, "breakdown work");
+	test->check(1.0 == stateVars[s_ruptureTime], "rupture time");
+	test->check(12.0 == stateVars[s_weakeningEndTime], "weakening end time");
+
+	// Slip in tension only works against the cohesion.
+	const PylithScalar workPrev = stateVars[s_frictionalWork];
+	const PylithScalar breakdownPrev = stateVars[s_breakdownWork];
+	model._updateStateVars(numSteps+1.0, 0.1 + (numSteps+1)*slipIncr, slipIncr / 1.0e-3,
+			       -normalTraction, &stateVars[0], numStateVarsDiagnostics,
+			       &properties[0], numProperties);
+	test->checkClose(workPrev + cohesion*slipIncr, stateVars[s_frictionalWork], tolerance,
+			 "frictional work in tension");
+	test->check(breakdownPrev == stateVars[s_breakdownWork], "breakdown work in tension");
+	test->check(1.0 == stateVars[s_ruptureTime] && 12.0 == stateVars[s_weakeningEndTime],
+		    "cohesive zone times kept");
+
+	// Times not reached are not scaled.
+	spatialdata::units::Nondimensional normalizer;
+	normalizer.lengthScale(1.0e+3);
+	normalizer.pressureScale(2.25e+10);
+	normalizer.timeScale(2.0);
+	model.normalizer(normalizer);
+	pylith::scalar_array stateVarsND(stateVars);
+	stateVarsND[s_weakeningEndTime] = PYLITH_MAXSCALAR;
+	model._nondimStateVars(&stateVarsND[0], numStateVarsDiagnostics);
+	test->checkClose(stateVars[s_frictionalWork], 2.25e+13*stateVarsND[s_frictionalWork],
+			 tolerance, "nondimensional frictional work");
+	test->checkClose(0.5, stateVarsND[s_ruptureTime], tolerance, "nondimensional rupture time");
+	test->check(PYLITH_MAXSCALAR == stateVarsND[s_weakeningEndTime],
+		    "nondimensional time not reached");
+	model._dimStateVars(&stateVarsND[0], numStateVarsDiagnostics);
+	test->checkClose(stateVars[s_breakdownWork], stateVarsND[s_breakdownWork], tolerance,
+			 "dimensional breakdown work");
+	test->check(PYLITH_MAXSCALAR == stateVarsND[s_weakeningEndTime],
+		    "dimensional time not reached");
+
+	// The exponential cohesive zone ends weakening at a fraction of
+	// the strength drop, x e^(1-x) <= 0.05 with x = (D + D_1) / D_2,
+	// i.e., between D = 0.04 and D = 0.05.
+	TestFrictionModel::Harness<ExponentialCohesiveZoneNoHeal> modelECZ(true);
+	test->checkClose(0.95, modelECZ.weakeningEndFraction(), tolerance,
+			 "default weakening end fraction");
+	bool caught = false;
+	try {
+	  modelECZ.weakeningEndFraction(1.0);
+	} catch (const std::runtime_error& err) {
+	  caught = true;
+	} // try/catch
+	test->check(caught, "weakening end fraction of 1");
+	pylith::scalar_array dbValuesECZ(5);
+	dbValuesECZ[0] = 0.7; // static_coefficient
+	dbValuesECZ[1] = 0.4; // dynamic_coefficient
+	dbValuesECZ[2] = 0.01; // slip_shift
+	dbValuesECZ[3] = 0.01; // slip_stretch
+	dbValuesECZ[4] = cohesion;
+	pylith::scalar_array propertiesECZ(ExponentialCohesiveZoneCurve::numProperties);
+	modelECZ._dbToProperties(&propertiesECZ[0], dbValuesECZ);
+	modelECZ._dbToStateVars(&stateVars[0], dbStateValues);
+	for (int iStep=1; iStep <= 6; ++iStep)
+	  modelECZ._updateStateVars(iStep, 0.1 + iStep*0.01, 10.0, normalTraction,
+				    &stateVars[0], numStateVarsDiagnostics,
+				    &propertiesECZ[0], propertiesECZ.size());
+	test->check(1.0 == stateVars[s_ruptureTime], "exponential rupture time");
+	test->check(5.0 == stateVars[s_weakeningEndTime], "exponential weakening end time");
+      } // testWork
+
+      // ----------------------------------------------------------------
+      // Slip to the next breakpoint of the friction laws.
+      void
+      testBreakpoints(TestFrictionModel* test)
+      { // testBreakpoints
+	test->start("Breakpoints");
+
+	TestFrictionModel::Harness<DoubleSlipWeakeningFrictionNoHeal> model;
+
+	pylith::scalar_array dbValues(6);
+	dbValues[0] = 0.7; // static_coefficient
+	dbValues[1] = 0.65; // transition_coefficient
+	dbValues[2] = 0.4; // dynamic_coefficient
+	dbValues[3] = 0.01; // transition_slip_distance
+	dbValues[4] = 0.03; // final_slip_distance
+	dbValues[5] = cohesion;
+	const int numProperties = DoubleSlipWeakeningCurve::numProperties;
+	const int numStateVars = numStateVarsSW;
+	const int numVerticesBreak = 5;
+	pylith::scalar_array properties(numVerticesBreak*numProperties);
+	model._dbToProperties(&properties[0], dbValues);
+	for (int i=1; i < numVerticesBreak; ++i)
+	  for (int j=0; j < numProperties; ++j)
+	    properties[i*numProperties+j] = properties[j];
+
+	// Vertices in tension, locked, in the first and second
+	// weakening segments, and fully weakened.
+	const PylithScalar slipCum[numVerticesBreak] = { 0.0, 0.0, 0.004, 0.02, 0.05 };
+	const PylithScalar slipIncr[numVerticesBreak] = { 0.001, 0.0, 0.001, 0.001, 0.001 };
+	const PylithScalar tractionN[numVerticesBreak] = {
+	  -normalTraction, normalTraction, normalTraction, normalTraction, normalTraction,
+	};
+	const PylithScalar rateT = fabs(normalTraction) * 0.05 / 0.01;
+	const PylithScalar rateF = fabs(normalTraction) * 0.25 / 0.02;
+	const PylithScalar slipToBreakpointE[numVerticesBreak] = {
+	  PYLITH_MAXSCALAR, 0.01, 0.005, 0.009, PYLITH_MAXSCALAR,
+	};
+	const PylithScalar weakeningRateE[numVerticesBreak] = { 0.0, rateT, rateT, rateF, 0.0 };
+	std::vector<PylithScalar> slip(numVerticesBreak);
+	std::vector<PylithScalar> slipRate(numVerticesBreak);
+	std::vector<PylithScalar> stateVars(numVerticesBreak*numStateVars);
+	for (int i=0; i < numVerticesBreak; ++i) {
+	  slip[i] = 0.1 + slipIncr[i];
+	  slipRate[i] = slipIncr[i] / 1.0e-3;
+	  stateVars[i*numStateVars+0] = slipCum[i];
+	  stateVars[i*numStateVars+1] = 0.1;
+	} // for
+
+	std::vector<PylithScalar> slipToBreakpoint(numVerticesBreak);
+	std::vector<PylithScalar> weakeningRate(numVerticesBreak);
+	ContribFrictionModel::BreakpointHint hint;
+	model.breakpointsBatch(&hint, &slipToBreakpoint[0], &weakeningRate[0],
+			       &slip[0], &slipRate[0], tractionN,
+			       &properties[0], numProperties, &stateVars[0], numStateVars,
+			       numVerticesBreak);
+	int numMismatch = 0;
+	for (int i=0; i < numVerticesBreak; ++i)
+	  if (fabs(slipToBreakpoint[i] - slipToBreakpointE[i]) > 1.0e-12 ||
+	      fabs(weakeningRate[i] - weakeningRateE[i]) > 1.0e-12*rateF)
+	    ++numMismatch;
+	test->check(0 == numMismatch, "slip to breakpoint and weakening rate");
+	test->checkClose(0.005, hint.slipToBreakpoint, tolerance, "minimum slip to breakpoint");
+	test->checkClose(0.005, hint.timeToBreakpoint, tolerance, "minimum time to breakpoint");
+	test->checkClose(rateF, hint.weakeningRate, tolerance, "maximum weakening rate");
+
+	// Hint without per-vertex values, locked vertex only.
+	model.breakpointsBatch(&hint, 0, 0, &slip[1], &slipRate[1], &tractionN[1],
+			       &properties[numProperties], numProperties,
+			       &stateVars[numStateVars], numStateVars, 1);
+	test->checkClose(0.01, hint.slipToBreakpoint, tolerance, "slip to breakpoint when locked");
+	test->check(PYLITH_MAXSCALAR == hint.timeToBreakpoint, "no time to breakpoint when locked");
+
+	// Parabola has a kink at its end; the exponential curve is smooth.
+	TestFrictionModel::Harness<ParabolicCohesiveZoneNoHeal> modelPCZ;
+	pylith::scalar_array dbValuesCZ(5);
+	dbValuesCZ[0] = 0.7; // static_coefficient
+	dbValuesCZ[1] = 0.4; // dynamic_coefficient
+	dbValuesCZ[2] = 0.01; // slip_shift
+	dbValuesCZ[3] = 0.02; // slip_stretch
+	dbValuesCZ[4] = cohesion;
+	pylith::scalar_array propertiesCZ(ParabolicCohesiveZoneCurve::numProperties);
+	modelPCZ._dbToProperties(&propertiesCZ[0], dbValuesCZ);
+	stateVars[0] = 0.02;
+	stateVars[1] = slip[1];
+	modelPCZ.breakpointsBatch(&hint, 0, 0, &slip[1], &slipRate[1], &tractionN[1],
+				  &propertiesCZ[0], propertiesCZ.size(), &stateVars[0], numStateVars, 1);
+	test->checkClose(0.01, hint.slipToBreakpoint, tolerance, "parabolic cohesive zone");
+	stateVars[0] = 0.04;
+	modelPCZ.breakpointsBatch(&hint, 0, 0, &slip[1], &slipRate[1], &tractionN[1],
+				  &propertiesCZ[0], propertiesCZ.size(), &stateVars[0], numStateVars, 1);
+	test->check(PYLITH_MAXSCALAR == hint.slipToBreakpoint && 0.0 == hint.weakeningRate,
+		    "parabolic cohesive zone past parabola");
+
+	TestFrictionModel::Harness<ExponentialCohesiveZoneNoHeal> modelECZ;
+	propertiesCZ.resize(ExponentialCohesiveZoneCurve::numProperties);
+	modelECZ._dbToProperties(&propertiesCZ[0], dbValuesCZ);
+	modelECZ.breakpointsBatch(&hint, 0, 0, &slip[1], &slipRate[1], &tractionN[1],
+				  &propertiesCZ[0], propertiesCZ.size(), &stateVars[0], numStateVars, 1);
+	test->check(PYLITH_MAXSCALAR == hint.slipToBreakpoint && hint.weakeningRate > 0.0,
+		    "exponential cohesive zone");
+
+	// Viscous friction has no breakpoints.
+	TestFrictionModel::Harness<ViscousFriction> modelViscous;
+	pylith::scalar_array propertiesViscous(3);
+	pylith::scalar_array dbValuesViscous(3);
+	dbValuesViscous[0] = 0.6; // static_coefficient
+	dbValuesViscous[1] = 1.0e-3; // reference_slip_rate
+	dbValuesViscous[2] = cohesion;
+	modelViscous._dbToProperties(&propertiesViscous[0], dbValuesViscous);
+	pylith::scalar_array stateVarsViscous(1);
+	stateVarsViscous[0] = 0.0;
+	modelViscous.breakpointsBatch(&hint, &slipToBreakpoint[0], &weakeningRate[0],
+				      &slip[2], &slipRate[2], &tractionN[2],
+				      &propertiesViscous[0], 3, &stateVarsViscous[0], 1, 1);
+	test->check(PYLITH_MAXSCALAR == hint.slipToBreakpoint &&
+		    PYLITH_MAXSCALAR == hint.timeToBreakpoint &&
+		    0.0 == hint.weakeningRate &&
+		    PYLITH_MAXSCALAR == slipToBreakpoint[0] &&
+		    0.0 == weakeningRate[0], "viscous friction");
+      } // testBreakpoints
+
+      // ----------------------------------------------------------------
+      // FrictionDB
+      void
+      testFrictionDB(TestFrictionModel* test)
+      { // testFrictionDB
+	test->start("FrictionDB");
+
+	// Irregular points in km with cohesion in MPa.
+	const int numLocs = 600;
+	std::vector<double> xy(2*numLocs);
+	const char* simpleDBFilename = "testcontrib_simpledb.tmp";
+	std::ofstream fout(simpleDBFilename);
+	fout << "// Friction properties\n"
+	     << "#SPATIAL.ascii 1\n"
+	     << "SimpleDB {\n"
+	     << "  num-values = 2\n"
+	     << "  value-names = static_coefficient cohesion\n"
+	     << "  value-units = none MPa\n"
+	     << "  num-locs = " << numLocs << "\n"
+	     << "  data-dim = 2\n"
+	     << "  space-dim = 2\n"
+	     << "  cs-data = cartesian {\n"
+	     << "    to-meters = 1.0e+3 // km\n"
+	     << "    space-dim = 2\n"
+	     << "  }\n"
+	     << "}\n";
+	fout.precision(17);
+	for (int i=0; i < numLocs; ++i) {
+	  xy[2*i+0] = 0.5*(i % 30) + 0.2*sin(1.3*i);
+	  xy[2*i+1] = -0.7*(i / 30) + 0.3*cos(0.7*i);
+	  fout << xy[2*i+0] << " " << xy[2*i+1] << "  " << 0.6+0.001*i << " " << 0.01*i << "\n";
+	} // for
+	fout.close();
+
+	const char* filename = "testcontrib_frictiondb.tmp";
+	FrictionDB::convert(simpleDBFilename, filename);
+	remove(simpleDBFilename);
+
+	FrictionDB db("friction properties");
+	db.filename(filename);
+	db.open();
+	test->check(2 == db.spaceDim() && numLocs == db.numLocs() && 2 == db.numValues() &&
+		    std::string("static_coefficient") == db.valueName(0) &&
+		    std::string("cohesion") == db.valueName(1), "header");
+
+	// Nearest point, with coordinates in km, against all points.
+	const char* names[2] = { "cohesion", "static_coefficient" };
+	db.queryVals(names, 2);
+	spatialdata::geocoords::CSCart cs;
+	cs.setSpaceDim(2);
+	cs.toMeters(1.0e+3);
+	int numMismatch = 0;
+	const int numQueries = 500;
+	for (int iQuery=0; iQuery < numQueries; ++iQuery) {
+	  const double coords[2] = {
+	    -2.0 + 18.0*(iQuery % 25)/24.0 + 0.05*sin(2.1*iQuery),
+	    2.0 - 18.0*(iQuery / 25)/19.0 + 0.05*cos(1.7*iQuery),
+	  };
+	  int nearest = 0;
+	  double nearestDist2 = 0.0;
+	  for (int i=0; i < numLocs; ++i) {
+	    const double dist2 = (xy[2*i+0]-coords[0])*(xy[2*i+0]-coords[0]) +
+	      (xy[2*i+1]-coords[1])*(xy[2*i+1]-coords[1]);
+	    if (0 == i || dist2 < nearestDist2) {
+	      nearest = i;
+	      nearestDist2 = dist2;
+	    } // if
+	  } // for
+	  double vals[2];
+	  const int err = db.query(vals, 2, coords, 2, &cs);
+	  if (err || fabs(vals[0] - 1.0e+6*0.01*nearest) > 1.0e-6 ||
+	      fabs(vals[1] - (0.6+0.001*nearest)) > tolerance)
+	    ++numMismatch;
+	} // for
+	test->check(0 == numMismatch, "nearest point");
+
+	// Coordinates in meters.
+	const double coordsM[2] = { 1.0e+3*xy[2*123+0], 1.0e+3*xy[2*123+1] };
+	double vals[2];
+	db.query(vals, 2, coordsM, 2, 0);
+	test->checkClose(1.23e+6, vals[0], 1.0e-6, "query in meters");
+
+	bool caught = false;
+	try {
+	  const char* missing[1] = { "slip_shift" };
+	  db.queryVals(missing, 1);
+	} catch (const std::runtime_error& err) {
+	  caught = true;
+	} // try/catch
+	test->check(caught, "missing value");
+	db.close();
+
+	// Bin table that is not monotone.
+	{ // corrupt
+	  std::fstream fdb(filename, std::ios::in | std::ios::out | std::ios::binary);
+	  int binsOffset = 0;
+	  fdb.seekg(8 + 8*sizeof(int));
+	  fdb.read(reinterpret_cast<char*>(&binsOffset), sizeof(binsOffset));
+	  const int binStart = numLocs + 1;
+	  fdb.seekp(binsOffset + sizeof(int));
+	  fdb.write(reinterpret_cast<const char*>(&binStart), sizeof(binStart));
+	} // corrupt
+	caught = false;
+	try {
+	  db.open();
+	} catch (const std::runtime_error& err) {
+	  caught = true;
+	} // try/catch
+	test->check(caught, "corrupt bins");
+	remove(filename);
+
+	caught = false;
+	try {
+	  fout.open(simpleDBFilename);
+	  fout << "#SPATIAL.ascii 1\nSimpleDB {\n num-values = 1\n value-names = cohesion\n"
+	       << " value-units = furlong\n num-locs = 1\n data-dim = 0\n space-dim = 1\n"
+	       << " cs-data = cartesian {\n to-meters = 1.0\n space-dim = 1\n }\n}\n0.0 1.0\n";
+	  fout.close();
+	  FrictionDB::convert(simpleDBFilename, filename);
+	} catch (const std::runtime_error& err) {
+	  caught = true;
+	} // try/catch
+	remove(simpleDBFilename);
+	test->check(caught, "unknown units");
+
+	caught = false;
+	try {
+	  FrictionDB::convert(simpleDBFilename, filename, "linear");
+	} catch (const std::runtime_error& err) {
+	  caught = true;
+	} // try/catch
+	test->check(caught, "linear query");
+
+	caught = false;
+	try {
+	  db.filename("testcontrib_nonexistent.tmp");
+	  db.open();
+	} catch (const std::runtime_error& err) {
+	  caught = true;
+	} // try/catch
+	test->check(caught, "missing file");
+      } // testFrictionDB
+
+      // ----------------------------------------------------------------
+      // Properties and state variables ordered by fault vertex.
+      void
+      testVertexFields(TestFrictionModel* test)
+      { // testVertexFields
+	test->start("Vertex fields");
+
+	spatialdata::units::Nondimensional normalizer;
+	normalizer.lengthScale(1.0e+3);
+	normalizer.pressureScale(2.25e+10);
+	normalizer.timeScale(2.0);
+
+	TestFrictionModel::Harness<DoubleSlipWeakeningFrictionNoHeal> model;
+	model.label("fault");
+	model.normalizer(normalizer);
+
+	pylith::scalar_array dbValues(6);
+	dbValues[0] = 0.7; // static_coefficient
+	dbValues[1] = 0.6; // transition_coefficient
+	dbValues[2] = 0.4; // dynamic_coefficient
+	dbValues[3] = 0.01; // transition_slip_distance
+	dbValues[4] = 0.03; // final_slip_distance
+	dbValues[5] = cohesion;
+	pylith::scalar_array properties(DoubleSlipWeakeningCurve::numProperties);
+	model._dbToProperties(&properties[0], dbValues);
+	model._nondimProperties(&properties[0], properties.size());
+
+	Fault fault;
+	TestFrictionModel::createFault(&fault, numVertices, &properties[0],
+				       properties.size(), numStateVarsSW, 0.04e-3);
+	const int numProperties = fault.numProperties;
+	const int numStateVars = fault.numStateVars;
+
+	const char* filename = "testcontrib_fields%d.tmp";
+	model.writeVertexFields(filename, &fault.properties[0], numProperties,
+				&fault.stateVars[0], numStateVars, numVertices);
+	std::vector<PylithScalar> propertiesRead(fault.properties.size());
+	std::vector<PylithScalar> stateVarsRead(fault.stateVars.size());
+	model.readVertexFields(&propertiesRead[0], numProperties,
+			       &stateVarsRead[0], numStateVars, numVertices, filename);
+	int numMismatch = 0;
+	for (size_t i=0; i < propertiesRead.size(); ++i)
+	  if (fabs(propertiesRead[i] - fault.properties[i]) > tolerance*fabs(fault.properties[i]))
+	    ++numMismatch;
+	for (size_t i=0; i < stateVarsRead.size(); ++i)
+	  if (fabs(stateVarsRead[i] - fault.stateVars[i]) > tolerance*fabs(fault.stateVars[i]))
+	    ++numMismatch;
+	test->check(0 == numMismatch, "read written fields");
+
+	// The file holds values in SI units.
+	TestFrictionModel::Harness<DoubleSlipWeakeningFrictionNoHeal> modelSI;
+	modelSI.readVertexFields(&propertiesRead[0], numProperties,
+				 &stateVarsRead[0], numStateVars, numVertices, filename);
+	test->checkClose(cohesion, propertiesRead[DoubleSlipWeakeningCurve::p_cohesion],
+			 tolerance*cohesion, "cohesion in SI units");
+	test->checkClose(1.0e+3*fault.stateVars[0], stateVarsRead[0], tolerance,
+			 "cumulative slip in SI units");
+
+	bool caught = false;
+	try {
+	  model.readVertexFields(&propertiesRead[0], numProperties,
+				 &stateVarsRead[0], numStateVars, numVertices-1, filename);
+	} catch (const std::runtime_error& err) {
+	  caught = true;
+	} // try/catch
+	test->check(caught, "number of vertices differs");
+	remove("testcontrib_fields0.tmp");
+      } // testVertexFields
+
+      // ----------------------------------------------------------------
+      // Initialization of the fields from a spatial database.
+      void
+      testInitialize(TestFrictionModel* test)
+      { // testInitialize
+	test->start("initialize");
+
+	// Properties that vary along the fault (x in km).
+	const int numLocs = 11;
+	const char* simpleDBFilename = "testcontrib_simpledb.tmp";
+	std::ofstream fout(simpleDBFilename);
+	fout << "#SPATIAL.ascii 1\n"
+	     << "SimpleDB {\n"
+	     << "  num-values = 6\n"
+	     << "  value-names = static_coefficient transition_coefficient dynamic_coefficient"
+	     << " transition_slip_distance final_slip_distance cohesion\n"
+	     << "  value-units = none none none m m MPa\n"
+	     << "  num-locs = " << numLocs << "\n"
+	     << "  data-dim = 1\n"
+	     << "  space-dim = 2\n"
+	     << "  cs-data = cartesian {\n"
+	     << "    to-meters = 1.0e+3\n"
+	     << "    space-dim = 2\n"
+	     << "  }\n"
+	     << "}\n";
+	for (int i=0; i < numLocs; ++i)
+	  fout << i << " 0.0  " << 0.7+0.01*i << " 0.6 0.4 " << 0.01+0.001*i << " 0.03 " << 0.1*i << "\n";
+	fout.close();
+	const char* dbFilename = "testcontrib_frictiondb.tmp";
+	FrictionDB::convert(simpleDBFilename, dbFilename);
+	remove(simpleDBFilename);
+	FrictionDB db("friction properties");
+	db.filename(dbFilename);
+
+	spatialdata::units::Nondimensional normalizer;
+	normalizer.lengthScale(1.0e+3);
+	normalizer.pressureScale(2.25e+10);
+	normalizer.timeScale(2.0);
+
+	// Fault vertices along the x axis (nondimensional coordinates).
+	const int numVerticesMesh = 200;
+	std::vector<PylithScalar> coordinates(2*numVerticesMesh, 0.0);
+	for (int v=0; v < numVerticesMesh; ++v)
+	  coordinates[2*v+0] = 10.0 * v / (numVerticesMesh-1);
+	spatialdata::geocoords::CSCart cs;
+	cs.setSpaceDim(2);
+	const pylith::topology::Mesh faultMesh(&coordinates[0], numVerticesMesh, 2, &cs);
+
+	TestFrictionModel::Harness<DoubleSlipWeakeningFrictionNoHeal> modelDB;
+	modelDB.label("fault");
+	modelDB.normalizer(normalizer);
+	modelDB.dbProperties(&db);
+	modelDB.initialize(faultMesh, 0);
+	// Static friction at the first vertex (x = 0 km) and the last
+	// vertex (x = 10 km) of the fault.
+	const PylithScalar tractionNormalDB = normalTraction/2.25e+10;
+	modelDB.retrievePropsStateVars(0);
+	test->checkClose(-0.7*normalTraction/2.25e+10,
+			 modelDB.calcFriction(0.0, 0.0, 0.0, tractionNormalDB),
+			 tolerance, "nondimensional properties from database");
+	modelDB.retrievePropsStateVars(numVerticesMesh-1);
+	test->checkClose((-0.8*normalTraction+1.0e+6)/2.25e+10,
+			 modelDB.calcFriction(0.0, 0.0, 0.0, tractionNormalDB),
+			 tolerance, "nondimensional properties from database");
+
+	// Bad values at two points of the database: a negative static
+	// coefficient at x = 3 km (vertices 50-69) and a transition slip
+	// distance larger than the final one at x = 7 km (vertices
+	// 130-149). Both are reported in a single error.
+	const char* badSimpleDBFilename = "testcontrib_badsimpledb.tmp";
+	std::ofstream foutBad(badSimpleDBFilename);
+	foutBad << "#SPATIAL.ascii 1\n"
+		<< "SimpleDB {\n"
+		<< "  num-values = 6\n"
+		<< "  value-names = static_coefficient transition_coefficient dynamic_coefficient"
+		<< " transition_slip_distance final_slip_distance cohesion\n"
+		<< "  value-units = none none none m m MPa\n"
+		<< "  num-locs = " << numLocs << "\n"
+		<< "  data-dim = 1\n"
+		<< "  space-dim = 2\n"
+		<< "  cs-data = cartesian {\n"
+		<< "    to-meters = 1.0e+3\n"
+		<< "    space-dim = 2\n"
+		<< "  }\n"
+		<< "}\n";
+	for (int i=0; i < numLocs; ++i)
+	  foutBad << i << " 0.0  " << ((3 == i) ? -0.7 : 0.7) << " 0.6 0.4 "
+		  << ((7 == i) ? 0.05 : 0.01) << " 0.03 " << 0.1*i << "\n";
+	foutBad.close();
+	const char* badDBFilename = "testcontrib_badfrictiondb.tmp";
+	FrictionDB::convert(badSimpleDBFilename, badDBFilename);
+	remove(badSimpleDBFilename);
+	FrictionDB badDB("bad friction properties");
+	badDB.filename(badDBFilename);
+
+	TestFrictionModel::Harness<DoubleSlipWeakeningFrictionNoHeal> modelBad;
+	modelBad.label("fault");
+	modelBad.normalizer(normalizer);
+	modelBad.dbProperties(&badDB);
+	std::string what;
+	try {
+	  modelBad.initialize(faultMesh, 0);
+	} catch (const std::runtime_error& err) {
+	  what = err.what();
+	} // try/catch
+	remove(badDBFilename);
+	test->check(std::string::npos != what.find("Invalid values of physical properties at 20 vertices") &&
+		    std::string::npos != what.find("vertex 50: Spatial database returned nonpositive value for static"),
+		    "invalid database values at all vertices");
+	test->check(std::string::npos != what.find("violate 1 rule") &&
+		    std::string::npos != what.find("final_slip_distance > transition_slip_distance: 20 vertices, first 130"),
+		    "rules checked over the filled field");
+	remove(dbFilename);
+      } // testInitialize
+
+      // ----------------------------------------------------------------
+      // Validation of the properties of a batch.
+      void
+      testValidateProperties(TestFrictionModel* test)
+      { // testValidateProperties
+	test->start("validateProperties");
+
+	TestFrictionModel::Harness<DoubleSlipWeakeningFrictionNoHeal> model;
+	model.label("fault");
+
+	pylith::scalar_array dbValues(6);
+	dbValues[0] = 0.7; // static_coefficient
+	dbValues[1] = 0.6; // transition_coefficient
+	dbValues[2] = 0.4; // dynamic_coefficient
+	dbValues[3] = 0.01; // transition_slip_distance
+	dbValues[4] = 0.03; // final_slip_distance
+	dbValues[5] = cohesion;
+	const int numProperties = DoubleSlipWeakeningCurve::numProperties;
+	std::vector<PylithScalar> properties(numVertices*numProperties);
+	for (int i=0; i < numVertices; ++i)
+	  model._dbToProperties(&properties[i*numProperties], dbValues);
+
+	bool caught = false;
+	try {
+	  model.validateProperties(&properties[0], numProperties, numVertices);
+	} catch (const std::runtime_error& err) {
+	  caught = true;
+	} // try/catch
+	test->check(!caught, "valid properties");
+
+	// Values _dbToProperties() does not check at a vertex.
+	const int badDistance[3] = { 7, 100, 4000 };
+	for (int i=0; i < 3; ++i)
+	  properties[badDistance[i]*numProperties+DoubleSlipWeakeningCurve::p_distF] = 0.005;
+	properties[3*numProperties+DoubleSlipWeakeningCurve::p_coefT] = 0.8;
+	properties[5*numProperties+DoubleSlipWeakeningCurve::p_coefD] = 0.65;
+	properties[12*numProperties+DoubleSlipWeakeningCurve::p_cohesion] = -1.0;
+	std::string what;
+	try {
+	  model.validateProperties(&properties[0], numProperties, numVertices);
+	} catch (const std::runtime_error& err) {
+	  what = err.what();
+	} // try/catch
+	test->check(std::string::npos != what.find("violate 4 rules"), "number of rules violated");
+	test->check(std::string::npos !=
+		    what.find("final_slip_distance > transition_slip_distance: 3 vertices, first 7 100 4000"),
+		    "cross-field rule");
+	test->check(std::string::npos != what.find("static_coefficient >= transition_coefficient: 1 vertex, first 3") &&
+		    std::string::npos != what.find("transition_coefficient >= dynamic_coefficient: 1 vertex, first 5"),
+		    "order of friction coefficients");
+	test->check(std::string::npos != what.find("cohesion >= 0: 1 vertex, first 12"), "cohesion");
+	test->check(std::string::npos == what.find("dynamic_coefficient > 0"), "rules not violated");
+
+	// Curve index of the tabulated law refers to a table.
+	const char* filename = "testcontrib_tables.tmp";
+	std::ofstream fout(filename);
+	fout << "1\n"
+	     << "2 0.01 linear 0.7 0.4\n";
+	fout.close();
+	TestFrictionModel::Harness<TabulatedSlipWeakeningNoHeal> modelTab;
+	modelTab.filename(filename);
+	remove(filename);
+	const int numPropertiesTab = TabulatedSlipWeakeningCurve::numProperties;
+	std::vector<PylithScalar> propertiesTab(2*numPropertiesTab, 0.0);
+	propertiesTab[numPropertiesTab+TabulatedSlipWeakeningCurve::p_curveIndex] = 1.0;
+	what = "";
+	try {
+	  modelTab.validateProperties(&propertiesTab[0], numPropertiesTab, 2);
+	} catch (const std::runtime_error& err) {
+	  what = err.what();
+	} // try/catch
+	test->check(std::string::npos != what.find("curve_index is the index of a table: 1 vertex, first 1"),
+		    "curve index");
+      } // testValidateProperties
+
+      // ----------------------------------------------------------------
+      // Nondimensionalization of batches of vertices.
+      void
+      testScalingBatch(TestFrictionModel* test)
+      { // testScalingBatch
+	test->start("Batch scaling");
+
+	spatialdata::units::Nondimensional normalizer;
+	normalizer.lengthScale(1.0e+3);
+	normalizer.pressureScale(2.25e+10);
+	normalizer.timeScale(2.0);
+
+	TestFrictionModel::Harness<DoubleSlipWeakeningFrictionNoHeal> modelDSW(true);
+	modelDSW.normalizer(normalizer);
+	pylith::scalar_array dbValues(6);
+	dbValues[0] = 0.7; // static_coefficient
+	dbValues[1] = 0.6; // transition_coefficient
+	dbValues[2] = 0.4; // dynamic_coefficient
+	dbValues[3] = 0.01; // transition_slip_distance
+	dbValues[4] = 0.03; // final_slip_distance
+	dbValues[5] = cohesion;
+	pylith::scalar_array properties(DoubleSlipWeakeningCurve::numProperties);
+	modelDSW._dbToProperties(&properties[0], dbValues);
+	checkScalingBatch(test, modelDSW, properties, numStateVarsDiagnostics,
+			  "double slip-weakening with diagnostics");
+
+	// Curvature has dimension 1/length^2.
+	TestFrictionModel::Harness<ParabolicCohesiveZoneNoHeal> modelPCZ;
+	modelPCZ.normalizer(normalizer);
+	dbValues.resize(5);
+	dbValues[0] = 0.7; // static_coefficient
+	dbValues[1] = 0.4; // dynamic_coefficient
+	dbValues[2] = 0.01; // slip_shift
+	dbValues[3] = 0.02; // slip_stretch
+	dbValues[4] = cohesion;
+	properties.resize(ParabolicCohesiveZoneCurve::numProperties);
+	modelPCZ._dbToProperties(&properties[0], dbValues);
+	checkScalingBatch(test, modelPCZ, properties, numStateVarsSW, "parabolic cohesive zone");
+
+	// Reference slip rate and slip rate have dimension length/time.
+	TestFrictionModel::Harness<ViscousFriction> modelViscous;
+	modelViscous.normalizer(normalizer);
+	dbValues.resize(3);
+	dbValues[0] = 0.6; // static_coefficient
+	dbValues[1] = 1.0e-3; // reference_slip_rate
+	dbValues[2] = cohesion;
+	properties.resize(3);
+	modelViscous._dbToProperties(&properties[0], dbValues);
+	checkScalingBatch(test, modelViscous, properties, 1, "viscous friction");
+
+	// Rescaling a batch in place invalidates the active sets built
+	// from it, since the coefficients of locked vertices have units.
+	dbValues.resize(6);
+	dbValues[0] = 0.7; // static_coefficient
+	dbValues[1] = 0.6; // transition_coefficient
+	dbValues[2] = 0.4; // dynamic_coefficient
+	dbValues[3] = 0.01; // transition_slip_distance
+	dbValues[4] = 0.03; // final_slip_distance
+	dbValues[5] = cohesion;
+	properties.resize(DoubleSlipWeakeningCurve::numProperties);
+	modelDSW._dbToProperties(&properties[0], dbValues);
+	modelDSW._nondimProperties(&properties[0], properties.size());
+	Fault fault;
+	TestFrictionModel::createFault(&fault, numVertices, &properties[0], properties.size(),
+				       numStateVarsDiagnostics, 0.04/1.0e+3);
+	const int numProperties = fault.numProperties;
+	const int numStateVars = fault.numStateVars;
+	const PylithScalar t = 0.0;
+	modelDSW.updateStateVarsBatch(t, &fault.slip[0], &fault.slipRate[0],
+				      &fault.normalTraction[0], &fault.stateVars[0], numStateVars,
+				      &fault.properties[0], numProperties, numVertices);
+	modelDSW.dimPropertiesBatch(&fault.properties[0], numProperties, numVertices);
+	modelDSW.dimStateVarsBatch(&fault.stateVars[0], numStateVars, numVertices);
+	for (int i=0; i < numVertices; ++i)
+	  fault.slip[i] *= 1.0e+3;
+
+	TestFrictionModel::Harness<DoubleSlipWeakeningFrictionNoHeal> modelRef(true);
+	modelRef.normalizer(normalizer);
+	std::vector<PylithScalar> friction(numVertices);
+	std::vector<PylithScalar> frictionDeriv(numVertices);
+	std::vector<PylithScalar> frictionRef(numVertices);
+	std::vector<PylithScalar> frictionDerivRef(numVertices);
+	modelDSW.calcFrictionAndDerivBatch(&friction[0], &frictionDeriv[0], t, &fault.slip[0],
+					   &fault.slipRate[0], &fault.normalTraction[0],
+					   &fault.properties[0], numProperties,
+					   &fault.stateVars[0], numStateVars, numVertices);
+	modelRef.calcFrictionAndDerivBatch(&frictionRef[0], &frictionDerivRef[0], t, &fault.slip[0],
+					   &fault.slipRate[0], &fault.normalTraction[0],
+					   &fault.properties[0], numProperties,
+					   &fault.stateVars[0], numStateVars, numVertices);
+	test->check(friction == frictionRef && frictionDeriv == frictionDerivRef,
+		    "active sets invalidated by rescaling");
+      } // testScalingBatch
+
+    } // _TestContrib
+  } // friction
+} // contrib
+
+// ----------------------------------------------------------------------
+int
+main(int argc,
+     char** argv)
+{ // main
+  using namespace contrib::friction::_TestContrib;
+
+  PetscErrorCode err = PetscInitialize(&argc, &argv, NULL, NULL);CHKERRQ(err);
+
+  contrib::friction::TestFrictionModel test;
+  try {
+    testViscousFriction(&test);
+    testDoubleSlipWeakening(&test);
+    testParabolicCohesiveZone(&test);
+    testExponentialCohesiveZone(&test);
+    testTabulatedSlipWeakening(&test);
+    testNondimensional(&test);
+    testNumThreads(&test);
+    testTrace(&test);
+    testFlops(&test);
+    testCensus(&test);
+    testTangentChanges(&test);
+    testWork(&test);
+    testBreakpoints(&test);
+    testFrictionDB(&test);
+    testVertexFields(&test);
+    testInitialize(&test);
+    testValidateProperties(&test);
+    testScalingBatch(&test);
+  } catch (const std::exception& err) {
+    printf("Error: %s\n", err.what());
+    test.check(false, "unexpected exception");
+  } // try/catch
+
+  printf("%d checks, %d failures\n", test.numChecks(), test.numFailures());
+
+  err = PetscFinalize();CHKERRQ(err);
+  return (0 == test.numFailures()) ? 0 : 1;
+} // main
+
+
+// End of file